@@ -257,7 +257,7 @@ namespace noco::editor
 					return;
 				}
 
-				Texture texture = noco::Asset::GetOrLoadTexture(texturePath);
+				Texture texture = noco::Asset::GetOrLoadTexture(texturePath, noco::AllowPlaceholderYN::No);
 				if (!texture)
 				{
 					return;
@@ -519,6 +519,7 @@ namespace noco::editor
 					MenuItem{ U"CursorChanger を追加", U"", KeyC, [this] { onClickAddComponent<CursorChanger>(); } },
 					MenuItem{ U"UISound を追加", U"", KeyU, [this] { onClickAddComponent<UISound>(); } },
 					MenuItem{ U"Tween を追加", U"", KeyW, [this] { onClickAddComponent<Tween>(); } },
+					MenuItem{ U"KeyframeAnimation を追加", U"", KeyK, [this] { onClickAddComponent<KeyframeAnimation>(); } },
 					MenuItem{ U"SubCanvas を追加", U"", Input{}, [this] { onClickAddComponent<SubCanvas>(); } },
 				};
 				
@@ -566,7 +566,7 @@ public:
 #endif
 		if (hasUserInput)
 		{
-			m_historySystem.recordStateIfNeeded(m_canvas->toJSON(WithInstanceIdYN::Yes));
+			m_historySystem.recordStateIfNeeded(m_canvas->toJSON(WithInstanceIdYN::Yes, OmitDefaultValuesYN::Yes));
 			m_toolbar.updateButtonStates();
 		}
 		
@@ -1606,7 +1606,7 @@ public:
 
 	void onClickMenuEditUndo()
 	{
-		if (const auto undoState = m_historySystem.undo(m_canvas->toJSON(WithInstanceIdYN::Yes)))
+		if (const auto undoState = m_historySystem.undo(m_canvas->toJSON(WithInstanceIdYN::Yes, OmitDefaultValuesYN::Yes)))
 		{
 			// 現在選択中のノードのinstanceIdを保存
 			const auto selectedNodeIds = saveSelectedNodeIds();
@@ -1630,7 +1630,7 @@ public:
 	
 	void onClickMenuEditRedo()
 	{
-		if (const auto redoState = m_historySystem.redo(m_canvas->toJSON(WithInstanceIdYN::Yes)))
+		if (const auto redoState = m_historySystem.redo(m_canvas->toJSON(WithInstanceIdYN::Yes, OmitDefaultValuesYN::Yes)))
 		{
 			// 現在選択中のノードのinstanceIdを保存
 			const auto selectedNodeIds = saveSelectedNodeIds();
@@ -1674,7 +1674,7 @@ public:
 	
 	void recordInitialHistoryState()
 	{
-		m_historySystem.recordInitialState(m_canvas->toJSON(WithInstanceIdYN::Yes));
+		m_historySystem.recordInitialState(m_canvas->toJSON(WithInstanceIdYN::Yes, OmitDefaultValuesYN::Yes));
 	}
 };
 
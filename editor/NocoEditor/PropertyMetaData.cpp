@@ -599,6 +599,19 @@ namespace noco::editor
 			},
 			.dragValueChangeStep = 1.0,
 		};
+		metadata[PropertyKey{ U"Label", U"autoShrinkPrecision" }] = PropertyMetadata{
+			.tooltip = U"AutoShrink時のフォントサイズの刻み幅",
+			.tooltipDetail = U"AutoShrink時に、指定フォントサイズからこの値の刻みで縮小したフォントサイズのうちノードサイズに収まる最大のものを使用します\n小数を指定すると、よりノードサイズに近いフォントサイズで表示できます(最小値0.01)",
+			.visibilityCondition = [](const ComponentBase& component)
+			{
+				if (auto label = dynamic_cast<const Label*>(&component))
+				{
+					return label->sizingMode().defaultValue() == LabelSizingMode::AutoShrink;
+				}
+				return false;
+			},
+			.dragValueChangeStep = 0.1,
+		};
 		metadata[PropertyKey{ U"Label", U"horizontalAlign" }] = PropertyMetadata{
 			.tooltip = U"水平方向の配置",
 		};
@@ -1017,6 +1030,10 @@ namespace noco::editor
 			.tooltip = U"PixelShaderAssetのキー名 (任意)",
 			.tooltipDetail = U"指定されている場合、描画時にこのキー名をもとに取得したPixelShaderAssetのシェーダーを適用します\n※エディタ上でプレビューするには、Custom/PixelShaders内にJSONファイルを作成してください",
 		};
+		metadata[PropertyKey{ U"Sprite", U"textureOpaque" }] = PropertyMetadata{
+			.tooltip = U"テクスチャが不透明かどうか",
+			.tooltipDetail = U"有効の場合、テクスチャに透明部分がないものとして扱います\nCanvasのオクルージョンカリングが有効な場合、このSpriteに完全に隠れる背面のノードの描画がスキップされます\n※colorのアルファが255未満、ブレンドモードがNormal以外、アスペクト比保持やPixelShader使用時は無視されます",
+		};
 
 		// TextBox
 		metadata[PropertyKey{ U"TextBox", U"fontAssetName" }] = PropertyMetadata{
@@ -1385,6 +1402,42 @@ namespace noco::editor
 			.tooltipDetail = U"Tweenを一括制御するためのタグ文字列です\nCanvas::setTweenActiveByTag()で同じタグを持つ\nTweenを一括でアクティブ/非アクティブにできます",
 		};
 
+		// KeyframeAnimation
+		metadata[PropertyKey{ U"KeyframeAnimation", U"active" }] = PropertyMetadata{
+			.tooltip = U"キーフレームアニメーションの再生状態",
+		};
+		metadata[PropertyKey{ U"KeyframeAnimation", U"keyframesJSON" }] = PropertyMetadata{
+			.tooltip = U"キーフレーム (JSON)",
+			.tooltipDetail = U"チャンネル毎のキーフレームを指定します\n形式: {\"translate\": [{\"time\": 0.0, \"value\": [0, 0], \"easing\": \"Linear\"}, {\"time\": 1.0, \"value\": [100, 0]}]}\n\nチャンネル:\n・translate: [x, y]\n・scale: [x, y]\n・rotation: 数値\n・color: [r, g, b, a] (0~255)\n・properties: {\"Label.fontSize\": [...]} のように\"コンポーネント型名.プロパティ名\"をキーとして指定\n\neasingは次のキーフレームまでの補間に使用されます",
+			.numTextAreaLines = 5,
+		};
+		metadata[PropertyKey{ U"KeyframeAnimation", U"loopType" }] = PropertyMetadata{
+			.tooltip = U"ループの種類",
+			.tooltipDetail = U"None: ループなし\nLoop: 最後のキーフレームに到達したら最初から再生\nPingPong: 最後のキーフレームに到達したら逆方向に再生",
+		};
+		metadata[PropertyKey{ U"KeyframeAnimation", U"restartOnActive" }] = PropertyMetadata{
+			.tooltip = U"アクティブ時に最初から再生",
+			.tooltipDetail = U"activeプロパティがfalse→trueになった時、またはノード自体のアクティブ状態がfalse→trueになった時に、アニメーションを最初から再生し直すかどうか",
+		};
+		metadata[PropertyKey{ U"KeyframeAnimation", U"manualMode" }] = PropertyMetadata{
+			.tooltip = U"手動制御モード",
+			.tooltipDetail = U"有効にすると、時間経過ではなくmanualTimeプロパティの値(秒)でアニメーションの再生位置を制御します",
+			.refreshInspectorOnChange = true,
+		};
+		metadata[PropertyKey{ U"KeyframeAnimation", U"manualTime" }] = PropertyMetadata{
+			.tooltip = U"手動制御の再生時間(秒)",
+			.tooltipDetail = U"アニメーションの再生時間を手動で指定します",
+			.visibilityCondition = [](const ComponentBase& component) -> bool
+			{
+				if (const auto* keyframeAnimation = dynamic_cast<const KeyframeAnimation*>(&component))
+				{
+					return HasAnyTrueState(keyframeAnimation->manualMode());
+				}
+				return false;
+			},
+			.dragValueChangeStep = 0.1,
+		};
+
 		// Canvasのプロパティ
 		metadata[PropertyKey{ U"Canvas", U"size" }] = PropertyMetadata{
 			.tooltip = U"Canvasのサイズ",
@@ -61,7 +61,7 @@ namespace noco::editor
 			const String texturePath = m_sprite->textureFilePath().defaultValue();
 			if (!texturePath.isEmpty())
 			{
-				Texture texture = noco::Asset::GetOrLoadTexture(texturePath);
+				Texture texture = noco::Asset::GetOrLoadTexture(texturePath, noco::AllowPlaceholderYN::No);
 				if (texture)
 				{
 					m_textureSize = texture.size();
@@ -3,11 +3,14 @@
 #include "NocoUI/DefaultFont.hpp"
 #include "NocoUI/Node.hpp"
 #include "NocoUI/Canvas.hpp"
+#include "NocoUI/CanvasPrototype.hpp"
 #include "NocoUI/Region/Region.hpp"
 #include "NocoUI/Layout/Layout.hpp"
 #include "NocoUI/Component/Component.hpp"
 #include "NocoUI/ComponentFactory.hpp"
 #include "NocoUI/Asset.hpp"
+#include "NocoUI/AssetArchive.hpp"
+#include "NocoUI/BinaryCanvas.hpp"
 #include "NocoUI/PropertyUtils.hpp"
 #include "NocoUI/ParamUtils.hpp"
 #include "NocoUI/Version.hpp"
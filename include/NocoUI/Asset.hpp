@@ -1,17 +1,61 @@
 ﻿#pragma once
 #include <Siv3D.hpp>
+#include "YN.hpp"
 
 namespace noco
 {
+	class CanvasPrototype;
+
 	namespace detail
 	{
+		/// @brief アセットのメモリ使用量(バイト数)の推定値を取得
+		/// @note テクスチャは幅・高さ・フォーマットのピクセルサイズ(ミップマップを含む)、オーディオはサンプル数から求める
+		/// @note JSONは内容から求めると再シリアライズが必要になるため、登録時に読み込み元のバイト数を指定する
+		[[nodiscard]]
+		size_t EstimateAssetByteSize(const Texture& texture);
+
+		[[nodiscard]]
+		size_t EstimateAssetByteSize(const Audio& audio);
+
+		/// @brief アセットが再生中かどうかを取得
+		/// @note 再生中のオーディオを破棄すると再生が途切れるため、退避の対象外とする
+		template <class T>
+		[[nodiscard]]
+		bool IsAssetPlaying(const T&)
+		{
+			return false;
+		}
+
+		[[nodiscard]]
+		inline bool IsAssetPlaying(const Audio& audio)
+		{
+			return audio.isPlaying();
+		}
+
 		// Siv3DのAssetシステムを直接使うとユーザー側のアセットとの衝突回避用にPrefixを付与する必要が生じてコストがかかるため、別途管理する
 		template <class T>
 		class AssetTable
 		{
 		private:
-			// get関数が返すTの参照がregisterAsset関数の呼び出しによるHashTableのメモリ再配置で無効にならないよう、Tは直接持たずshared_ptr<T>で持つ
-			HashTable<AssetName, std::shared_ptr<T>> m_table;
+			struct Entry
+			{
+				// get関数が返すTの参照がregisterAsset関数の呼び出しによるHashTableのメモリ再配置で無効にならないよう、Tは直接持たずshared_ptr<T>で持つ
+				// getShared関数で渡したshared_ptrが残っている間は参照中とみなし、退避の対象外とする
+				std::shared_ptr<T> asset;
+				size_t byteSize = 0;
+				mutable int32 lastUsedFrameCount = 0;
+			};
+
+			HashTable<AssetName, Entry> m_table;
+			size_t m_totalByteSize = 0;
+
+			void emplaceEntry(FilePathView filePath, std::shared_ptr<T>&& asset, size_t byteSize)
+			{
+				if (m_table.emplace(filePath, Entry{ .asset = std::move(asset), .byteSize = byteSize, .lastUsedFrameCount = Scene::FrameCount() }).second)
+				{
+					m_totalByteSize += byteSize;
+				}
+			}
 
 		public:
 			bool isRegistered(FilePathView filePath) const
@@ -21,27 +65,52 @@ namespace noco
 
 			void registerAsset(FilePathView filePath, const T& asset)
 			{
-				m_table.emplace(filePath, std::make_shared<T>(asset));
+				const size_t byteSize = EstimateAssetByteSize(asset);
+				emplaceEntry(filePath, std::make_shared<T>(asset), byteSize);
 			}
 
 			void registerAsset(FilePathView filePath, T&& asset)
 			{
-				m_table.emplace(filePath, std::make_shared<T>(std::move(asset)));
+				const size_t byteSize = EstimateAssetByteSize(asset);
+				emplaceEntry(filePath, std::make_shared<T>(std::move(asset)), byteSize);
+			}
+
+			/// @brief メモリ使用量の推定値を指定してアセットを登録する
+			/// @param byteSize メモリ使用量(推定値)。読み込み元のファイルサイズ等、読み込み時に分かっている値を指定する
+			void registerAsset(FilePathView filePath, T&& asset, size_t byteSize)
+			{
+				emplaceEntry(filePath, std::make_shared<T>(std::move(asset)), byteSize);
 			}
 
 			void unregister(FilePathView filePath)
 			{
-				m_table.erase(filePath);
+				if (const auto it = m_table.find(filePath); it != m_table.end())
+				{
+					m_totalByteSize -= it->second.byteSize;
+					m_table.erase(it);
+				}
 			}
 
 			const T& get(FilePathView filePath) const
 			{
-				return *m_table.at(filePath);
+				const Entry& entry = m_table.at(filePath);
+				entry.lastUsedFrameCount = Scene::FrameCount();
+				return *entry.asset;
+			}
+
+			/// @brief アセットを参照として取得する
+			/// @note 戻り値が破棄されるまでは退避の対象外となる
+			std::shared_ptr<const T> getShared(FilePathView filePath) const
+			{
+				const Entry& entry = m_table.at(filePath);
+				entry.lastUsedFrameCount = Scene::FrameCount();
+				return entry.asset;
 			}
 
 			void clear()
 			{
 				m_table.clear();
+				m_totalByteSize = 0;
 			}
 
 			template <class Pred>
@@ -49,8 +118,9 @@ namespace noco
 			{
 				for (auto it = m_table.begin(); it != m_table.end();)
 				{
-					if (predicate(*it))
+					if (predicate(std::pair<const AssetName&, const std::shared_ptr<T>&>{ it->first, it->second.asset }))
 					{
+						m_totalByteSize -= it->second.byteSize;
 						it = m_table.erase(it);
 					}
 					else
@@ -59,6 +129,55 @@ namespace noco
 					}
 				}
 			}
+
+			/// @brief 登録済みアセットのメモリ使用量の合計(推定値)
+			[[nodiscard]]
+			size_t totalByteSize() const
+			{
+				return m_totalByteSize;
+			}
+
+			[[nodiscard]]
+			size_t size() const
+			{
+				return m_table.size();
+			}
+
+			/// @brief メモリ使用量の合計が上限を超えている間、参照されていないアセットを最終使用フレームが古い順に破棄する
+			/// @param budgetByteSize メモリ使用量の上限
+			/// @return 破棄した件数
+			/// @note get関数が返した参照を保護するため、現在のフレームで使用されたアセットは破棄しない
+			/// @note 再生中のオーディオは破棄しない
+			size_t evictToBudget(size_t budgetByteSize)
+			{
+				if (m_totalByteSize <= budgetByteSize)
+				{
+					return 0;
+				}
+
+				const int32 currentFrameCount = Scene::FrameCount();
+				Array<std::pair<int32, AssetName>> candidates;
+				for (const auto& [filePath, entry] : m_table)
+				{
+					if (entry.asset.use_count() == 1 && entry.lastUsedFrameCount != currentFrameCount && !IsAssetPlaying(*entry.asset))
+					{
+						candidates.emplace_back(entry.lastUsedFrameCount, filePath);
+					}
+				}
+				std::sort(candidates.begin(), candidates.end());
+
+				size_t evictedCount = 0;
+				for (const auto& [lastUsedFrameCount, filePath] : candidates)
+				{
+					if (m_totalByteSize <= budgetByteSize)
+					{
+						break;
+					}
+					unregister(filePath);
+					++evictedCount;
+				}
+				return evictedCount;
+			}
 		};
 
 		inline AssetTable<Texture>& TextureAssetTable()
@@ -78,8 +197,178 @@ namespace noco
 			static AssetTable<JSON> table;
 			return table;
 		}
+
+		/// @brief JSONを取得(未読み込みの場合は非同期読み込みの設定に関わらずその場で読み込む)
+		/// @param filePath JSONファイルのパス
+		/// @return JSON
+		/// @note 非同期読み込み中の場合は依頼を取り消して読み込み直す。参照先を辿るために内容がすぐに必要な場合に使用する
+		[[nodiscard]]
+		const JSON& GetOrLoadJSONImmediately(FilePathView filePath);
+
+		/// @brief アセットの世代番号を進める
+		/// @note 読み込み済みのアセットが再読み込み・アンロードされた場合に呼び出し、解決済みテクスチャのキャッシュを無効にする
+		void IncrementAssetGeneration();
+
+		/// @brief コンポーネント毎に解決済みのテクスチャを保持するキャッシュ
+		/// @note テクスチャファイルパス・アセット名の各プロパティの内容バージョン、エディタモードかどうか、代替テクスチャを許可するかどうか、アセットの世代番号が一致する間は再解決しない
+		/// @note Asset::AcquireTextureで取得した参照を保持するため、キャッシュしている間はアセットテーブルからの退避の対象外となる
+		class ResolvedTextureCache
+		{
+		private:
+			std::shared_ptr<const Texture> m_texture;
+			uint64 m_textureFilePathVersion = 0;
+			uint64 m_textureAssetNameVersion = 0;
+			uint64 m_assetGeneration = 0;
+			bool m_isEditorMode = false;
+			bool m_allowPlaceholder = false;
+			bool m_hasTexture = false;
+
+		public:
+			/// @brief キャッシュ済みのテクスチャを返す。キーが変化している場合は解決し直す
+			/// @param textureFilePathVersion テクスチャファイルパスのプロパティの内容バージョン
+			/// @param textureAssetNameVersion テクスチャアセット名のプロパティの内容バージョン
+			/// @param isEditorMode エディタモードかどうか
+			/// @param allowPlaceholder 非同期読み込み中の代替テクスチャを許可するかどうか
+			/// @param assetGeneration アセットの世代番号(Asset::Generation())
+			/// @param resolveTexture テクスチャを解決し、その参照(std::shared_ptr<const Texture>)を返す関数
+			/// @return テクスチャ
+			/// @note 空のテクスチャはキャッシュしないため、ファイルが存在しない場合等は毎回解決を試みる
+			template <class Fun>
+			const Texture& getOrResolve(uint64 textureFilePathVersion, uint64 textureAssetNameVersion, bool isEditorMode, AllowPlaceholderYN allowPlaceholder, uint64 assetGeneration, Fun&& resolveTexture)
+			{
+				static const Texture EmptyTexture{};
+
+				if (m_hasTexture
+					&& m_textureFilePathVersion == textureFilePathVersion
+					&& m_textureAssetNameVersion == textureAssetNameVersion
+					&& m_isEditorMode == isEditorMode
+					&& m_allowPlaceholder == allowPlaceholder.getBool()
+					&& m_assetGeneration == assetGeneration)
+				{
+					return *m_texture;
+				}
+
+				m_texture = resolveTexture();
+				m_textureFilePathVersion = textureFilePathVersion;
+				m_textureAssetNameVersion = textureAssetNameVersion;
+				m_isEditorMode = isEditorMode;
+				m_allowPlaceholder = allowPlaceholder.getBool();
+				m_assetGeneration = assetGeneration;
+				m_hasTexture = m_texture && !m_texture->isEmpty();
+				return m_texture ? *m_texture : EmptyTexture;
+			}
+
+			void clear()
+			{
+				m_texture.reset();
+				m_hasTexture = false;
+			}
+		};
 	}
 
+	/// @brief Canvasが参照するアセットファイルの一覧
+	/// @note 重複するパスは最初の1件のみ保持する
+	class AssetDependencies
+	{
+	private:
+		Array<FilePath> m_textureFilePaths;
+		Array<FilePath> m_audioFilePaths;
+		Array<FilePath> m_canvasFilePaths;
+		HashSet<FilePath> m_addedTextureFilePaths;
+		HashSet<FilePath> m_addedAudioFilePaths;
+		HashSet<FilePath> m_addedCanvasFilePaths;
+
+	public:
+		/// @brief テクスチャファイルのパスを追加する
+		/// @param filePath テクスチャファイルのパス(空の場合は何もしない)
+		void addTextureFilePath(FilePathView filePath)
+		{
+			if (!filePath.isEmpty() && m_addedTextureFilePaths.emplace(filePath).second)
+			{
+				m_textureFilePaths.emplace_back(filePath);
+			}
+		}
+
+		/// @brief オーディオファイルのパスを追加する
+		/// @param filePath オーディオファイルのパス(空の場合は何もしない)
+		void addAudioFilePath(FilePathView filePath)
+		{
+			if (!filePath.isEmpty() && m_addedAudioFilePaths.emplace(filePath).second)
+			{
+				m_audioFilePaths.emplace_back(filePath);
+			}
+		}
+
+		/// @brief Canvasファイル(.noco)のパスを追加する
+		/// @param filePath Canvasファイルのパス(空の場合は何もしない)
+		void addCanvasFilePath(FilePathView filePath)
+		{
+			if (!filePath.isEmpty() && m_addedCanvasFilePaths.emplace(filePath).second)
+			{
+				m_canvasFilePaths.emplace_back(filePath);
+			}
+		}
+
+		[[nodiscard]]
+		const Array<FilePath>& textureFilePaths() const
+		{
+			return m_textureFilePaths;
+		}
+
+		[[nodiscard]]
+		const Array<FilePath>& audioFilePaths() const
+		{
+			return m_audioFilePaths;
+		}
+
+		[[nodiscard]]
+		const Array<FilePath>& canvasFilePaths() const
+		{
+			return m_canvasFilePaths;
+		}
+
+		/// @brief 含まれるパスの総数を取得
+		[[nodiscard]]
+		size_t size() const
+		{
+			return m_textureFilePaths.size() + m_audioFilePaths.size() + m_canvasFilePaths.size();
+		}
+
+		[[nodiscard]]
+		bool empty() const
+		{
+			return size() == 0;
+		}
+	};
+
+	/// @brief Assetが管理しているアセットのメモリ使用量(推定値)
+	struct AssetMemoryUsage
+	{
+		/// @brief テクスチャのバイト数
+		size_t textureBytes = 0;
+
+		/// @brief オーディオのバイト数
+		size_t audioBytes = 0;
+
+		/// @brief JSONのバイト数
+		size_t jsonBytes = 0;
+
+		/// @brief 読み込み済みのテクスチャ数
+		size_t textureCount = 0;
+
+		/// @brief 読み込み済みのオーディオ数
+		size_t audioCount = 0;
+
+		/// @brief 読み込み済みのJSON数
+		size_t jsonCount = 0;
+
+		[[nodiscard]]
+		size_t totalBytes() const
+		{
+			return textureBytes + audioBytes + jsonBytes;
+		}
+	};
+
 	namespace Asset
 	{
 		/// @brief アセットのベースディレクトリパスを取得
@@ -91,17 +380,165 @@ namespace noco
 		/// @param path ベースディレクトリパス
 		void SetBaseDirectoryPath(FilePathView path);
 
+		/// @brief アセットの世代番号を取得
+		/// @return 読み込み済みのアセットが再読み込み・アンロードされるたび、またはベースディレクトリパスが変更されるたびに増加する値
+		[[nodiscard]]
+		uint64 Generation();
+
+		/// @brief 解決済みテクスチャのキャッシュを無効にする
+		/// @note Siv3DのTextureAssetの登録内容を変更した場合、SpriteやTextureFontLabelが古いテクスチャを使い続けないよう呼び出す必要がある
+		void InvalidateResolvedTextures();
+
+		/// @brief 非同期読み込みを有効にするかどうかを設定
+		/// @param enabled 有効にする場合はtrue
+		/// @note 有効な場合、GetOrLoadTexture・GetOrLoadAudio・GetOrLoadJSONは未読み込みのファイルの読み込みをワーカースレッドへ依頼し、完了までは代替値(テクスチャの場合はSetPlaceholderTextureで設定したテクスチャ)を返す
+		/// @note ファイル読み込みとデコード・JSONのパースはワーカースレッドで行い、テクスチャ・オーディオの生成はメインスレッドのProcessPendingLoadsで行う
+		void SetAsyncLoadingEnabled(bool enabled);
+
+		/// @brief 非同期読み込みが有効かどうかを取得
+		/// @return 有効な場合はtrue
+		[[nodiscard]]
+		bool IsAsyncLoadingEnabled();
+
+		/// @brief 非同期読み込みに使用するワーカースレッド数を設定
+		/// @param workerCount ワーカースレッド数(1以上)
+		/// @note 読み込み中のタスクが存在する場合、完了を待ってからスレッドを作り直す
+		void SetAsyncWorkerCount(size_t workerCount);
+
+		/// @brief 非同期読み込みに使用するワーカースレッド数を取得
+		/// @return ワーカースレッド数
+		[[nodiscard]]
+		size_t AsyncWorkerCount();
+
+		/// @brief 1フレームあたりにメインスレッドでテクスチャ・オーディオの生成に使用する時間の上限を設定
+		/// @param budget 時間の上限
+		/// @note 上限を超えた分は次フレーム以降に持ち越す。ただし進行を保証するため、1フレームに最低1件は処理する
+		void SetUploadTimeBudgetPerFrame(const Duration& budget);
+
+		/// @brief 1フレームあたりにメインスレッドでテクスチャ・オーディオの生成に使用する時間の上限を取得
+		/// @return 時間の上限
+		[[nodiscard]]
+		Duration UploadTimeBudgetPerFrame();
+
+		/// @brief 非同期読み込み中に代わりに返すテクスチャを設定
+		/// @param texture 代替テクスチャ。空のテクスチャ(デフォルト)の場合、読み込み完了まではファイルが存在しない場合と同様に扱われる
+		void SetPlaceholderTexture(const Texture& texture);
+
+		/// @brief 非同期読み込み中に代わりに返すテクスチャを取得
+		/// @return 代替テクスチャ
+		[[nodiscard]]
+		const Texture& PlaceholderTexture();
+
+		/// @brief 指定ファイルが非同期読み込み中かどうかを取得
+		/// @param filePath ファイルのパス
+		/// @return テクスチャ・オーディオ・JSONのいずれかとして読み込み中の場合はtrue
+		[[nodiscard]]
+		bool IsLoading(FilePathView filePath);
+
+		/// @brief 非同期読み込み中のアセット数を取得
+		/// @return ワーカースレッドでの読み込み待ち・読み込み中・メインスレッドでの生成待ちのアセットの合計数
+		[[nodiscard]]
+		size_t PendingCount();
+
+		/// @brief 非同期読み込みが完了したアセットを生成して登録し、メモリ使用量の上限を超えたアセットをアンロードする
+		/// @note Canvas::updateから自動的に呼ばれる。同一フレーム内で複数回呼ばれた場合、2回目以降は何もしない
+		void ProcessPendingLoads();
+
+		/// @brief テクスチャのメモリ使用量の上限を設定
+		/// @param budgetBytes 上限のバイト数。noneの場合は上限なし(デフォルト)
+		/// @note 上限を超えた場合、どのコンポーネントからも参照されていないテクスチャを最後に使用されたフレームが古い順にアンロードする
+		/// @note 上限の判定はProcessPendingLoads(Canvas::updateから1フレームに1回呼ばれる)とEnforceMemoryBudgetsの呼び出し時に行う
+		void SetTextureMemoryBudget(const Optional<size_t>& budgetBytes);
+
+		/// @brief テクスチャのメモリ使用量の上限を取得
+		[[nodiscard]]
+		const Optional<size_t>& TextureMemoryBudget();
+
+		/// @brief オーディオのメモリ使用量の上限を設定
+		/// @param budgetBytes 上限のバイト数。noneの場合は上限なし(デフォルト)
+		/// @note オーディオは再生時にのみ参照されるため、上限を超えた場合は最後に使用されたフレームが古い順にアンロードする
+		/// @note 再生中のオーディオ(RetainAudioUntilOneShotEndsでワンショット再生の終了まで保持しているものを含む)はアンロードしない
+		void SetAudioMemoryBudget(const Optional<size_t>& budgetBytes);
+
+		/// @brief オーディオのメモリ使用量の上限を取得
+		[[nodiscard]]
+		const Optional<size_t>& AudioMemoryBudget();
+
+		/// @brief JSONのメモリ使用量の上限を設定
+		/// @param budgetBytes 上限のバイト数。noneの場合は上限なし(デフォルト)
+		void SetJSONMemoryBudget(const Optional<size_t>& budgetBytes);
+
+		/// @brief JSONのメモリ使用量の上限を取得
+		[[nodiscard]]
+		const Optional<size_t>& JSONMemoryBudget();
+
+		/// @brief メモリ使用量の上限を超えているアセットを直ちにアンロードする
+		/// @note 現在のフレームで使用されたアセットはアンロードしない
+		void EnforceMemoryBudgets();
+
+		/// @brief 読み込み済みのアセットのメモリ使用量(推定値)を取得
+		/// @return 種類毎のバイト数と件数
+		[[nodiscard]]
+		AssetMemoryUsage MemoryUsage();
+
+		/// @brief 指定したアセットのうち未読み込みのものをワーカースレッドで並列に読み込む
+		/// @param dependencies 読み込むアセットの一覧
+		/// @note 非同期読み込みの設定に関わらず、テクスチャ・オーディオは完了を待たずに返る。進捗はPendingCountで確認でき、完了まで待つ場合はWaitForPendingLoadsを呼ぶ
+		/// @note Canvasファイル(.noco)は参照先を辿る際にすでに読み込まれているため対象外
+		void Preload(const AssetDependencies& dependencies);
+
+		/// @brief 非同期読み込み中のアセットがすべて登録されるまで待機する
+		/// @note ロード画面等で読み込み完了を待つ場合に使用する。時間の上限は適用されない
+		void WaitForPendingLoads();
+
 		/// @brief 絶対パス/相対パスをアセットのフルパスに変換
 		/// @param filePath 入力パス(絶対または相対)
 		/// @return アセットのフルパス(絶対パスならそのまま、相対パスならベースディレクトリと結合)
 		[[nodiscard]]
 		FilePath GetFullPath(FilePathView filePath);
 
+		/// @brief アセットアーカイブ(.nocopack)をマウントする
+		/// @param archivePath アーカイブファイルのパス
+		/// @return 成功した場合はtrue
+		/// @note マウント中はベースディレクトリからの相対パスで指定されたアセットのうちアーカイブに含まれるものを、ファイルシステムにアクセスせずアーカイブから読み込む
+		/// @note アーカイブはベースディレクトリをAssetArchive::Build(またはNocoPackツール)でまとめたものを想定している
+		/// @note 読み込み済みのアセットはすべてアンロードされる
+		bool MountArchive(FilePathView archivePath);
+
+		/// @brief マウント中のアセットアーカイブをアンマウントする
+		/// @note 読み込み済みのアセットはすべてアンロードされる
+		void UnmountArchive();
+
+		/// @brief アセットアーカイブがマウントされているかどうかを取得
+		[[nodiscard]]
+		bool IsArchiveMounted();
+
+		/// @brief アセットが存在するかどうかを取得
+		/// @param filePath アセットのパス
+		/// @return マウント中のアーカイブに含まれるか、ファイルが存在する場合はtrue
+		[[nodiscard]]
+		bool Exists(FilePathView filePath);
+
+		/// @brief アセットがマウント中のアーカイブに含まれるかどうかを取得
+		/// @param filePath アセットのパス
+		[[nodiscard]]
+		bool IsInArchive(FilePathView filePath);
+
 		/// @brief テクスチャを取得(未読み込みの場合はロードする)
 		/// @param filePath テクスチャファイルのパス
+		/// @param allowPlaceholder 非同期読み込み中に代替テクスチャを返すかどうか
 		/// @return テクスチャ
+		/// @note テクスチャの一部の領域を切り出して使用する場合(アトラス・グリッド・9スライス等)やテクスチャのサイズを参照する場合は、代替テクスチャでは正しく描画できないためAllowPlaceholderYN::Noを指定する
 		[[nodiscard]]
-		const Texture& GetOrLoadTexture(FilePathView filePath);
+		const Texture& GetOrLoadTexture(FilePathView filePath, AllowPlaceholderYN allowPlaceholder = AllowPlaceholderYN::Yes);
+
+		/// @brief テクスチャを参照として取得(未読み込みの場合はロードする)
+		/// @param filePath テクスチャファイルのパス
+		/// @param allowPlaceholder 非同期読み込み中に代替テクスチャを返すかどうか
+		/// @return テクスチャの参照。ファイルが存在しない場合はnullptr。非同期読み込み中は代替テクスチャ(未設定の場合やAllowPlaceholderYN::Noの場合はnullptr)
+		/// @note 戻り値を保持している間、テクスチャはメモリ使用量の上限による退避の対象外となる
+		[[nodiscard]]
+		std::shared_ptr<const Texture> AcquireTexture(FilePathView filePath, AllowPlaceholderYN allowPlaceholder = AllowPlaceholderYN::Yes);
 
 		/// @brief テクスチャを再読み込み
 		/// @param filePath テクスチャファイルのパス
@@ -122,6 +559,7 @@ namespace noco
 		void UnloadTexturesIf(Pred&& predicate)
 		{
 			detail::TextureAssetTable().eraseIf(std::forward<Pred>(predicate));
+			detail::IncrementAssetGeneration();
 		}
 
 		/// @brief オーディオを取得(未読み込みの場合はロードする)
@@ -130,6 +568,18 @@ namespace noco
 		[[nodiscard]]
 		const Audio& GetOrLoadAudio(FilePathView filePath);
 
+		/// @brief オーディオを参照として取得(未読み込みの場合はロードする)
+		/// @param filePath オーディオファイルのパス
+		/// @return オーディオの参照。ファイルが存在しない場合や非同期読み込み中はnullptr
+		/// @note 戻り値を保持している間、オーディオはメモリ使用量の上限による退避の対象外となる
+		[[nodiscard]]
+		std::shared_ptr<const Audio> AcquireAudio(FilePathView filePath);
+
+		/// @brief ワンショット再生したオーディオを再生終了まで保持する
+		/// @param audio AcquireAudioで取得したオーディオの参照
+		/// @note playOneShotによる再生はAudio::isPlayingで検出できないため、再生中にメモリ使用量の上限による退避で再生が途切れないよう呼び出す
+		void RetainAudioUntilOneShotEnds(const std::shared_ptr<const Audio>& audio);
+
 		/// @brief オーディオを再読み込み
 		/// @param filePath オーディオファイルのパス
 		/// @return 再読み込みしたオーディオ
@@ -149,6 +599,7 @@ namespace noco
 		void UnloadAudiosIf(Pred&& predicate)
 		{
 			detail::AudioAssetTable().eraseIf(std::forward<Pred>(predicate));
+			detail::IncrementAssetGeneration();
 		}
 
 		/// @brief JSONを取得(未読み込みの場合はロードする)
@@ -168,6 +619,7 @@ namespace noco
 		bool UnloadJSON(FilePathView filePath);
 
 		/// @brief すべてのJSONをアンロード
+		/// @note キャッシュされたCanvasのプロトタイプも破棄される
 		void UnloadAllJSONs();
 
 		/// @brief 条件を満たすJSONをアンロード
@@ -176,6 +628,15 @@ namespace noco
 		void UnloadJSONsIf(Pred&& predicate)
 		{
 			detail::JSONAssetTable().eraseIf(std::forward<Pred>(predicate));
+			detail::IncrementAssetGeneration();
 		}
+
+		/// @brief Canvasファイルのプロトタイプを取得(未作成の場合はJSONを読み込んで作成する)
+		/// @param filePath Canvasファイル(.nocoまたは.nocob)のパス
+		/// @return プロトタイプ。ファイルが存在しないかCanvasとして不正な場合、または非同期読み込み中の場合はnullptr
+		/// @note プロトタイプはファイルパス毎にキャッシュされ、元となるJSONが再読み込み・アンロードされた場合は次回の呼び出し時に作り直される
+		/// @note SubCanvasは同じCanvasファイルを参照するインスタンス間でこのプロトタイプを共有し、JSONを毎回辿らずにCanvasを生成する
+		[[nodiscard]]
+		std::shared_ptr<const CanvasPrototype> GetOrLoadCanvasPrototype(FilePathView filePath);
 	}
 }
@@ -0,0 +1,86 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+#include <span>
+
+namespace noco
+{
+	/// @brief UIアセットのディレクトリを1つのファイルにまとめたアーカイブ(.nocopack)
+	/// @note ファイル全体をメモリマップして扱い、各エントリの内容はコピーせずに参照する
+	/// @note フォーマット: ヘッダ(マジック"NOCOPACK"・フォーマットバージョン・エントリ数)、インデックス(エントリ毎にデータ位置・サイズ・UTF-8のパス)、各ファイルの内容をそのまま連結したデータ領域
+	class AssetArchive
+	{
+	public:
+		/// @brief アーカイブファイルの拡張子
+		static constexpr StringView FileExtension = U"nocopack";
+
+		/// @brief フォーマットバージョン
+		static constexpr uint32 FormatVersion = 1;
+
+	private:
+		struct Entry
+		{
+			size_t offset = 0;
+			size_t size = 0;
+		};
+
+		MemoryMappedFileView m_file;
+		const Byte* m_data = nullptr;
+		size_t m_dataSize = 0;
+		HashTable<String, Entry> m_entries;
+
+	public:
+		AssetArchive() = default;
+
+		AssetArchive(const AssetArchive&) = delete;
+
+		AssetArchive& operator=(const AssetArchive&) = delete;
+
+		~AssetArchive();
+
+		/// @brief アーカイブファイルを開く
+		/// @param archivePath アーカイブファイルのパス
+		/// @return 成功した場合はtrue、ファイルが存在しないか形式が不正な場合はfalse
+		bool open(FilePathView archivePath);
+
+		/// @brief アーカイブファイルを閉じる
+		/// @note 閉じた後はfindで取得したメモリ領域にアクセスしてはならない
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const
+		{
+			return m_data != nullptr;
+		}
+
+		/// @brief 含まれるファイル数を取得
+		[[nodiscard]]
+		size_t size() const
+		{
+			return m_entries.size();
+		}
+
+		/// @brief 指定したパスのファイルが含まれるかどうかを取得
+		/// @param path アーカイブ内のパス(区切り文字は'/'と'\\'のどちらでもよい)
+		[[nodiscard]]
+		bool contains(StringView path) const;
+
+		/// @brief 指定したパスのファイルの内容を取得
+		/// @param path アーカイブ内のパス(区切り文字は'/'と'\\'のどちらでもよい)
+		/// @return メモリマップされたファイルの内容。含まれない場合はnone
+		[[nodiscard]]
+		Optional<std::span<const Byte>> find(StringView path) const;
+
+		/// @brief アーカイブ内のパスの表記を正規化する
+		/// @param path パス
+		/// @return 区切り文字を'/'に統一し、先頭の"./"を取り除いたパス
+		[[nodiscard]]
+		static String NormalizePath(StringView path);
+
+		/// @brief ディレクトリ内のファイルをまとめてアーカイブファイルを作成する
+		/// @param sourceDirectoryPath まとめるディレクトリのパス。アーカイブ内のパスはこのディレクトリからの相対パスとなる
+		/// @param archivePath 出力するアーカイブファイルのパス
+		/// @return 成功した場合はtrue
+		/// @note 出力先のアーカイブファイル自体がディレクトリ内にある場合は含めない
+		static bool Build(FilePathView sourceDirectoryPath, FilePathView archivePath);
+	};
+}
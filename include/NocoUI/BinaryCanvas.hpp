@@ -0,0 +1,109 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+#include <span>
+
+namespace noco
+{
+	class Canvas;
+	class ComponentFactory;
+
+	/// @brief Canvasのバイナリ形式(.nocob)の読み書き
+	/// @note 読み込み時はJSONを経由せず、データから直接ノードとコンポーネントを生成する。テキストの字句解析・数値変換・キー名による検索が不要で、同じ文字列のUTF-8変換は1回で済む
+	/// @note フォーマット: ヘッダ(マジック"NOCOBIN"・フォーマットバージョン)、文字列テーブル、コンポーネントの型定義(型名と、プロパティID毎のプロパティ名・値の種類・列挙子名)、Canvasの本体(ノードの設定値・コンポーネント・子ノードを順に並べたもの)
+	/// @note コンポーネントのプロパティはプロパティIDで、列挙値は列挙子の序数で書き込む。既定値と等しいプロパティは書き込まない。読み込み時はプロパティ名・列挙子名で現在の定義と対応付けるため、書き込み後にプロパティや列挙子が追加・並べ替えられても読み込める
+	namespace BinaryCanvas
+	{
+		/// @brief バイナリ形式のCanvasファイルの拡張子
+		constexpr StringView FileExtension = U"nocob";
+
+		/// @brief フォーマットバージョン
+		constexpr uint32 FormatVersion = 2;
+
+		/// @brief データがバイナリ形式のCanvasかどうかを取得
+		/// @param data データ
+		/// @return 先頭がバイナリ形式のマジックで始まる場合はtrue
+		[[nodiscard]]
+		bool IsBinary(std::span<const Byte> data);
+
+		/// @brief ファイルがバイナリ形式のCanvasかどうかを取得
+		/// @param path ファイルのパス
+		/// @return 先頭がバイナリ形式のマジックで始まる場合はtrue
+		[[nodiscard]]
+		bool IsBinaryFile(FilePathView path);
+
+		/// @brief Canvasをバイナリ形式に変換
+		/// @param canvas Canvas
+		/// @return バイナリ形式のデータ
+		[[nodiscard]]
+		Blob Encode(const Canvas& canvas);
+
+		/// @brief Canvasをバイナリ形式に変換
+		/// @param canvas Canvas
+		/// @param factory コンポーネントの既定値の取得に使用するファクトリ
+		/// @return バイナリ形式のデータ
+		/// @note ファクトリに登録されていない型のコンポーネントは、JSONと同じ内容を汎用の値の木として書き込む
+		[[nodiscard]]
+		Blob Encode(const Canvas& canvas, const ComponentFactory& factory);
+
+		/// @brief CanvasのJSONをバイナリ形式に変換
+		/// @param json CanvasのJSON(Canvas::toJSONの戻り値や.nocoファイルの内容)
+		/// @return バイナリ形式のデータ。JSONがCanvasとして不正な場合は空のデータ
+		[[nodiscard]]
+		Blob Encode(const JSON& json);
+
+		/// @brief CanvasのJSONをバイナリ形式に変換
+		/// @param json CanvasのJSON(Canvas::toJSONの戻り値や.nocoファイルの内容)
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return バイナリ形式のデータ。JSONがCanvasとして不正な場合は空のデータ
+		[[nodiscard]]
+		Blob Encode(const JSON& json, const ComponentFactory& factory);
+
+		/// @brief バイナリ形式のデータからCanvasを生成
+		/// @param data バイナリ形式のデータ
+		/// @return 生成されたCanvas。形式が不正な場合はnullptr
+		/// @note SetDeferredNodeLoadingEnabledの設定に関わらず、非アクティブなノードの中身も生成する
+		[[nodiscard]]
+		std::shared_ptr<Canvas> Load(std::span<const Byte> data);
+
+		/// @brief バイナリ形式のデータからCanvasを生成
+		/// @param data バイナリ形式のデータ
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 生成されたCanvas。形式が不正な場合はnullptr
+		/// @note SetDeferredNodeLoadingEnabledの設定に関わらず、非アクティブなノードの中身も生成する
+		[[nodiscard]]
+		std::shared_ptr<Canvas> Load(std::span<const Byte> data, const ComponentFactory& factory);
+
+		/// @brief バイナリ形式のデータからJSONを復元
+		/// @param data バイナリ形式のデータ
+		/// @return 復元したJSON。形式が不正な場合は無効なJSON
+		/// @note ノード・コンポーネントを生成せず、コンポーネントの型定義から直接JSONを組み立てるため、ファクトリに登録されていない型のコンポーネントもそのまま復元され、ワーカースレッドからも呼び出せる
+		/// @note 既定値と等しいため書き込まれていないコンポーネントのプロパティはJSONにも含まれない(Canvas::CreateFromJSONで読み込むと既定値となる)。Canvasとして使用する場合はLoadを使用する
+		[[nodiscard]]
+		JSON Decode(std::span<const Byte> data);
+
+		/// @brief CanvasのJSONをバイナリ形式でファイルに保存
+		/// @param json CanvasのJSON
+		/// @param path 保存先のパス
+		/// @return 成功した場合はtrue
+		bool Save(const JSON& json, FilePathView path);
+
+		/// @brief .nocoファイルをバイナリ形式に変換して保存
+		/// @param sourcePath 変換元の.nocoファイルのパス
+		/// @param binaryPath 保存先のパス
+		/// @return 成功した場合はtrue
+		bool ConvertFile(FilePathView sourcePath, FilePathView binaryPath);
+
+		/// @brief データを形式を自動判別してJSONとして読み込む
+		/// @param data バイナリ形式またはJSONテキストのデータ
+		/// @return 読み込んだJSON。失敗した場合は無効なJSON
+		[[nodiscard]]
+		JSON LoadJSON(std::span<const Byte> data);
+
+		/// @brief ファイルを形式を自動判別してJSONとして読み込む
+		/// @param path バイナリ形式または.noco(JSON)のファイルのパス
+		/// @param allowExceptions 読み込みに失敗した場合に例外を投げるかどうか
+		/// @return 読み込んだJSON。失敗した場合は無効なJSON
+		[[nodiscard]]
+		JSON LoadJSON(FilePathView path, AllowExceptions allowExceptions = AllowExceptions::No);
+	}
+}
@@ -5,6 +5,7 @@
 #include "Component/IFocusable.hpp"
 #include "Param.hpp"
 #include "ParamUtils.hpp"
+#include "Asset.hpp"
 
 namespace noco
 {
@@ -12,6 +13,14 @@ namespace noco
 	class IFocusable;
 	class ComponentFactory;
 	class SubCanvas;
+	class Tween;
+	class KeyframeAnimation;
+
+	namespace detail
+	{
+		class GlyphPrewarmList;
+		class BinaryCanvasDecoder;
+	}
 
 	struct CanvasUpdateContext
 	{
@@ -420,9 +429,24 @@ namespace noco
 		std::weak_ptr<Node> sourceNode;
 	};
 
+	struct CanvasDrawStats
+	{
+		/// @brief オクルージョンカリングの判定対象となったノード数
+		size_t occlusionTestedNodeCount = 0;
+
+		/// @brief オクルージョンカリングにより描画をスキップしたノード数
+		size_t occlusionCulledNodeCount = 0;
+
+		/// @brief 保持描画モードで再描画した範囲(再描画しなかった場合はnone)
+		Optional<Rect> retainedRedrawRect;
+	};
+
 	class Canvas : public INodeContainer, public std::enable_shared_from_this<Canvas>
 	{
 		friend class Node;
+		friend class Tween;
+		friend class KeyframeAnimation;
+		friend class detail::BinaryCanvasDecoder;
 
 	private:
 		class EventRegistry
@@ -450,6 +474,21 @@ namespace noco
 			const Array<Event>& getFiredEventsAll() const;
 		};
 
+		struct OcclusionCullingEntry
+		{
+			std::shared_ptr<const Node> node;
+			Optional<RectF> drawnRect; // 描画範囲の外接矩形(領域外へのはみ出しを求められない場合はnoneで、カリング対象外)
+			Optional<RectF> occluderRect; // 遮蔽物となる場合はその範囲
+		};
+
+		struct RetainedNodeDrawState
+		{
+			uint64 drawVersion = 0;
+			RectF boundingRect;
+			bool redrawEveryFrame = false;
+			uint64 lastSeenDrawCount = 0;
+		};
+
 		SizeF m_referenceSize = DefaultSize;
 		LayoutVariant m_childrenLayout = FlowLayout{};
 		Array<std::shared_ptr<Node>> m_children;
@@ -468,9 +507,33 @@ namespace noco
 		/* NonSerialized */ int32 m_serializedVersion = CurrentSerializedVersion; // これは読み込んだバージョンで、シリアライズ時はこの変数の値ではなくCurrentSerializedVersionが固定で出力される
 		/* NonSerialized */ bool m_isLayoutDirty = false; // レイアウト更新が必要かどうか
 		/* NonSerialized */ InteractableYN m_interactable = InteractableYN::Yes;
+		/* NonSerialized */ bool m_transparentHitTestEnabled = true; // 乗算カラーのアルファが0のノードをヒットテスト対象にするかどうか
 		/* NonSerialized */ Mat3x2 m_parentTransformMat = Mat3x2::Identity(); // 親Transformの変換行列(SubCanvas用)
 		/* NonSerialized */ Mat3x2 m_parentHitTestMat = Mat3x2::Identity(); // 親Transformのヒットテスト用変換行列(SubCanvas用)
 		/* NonSerialized */ mutable Array<std::shared_ptr<Node>> m_tempChildrenBuffer; // 子ノードの一時バッファ(update内で別のCanvasのupdateが呼ばれる場合があるためthread_local staticにはできない。drawで呼ぶためmutableだが、drawはシングルスレッド前提なのでロック不要)
+		/* NonSerialized */ bool m_occlusionCullingEnabled = false;
+		/* NonSerialized */ mutable CanvasDrawStats m_drawStats;
+		/* NonSerialized */ mutable detail::ChildrenDrawOrderCache m_childrenDrawOrderCache; // 子ノードの描画順のキャッシュ
+		/* NonSerialized */ mutable Array<OcclusionCullingEntry> m_tempOcclusionCullingEntries; // オクルージョンカリング用の一時バッファ(描画順)
+		/* NonSerialized */ mutable Array<RectF> m_tempOccluderRects; // オクルージョンカリング用の遮蔽物の一時バッファ
+		/* NonSerialized */ bool m_retainedRenderingEnabled = false;
+		/* NonSerialized */ double m_retainedDamageMargin = 16.0; // 保持描画モードで変化したノードの領域を広げる量(影など領域外への描画を考慮するため)
+		/* NonSerialized */ mutable RenderTexture m_retainedRenderTexture;
+		/* NonSerialized */ mutable Size m_retainedRenderTextureSize = Size::Zero();
+		/* NonSerialized */ mutable ColorF m_retainedColorMul{ 1.0 };
+		/* NonSerialized */ mutable bool m_retainedFullRedrawRequested = true;
+		/* NonSerialized */ mutable uint64 m_retainedDrawCount = 0;
+		/* NonSerialized */ mutable HashTable<uint64, RetainedNodeDrawState> m_retainedNodeDrawStates; // キーはノードのインスタンスID
+		/* NonSerialized */ mutable Optional<RectF> m_retainedDamagedRect; // 保持描画モードで再描画が必要な範囲(変化したノードの前回・今回の領域の和)
+		/* NonSerialized */ Array<std::pair<Font, String>> m_pendingPrewarmGlyphs; // 複数フレームに分けて事前ラスタライズする文字のチャンク
+		/* NonSerialized */ size_t m_pendingPrewarmGlyphsIndex = 0;
+		/* NonSerialized */ Duration m_prewarmGlyphsTimeBudgetPerFrame = Duration::zero();
+		/* NonSerialized */ double m_animationTime = 0.0; // アニメーション用時計の現在時刻(秒)
+		/* NonSerialized */ double m_animationDeltaTime = 0.0; // 直前のupdateで進んだアニメーション用時計の時間(秒)
+		/* NonSerialized */ double m_animationTimeScale = 1.0;
+		/* NonSerialized */ bool m_animationPaused = false;
+		/* NonSerialized */ Array<std::pair<std::variant<std::shared_ptr<Tween>, std::shared_ptr<KeyframeAnimation>>, std::shared_ptr<Node>>> m_scheduledTweens; // 今フレームで評価するTween・KeyframeAnimation(登録順に評価)
+		/* NonSerialized */ detail::SmoothingBatch m_smoothingBatch; // スムージング中のプロパティのSmoothDampを一括評価するためのバッファ
 
 		[[nodiscard]]
 		Mat3x2 rootPosScaleMat() const;
@@ -485,10 +548,43 @@ namespace noco
 
 		void updateAutoFitIfNeeded(const SizeF& sceneSize, bool force = false);
 
+		void collectOcclusionCullingEntriesRecursive(const std::shared_ptr<Node>& nodePtr, double parentAlpha, const Optional<RectF>& parentClipRect) const;
+
+		void applyOcclusionCulling() const;
+
+		void clearOcclusionCulling() const;
+
+		void drawImmediate() const;
+
+		void drawRetained() const;
+
+		void collectDamagedRectsRecursive(const std::shared_ptr<Node>& nodePtr, size_t drawOrderIndex, const ColorF& parentColor, const Optional<RectF>& parentClipRect) const;
+
+		void addDamagedRect(const RectF& rect) const;
+
+		void collectPrewarmGlyphs(detail::GlyphPrewarmList& list, IncludeSubCanvasYN includeSubCanvas) const;
+
+		void processPendingPrewarmGlyphs();
+
+		void collectAssetDependenciesRecursive(AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, int32 nestLevel) const;
+
+		void collectNodeAssetDependenciesRecursive(const Node& node, AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, int32 nestLevel) const;
+
+		void scheduleTween(const std::shared_ptr<Tween>& tween, const std::shared_ptr<Node>& node);
+
+		void scheduleTween(const std::shared_ptr<KeyframeAnimation>& keyframeAnimation, const std::shared_ptr<Node>& node);
+
+		void evaluateScheduledTweens();
+
 		// ノードツリー内でinstanceIdによるノード検索（再帰）
 		[[nodiscard]]
 		std::shared_ptr<Node> findNodeByInstanceIdRecursive(const std::shared_ptr<Node>& node, uint64 instanceId) const;
 
+		/// @brief JSONからCanvasを作成
+		/// @param sharedJSON jsonを所有する共有されたJSON(nullptrの場合は共有しない)。生成を遅延するノードはこのJSONを複製せずに参照する
+		[[nodiscard]]
+		static std::shared_ptr<Canvas> CreateFromJSONImpl(const JSON& json, const ComponentFactory& factory, detail::WithInstanceIdYN withInstanceId, const std::shared_ptr<const JSON>& sharedJSON);
+
 		Canvas();
 
 	public:
@@ -527,9 +623,20 @@ namespace noco
 
 		/// @brief CanvasをJSON形式でシリアライズ
 		/// @param withInstanceId 出力内容にインスタンスIDを含めるかどうか(NocoEditorの内部実装向けのため、通常は指定不要)
+		/// @param omitDefaultValues ノードの設定値・コンポーネントのプロパティのうち、既定値と等しいものを省略するかどうか
+		/// @return JSON
+		[[nodiscard]]
+		JSON toJSON(detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No, OmitDefaultValuesYN omitDefaultValues = OmitDefaultValuesYN::No) const;
+
+		/// @brief CanvasをJSON形式でシリアライズ
+		/// @param omitDefaultValues ノードの設定値・コンポーネントのプロパティのうち、既定値と等しいものを省略するかどうか
 		/// @return JSON
+		/// @note 省略した値は読み込み時に既定値として扱われるため、ファイルサイズや読み込み時間を削減できる
 		[[nodiscard]]
-		JSON toJSON(detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No) const;
+		JSON toJSON(OmitDefaultValuesYN omitDefaultValues) const
+		{
+			return toJSON(detail::WithInstanceIdYN::No, omitDefaultValues);
+		}
 
 		/// @brief JSONからCanvasを作成
 		/// @param json JSON
@@ -547,7 +654,7 @@ namespace noco
 		static std::shared_ptr<Canvas> CreateFromJSON(const JSON& json, const ComponentFactory& factory, detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No);
 
 		/// @brief ファイルからCanvasを読み込む
-		/// @param path ファイルパス
+		/// @param path ファイルパス(.nocoまたはバイナリ形式の.nocob。形式はファイルの内容から自動判別する)
 		/// @param allowExceptions 例外を発生させるか
 		/// @return 読み込まれたCanvas。AllowExceptions::Noで読み込みに失敗した場合はnullptrを返す
 		/// @throws AllowExceptions::Yesで読み込みに失敗した場合は例外を送出する
@@ -555,7 +662,7 @@ namespace noco
 		static std::shared_ptr<Canvas> LoadFromFile(FilePathView path, AllowExceptions allowExceptions = AllowExceptions::No);
 
 		/// @brief ファイルからCanvasを読み込む
-		/// @param path ファイルパス
+		/// @param path ファイルパス(.nocoまたはバイナリ形式の.nocob。形式はファイルの内容から自動判別する)
 		/// @param factory コンポーネントを生成するためのファクトリ
 		/// @param allowExceptions 例外を発生させるか
 		/// @return 読み込まれたCanvas。AllowExceptions::Noで読み込みに失敗した場合はnullptrを返す
@@ -576,6 +683,19 @@ namespace noco
 		/// @return 読み込みに成功した場合はtrue、失敗した場合はfalseを返す
 		bool tryReadFromJSON(const JSON& json, const ComponentFactory& factory, detail::WithInstanceIdYN withInstanceId);
 
+		/// @brief Canvasを複製する
+		/// @return 複製されたCanvas
+		/// @note シリアライズ対象の内容(参照サイズ・子レイアウト・パラメータ・子ノード等)をJSONを経由せずに直接コピーする
+		[[nodiscard]]
+		std::shared_ptr<Canvas> clone() const;
+
+		/// @brief Canvasを複製する
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 複製されたCanvas
+		/// @note シリアライズ対象の内容(参照サイズ・子レイアウト・パラメータ・子ノード等)をJSONを経由せずに直接コピーする
+		[[nodiscard]]
+		std::shared_ptr<Canvas> clone(const ComponentFactory& factory) const;
+
 		/// @brief 毎フレームの更新処理
 		/// @param hitTestEnabled ヒットテストを有効にするかどうか
 		void update(HitTestEnabledYN hitTestEnabled = HitTestEnabledYN::Yes);
@@ -603,6 +723,74 @@ namespace noco
 		/// @brief 毎フレームの描画処理
 		void draw() const;
 
+		/// @brief オクルージョンカリングが有効かどうかを取得
+		/// @return 有効な場合はtrue、無効な場合はfalse
+		[[nodiscard]]
+		bool occlusionCullingEnabled() const
+		{
+			return m_occlusionCullingEnabled;
+		}
+
+		/// @brief オクルージョンカリングを有効にするかどうかを設定
+		/// @param enabled 有効にするかどうか
+		/// @return Canvas自身(メソッドチェーン用)
+		/// @note 有効にすると、後から描画される不透明なノード(RectRenderer・Sprite等)に完全に隠れるノードのコンポーネント描画をスキップする
+		/// @note 隠れているかの判定には、コンポーネントが報告する領域外へのはみ出し(ComponentBase::drawOverflow)を含む描画範囲を使用する。はみ出す範囲を求められないコンポーネント(領域外へのはみ出しを許可したLabel・DrawerComponent等)を持つノードはカリングされない
+		std::shared_ptr<Canvas> setOcclusionCullingEnabled(bool enabled)
+		{
+			m_occlusionCullingEnabled = enabled;
+			return shared_from_this();
+		}
+
+		/// @brief 保持描画モードが有効かどうかを取得
+		/// @return 有効な場合はtrue、無効な場合はfalse
+		[[nodiscard]]
+		bool retainedRenderingEnabled() const
+		{
+			return m_retainedRenderingEnabled;
+		}
+
+		/// @brief 保持描画モードを有効にするかどうかを設定
+		/// @param enabled 有効にするかどうか
+		/// @return Canvas自身(メソッドチェーン用)
+		/// @note 有効にすると、描画結果をレンダーテクスチャに保持し、前回の描画から変化したノードの領域のみを再描画する
+		/// @note 変化の検出はノードの領域・乗算カラー・兄弟間の描画順・コンポーネントのプロパティ値の内容バージョン・コンポーネントが解決したアセットをもとに行う。プロパティ外の状態で描画内容が変化するコンポーネントはrequiresRedrawEveryFrameをオーバーライドする必要がある
+		/// @note 変化したノードの前回・今回の領域をすべて含む矩形の範囲を、1回の描画で再描画する
+		/// @note 描画先と同じサイズのレンダーテクスチャを使用するため、Transformer2D等を適用せずにシーンへ直接描画する場合のみ使用可能
+		std::shared_ptr<Canvas> setRetainedRenderingEnabled(bool enabled);
+
+		/// @brief 保持描画モードで変化したノードの領域を広げる量を取得
+		/// @return 広げる量(ピクセル数)
+		[[nodiscard]]
+		double retainedDamageMargin() const
+		{
+			return m_retainedDamageMargin;
+		}
+
+		/// @brief 保持描画モードで変化したノードの領域を広げる量を設定
+		/// @param margin 広げる量(ピクセル数)
+		/// @return Canvas自身(メソッドチェーン用)
+		/// @note 影やはみ出したテキスト等、ノードの領域外に描画するコンポーネントがある場合はその分を指定する
+		std::shared_ptr<Canvas> setRetainedDamageMargin(double margin)
+		{
+			m_retainedDamageMargin = Max(margin, 0.0);
+			return shared_from_this();
+		}
+
+		/// @brief 保持描画モードで次回のdraw時に全体を再描画するよう要求
+		void requestFullRedraw()
+		{
+			m_retainedFullRedrawRequested = true;
+		}
+
+		/// @brief 直前のdrawの統計情報を取得
+		/// @return 描画の統計情報
+		[[nodiscard]]
+		const CanvasDrawStats& drawStats() const
+		{
+			return m_drawStats;
+		}
+
 		/// @brief Canvasをクリア
 		/// @note Canvasのすべての設定が初期化され、ノード、パラメータが削除される
 		void clearAll();
@@ -955,6 +1143,24 @@ namespace noco
 			return setInteractable(InteractableYN{ interactable });
 		}
 
+		/// @brief 乗算カラーのアルファが0のノードをヒットテスト対象にするかどうかを取得
+		/// @return ヒットテスト対象にする場合はtrue、そうでない場合はfalse
+		[[nodiscard]]
+		bool transparentHitTestEnabled() const
+		{
+			return m_transparentHitTestEnabled;
+		}
+
+		/// @brief 乗算カラーのアルファが0のノードをヒットテスト対象にするかどうかを設定
+		/// @param enabled ヒットテスト対象にするかどうか
+		/// @return Canvas自身(メソッドチェーンのため)
+		/// @note falseを指定すると、フェードアウト中などでTransformのcolorのアルファが0のノードは子孫を含めてヒットテストの対象外となる
+		std::shared_ptr<Canvas> setTransparentHitTestEnabled(bool enabled)
+		{
+			m_transparentHitTestEnabled = enabled;
+			return shared_from_this();
+		}
+
 		/// @brief FlowLayoutを取得
 		/// @return FlowLayoutのポインタを返す。Canvasに設定された子レイアウトがFlowLayoutでない場合はnullptrを返す
 		[[nodiscard]]
@@ -1133,6 +1339,61 @@ namespace noco
 		/// @param includeSubCanvas SubCanvas配下のノードも対象とするかどうか
 		void setSubCanvasParamValuesByTag(StringView tag, std::initializer_list<std::pair<String, std::variant<bool, int32, double, const char32_t*, String, Color, ColorF, Vec2, LRTB>>> params, IncludeSubCanvasYN includeSubCanvas = IncludeSubCanvasYN::No);
 
+		/// @brief アニメーション用時計の現在時刻を取得
+		/// @return updateのたびにScene::DeltaTime()×時間スケールずつ進む時刻(秒)。Tweenの再生時間はこの時計で計測される
+		[[nodiscard]]
+		double animationTime() const
+		{
+			return m_animationTime;
+		}
+
+		/// @brief 直前のupdateでアニメーション用時計が進んだ時間を取得
+		[[nodiscard]]
+		double animationDeltaTime() const
+		{
+			return m_animationDeltaTime;
+		}
+
+		/// @brief アニメーション用時計の時間スケールを取得
+		[[nodiscard]]
+		double animationTimeScale() const
+		{
+			return m_animationTimeScale;
+		}
+
+		/// @brief アニメーション用時計の時間スケールを設定
+		/// @param timeScale 時間スケール(1.0で等速、0.5でスローモーション)。負の値は0として扱う
+		/// @return Canvas自身(メソッドチェーン用)
+		std::shared_ptr<Canvas> setAnimationTimeScale(double timeScale)
+		{
+			m_animationTimeScale = Max(timeScale, 0.0);
+			return shared_from_this();
+		}
+
+		/// @brief アニメーション用時計が一時停止中かどうかを取得
+		[[nodiscard]]
+		bool isAnimationPaused() const
+		{
+			return m_animationPaused;
+		}
+
+		/// @brief アニメーション用時計を一時停止または再開
+		/// @param paused 一時停止する場合はtrue
+		/// @return Canvas自身(メソッドチェーン用)
+		std::shared_ptr<Canvas> setAnimationPaused(bool paused)
+		{
+			m_animationPaused = paused;
+			return shared_from_this();
+		}
+
+		/// @brief アニメーション用時計を指定時間だけ進める
+		/// @param deltaTime 進める時間(秒)
+		/// @note 一時停止中でも進められるため、ヘッドレスのテストなどでフレーム時間に依存せずTweenを進める用途に使用できる
+		void stepAnimation(double deltaTime)
+		{
+			m_animationTime += Max(deltaTime, 0.0);
+		}
+
 		/// @brief 指定したタグを持つTweenコンポーネントのアクティブ状態を一括設定
 		/// @param active アクティブ状態
 		/// @param includeSubCanvas SubCanvas配下のノードも対象とするかどうか
@@ -1214,5 +1475,41 @@ namespace noco
 
 		/// @brief フォントキャッシュをクリア
 		void clearFontCache();
+
+		/// @brief Label・TextBox・TextAreaが描画に使用するグリフを事前にラスタライズ
+		/// @param includeSubCanvas SubCanvas配下のノードも対象とするかどうか
+		/// @param timeBudgetPerFrame 1フレームあたりの処理時間の上限。指定した場合はその場では処理せず、以降のupdate呼び出しで複数フレームに分けて処理する
+		/// @note テキストのデフォルト値・InteractionState毎の値・styleState毎の値、参照先パラメータの文字列値、プレースホルダーが対象
+		/// @note 新しい文字を含む画面を初めて表示した際のグリフ生成によるフレーム落ちを避けるため、Canvasの読み込み直後などに呼び出す
+		void prewarmGlyphs(IncludeSubCanvasYN includeSubCanvas = IncludeSubCanvasYN::No, const Optional<Duration>& timeBudgetPerFrame = none);
+
+		/// @brief 複数フレームに分けたグリフの事前ラスタライズが進行中かどうか
+		[[nodiscard]]
+		bool isPrewarmingGlyphs() const
+		{
+			return m_pendingPrewarmGlyphsIndex < m_pendingPrewarmGlyphs.size();
+		}
+
+		/// @brief Canvasが使用する可能性のあるアセットファイルを列挙
+		/// @return Sprite・TextureFontLabelのテクスチャ、UISoundのオーディオ、SubCanvasのCanvasファイルのパス
+		/// @note プロパティのInteractionState毎・styleState毎の値や参照先パラメータの値も対象
+		/// @note SubCanvasが参照するCanvasファイルは読み込んで再帰的に辿る。同じファイルは一度のみ辿るため循環参照があっても終了し、SubCanvas::MaxNestLevelを超える階層は辿らない
+		/// @note 生成が遅延されているノードの中身や未読み込みのCanvasファイルは、ノードを生成せずにJSONから収集する
+		[[nodiscard]]
+		AssetDependencies collectAssetDependencies() const;
+
+		/// @brief Canvasファイルが使用する可能性のあるアセットファイルを列挙
+		/// @param path Canvasファイルのパス
+		/// @return アセットファイルの一覧。読み込みに失敗した場合は空
+		/// @note Canvasやノードを生成せずにJSONを走査するため、対象は組み込みのコンポーネント(Sprite・TextureFontLabel・UISound・SubCanvas)のみ
+		[[nodiscard]]
+		static AssetDependencies CollectAssetDependenciesFromFile(FilePathView path);
+
+		/// @brief Canvasファイルが使用する可能性のあるアセットファイルをワーカースレッドで並列に読み込む
+		/// @param path Canvasファイルのパス
+		/// @return 読み込みを依頼したアセットファイルの一覧
+		/// @note 完了を待たずに返る。進捗はAsset::PendingCountで確認でき、完了まで待つ場合はAsset::WaitForPendingLoadsを呼ぶ
+		/// @note ロード画面などで画面表示前にファイル読み込みを済ませ、表示中のファイル読み込みによるフレーム落ちを避けるために使用する
+		static AssetDependencies PreloadFromFile(FilePathView path);
 	};
 }
@@ -0,0 +1,115 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+#include "Node.hpp"
+#include "Canvas.hpp"
+#include "ComponentFactory.hpp"
+
+namespace noco
+{
+	/// @brief JSONから一度だけ構築し、同じ内容のノードを繰り返し生成するためのプロトタイプ
+	/// @note 構築済みの雛形ノード(コンポーネント生成・プロパティ値の読み込みが済んだもの)を保持し、instantiateではJSONを経由せずに雛形を直接コピーする
+	class NodePrototype
+	{
+	private:
+		std::shared_ptr<Node> m_node; // どのCanvasにも所属しない雛形。外部には公開せず変更しない
+		ComponentFactory m_componentFactory;
+
+		NodePrototype(const std::shared_ptr<Node>& node, const ComponentFactory& componentFactory);
+
+	public:
+		/// @brief JSONからプロトタイプを作成
+		/// @param json ノードのJSON
+		/// @return 生成されたプロトタイプ
+		[[nodiscard]]
+		static std::shared_ptr<NodePrototype> CreateFromJSON(const JSON& json);
+
+		/// @brief JSONからプロトタイプを作成
+		/// @param json ノードのJSON
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 生成されたプロトタイプ
+		[[nodiscard]]
+		static std::shared_ptr<NodePrototype> CreateFromJSON(const JSON& json, const ComponentFactory& factory);
+
+		/// @brief 既存のノードの現在の内容からプロトタイプを作成
+		/// @param node 雛形とするノード。内容は複製されるため、作成後にノードを変更してもプロトタイプには影響しない
+		/// @return 生成されたプロトタイプ
+		[[nodiscard]]
+		static std::shared_ptr<NodePrototype> CreateFromNode(const Node& node);
+
+		/// @brief 既存のノードの現在の内容からプロトタイプを作成
+		/// @param node 雛形とするノード。内容は複製されるため、作成後にノードを変更してもプロトタイプには影響しない
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 生成されたプロトタイプ
+		[[nodiscard]]
+		static std::shared_ptr<NodePrototype> CreateFromNode(const Node& node, const ComponentFactory& factory);
+
+		/// @brief プロトタイプからノードを生成
+		/// @return 生成されたノード。呼び出す度に新しいノードを返す
+		[[nodiscard]]
+		std::shared_ptr<Node> instantiate() const;
+	};
+
+	/// @brief JSONから一度だけ構築し、同じ内容のCanvasを繰り返し生成するためのプロトタイプ
+	/// @note SubCanvasは参照先のCanvasファイル毎にAsset::GetOrLoadCanvasPrototypeでキャッシュされたプロトタイプを使用する
+	class CanvasPrototype
+	{
+	private:
+		std::shared_ptr<Canvas> m_canvas; // 更新・描画されない雛形。外部には公開せず変更しない
+		ComponentFactory m_componentFactory;
+
+		CanvasPrototype(const std::shared_ptr<Canvas>& canvas, const ComponentFactory& componentFactory);
+
+	public:
+		/// @brief JSONからプロトタイプを作成
+		/// @param json CanvasのJSON
+		/// @return 生成されたプロトタイプ。JSONがCanvasとして不正な場合はnullptr
+		[[nodiscard]]
+		static std::shared_ptr<CanvasPrototype> CreateFromJSON(const JSON& json);
+
+		/// @brief JSONからプロトタイプを作成
+		/// @param json CanvasのJSON
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 生成されたプロトタイプ。JSONがCanvasとして不正な場合はnullptr
+		[[nodiscard]]
+		static std::shared_ptr<CanvasPrototype> CreateFromJSON(const JSON& json, const ComponentFactory& factory);
+
+		/// @brief ファイルからプロトタイプを作成
+		/// @param path ファイルパス(.nocoまたはバイナリ形式の.nocob)
+		/// @return 生成されたプロトタイプ。読み込みに失敗した場合はnullptr
+		[[nodiscard]]
+		static std::shared_ptr<CanvasPrototype> LoadFromFile(FilePathView path);
+
+		/// @brief ファイルからプロトタイプを作成
+		/// @param path ファイルパス(.nocoまたはバイナリ形式の.nocob)
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 生成されたプロトタイプ。読み込みに失敗した場合はnullptr
+		[[nodiscard]]
+		static std::shared_ptr<CanvasPrototype> LoadFromFile(FilePathView path, const ComponentFactory& factory);
+
+		/// @brief 既存のCanvasの現在の内容からプロトタイプを作成
+		/// @param canvas 雛形とするCanvas。内容は複製されるため、作成後にCanvasを変更してもプロトタイプには影響しない
+		/// @return 生成されたプロトタイプ
+		[[nodiscard]]
+		static std::shared_ptr<CanvasPrototype> CreateFromCanvas(const Canvas& canvas);
+
+		/// @brief 既存のCanvasの現在の内容からプロトタイプを作成
+		/// @param canvas 雛形とするCanvas。内容は複製されるため、作成後にCanvasを変更してもプロトタイプには影響しない
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 生成されたプロトタイプ
+		[[nodiscard]]
+		static std::shared_ptr<CanvasPrototype> CreateFromCanvas(const Canvas& canvas, const ComponentFactory& factory);
+
+		/// @brief プロトタイプからCanvasを生成
+		/// @return 生成されたCanvas。呼び出す度に新しいCanvasを返す
+		[[nodiscard]]
+		std::shared_ptr<Canvas> instantiate() const;
+
+		/// @brief 雛形のCanvasの参照サイズを取得
+		[[nodiscard]]
+		const SizeF& referenceSize() const;
+
+		/// @brief 雛形のCanvasのAutoFitModeを取得
+		[[nodiscard]]
+		AutoFitMode autoFitMode() const;
+	};
+}
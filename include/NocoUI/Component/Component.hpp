@@ -19,5 +19,6 @@
 #include "CursorChanger.hpp"
 #include "UISound.hpp"
 #include "Tween.hpp"
+#include "KeyframeAnimation.hpp"
 #include "Toggle.hpp"
 #include "SubCanvas.hpp"
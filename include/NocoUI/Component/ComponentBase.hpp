@@ -7,6 +7,7 @@
 namespace noco
 {
 	class Node;
+	class ComponentFactory;
 
 	struct CanvasUpdateContext;
 
@@ -20,12 +21,21 @@ namespace noco
 	private:
 		Array<IProperty*> m_properties;
 
+		/* NonSerialized */ uint64 m_contentVersion = 0;
+
 	protected:
 		void setProperties(const Array<IProperty*>& properties)
 		{
 			m_properties = properties;
 		}
 
+		/// @brief プロパティ以外の描画内容(直接設定されたテクスチャ等)が変化したことを通知
+		/// @note Canvasの保持描画モードで再描画が必要かの判定に使用されるpropertyValuesVersionに反映される
+		void incrementContentVersion()
+		{
+			++m_contentVersion;
+		}
+
 	public:
 		explicit ComponentBase(const Array<IProperty*>& properties)
 			: m_properties{ properties }
@@ -50,6 +60,44 @@ namespace noco
 		{
 		}
 
+		/// @brief ノードの領域全体を不透明で塗りつぶして描画するかどうかを取得
+		/// @return 領域全体を不透明で描画する場合はtrue
+		/// @note オクルージョンカリングで背面のノードを隠す遮蔽物として扱うかの判定に使用される
+		[[nodiscard]]
+		virtual bool isOpaqueFullRect() const
+		{
+			return false;
+		}
+
+		/// @brief ノードの領域の外側にはみ出して描画する幅を取得
+		/// @return 領域の各辺から外側にはみ出す幅(ノードの変換前の座標系)。はみ出す範囲を求められない場合はnone
+		/// @note オクルージョンカリングで手前のノードに完全に隠れているかの判定に使用される。noneを返すコンポーネントを持つノードはカリングされない
+		/// @note 影・外側の輪郭線・領域外へのテキストのはみ出し等、領域の外側に描画するコンポーネントはオーバーライドする
+		[[nodiscard]]
+		virtual Optional<LRTB> drawOverflow() const
+		{
+			return LRTB::Zero();
+		}
+
+		/// @brief プロパティ以外の状態(時間経過等)により毎フレーム描画内容が変化し得るかどうかを取得
+		/// @return 変化し得る場合はtrue
+		/// @note Canvasの保持描画モードで再描画が必要かの判定に使用される。プロパティ値の変化は自動で検出されるため考慮不要
+		[[nodiscard]]
+		virtual bool requiresRedrawEveryFrame() const
+		{
+			return false;
+		}
+
+		/// @brief 描画に使用する解決済みのアセットの識別値を取得
+		/// @param node コンポーネントが所属するノード
+		/// @return 解決済みのアセット(テクスチャ・フォント等)が変わると変化する値
+		/// @note Canvasの保持描画モードで再描画が必要かの判定に使用される。アセットの登録・解放や非同期読み込みの完了により、プロパティ値が変わらずに描画に使用するアセットが変わり得るコンポーネントはオーバーライドする
+		[[nodiscard]]
+		virtual uint64 resolvedAssetsHash(const Node&) const
+		{
+			return 0;
+		}
+
 		virtual void onActivated(const std::shared_ptr<Node>&)
 		{
 		}
@@ -103,6 +151,19 @@ namespace noco
 				property->clearCurrentFrameOverride();
 			}
 		}
+
+		/// @brief プロパティ値の変化検出用の値を取得
+		/// @return いずれかのプロパティの現在の値が変化すると変化する値
+		[[nodiscard]]
+		uint64 propertyValuesVersion() const
+		{
+			uint64 version = m_contentVersion;
+			for (const IProperty* property : m_properties)
+			{
+				version = detail::HashCombine(version, property->currentValueVersion());
+			}
+			return version;
+		}
 	};
 
 	inline ComponentBase::~ComponentBase() = default;
@@ -163,6 +224,35 @@ namespace noco
 			return true;
 		}
 
+		virtual void readFromBinaryOverrideInternal(detail::BinaryCanvasReader& reader, const Array<detail::BinaryPropertyBinding>& propertyBindings)
+		{
+			// プロパティID+1の列(0で終端)と各プロパティの内容が並ぶ。既定値と等しいプロパティは書き込まれていない
+			const auto& componentProperties = properties();
+			while (true)
+			{
+				const uint64 propertyIdPlusOne = reader.readVarUint();
+				if (propertyIdPlusOne == 0 || reader.failed())
+				{
+					break;
+				}
+				if (propertyIdPlusOne > propertyBindings.size())
+				{
+					reader.fail();
+					break;
+				}
+
+				const detail::BinaryPropertyBinding& binding = propertyBindings[static_cast<size_t>(propertyIdPlusOne - 1)];
+				if (!binding.propertyIndex)
+				{
+					reader.skipProperty(binding.kind);
+					continue;
+				}
+				reader.setEnumOrdinalMap(binding.enumOrdinalMap ? &*binding.enumOrdinalMap : nullptr);
+				componentProperties[*binding.propertyIndex]->readBinary(reader);
+				reader.setEnumOrdinalMap(nullptr);
+			}
+		}
+
 	public:
 		explicit SerializableComponentBase(StringView type, const Array<IProperty*>& properties)
 			: ComponentBase{ properties }
@@ -190,17 +280,41 @@ namespace noco
 			m_instanceId = id;
 		}
 
+		/// @brief コンポーネントをJSON形式でシリアライズ
+		/// @param withInstanceId 出力内容にインスタンスIDを含めるかどうか(NocoEditorの内部実装向けのため、通常は指定不要)
+		/// @param omitDefaultValues 組み込みのファクトリで生成した直後の値と等しいプロパティを省略するかどうか
+		/// @return JSON
+		/// @note 組み込みのファクトリに登録されていない型の場合、omitDefaultValuesの指定に関わらずすべてのプロパティを出力する
 		[[nodiscard]]
-		JSON toJSON(detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No) const
-		{
-			return toJSONOverrideInternal(withInstanceId);
-		}
+		JSON toJSON(detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No, OmitDefaultValuesYN omitDefaultValues = OmitDefaultValuesYN::No) const;
 
 		bool tryReadFromJSON(const JSON& json, detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No)
 		{
 			return tryReadFromJSONOverrideInternal(json, withInstanceId);
 		}
 
+		/// @brief バイナリ形式(.nocob)からプロパティを読み込む
+		/// @param reader 読み込み元
+		/// @param propertyBindings 書き込み時のプロパティID毎の読み込み先
+		/// @note BinaryCanvasの読み込み処理から呼ばれる。読み込みに失敗した場合はreaderが失敗状態となる
+		void readFromBinary(detail::BinaryCanvasReader& reader, const Array<detail::BinaryPropertyBinding>& propertyBindings)
+		{
+			readFromBinaryOverrideInternal(reader, propertyBindings);
+		}
+
+		/// @brief コンポーネントを複製する
+		/// @param factory 複製先のコンポーネントを生成するためのファクトリ
+		/// @return 複製されたコンポーネント。生成できない場合はnullptr
+		/// @note 既定の実装はファクトリで同じ型のコンポーネントを生成し、プロパティ毎にシリアライズ対象の内容(プロパティ値・パラメータ参照)をコピーする。ファクトリに登録されていない型の場合はJSONを経由する
+		/// @note プロパティ以外にシリアライズ対象の状態を持つコンポーネントや、読み込み後の処理が必要なコンポーネントはオーバーライドする
+		[[nodiscard]]
+		virtual std::shared_ptr<SerializableComponentBase> cloneComponent(const ComponentFactory& factory) const;
+
+		/// @brief 組み込みのファクトリを使用してコンポーネントを複製する
+		/// @return 複製されたコンポーネント。生成できない場合はnullptr
+		[[nodiscard]]
+		std::shared_ptr<SerializableComponentBase> cloneComponent() const;
+
 		void replaceParamRefs(StringView oldName, StringView newName)
 		{
 			for (IProperty* property : properties())
@@ -219,4 +333,17 @@ namespace noco
 	};
 
 	inline SerializableComponentBase::~SerializableComponentBase() = default;
+
+	namespace detail
+	{
+		/// @brief コンポーネントのJSONから、組み込みのファクトリで生成した直後の値と等しいプロパティを省略する
+		/// @param componentJSON コンポーネントのJSON
+		/// @note 組み込みのファクトリに登録されていない型の場合は何もしない
+		void EraseDefaultComponentValuesFromJSON(JSON& componentJSON);
+
+		/// @brief 2つのコンポーネントのプロパティ構成(プロパティ名の並び)が等しいかどうかを取得
+		/// @note 同じ型名でも不明なコンポーネントのハンドラで生成されたものはプロパティ構成が異なる場合があるため、プロパティ単位でコピー・比較する前に確認する
+		[[nodiscard]]
+		bool HasSamePropertyLayout(const ComponentBase& a, const ComponentBase& b);
+	}
 }
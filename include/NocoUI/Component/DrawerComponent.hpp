@@ -23,5 +23,19 @@ namespace noco
 				m_function(node);
 			}
 		}
+
+		[[nodiscard]]
+		bool requiresRedrawEveryFrame() const override
+		{
+			// 任意の関数で描画するため、描画内容の変化を検出できない
+			return true;
+		}
+
+		[[nodiscard]]
+		Optional<LRTB> drawOverflow() const override
+		{
+			// 任意の関数で描画するため、描画範囲を求められない
+			return none;
+		}
 	};
 }
@@ -0,0 +1,72 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+#include "../Param.hpp"
+#include "../Property.hpp"
+#include "../Asset.hpp"
+
+namespace noco::detail
+{
+	/// @brief 文字列プロパティが取り得る値をすべて列挙する
+	/// @note デフォルト値・InteractionState毎の値・styleState毎の値・現在値、および参照先パラメータの文字列値が対象
+	template <class Fun>
+	void ForEachPossibleStringValue(const Property<String>& property, const HashTable<String, ParamValue>& params, Fun&& fun)
+	{
+		property.propertyValue().forEachValue(fun);
+		fun(property.value());
+		if (const String& paramRef = property.paramRef(); !paramRef.isEmpty())
+		{
+			if (auto it = params.find(paramRef); it != params.end())
+			{
+				if (const auto value = GetParamValueAs<String>(it->second))
+				{
+					fun(*value);
+				}
+			}
+		}
+	}
+
+	/// @brief コンポーネントのJSONに書かれた文字列プロパティが取り得る値をすべて列挙する
+	/// @note コンポーネントを生成せずにアセットファイルを列挙するために使用する。ForEachPossibleStringValueと同様に、デフォルト値・InteractionState毎の値・styleState毎の値、および参照先パラメータの文字列値が対象
+	template <class Fun>
+	void ForEachPossibleStringValueInJSON(const JSON& componentJSON, StringView propertyName, const HashTable<String, ParamValue>& params, Fun&& fun)
+	{
+		if (componentJSON.contains(propertyName))
+		{
+			PropertyValue<String>::FromJSON(componentJSON[propertyName]).forEachValue(fun);
+		}
+		const String paramRefKey = String{ propertyName } + U"_paramRef";
+		if (componentJSON.contains(paramRefKey))
+		{
+			if (auto it = params.find(componentJSON[paramRefKey].getOr<String>(U"")); it != params.end())
+			{
+				if (const auto value = GetParamValueAs<String>(it->second))
+				{
+					fun(*value);
+				}
+			}
+		}
+	}
+
+	/// @brief コンポーネントのJSONに書かれた文字列プロパティのデフォルト値を取得する
+	/// @return デフォルト値。JSONに含まれない場合は空文字列
+	[[nodiscard]]
+	inline String GetDefaultStringValueFromJSON(const JSON& componentJSON, StringView propertyName)
+	{
+		if (!componentJSON.contains(propertyName))
+		{
+			return String{};
+		}
+		return PropertyValue<String>::FromJSON(componentJSON[propertyName]).defaultValue();
+	}
+
+	class IAssetDependentComponent
+	{
+	public:
+		virtual ~IAssetDependentComponent() = default;
+
+		/// @brief 使用する可能性のあるアセットファイルのパスを収集する
+		/// @param params Canvasのパラメータ
+		/// @param dependencies 収集先
+		virtual void collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const = 0;
+	};
+}
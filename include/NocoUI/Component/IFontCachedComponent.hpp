@@ -1,12 +1,139 @@
 ﻿#pragma once
+#include <Siv3D.hpp>
+#include "../Param.hpp"
+#include "../Property.hpp"
+#include "../DefaultFont.hpp"
 
 namespace noco::detail
 {
+	/// @brief 事前ラスタライズ対象のグリフをフォント毎にまとめたもの
+	class GlyphPrewarmList
+	{
+	public:
+		struct Entry
+		{
+			Font font;
+			HashSet<char32> codePoints;
+		};
+
+	private:
+		Array<Entry> m_entries;
+		HashTable<uint64, size_t> m_entryIndexByFontId;
+
+	public:
+		/// @brief 指定フォントで描画されるテキストを追加する
+		void add(const Font& font, StringView text)
+		{
+			if (text.empty())
+			{
+				return;
+			}
+
+			const uint64 fontId = static_cast<uint64>(font.id().value());
+			auto [it, inserted] = m_entryIndexByFontId.try_emplace(fontId, m_entries.size());
+			if (inserted)
+			{
+				m_entries.push_back(Entry{ .font = font, .codePoints = {} });
+			}
+
+			auto& codePoints = m_entries[it->second].codePoints;
+			for (const char32 ch : text)
+			{
+				// 改行・タブはグリフを持たないため除外
+				if (ch != U'\n' && ch != U'\r' && ch != U'\t')
+				{
+					codePoints.insert(ch);
+				}
+			}
+		}
+
+		/// @brief 文字列プロパティが取り得る値をすべて追加する
+		/// @note デフォルト値・InteractionState毎の値・styleState毎の値・現在値、および参照先パラメータの文字列値が対象
+		void addProperty(const Font& font, const Property<String>& property, const HashTable<String, ParamValue>& params)
+		{
+			property.propertyValue().forEachValue([&](const String& value) { add(font, value); });
+			add(font, property.value());
+			addParamValue(font, property.paramRef(), params);
+		}
+
+		/// @brief 文字列プロパティが取り得る値をすべて追加する
+		/// @note 現在値、および参照先パラメータの文字列値が対象
+		void addProperty(const Font& font, const PropertyNonInteractive<String>& property, const HashTable<String, ParamValue>& params)
+		{
+			add(font, property.propertyValue());
+			add(font, property.value());
+			addParamValue(font, property.paramRef(), params);
+		}
+
+		/// @brief フォントアセット名プロパティが取り得る値それぞれについて、実際に使用されるフォントを解決する
+		[[nodiscard]]
+		static Array<Font> ResolveFonts(const Property<String>& fontAssetNameProperty, const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params)
+		{
+			Array<Font> fonts;
+			HashSet<uint64> fontIds;
+			const auto addFont = [&](const String& fontAssetName)
+			{
+				const Font font = ResolveFont(fontAssetName, canvasDefaultFontAssetName);
+				if (fontIds.insert(static_cast<uint64>(font.id().value())).second)
+				{
+					fonts.push_back(font);
+				}
+			};
+			fontAssetNameProperty.propertyValue().forEachValue(addFont);
+			addFont(fontAssetNameProperty.value());
+			if (const String& paramRef = fontAssetNameProperty.paramRef(); !paramRef.isEmpty())
+			{
+				if (auto it = params.find(paramRef); it != params.end())
+				{
+					if (const auto value = GetParamValueAs<String>(it->second))
+					{
+						addFont(*value);
+					}
+				}
+			}
+			return fonts;
+		}
+
+		[[nodiscard]]
+		const Array<Entry>& entries() const
+		{
+			return m_entries;
+		}
+
+		[[nodiscard]]
+		bool empty() const
+		{
+			return m_entries.empty();
+		}
+
+	private:
+		void addParamValue(const Font& font, const String& paramRef, const HashTable<String, ParamValue>& params)
+		{
+			if (paramRef.isEmpty())
+			{
+				return;
+			}
+			if (auto it = params.find(paramRef); it != params.end())
+			{
+				if (const auto value = GetParamValueAs<String>(it->second))
+				{
+					add(font, *value);
+				}
+			}
+		}
+	};
+
 	class IFontCachedComponent
 	{
 	public:
 		virtual ~IFontCachedComponent() = default;
 
 		virtual void clearFontCache() = 0;
+
+		/// @brief 描画に使用するフォントとテキストを事前ラスタライズ用に収集する
+		/// @param canvasDefaultFontAssetName Canvasのデフォルトフォントアセット名
+		/// @param params Canvasのパラメータ
+		/// @param list 収集先
+		virtual void collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, GlyphPrewarmList& list) const = 0;
 	};
 }
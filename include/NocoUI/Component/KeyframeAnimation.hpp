@@ -0,0 +1,215 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+#include "ComponentBase.hpp"
+#include "Tween.hpp"
+
+namespace noco
+{
+	/// @brief KeyframeAnimationのキーフレーム
+	template <class T>
+	struct Keyframe
+	{
+		/// @brief アニメーション開始からの時刻(秒)
+		double time = 0.0;
+
+		/// @brief 値
+		T value{};
+
+		/// @brief 次のキーフレームまでの補間に使用するイージング
+		TweenEasing easing = TweenEasing::Linear;
+	};
+
+	/// @brief 複数のキーフレームを持つアニメーションを再生するコンポーネント
+	/// @note チャンネル(translate・scale・rotation・color・名前指定のプロパティ)毎に任意個のキーフレームを持つ
+	/// @note キーフレームはkeyframesJSONプロパティにJSON文字列として保持され、変更時に連続した配列へ展開される
+	class KeyframeAnimation : public SerializableComponentBase, public std::enable_shared_from_this<KeyframeAnimation>
+	{
+		friend class Canvas;
+
+	private:
+		enum class ChannelTarget : uint8
+		{
+			Translate,
+			Scale,
+			Rotation,
+			Color,
+			Property,
+		};
+
+		struct Channel
+		{
+			ChannelTarget target = ChannelTarget::Translate;
+			String propertyPath; // targetがPropertyの場合のみ使用("コンポーネント型名.プロパティ名")
+			size_t keyframeOffset = 0; // m_keyframeTimes・m_keyframeEasings内の開始位置
+			size_t keyframeCount = 0;
+			size_t valueOffset = 0; // m_keyframeValues内の開始位置
+			size_t valueDimension = 1; // キーフレーム1つあたりの値の要素数
+			size_t cursor = 0; // 前回評価した区間の番号
+			std::weak_ptr<ComponentBase> resolvedComponent;
+			IProperty* resolvedProperty = nullptr;
+			Optional<uint64> resolvedComponentsVersion = none; // resolvedPropertyを解決した時点のノードのcomponentsVersion(見つからなかった場合も記録する)
+		};
+
+		Property<bool> m_active;
+		PropertyNonInteractive<String> m_keyframesJSON;
+		PropertyNonInteractive<TweenLoopType> m_loopType;
+		PropertyNonInteractive<bool> m_restartOnActive;
+		Property<bool> m_manualMode;
+		SmoothProperty<double> m_manualTime;
+
+		/* NonSerialized */ mutable Array<Channel> m_channels;
+		/* NonSerialized */ mutable Array<double> m_keyframeTimes; // 全チャンネルのキーフレーム時刻(チャンネル毎に時刻順で連続して格納)
+		/* NonSerialized */ mutable Array<TweenEasing> m_keyframeEasings;
+		/* NonSerialized */ mutable Array<double> m_keyframeValues; // 全チャンネルのキーフレーム値(valueDimension個ずつ連続して格納)
+		/* NonSerialized */ mutable double m_duration = 0.0;
+		/* NonSerialized */ mutable Optional<uint64> m_parsedKeyframesVersion = none;
+		/* NonSerialized */ Optional<double> m_startTime = none; // Canvasのアニメーション用時計での再生開始時刻(noneの場合は次回update時に設定)
+		/* NonSerialized */ double m_elapsedTime = 0.0;
+		/* NonSerialized */ Optional<bool> m_prevActive = none;
+
+		/// @brief keyframesJSONが変更されていればチャンネルを作り直す
+		void refreshChannelsIfNeeded() const;
+
+		/// @brief 指定チャンネルのキーフレーム配列をkeyframesJSONへ書き込む
+		void setChannelJSON(StringView key, const JSON& keyframesJSON);
+
+		/// @brief 指定の名前付きプロパティチャンネルのキーフレーム配列をkeyframesJSONへ書き込む
+		void setPropertyChannelJSON(StringView propertyPath, const JSON& keyframesJSON);
+
+		void restart();
+
+		[[nodiscard]]
+		double currentTime() const;
+
+		void evaluate(const std::shared_ptr<Node>& node);
+
+		/// @brief チャンネルの指定時刻における値を求める
+		/// @param channel チャンネル
+		/// @param time 時刻(秒)
+		/// @param out 値の出力先(valueDimension個の要素を書き込む)
+		void evaluateChannel(Channel& channel, double time, double* out) const;
+
+		[[nodiscard]]
+		IProperty* resolveProperty(Channel& channel, const std::shared_ptr<Node>& node) const;
+
+	public:
+		explicit KeyframeAnimation(const PropertyValue<bool>& active = true)
+			: SerializableComponentBase{ U"KeyframeAnimation", { &m_active, &m_keyframesJSON, &m_loopType, &m_restartOnActive, &m_manualMode, &m_manualTime } }
+			, m_active{ U"active", active }
+			, m_keyframesJSON{ U"keyframesJSON", U"{}" }
+			, m_loopType{ U"loopType", TweenLoopType::None }
+			, m_restartOnActive{ U"restartOnActive", true }
+			, m_manualMode{ U"manualMode", false }
+			, m_manualTime{ U"manualTime", 0.0 }
+		{
+		}
+
+		void onActivated(const std::shared_ptr<Node>& node) override;
+		void update(const std::shared_ptr<Node>& node) override;
+
+		[[nodiscard]]
+		const PropertyValue<bool>& active() const
+		{
+			return m_active.propertyValue();
+		}
+
+		std::shared_ptr<KeyframeAnimation> setActive(const PropertyValue<bool>& active);
+
+		/// @brief 再生中かどうかを返す
+		/// @return アクティブかつ、ループ再生中または最後のキーフレームに到達していない場合はtrue
+		[[nodiscard]]
+		bool isPlaying() const;
+
+		/// @brief アニメーションの長さ(全チャンネルの最後のキーフレームの時刻の最大値)を返す
+		[[nodiscard]]
+		double duration() const;
+
+		[[nodiscard]]
+		const String& keyframesJSON() const
+		{
+			return m_keyframesJSON.value();
+		}
+
+		/// @brief キーフレームをJSON文字列で設定する
+		/// @param keyframesJSON 形式: {"translate": [{"time": 0.0, "value": [0, 0], "easing": "Linear"}, ...], "scale": [...], "rotation": [...], "color": [...], "properties": {"Label.fontSize": [...]}}
+		std::shared_ptr<KeyframeAnimation> setKeyframesJSON(const String& keyframesJSON)
+		{
+			m_keyframesJSON.setValue(keyframesJSON);
+			return shared_from_this();
+		}
+
+		std::shared_ptr<KeyframeAnimation> setTranslateKeyframes(const Array<Keyframe<Vec2>>& keyframes);
+
+		std::shared_ptr<KeyframeAnimation> setScaleKeyframes(const Array<Keyframe<Vec2>>& keyframes);
+
+		std::shared_ptr<KeyframeAnimation> setRotationKeyframes(const Array<Keyframe<double>>& keyframes);
+
+		std::shared_ptr<KeyframeAnimation> setColorKeyframes(const Array<Keyframe<Color>>& keyframes);
+
+		/// @brief ノード上のコンポーネントのプロパティを対象とするキーフレームを設定する
+		/// @param propertyPath "コンポーネント型名.プロパティ名"の形式(例: "Label.fontSize")。同じ型のコンポーネントが複数ある場合は最初のものが対象
+		/// @param keyframes キーフレーム(double型・int32型のプロパティが対象。int32型へは四捨五入して適用される)
+		std::shared_ptr<KeyframeAnimation> setPropertyKeyframes(StringView propertyPath, const Array<Keyframe<double>>& keyframes);
+
+		/// @brief ノード上のコンポーネントのVec2型プロパティを対象とするキーフレームを設定する
+		std::shared_ptr<KeyframeAnimation> setPropertyKeyframes(StringView propertyPath, const Array<Keyframe<Vec2>>& keyframes);
+
+		/// @brief ノード上のコンポーネントのColor型プロパティを対象とするキーフレームを設定する
+		std::shared_ptr<KeyframeAnimation> setPropertyKeyframes(StringView propertyPath, const Array<Keyframe<Color>>& keyframes);
+
+		/// @brief すべてのキーフレームを削除する
+		std::shared_ptr<KeyframeAnimation> clearKeyframes()
+		{
+			m_keyframesJSON.setValue(U"{}");
+			return shared_from_this();
+		}
+
+		[[nodiscard]]
+		TweenLoopType loopType() const
+		{
+			return m_loopType.value();
+		}
+
+		std::shared_ptr<KeyframeAnimation> setLoopType(TweenLoopType loopType)
+		{
+			m_loopType.setValue(loopType);
+			return shared_from_this();
+		}
+
+		[[nodiscard]]
+		bool restartOnActive() const
+		{
+			return m_restartOnActive.value();
+		}
+
+		std::shared_ptr<KeyframeAnimation> setRestartOnActive(bool restartOnActive)
+		{
+			m_restartOnActive.setValue(restartOnActive);
+			return shared_from_this();
+		}
+
+		[[nodiscard]]
+		const PropertyValue<bool>& manualMode() const
+		{
+			return m_manualMode.propertyValue();
+		}
+
+		std::shared_ptr<KeyframeAnimation> setManualMode(const PropertyValue<bool>& manualMode)
+		{
+			m_manualMode.setPropertyValue(manualMode);
+			return shared_from_this();
+		}
+
+		[[nodiscard]]
+		const PropertyValue<double>& manualTime() const
+		{
+			return m_manualTime.propertyValue();
+		}
+
+		std::shared_ptr<KeyframeAnimation> setManualTime(const PropertyValue<double>& manualTime)
+		{
+			m_manualTime.setPropertyValue(manualTime);
+			return shared_from_this();
+		}
+	};
+}
@@ -29,6 +29,41 @@ namespace noco
 		LeftRight,
 	};
 
+	namespace detail
+	{
+		/// @brief Labelの1行分のレイアウト結果
+		/// @note グリフはLabelLayout::glyphs内の[glyphBegin, glyphEnd)の範囲で表す
+		struct LabelLineLayout
+		{
+			size_t glyphBegin = 0;
+			size_t glyphEnd = 0;
+			double width = 0.0;
+			double offsetY = 0.0;
+			double minTopT = 0.0;
+			double maxBottomT = 1.0;
+		};
+
+		/// @brief Labelのレイアウト結果
+		/// @note 同じフォント・テキスト・レイアウト条件のLabel間で共有されるため、生成後は変更しない
+		struct LabelLayout
+		{
+			Array<Glyph> glyphs;
+			Array<LabelLineLayout> lineCaches;
+			double assetFontSizeScale = 1.0;
+			double lineHeight = 0.0;
+			SizeF regionSize = SizeF::Zero();
+
+			// AutoShrink用
+			double effectiveFontSize = 0.0;
+
+			// AutoShrinkWidth用
+			double effectiveAutoShrinkWidthScale = 1.0;
+
+			[[nodiscard]]
+			static const std::shared_ptr<const LabelLayout>& Empty();
+		};
+	}
+
 	class Label : public SerializableComponentBase, public detail::IFontCachedComponent, public std::enable_shared_from_this<Label>
 	{
 	private:
@@ -41,6 +76,7 @@ namespace noco
 		SmoothProperty<Color> m_gradationColor2;
 		Property<LabelSizingMode> m_sizingMode;
 		SmoothProperty<double> m_minFontSize;
+		Property<double> m_autoShrinkPrecision;
 		Property<HorizontalAlign> m_horizontalAlign;
 		Property<VerticalAlign> m_verticalAlign;
 		SmoothProperty<LRTB> m_padding;
@@ -61,9 +97,12 @@ namespace noco
 		struct CacheParams
 		{
 			String text;
+			uint64 textVersion;
 			String fontAssetName;
+			uint64 fontAssetNameVersion;
 			double fontSize;
 			double minFontSize;
+			double autoShrinkPrecision;
 			HorizontalOverflow horizontalOverflow;
 			VerticalOverflow verticalOverflow;
 			Vec2 spacing;
@@ -75,9 +114,12 @@ namespace noco
 			[[nodiscard]]
 			bool isDirty(
 				const String& newText,
+				uint64 newTextVersion,
 				const String& newFontAssetName,
+				uint64 newFontAssetNameVersion,
 				double newFontSize,
 				double newMinFontSize,
+				double newAutoShrinkPrecision,
 				HorizontalOverflow newHorizontalOverflow,
 				VerticalOverflow newVerticalOverflow,
 				const Vec2& newSpacing,
@@ -86,10 +128,12 @@ namespace noco
 				const Font& newCustomFont,
 				LabelSizingMode newSizingMode) const
 			{
-				return text != newText
-					|| fontAssetName != newFontAssetName
+				// 内容バージョンが一致する場合は文字列の比較を省略する
+				return (newTextVersion != textVersion && text != newText)
+					|| (newFontAssetNameVersion != fontAssetNameVersion && fontAssetName != newFontAssetName)
 					|| fontSize != newFontSize
 					|| minFontSize != newMinFontSize
+					|| autoShrinkPrecision != newAutoShrinkPrecision
 					|| horizontalOverflow != newHorizontalOverflow
 					|| verticalOverflow != newVerticalOverflow
 					|| spacing != newSpacing
@@ -102,33 +146,16 @@ namespace noco
 
 		struct Cache
 		{
-			struct LineCache
-			{
-				Array<Glyph> glyphs;
-				double width = 0.0;
-				double offsetY = 0.0;
-				double minTopT = 0.0;
-				double maxBottomT = 1.0;
-			};
-
-			Array<LineCache> lineCaches;
-			double assetFontSizeScale = 1.0;
-			double lineHeight = 0.0;
-			SizeF regionSize = SizeF::Zero();
+			// レイアウト結果は同条件のLabel間でLabelLayoutCacheを通じて共有される
+			std::shared_ptr<const detail::LabelLayout> layout = detail::LabelLayout::Empty();
 			Optional<CacheParams> prevParams = std::nullopt;
 			FontMethod fontMethod = FontMethod::Bitmap;
 			Font currentFont;
 			int32 assetFontSize = 0;
 
-			// AutoShrink用キャッシュ
-			double effectiveFontSize = 0.0;
-
-			// AutoShrinkWidth用キャッシュ
-			double effectiveAutoShrinkWidthScale = 1.0;
-
 			Cache() = default;
 
-			bool refreshIfDirty(const String& text, const Optional<Font>& fontOpt, const String& fontAssetName, const String& canvasDefaultFontAssetName, double fontSize, double minFontSize, const Vec2& spacing, HorizontalOverflow horizontalOverflow, VerticalOverflow verticalOverflow, const SizeF& rectSize, LabelSizingMode newSizingMode);
+			bool refreshIfDirty(const String& text, uint64 textVersion, const Optional<Font>& fontOpt, const String& fontAssetName, uint64 fontAssetNameVersion, const String& canvasDefaultFontAssetName, double fontSize, double minFontSize, double autoShrinkPrecision, const Vec2& spacing, HorizontalOverflow horizontalOverflow, VerticalOverflow verticalOverflow, const SizeF& rectSize, LabelSizingMode newSizingMode);
 		};
 
 		/* NonSerialized */ mutable Cache m_cache;
@@ -142,6 +169,8 @@ namespace noco
 			m_autoResizeCache.prevParams.reset();
 		}
 
+		void collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, detail::GlyphPrewarmList& list) const override;
+
 	public:
 		explicit Label(
 			const PropertyValue<String>& text = U"",
@@ -158,7 +187,7 @@ namespace noco
 			const PropertyValue<Color>& underlineColor = Palette::White,
 			const PropertyValue<double>& underlineThickness = 1.0,
 			const PropertyValue<LabelSizingMode>& sizingMode = LabelSizingMode::Fixed)
-			: SerializableComponentBase{ U"Label", { &m_text, &m_fontAssetName, &m_fontSize, &m_gradationType, &m_color, &m_gradationColor1, &m_gradationColor2, &m_sizingMode, &m_minFontSize, &m_horizontalAlign, &m_verticalAlign, &m_padding, &m_horizontalOverflow, &m_verticalOverflow, &m_characterSpacing, &m_underlineStyle, &m_underlineColor, &m_underlineThickness, &m_outlineColor, &m_outlineFactorInner, &m_outlineFactorOuter, &m_shadowColor, &m_shadowOffset } }
+			: SerializableComponentBase{ U"Label", { &m_text, &m_fontAssetName, &m_fontSize, &m_gradationType, &m_color, &m_gradationColor1, &m_gradationColor2, &m_sizingMode, &m_minFontSize, &m_autoShrinkPrecision, &m_horizontalAlign, &m_verticalAlign, &m_padding, &m_horizontalOverflow, &m_verticalOverflow, &m_characterSpacing, &m_underlineStyle, &m_underlineColor, &m_underlineThickness, &m_outlineColor, &m_outlineFactorInner, &m_outlineFactorOuter, &m_shadowColor, &m_shadowOffset } }
 			, m_text{ U"text", text }
 			, m_fontAssetName{ U"fontAssetName", fontAssetName }
 			, m_fontSize{ U"fontSize", fontSize }
@@ -168,6 +197,7 @@ namespace noco
 			, m_gradationColor2{ U"gradationColor2", color }
 			, m_sizingMode{ U"sizingMode", sizingMode }
 			, m_minFontSize{ U"minFontSize", 1.0 }
+			, m_autoShrinkPrecision{ U"autoShrinkPrecision", 1.0 }
 			, m_horizontalAlign{ U"horizontalAlign", horizontalAlign }
 			, m_verticalAlign{ U"verticalAlign", verticalAlign }
 			, m_padding{ U"padding", padding }
@@ -189,6 +219,12 @@ namespace noco
 
 		void draw(const Node& node) const override;
 
+		[[nodiscard]]
+		Optional<LRTB> drawOverflow() const override;
+
+		[[nodiscard]]
+		uint64 resolvedAssetsHash(const Node& node) const override;
+
 		[[nodiscard]]
 		const PropertyValue<String>& text() const
 		{
@@ -304,6 +340,18 @@ namespace noco
 			return shared_from_this();
 		}
 
+		[[nodiscard]]
+		const PropertyValue<double>& autoShrinkPrecision() const
+		{
+			return m_autoShrinkPrecision.propertyValue();
+		}
+
+		std::shared_ptr<Label> setAutoShrinkPrecision(const PropertyValue<double>& autoShrinkPrecision)
+		{
+			m_autoShrinkPrecision.setPropertyValue(autoShrinkPrecision);
+			return shared_from_this();
+		}
+
 		[[nodiscard]]
 		const PropertyValue<HorizontalAlign>& horizontalAlign() const
 		{
@@ -492,4 +540,28 @@ namespace noco
 
 		void refreshAutoResizeImmediately(const std::shared_ptr<Node>& node);
 	};
+
+	/// @brief Labelのレイアウト結果を複数のLabelで共有するためのキャッシュ
+	/// @note フォント・テキスト・フォントサイズ・レイアウト条件が同一のLabelは、グリフ取得と行分割の結果を共有する
+	/// @note 容量を超えた場合は最も長く参照されていないエントリから破棄される
+	namespace LabelLayoutCache
+	{
+		/// @brief キャッシュの最大エントリ数を設定する
+		/// @param capacity 最大エントリ数(0の場合はキャッシュによる共有を行わない)
+		void SetCapacity(size_t capacity);
+
+		/// @brief キャッシュの最大エントリ数を取得する
+		/// @return 最大エントリ数
+		[[nodiscard]]
+		size_t Capacity();
+
+		/// @brief 現在キャッシュされているエントリ数を取得する
+		/// @return エントリ数
+		[[nodiscard]]
+		size_t Count();
+
+		/// @brief キャッシュを全て破棄する
+		/// @note 各Labelが保持中のレイアウトは破棄されず、次回の再計算時から反映される
+		void Clear();
+	}
 }
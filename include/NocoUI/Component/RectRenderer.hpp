@@ -59,6 +59,12 @@ namespace noco
 
 		void draw(const Node& node) const override;
 
+		[[nodiscard]]
+		bool isOpaqueFullRect() const override;
+
+		[[nodiscard]]
+		Optional<LRTB> drawOverflow() const override;
+
 		[[nodiscard]]
 		const PropertyValue<RectFillGradationType>& fillGradationType() const
 		{
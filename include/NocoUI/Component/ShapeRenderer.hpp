@@ -161,6 +161,13 @@ namespace noco
 
 		void draw(const Node& node) const override;
 
+		[[nodiscard]]
+		Optional<LRTB> drawOverflow() const override
+		{
+			// 図形の種類によっては線の太さや頂点の指定により領域の外側に描画されるため
+			return none;
+		}
+
 		[[nodiscard]]
 		ShapeType shapeType() const
 		{
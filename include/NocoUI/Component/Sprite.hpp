@@ -3,10 +3,12 @@
 #include "ComponentBase.hpp"
 #include "../LRTB.hpp"
 #include "../Enums.hpp"
+#include "../Asset.hpp"
+#include "IAssetDependentComponent.hpp"
 
 namespace noco
 {
-	class Sprite : public SerializableComponentBase, public std::enable_shared_from_this<Sprite>
+	class Sprite : public SerializableComponentBase, public detail::IAssetDependentComponent, public std::enable_shared_from_this<Sprite>
 	{
 	private:
 		Property<String> m_textureFilePath;
@@ -42,19 +44,24 @@ namespace noco
 		Property<SpriteTextureFilter> m_textureFilter;
 		Property<SpriteTextureAddressMode> m_textureAddressMode;
 		Property<String> m_pixelShaderAssetName;
+		Property<bool> m_textureOpaque;
 
 		/* NonSerialized */ Optional<Texture> m_textureOpt;
+		/* NonSerialized */ mutable detail::ResolvedTextureCache m_resolvedTextureCache;
 		/* NonSerialized */ Stopwatch m_animationStopwatch;
 		/* NonSerialized */ int32 m_currentGridAnimationIndex = 0;
 		/* NonSerialized */ bool m_gridAnimationFinished = false;
 		/* NonSerialized */ Vec2 m_currentOffsetAnimation = Vec2::Zero();
 
+		[[nodiscard]]
+		const Texture& resolveTexture() const;
+
 		void drawNineSlice(const Texture& texture, const RectF& rect, const Color& color) const;
 		void drawNineSliceFromRegion(const Texture& texture, const RectF& sourceRect, const RectF& rect, const Color& color) const;
 
 	public:
 		explicit Sprite(const PropertyValue<String>& textureFilePath = String{}, const PropertyValue<String>& textureAssetName = String{}, const PropertyValue<Color>& color = Palette::White, const PropertyValue<bool>& preserveAspect = false)
-			: SerializableComponentBase{ U"Sprite", { &m_textureFilePath, &m_textureAssetName, &m_color, &m_addColor, &m_blendMode, &m_preserveAspect, &m_nineSliceEnabled, &m_nineSliceMargin, &m_nineSliceScale, &m_nineSliceCenterTiled, &m_nineSliceLeftTiled, &m_nineSliceRightTiled, &m_nineSliceTopTiled, &m_nineSliceBottomTiled, &m_nineSliceFallback, &m_textureRegionMode, &m_textureOffset, &m_textureSize, &m_textureGridCellSize, &m_textureGridColumns, &m_textureGridRows, &m_textureGridIndex, &m_textureGridCellTrim, &m_gridAnimationType, &m_gridAnimationFPS, &m_gridAnimationStartIndex, &m_gridAnimationEndIndex, &m_offsetAnimationType, &m_offsetAnimationSpeed, &m_textureFilter, &m_hideIfTextureEmpty, &m_textureAddressMode, &m_pixelShaderAssetName } }
+			: SerializableComponentBase{ U"Sprite", { &m_textureFilePath, &m_textureAssetName, &m_color, &m_addColor, &m_blendMode, &m_preserveAspect, &m_nineSliceEnabled, &m_nineSliceMargin, &m_nineSliceScale, &m_nineSliceCenterTiled, &m_nineSliceLeftTiled, &m_nineSliceRightTiled, &m_nineSliceTopTiled, &m_nineSliceBottomTiled, &m_nineSliceFallback, &m_textureRegionMode, &m_textureOffset, &m_textureSize, &m_textureGridCellSize, &m_textureGridColumns, &m_textureGridRows, &m_textureGridIndex, &m_textureGridCellTrim, &m_gridAnimationType, &m_gridAnimationFPS, &m_gridAnimationStartIndex, &m_gridAnimationEndIndex, &m_offsetAnimationType, &m_offsetAnimationSpeed, &m_textureFilter, &m_hideIfTextureEmpty, &m_textureAddressMode, &m_pixelShaderAssetName, &m_textureOpaque } }
 			, m_textureFilePath{ U"textureFilePath", textureFilePath }
 			, m_textureAssetName{ U"textureAssetName", textureAssetName }
 			, m_color{ U"color", color }
@@ -88,6 +95,7 @@ namespace noco
 			, m_textureFilter{ U"textureFilter", SpriteTextureFilter::Default }
 			, m_textureAddressMode{ U"textureAddressMode", SpriteTextureAddressMode::Default }
 			, m_pixelShaderAssetName{ U"pixelShaderAssetName", String{} }
+			, m_textureOpaque{ U"textureOpaque", false }
 		{
 		}
 
@@ -95,6 +103,21 @@ namespace noco
 		void update(const std::shared_ptr<Node>& node) override;
 		void draw(const Node& node) const override;
 
+		void collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const override;
+
+		/// @brief コンポーネントのJSONから、使用する可能性のあるアセットファイルのパスを収集する
+		/// @note collectAssetDependenciesと同じ対象を、コンポーネントを生成せずに収集する
+		static void CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies);
+
+		[[nodiscard]]
+		bool isOpaqueFullRect() const override;
+
+		[[nodiscard]]
+		bool requiresRedrawEveryFrame() const override;
+
+		[[nodiscard]]
+		uint64 resolvedAssetsHash(const Node& node) const override;
+
 		[[nodiscard]]
 		const PropertyValue<String>& textureFilePath() const
 		{
@@ -386,12 +409,14 @@ namespace noco
 		std::shared_ptr<Sprite> setTexture(const Texture& texture)
 		{
 			m_textureOpt = texture;
+			incrementContentVersion();
 			return shared_from_this();
 		}
 		
 		std::shared_ptr<Sprite> clearTexture()
 		{
 			m_textureOpt.reset();
+			incrementContentVersion();
 			return shared_from_this();
 		}
 		
@@ -511,5 +536,17 @@ namespace noco
 			m_pixelShaderAssetName.setPropertyValue(pixelShaderAssetName);
 			return shared_from_this();
 		}
+
+		[[nodiscard]]
+		const PropertyValue<bool>& textureOpaque() const
+		{
+			return m_textureOpaque.propertyValue();
+		}
+
+		std::shared_ptr<Sprite> setTextureOpaque(const PropertyValue<bool>& textureOpaque)
+		{
+			m_textureOpaque.setPropertyValue(textureOpaque);
+			return shared_from_this();
+		}
 	};
 }
@@ -4,6 +4,7 @@
 #include "../YN.hpp"
 #include "../Param.hpp"
 #include "../Property.hpp"
+#include "IAssetDependentComponent.hpp"
 
 namespace noco
 {
@@ -26,7 +27,7 @@ namespace noco
 	};
 
 	/// @brief 入れ子でCanvas利用できるようにするためのコンポーネント
-	class SubCanvas : public SerializableComponentBase, public std::enable_shared_from_this<SubCanvas>
+	class SubCanvas : public SerializableComponentBase, public detail::IAssetDependentComponent, public std::enable_shared_from_this<SubCanvas>
 	{
 	private:
 		Property<String> m_canvasPath;
@@ -61,10 +62,19 @@ namespace noco
 			return true;
 		}
 
+		void readFromBinaryOverrideInternal(detail::BinaryCanvasReader& reader, const Array<detail::BinaryPropertyBinding>& propertyBindings) override
+		{
+			SerializableComponentBase::readFromBinaryOverrideInternal(reader, propertyBindings);
+			loadCanvasInternal();
+		}
+
 	protected:
 		void replaceAdditionalParamRefsInternal(StringView oldName, StringView newName) override;
 
 	public:
+		/// @brief SubCanvasの最大ネストレベル
+		static constexpr int32 MaxNestLevel = 10;
+
 		explicit SubCanvas(const PropertyValue<String>& canvasPath = U"")
 			: SerializableComponentBase{ U"SubCanvas", { &m_canvasPath, &m_propagateEvents, &m_autoFitModeOverride, &m_serializedParamsJSON, &m_serializedParamBindingsJSON, &m_serializedParamBindingModesJSON, &m_tag } }
 			, m_canvasPath{ U"canvasPath", canvasPath }
@@ -78,10 +88,38 @@ namespace noco
 			loadCanvasInternal();
 		}
 
+		using SerializableComponentBase::cloneComponent;
+
+		/// @brief コンポーネントを複製する
+		/// @note JSONから読み込んだ場合と同様に、複製後に参照先のCanvasを読み込む
+		[[nodiscard]]
+		std::shared_ptr<SerializableComponentBase> cloneComponent(const ComponentFactory& factory) const override;
+
 		void update(const std::shared_ptr<Node>& node) override;
 
 		void draw(const Node& node) const override;
 
+		/// @note canvasPathが取り得るCanvasファイルのパスのみを追加する。参照先のCanvasが使用するアセットはCanvas::collectAssetDependenciesが辿る
+		void collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const override;
+
+		/// @brief コンポーネントのJSONから、使用する可能性のあるアセットファイルのパスを収集する
+		/// @note collectAssetDependenciesと同じ対象を、コンポーネントを生成せずに収集する
+		static void CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies);
+
+		[[nodiscard]]
+		bool requiresRedrawEveryFrame() const override
+		{
+			// 内部のCanvasの描画内容は親Canvas側からは検出できないため
+			return true;
+		}
+
+		[[nodiscard]]
+		Optional<LRTB> drawOverflow() const override
+		{
+			// 内部のCanvasのノードは領域の外側に配置され得るため
+			return none;
+		}
+
 		std::shared_ptr<Node> hitTest(
 			const std::shared_ptr<Node>& node,
 			const Vec2& point,
@@ -6,86 +6,114 @@
 
 namespace noco
 {
-	class TextArea : public SerializableComponentBase, public ITextBox, public detail::IFontCachedComponent, public std::enable_shared_from_this<TextArea>
+	namespace detail
 	{
-	private:
-		static constexpr double CursorWidth = 1.5;
-
-		PropertyNonInteractive<String> m_text;
-		Property<String> m_fontAssetName;
-		SmoothProperty<double> m_fontSize;
-		SmoothProperty<Color> m_color;
-		SmoothProperty<Vec2> m_horizontalPadding;
-		SmoothProperty<Vec2> m_verticalPadding;
-		SmoothProperty<Color> m_cursorColor;
-		SmoothProperty<Color> m_selectionColor;
-		PropertyNonInteractive<String> m_placeholderText;
-		SmoothProperty<Color> m_placeholderColor;
-		PropertyNonInteractive<bool> m_readOnly;
-		PropertyNonInteractive<String> m_tag;
-
-		/* NonSerialized */ double m_cursorBlinkTime = 0.0;
-		/* NonSerialized */ bool m_isEditing = false;
-		/* NonSerialized */ bool m_isDragging = false;
-		/* NonSerialized */ size_t m_selectionAnchorLine = 0;
-		/* NonSerialized */ size_t m_selectionAnchorColumn = 0;
-		/* NonSerialized */ String m_prevText;
-		/* NonSerialized */ size_t m_cursorLine = 0;
-		/* NonSerialized */ size_t m_cursorColumn = 0;
-		/* NonSerialized */ Stopwatch m_leftPressStopwatch;
-		/* NonSerialized */ Stopwatch m_rightPressStopwatch;
-		/* NonSerialized */ Stopwatch m_upPressStopwatch;
-		/* NonSerialized */ Stopwatch m_downPressStopwatch;
-		/* NonSerialized */ Stopwatch m_pageUpPressStopwatch;
-		/* NonSerialized */ Stopwatch m_pageDownPressStopwatch;
-		/* NonSerialized */ Stopwatch m_backspacePressStopwatch;
-		/* NonSerialized */ Stopwatch m_deletePressStopwatch;
-		/* NonSerialized */ Stopwatch m_enterPressStopwatch;
-		/* NonSerialized */ Stopwatch m_dragScrollStopwatch;
-		/* NonSerialized */ size_t m_scrollOffsetX = 0;
-		/* NonSerialized */ size_t m_scrollOffsetY = 0;
-		/* NonSerialized */ bool m_isChanged = false;
-		/* NonSerialized */ bool m_prevEditingTextExists = false;
-
-		struct CacheParams
+		struct TextAreaCacheParams
 		{
 			String text;
+			uint64 textVersion;
 			String fontAssetName;
 			double fontSize;
 			SizeF rectSize;
 
+			/// @brief テキスト以外のレイアウト条件が変化したかどうかを返す
+			/// @note テキストのみの変化は段落単位の差分更新で処理するため、ここでは比較しない
 			[[nodiscard]]
-			bool isDirty(
-				StringView newText,
+			bool isLayoutDirty(
 				StringView newFontAssetName,
 				double newFontSize,
 				const SizeF& newRectSize) const
 			{
-				return text != newText
-					|| fontAssetName != newFontAssetName
+				return fontAssetName != newFontAssetName
 					|| fontSize != newFontSize
 					|| rectSize != newRectSize;
 			}
 		};
 
-		struct LineCache
+		/// @brief 改行で区切られた1段落分のキャッシュ
+		struct TextAreaParagraphCache
 		{
+			struct WrappedLine
+			{
+				size_t glyphBegin = 0;
+				size_t glyphEnd = 0;
+				double width = 0.0;
+			};
+
+			// 段落内のグリフ(改行文字は含まない)
 			Array<Glyph> glyphs;
+
+			// 段落先頭からi番目のグリフの手前までの累積幅(要素数はグリフ数+1)
+			Array<double> advanceOffsets;
+
+			Array<WrappedLine> wrappedLines;
+			size_t textBeginIndex = 0;
+			size_t textLength = 0;
+			double maxWidth = 0.0;
+
+			[[nodiscard]]
+			size_t textEndIndex() const
+			{
+				return textBeginIndex + textLength;
+			}
+		};
+
+		struct TextAreaLineCache
+		{
+			// グリフはTextAreaCache::paragraphs[paragraphIndex].glyphs内の[glyphBegin, glyphEnd)の範囲で表す
+			size_t paragraphIndex = 0;
+			size_t glyphBegin = 0;
+			size_t glyphEnd = 0;
 			size_t textBeginIndex;
 			size_t textEndIndex;
 			double width = 0.0;
+
+			[[nodiscard]]
+			size_t glyphCount() const
+			{
+				return glyphEnd - glyphBegin;
+			}
 		};
 
-		struct Cache
+		/// @brief TextAreaのテキストを段落・折り返し行に分けたレイアウトのキャッシュ
+		struct TextAreaCache
 		{
-			Array<LineCache> lines;
+			Array<TextAreaParagraphCache> paragraphs;
+			Array<TextAreaLineCache> lines;
 			double scale = 1.0;
 			double lineHeight = 0.0;
 			SizeF regionSize = SizeF::Zero();
-			Optional<CacheParams> prevParams = std::nullopt;
+			Optional<TextAreaCacheParams> prevParams = std::nullopt;
 			FontMethod fontMethod = FontMethod::Bitmap;
+			Font font;
+
+			/// @brief キャッシュを更新する
+			/// @note レイアウト条件が同じでテキストのみ変化した場合は、変化した範囲を含む段落のみグリフ取得と折り返しをやり直す
+			/// @note textVersionにはテキストの内容バージョンを指定する(0の場合はテキストの内容を比較する)
+			void refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize, uint64 textVersion = 0);
+
+			/// @brief paragraphs内の[firstParagraph, lastParagraph)を、text内の[textBegin, textEnd)から生成した段落で置き換える
+			void replaceParagraphs(StringView text, size_t firstParagraph, size_t lastParagraph, size_t textBegin, size_t textEnd);
+
+			/// @brief 段落のキャッシュから行の一覧と領域サイズを再構築する
+			void rebuildLines();
 
-			void refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize);
+			[[nodiscard]]
+			size_t findParagraphIndex(size_t textIndex) const;
+
+			[[nodiscard]]
+			const Glyph& glyphAt(const TextAreaLineCache& line, size_t column) const
+			{
+				return paragraphs[line.paragraphIndex].glyphs[line.glyphBegin + column];
+			}
+
+			/// @brief 行の先頭からcolumn番目の文字の手前までの幅を返す
+			[[nodiscard]]
+			double advanceToColumn(const TextAreaLineCache& line, size_t column) const
+			{
+				const auto& advanceOffsets = paragraphs[line.paragraphIndex].advanceOffsets;
+				return advanceOffsets[line.glyphBegin + column] - advanceOffsets[line.glyphBegin];
+			}
 
 			[[nodiscard]]
 			Vec2 getCursorPos(size_t line, size_t column, size_t scrollOffsetX, size_t scrollOffsetY) const;
@@ -98,10 +126,59 @@ namespace noco
 
 			[[nodiscard]]
 			std::pair<size_t, size_t> getIndexToLineColumn(size_t index) const;
+
+			/// @brief 表示領域内に上端が収まる行の範囲を返す
+			/// @param scrollOffsetY 先頭に表示する行番号
+			/// @param viewHeight 表示領域の高さ
+			/// @return 行番号の範囲[first, last)
+			[[nodiscard]]
+			std::pair<size_t, size_t> getVisibleLineRange(size_t scrollOffsetY, double viewHeight) const;
 		};
+	}
+
+	class TextArea : public SerializableComponentBase, public ITextBox, public detail::IFontCachedComponent, public std::enable_shared_from_this<TextArea>
+	{
+	private:
+		static constexpr double CursorWidth = 1.5;
+
+		PropertyNonInteractive<String> m_text;
+		Property<String> m_fontAssetName;
+		SmoothProperty<double> m_fontSize;
+		SmoothProperty<Color> m_color;
+		SmoothProperty<Vec2> m_horizontalPadding;
+		SmoothProperty<Vec2> m_verticalPadding;
+		SmoothProperty<Color> m_cursorColor;
+		SmoothProperty<Color> m_selectionColor;
+		PropertyNonInteractive<String> m_placeholderText;
+		SmoothProperty<Color> m_placeholderColor;
+		PropertyNonInteractive<bool> m_readOnly;
+		PropertyNonInteractive<String> m_tag;
 
-		/* NonSerialized */ mutable Cache m_cache;
-		/* NonSerialized */ mutable Cache m_editingCache;
+		/* NonSerialized */ double m_cursorBlinkTime = 0.0;
+		/* NonSerialized */ bool m_isEditing = false;
+		/* NonSerialized */ bool m_isDragging = false;
+		/* NonSerialized */ size_t m_selectionAnchorLine = 0;
+		/* NonSerialized */ size_t m_selectionAnchorColumn = 0;
+		/* NonSerialized */ String m_prevText;
+		/* NonSerialized */ size_t m_cursorLine = 0;
+		/* NonSerialized */ size_t m_cursorColumn = 0;
+		/* NonSerialized */ Stopwatch m_leftPressStopwatch;
+		/* NonSerialized */ Stopwatch m_rightPressStopwatch;
+		/* NonSerialized */ Stopwatch m_upPressStopwatch;
+		/* NonSerialized */ Stopwatch m_downPressStopwatch;
+		/* NonSerialized */ Stopwatch m_pageUpPressStopwatch;
+		/* NonSerialized */ Stopwatch m_pageDownPressStopwatch;
+		/* NonSerialized */ Stopwatch m_backspacePressStopwatch;
+		/* NonSerialized */ Stopwatch m_deletePressStopwatch;
+		/* NonSerialized */ Stopwatch m_enterPressStopwatch;
+		/* NonSerialized */ Stopwatch m_dragScrollStopwatch;
+		/* NonSerialized */ size_t m_scrollOffsetX = 0;
+		/* NonSerialized */ size_t m_scrollOffsetY = 0;
+		/* NonSerialized */ bool m_isChanged = false;
+		/* NonSerialized */ bool m_prevEditingTextExists = false;
+
+		/* NonSerialized */ mutable detail::TextAreaCache m_cache;
+		/* NonSerialized */ mutable detail::TextAreaCache m_editingCache;
 
 		std::pair<size_t, size_t> moveCursorToMousePos(const RectF& rect, const std::shared_ptr<Node>& node);
 
@@ -129,6 +206,8 @@ namespace noco
 			m_editingCache.prevParams.reset();
 		}
 
+		void collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, detail::GlyphPrewarmList& list) const override;
+
 		// IFocusableインタフェースの実装
 		void focus(const std::shared_ptr<Node>& node) override;
 		void blur(const std::shared_ptr<Node>& node) override;
@@ -270,6 +349,13 @@ namespace noco
 			return m_isEditing;
 		}
 
+		[[nodiscard]]
+		bool requiresRedrawEveryFrame() const override
+		{
+			// 編集中はカーソルの点滅や選択範囲の描画がプロパティ外の状態で変化するため
+			return m_isEditing;
+		}
+
 		[[nodiscard]]
 		const String& placeholderText() const
 		{
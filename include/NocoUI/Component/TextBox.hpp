@@ -52,6 +52,7 @@ namespace noco
 		struct CacheParams
 		{
 			String text;
+			uint64 textVersion;
 			String fontAssetName;
 			double fontSize;
 			SizeF rectSize;
@@ -59,11 +60,13 @@ namespace noco
 			[[nodiscard]]
 			bool isDirty(
 				StringView newText,
+				uint64 newTextVersion,
 				StringView newFontAssetName,
 				double newFontSize,
 				const SizeF& newRectSize) const
 			{
-				return text != newText
+				// 内容バージョンが一致する場合はテキストの比較を省略する(0はバージョンなし)
+				return ((newTextVersion == 0 || newTextVersion != textVersion) && text != newText)
 					|| fontAssetName != newFontAssetName
 					|| fontSize != newFontSize
 					|| rectSize != newRectSize;
@@ -79,7 +82,8 @@ namespace noco
 			Optional<CacheParams> prevParams = std::nullopt;
 			FontMethod fontMethod = FontMethod::Bitmap;
 
-			void refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize);
+			/// @note textVersionにはテキストの内容バージョンを指定する(0の場合はテキストの内容を比較する)
+			void refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize, uint64 textVersion = 0);
 
 			[[nodiscard]]
 			double getCursorPosX(double drawOffsetX, size_t scrollOffset, size_t cursorIndex) const;
@@ -115,6 +119,8 @@ namespace noco
 			m_editingCache.prevParams.reset();
 		}
 
+		void collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, detail::GlyphPrewarmList& list) const override;
+
 		// IFocusableインタフェースの実装
 		void focus(const std::shared_ptr<Node>& node) override;
 		void blur(const std::shared_ptr<Node>& node) override;
@@ -262,6 +268,13 @@ namespace noco
 			return m_isEditing;
 		}
 
+		[[nodiscard]]
+		bool requiresRedrawEveryFrame() const override
+		{
+			// 編集中はカーソルの点滅や選択範囲の描画がプロパティ外の状態で変化するため
+			return m_isEditing;
+		}
+
 		[[nodiscard]]
 		const PropertyValue<HorizontalAlign>& horizontalAlign() const
 		{
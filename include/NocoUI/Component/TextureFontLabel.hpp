@@ -3,6 +3,8 @@
 #include "ComponentBase.hpp"
 #include "../LRTB.hpp"
 #include "../Enums.hpp"
+#include "../Asset.hpp"
+#include "IAssetDependentComponent.hpp"
 
 namespace noco
 {
@@ -16,7 +18,7 @@ namespace noco
 		AutoShrinkWidthResizeHeight,
 	};
 
-	class TextureFontLabel : public SerializableComponentBase, public std::enable_shared_from_this<TextureFontLabel>
+	class TextureFontLabel : public SerializableComponentBase, public detail::IAssetDependentComponent, public std::enable_shared_from_this<TextureFontLabel>
 	{
 	private:
 		Property<String> m_text;
@@ -76,8 +78,20 @@ namespace noco
 				Vec2 effectiveSize;
 			};
 
-			HashTable<char32, RectF> uvMap;
-			HashTable<char32, CharacterMetrics> metricsMap;
+			struct CharacterEntry
+			{
+				RectF uv;
+				CharacterMetrics metrics;
+			};
+
+			// 直接インデックス参照するテーブルで扱うコードポイントの上限(これ以上はハッシュテーブルで引く)
+			static constexpr size_t DenseTableMaxSize = 4096;
+
+			static constexpr int32 InvalidEntryIndex = -1;
+
+			Array<CharacterEntry> entries;
+			Array<int32> denseEntryIndices; // コードポイントをそのまま添字としたentriesのインデックス(ASCIIと文字セット内の小さいコードポイント用)
+			HashTable<char32, int32> sparseEntryIndices; // denseEntryIndicesの範囲外のコードポイント用
 			Optional<CacheParams> prevParams;
 
 			bool refreshIfDirty(
@@ -90,8 +104,14 @@ namespace noco
 				const String& textureCellTrimByCharacterJSON,
 				bool textureCellTrimClip);
 
+			[[nodiscard]]
+			const CharacterEntry* find(char32 character) const;
+
 			[[nodiscard]]
 			Optional<RectF> getUV(char32 character) const;
+
+		private:
+			void setEntry(char32 character, const CharacterEntry& entry);
 		};
 
 		struct CharacterCache
@@ -103,13 +123,16 @@ namespace noco
 				Vec2 position;
 			};
 
+			// 文字はCharacterCache::characters内の[characterBegin, characterEnd)の範囲で表す
 			struct LineCache
 			{
-				Array<CharInfo> characters;
+				size_t characterBegin = 0;
+				size_t characterEnd = 0;
 				double width = 0.0;
 				double offsetY = 0.0;
 			};
 
+			Array<CharInfo> characters;
 			Array<LineCache> lineCaches;
 			SizeF regionSize = SizeF::Zero();
 
@@ -175,11 +198,16 @@ namespace noco
 		};
 
 		/* NonSerialized */ mutable TextureFontCache m_textureFontCache;
+		/* NonSerialized */ mutable detail::ResolvedTextureCache m_resolvedTextureCache;
 		/* NonSerialized */ mutable CharacterCache m_cache;
 		/* NonSerialized */ mutable CharacterCache m_autoResizeCache;
+		/* NonSerialized */ mutable Buffer2D m_drawBuffer; // 全文字の矩形を1回の描画にまとめるためのバッファ(容量を使い回す)
 
 		SizeF getContentSizeForAutoResize() const;
 
+		[[nodiscard]]
+		const Texture& resolveTexture() const;
+
 	public:
 		explicit TextureFontLabel(
 			const PropertyValue<String>& text = U"",
@@ -204,6 +232,18 @@ namespace noco
 
 		void draw(const Node& node) const override;
 
+		[[nodiscard]]
+		Optional<LRTB> drawOverflow() const override;
+
+		[[nodiscard]]
+		uint64 resolvedAssetsHash(const Node& node) const override;
+
+		void collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const override;
+
+		/// @brief コンポーネントのJSONから、使用する可能性のあるアセットファイルのパスを収集する
+		/// @note collectAssetDependenciesと同じ対象を、コンポーネントを生成せずに収集する
+		static void CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies);
+
 		[[nodiscard]]
 		const PropertyValue<String>& textureFilePath() const
 		{
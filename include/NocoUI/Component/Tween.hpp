@@ -46,8 +46,56 @@ namespace noco
 		PingPong,
 	};
 
+	/// @brief Tweenのイージングの評価方法
+	enum class TweenEasingEvaluation : uint8
+	{
+		Global, // TweenEasingLookupTable::SetGlobalEnabledの設定に従う
+		Exact, // イージング関数を毎回評価する
+		LookupTable, // 事前計算したテーブルを線形補間して評価する
+	};
+
+	/// @brief イージング関数を評価する
+	/// @param easing イージングの種類
+	/// @param t 進捗(0.0～1.0)
+	/// @return イージング適用後の進捗
+	[[nodiscard]]
+	double EvaluateTweenEasing(TweenEasing easing, double t);
+
+	/// @brief Tweenのイージングを事前計算したテーブルで評価するための設定
+	/// @note テーブルはイージングの種類毎に初回使用時に作成され、サンプル間は線形補間される
+	namespace TweenEasingLookupTable
+	{
+		/// @brief 分割数の既定値
+		inline constexpr size_t DefaultResolution = 1024;
+
+		/// @brief evaluationがGlobalのTweenでテーブルを使用するかどうかを設定する
+		/// @param enabled テーブルを使用する場合はtrue
+		void SetGlobalEnabled(bool enabled);
+
+		/// @brief evaluationがGlobalのTweenでテーブルを使用するかどうかを取得する
+		[[nodiscard]]
+		bool IsGlobalEnabled();
+
+		/// @brief テーブルの分割数を設定する
+		/// @param resolution 分割数(1未満は1として扱う)。変更すると作成済みのテーブルは破棄される
+		void SetResolution(size_t resolution);
+
+		/// @brief テーブルの分割数を取得する
+		[[nodiscard]]
+		size_t Resolution();
+
+		/// @brief テーブルを使用してイージングを評価する
+		/// @param easing イージングの種類
+		/// @param t 進捗(0.0～1.0の範囲外はクランプされる)
+		/// @return イージング適用後の進捗
+		[[nodiscard]]
+		double Evaluate(TweenEasing easing, double t);
+	}
+
 	class Tween : public SerializableComponentBase, public std::enable_shared_from_this<Tween>
 	{
+		friend class Canvas;
+
 	private:
 		Property<bool> m_active;
 
@@ -82,7 +130,10 @@ namespace noco
 		SmoothProperty<double> m_manualTime;
 		PropertyNonInteractive<String> m_tag;
 
-		/* NonSerialized */ Stopwatch m_stopwatch;
+		/* NonSerialized */ Optional<double> m_startTime = none; // Canvasのアニメーション用時計での再生開始時刻(noneの場合は次回update時に設定)
+		/* NonSerialized */ double m_elapsedTime = 0.0;
+		/* NonSerialized */ bool m_retired = false; // 再生終了済みで最終値の適用のみ行う状態かどうか
+		/* NonSerialized */ TweenEasingEvaluation m_easingEvaluation = TweenEasingEvaluation::Global;
 		/* NonSerialized */ Optional<bool> m_prevActive = none;
 
 		[[nodiscard]]
@@ -93,6 +144,14 @@ namespace noco
 		void updateRotation(const std::shared_ptr<Node>& node, double progress);
 		void updateColor(const std::shared_ptr<Node>& node, double progress);
 
+		void applyEasedProgress(const std::shared_ptr<Node>& node, double easedProgress);
+
+		void restart();
+
+		/// @brief 現在の再生時間に応じた値をノードへ適用する
+		/// @note Canvasに属するノードの場合は、Canvasがupdate後にまとめて呼び出す
+		void evaluate(const std::shared_ptr<Node>& node);
+
 	public:
 		explicit Tween(
 			const PropertyValue<bool>& active = true,
@@ -307,6 +366,20 @@ namespace noco
 			return shared_from_this();
 		}
 
+		[[nodiscard]]
+		TweenEasingEvaluation easingEvaluation() const
+		{
+			return m_easingEvaluation;
+		}
+
+		/// @brief イージングの評価方法を設定する
+		/// @note 大量のTweenを同時に再生する場合はLookupTableにすることで評価コストを抑えられる
+		std::shared_ptr<Tween> setEasingEvaluation(TweenEasingEvaluation easingEvaluation)
+		{
+			m_easingEvaluation = easingEvaluation;
+			return shared_from_this();
+		}
+
 		[[nodiscard]]
 		double duration() const
 		{
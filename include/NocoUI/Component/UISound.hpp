@@ -3,10 +3,11 @@
 #include "ComponentBase.hpp"
 #include "../Node.hpp"
 #include "../Enums.hpp"
+#include "IAssetDependentComponent.hpp"
 
 namespace noco
 {
-	class UISound : public SerializableComponentBase, public std::enable_shared_from_this<UISound>
+	class UISound : public SerializableComponentBase, public detail::IAssetDependentComponent, public std::enable_shared_from_this<UISound>
 	{
 	public:
 		enum class TriggerType : uint8
@@ -50,6 +51,12 @@ namespace noco
 
 		void update(const std::shared_ptr<Node>& node) override;
 
+		void collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const override;
+
+		/// @brief コンポーネントのJSONから、使用する可能性のあるアセットファイルのパスを収集する
+		/// @note collectAssetDependenciesと同じ対象を、コンポーネントを生成せずに収集する
+		static void CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies);
+
 		const PropertyValue<String>& audioFilePath() const
 		{
 			return m_audioFilePath.propertyValue();
@@ -61,5 +61,30 @@ namespace noco
 		{
 			return s_globalDefaultFont.defaultFontAssetName;
 		}
+
+		/// @brief テキスト系コンポーネントが実際に使用するフォントを解決する
+		/// @param fontAssetName コンポーネントに指定されたフォントアセット名
+		/// @param canvasDefaultFontAssetName Canvasのデフォルトフォントアセット名
+		/// @return フォントアセット名、Canvasのデフォルト、グローバルのデフォルト、SimpleGUIのフォントの順で最初に見つかったフォント
+		[[nodiscard]]
+		inline Font ResolveFont(StringView fontAssetName, StringView canvasDefaultFontAssetName)
+		{
+			if (!fontAssetName.empty() && FontAsset::IsRegistered(fontAssetName))
+			{
+				return FontAsset(fontAssetName);
+			}
+
+			if (!canvasDefaultFontAssetName.empty() && FontAsset::IsRegistered(canvasDefaultFontAssetName))
+			{
+				return FontAsset(canvasDefaultFontAssetName);
+			}
+
+			if (auto globalFont = GetGlobalDefaultFont())
+			{
+				return *globalFont;
+			}
+
+			return SimpleGUI::GetFont();
+		}
 	}
 }
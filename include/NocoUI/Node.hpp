@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <Siv3D.hpp>
+#include <span>
 #include "YN.hpp"
 #include "PropertyValue.hpp"
 #include "Property.hpp"
@@ -24,6 +25,87 @@ namespace noco
 
 	struct CanvasUpdateContext;
 
+	class Node;
+
+	namespace detail
+	{
+		inline std::atomic<bool> s_deferredNodeLoadingEnabled = false;
+
+		/// @brief 共有されたJSON内での、ノードのJSONの位置
+		/// @note 生成を遅延したノードが、読み込み元のJSONをノード毎に複製せずに参照するために使用する
+		struct SharedJSONLocation
+		{
+			/// @brief 読み込み元のJSON(CanvasまたはノードのJSON)
+			std::shared_ptr<const JSON> source;
+
+			/// @brief sourceからノードのJSONまで辿るchildrenの添字の列
+			Array<size_t> childIndexPath;
+
+			/// @brief index番目の子ノードのJSONの位置を取得
+			[[nodiscard]]
+			SharedJSONLocation child(size_t index) const
+			{
+				SharedJSONLocation location{ .source = source, .childIndexPath = childIndexPath };
+				location.childIndexPath.push_back(index);
+				return location;
+			}
+
+			/// @brief ノードのJSONを引数として関数を呼び出す
+			/// @note 要素は参照として辿るため、JSONは複製されない
+			template <class Fun>
+			void visit(Fun&& fun) const
+			{
+				VisitImpl(*source, std::span<const size_t>{ childIndexPath.data(), childIndexPath.size() }, fun);
+			}
+
+		private:
+			template <class Fun>
+			static void VisitImpl(const JSON& json, std::span<const size_t> childIndexPath, Fun& fun)
+			{
+				if (childIndexPath.empty())
+				{
+					fun(json);
+					return;
+				}
+				VisitImpl(json[U"children"][childIndexPath.front()], childIndexPath.subspan(1), fun);
+			}
+		};
+
+		/// @brief 子ノードの描画順(zOrderInSiblingsの昇順)のキャッシュ
+		/// @note 子ノードの構成(インスタンスID)とzOrderInSiblingsの内容バージョンが前回と同じ場合は並べ替えを省略する
+		class ChildrenDrawOrderCache
+		{
+		private:
+			Array<size_t> m_order;
+			Array<uint64> m_instanceIds;
+			uint64 m_zOrderVersionSum = 0;
+
+		public:
+			/// @brief 子ノードを描画順に並べたインデックスを取得
+			/// @param children 子ノード
+			/// @return childrenのインデックスを描画順に並べたもの
+			[[nodiscard]]
+			const Array<size_t>& get(const Array<std::shared_ptr<Node>>& children);
+		};
+	}
+
+	/// @brief JSONからの読み込み時に、非アクティブなノードの中身の生成を遅延させるかどうかを設定
+	/// @param enabled trueの場合、activeSelfがfalseのノードはコンポーネントと子ノードを生成せずに読み込み元のJSONを共有して保持し、初めてactiveInHierarchyがtrueになった時点で生成する
+	/// @note 子ノード・コンポーネントの取得や名前・タグによる検索を行った場合もその時点で生成されるため、利用側で遅延の有無を意識する必要はない
+	/// @note NocoEditorのエディタモードでは常に無効
+	inline void SetDeferredNodeLoadingEnabled(bool enabled)
+	{
+		detail::s_deferredNodeLoadingEnabled = enabled;
+	}
+
+	/// @brief JSONからの読み込み時に、非アクティブなノードの中身の生成を遅延させるかどうかを取得
+	/// @return 遅延させる場合はtrue
+	[[nodiscard]]
+	inline bool IsDeferredNodeLoadingEnabled()
+	{
+		return detail::s_deferredNodeLoadingEnabled;
+	}
+
 	class Node : public INodeContainer, public std::enable_shared_from_this<Node>
 	{
 		friend class Canvas;
@@ -51,6 +133,19 @@ namespace noco
 		PropertyNonInteractive<bool> m_activeSelf{ U"activeSelf", true };
 		Property<int32> m_zOrderInSiblings{ U"zOrderInSiblings", 0 };
 
+		/// @brief 生成が遅延されているノードの中身(コンポーネント・子ノード)
+		struct DeferredContent
+		{
+			/// @brief 読み込み元のJSON内でのノードのJSONの位置(読み込み元のJSONは同じJSONから読み込んだノード間・複製したノード間で共有される)
+			detail::SharedJSONLocation jsonLocation;
+
+			/// @brief 生成に使用するコンポーネントファクトリ
+			std::shared_ptr<const ComponentFactory> componentFactory;
+
+			/// @brief 生成せずに型を判定するための、コンポーネントの種類名毎のインスタンス
+			HashTable<String, std::shared_ptr<ComponentBase>> componentTypeProbes;
+		};
+
 		/* NonSerialized */ std::weak_ptr<Canvas> m_canvas;
 		/* NonSerialized */ std::weak_ptr<Node> m_parent;
 		/* NonSerialized */ RectF m_regionRect{ 0.0, 0.0, 0.0, 0.0 };
@@ -71,6 +166,7 @@ namespace noco
 		/* NonSerialized */ bool m_rightClickRequested = false;
 		/* NonSerialized */ bool m_prevClickRequested = false;
 		/* NonSerialized */ bool m_prevRightClickRequested = false;
+		/* NonSerialized */ uint64 m_componentsVersion = 0; // コンポーネントの追加・削除・並べ替えの度に増加
 		/* NonSerialized */ Optional<Vec2> m_dragStartPos; // ドラッグ開始位置
 		/* NonSerialized */ Vec2 m_dragStartScrollOffset{ 0.0, 0.0 }; // ドラッグ開始時のスクロールオフセット
 		/* NonSerialized */ Vec2 m_scrollVelocity{ 0.0, 0.0 }; // スクロール速度
@@ -86,11 +182,19 @@ namespace noco
 		/* NonSerialized */ Optional<int32> m_prevZOrderInSiblings; // 前回フレームのzOrderInSiblings
 		/* NonSerialized */ mutable Array<std::shared_ptr<Node>> m_tempChildrenBuffer; // 子ノードの一時バッファ(update内で別のNodeのupdateが呼ばれる場合があるためthread_local staticにはできない。drawで呼ぶためmutableだが、drawはシングルスレッド前提なのでロック不要)
 		/* NonSerialized */ mutable Array<std::shared_ptr<ComponentBase>> m_tempComponentsBuffer; // コンポーネントの一時バッファ(update内で別のNodeのupdateが呼ばれる場合があるためthread_local staticにはできない。drawで呼ぶためmutableだが、drawはシングルスレッド前提なのでロック不要)
+		/* NonSerialized */ mutable detail::ChildrenDrawOrderCache m_childrenDrawOrderCache; // 子ノードの描画順のキャッシュ(drawで使用するためmutableだが、drawはシングルスレッド前提なのでロック不要)
+		/* NonSerialized */ mutable bool m_occlusionCulled = false; // オクルージョンカリングにより自身のコンポーネントの描画をスキップするかどうか(Canvas::drawの実行中のみ設定される)
 		/* NonSerialized */ mutable FirstActiveLifecycleCompletedFlags m_firstActiveLifecycleCompletedFlags = FirstActiveLifecycleCompletedFlags::None; // activeInHierarchy=Yesで一度でも各種updateが呼ばれたかどうかのビットフラグ
+		/* NonSerialized */ std::unique_ptr<DeferredContent> m_deferredContent; // 生成が遅延されている中身(IsDeferredNodeLoadingEnabledの場合のみ)
 
 		[[nodiscard]]
 		Mat3x2 calculateHitTestMat(const Mat3x2& parentHitTestMat) const;
 
+		/// @brief コンポーネントの描画範囲(領域の外側へのはみ出しを含む)の外接矩形を取得
+		/// @return 外接矩形。はみ出す範囲を求められないコンポーネントを持つ場合はnone
+		[[nodiscard]]
+		Optional<RectF> drawnBoundingRect() const;
+
 		[[nodiscard]]
 		explicit Node(uint64 instanceId, StringView name, const RegionVariant& region, IsHitTargetYN isHitTarget, InheritChildrenStateFlags inheritChildrenStateFlags)
 			: m_instanceId{ instanceId }
@@ -119,6 +223,55 @@ namespace noco
 
 		void refreshActiveInHierarchy();
 
+		void materializeDeferredContentImpl();
+
+		/// @brief JSONからノードを作成
+		/// @param location jsonの共有されたJSON内での位置。nullptrの場合、生成を遅延するノードは自身のJSONを1回だけ複製して保持する
+		[[nodiscard]]
+		static std::shared_ptr<Node> CreateFromJSONImpl(const JSON& json, const ComponentFactory& factory, detail::WithInstanceIdYN withInstanceId, const detail::SharedJSONLocation* location);
+
+		/// @brief 中身の生成が遅延されている場合は生成する
+		/// @note 子ノード・コンポーネントを参照する公開関数の先頭で呼び出す。constな関数からも呼ばれるが、論理的な内容は変化しない
+		void materializeIfDeferred() const
+		{
+			if (m_deferredContent) [[unlikely]]
+			{
+				const_cast<Node*>(this)->materializeDeferredContentImpl();
+			}
+		}
+
+		/// @brief 生成が遅延されている中身を生成せずに走査し、条件を満たし得るコンポーネント・子ノードが含まれるかどうかを取得
+		/// @param componentPredicate コンポーネントのJSONに対する条件(空の場合は判定しない)
+		/// @param childPredicate 子ノードのJSONに対する条件(空の場合は判定しない)
+		/// @param recursive 子孫ノードも対象とするかどうか
+		/// @param includeSubCanvas SubCanvas配下も対象とするかどうか。SubCanvasの中身は読み込むまで分からないため、SubCanvasが含まれる場合は条件を満たし得るとみなす
+		/// @return 条件を満たし得る場合はtrue。中身の生成が遅延されていない場合もtrue
+		/// @note 検索系の関数で、一致するものが含まれない遅延ノードの中身を生成しないために使用する
+		[[nodiscard]]
+		bool deferredContentMayContain(const std::function<bool(const JSON&)>& componentPredicate, const std::function<bool(const JSON&)>& childPredicate, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const;
+
+		/// @brief 生成が遅延されている中身に、指定した型のコンポーネントが含まれ得るかどうかを取得
+		/// @param isInstanceOf コンポーネントが対象の型かどうかを返す関数
+		/// @note SubCanvas配下はrecursiveが有効な場合のみ対象とする(getComponent等と同様)
+		[[nodiscard]]
+		bool deferredContentMayContainComponentOf(bool (*isInstanceOf)(const ComponentBase&), RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const;
+
+		/// @brief 生成が遅延されている中身に、指定したタグを持つコンポーネントが含まれ得るかどうかを取得
+		/// @note SubCanvas配下はrecursiveが有効な場合のみ対象とする(setTweenActiveByTag等と同様)
+		[[nodiscard]]
+		bool deferredContentMayContainTag(StringView tag, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const;
+
+		template <class TComponent>
+		[[nodiscard]]
+		bool deferredContentMayContainComponent(RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const
+		{
+			if (!m_deferredContent) [[likely]]
+			{
+				return true;
+			}
+			return deferredContentMayContainComponentOf([](const ComponentBase& component) { return dynamic_cast<const TComponent*>(&component) != nullptr; }, recursive, includeSubCanvas);
+		}
+
 		void refreshPropertiesForInteractable(InteractableYN effectiveInteractable, SkipSmoothingYN skipSmoothing);
 
 		void refreshChildrenPropertiesForInteractableRecursive(InteractableYN interactable, const HashTable<String, ParamValue>& params, SkipSmoothingYN skipSmoothing);
@@ -127,6 +280,9 @@ namespace noco
 
 		void clampScrollOffset();
 
+		[[nodiscard]]
+		bool isTransparentForHitTest() const;
+
 		static void SortByZOrderInSiblings(Array<std::shared_ptr<Node>>& nodes, detail::UsePrevZOrderInSiblingsYN usePrevZOrderInSiblings = detail::UsePrevZOrderInSiblingsYN::No);
 
 	public:
@@ -220,9 +376,10 @@ namespace noco
 
 		/// @brief ノードをJSON形式でシリアライズ
 		/// @param withInstanceId 出力内容にインスタンスIDを含めるかどうか(NocoEditorの内部実装向けのため、通常は指定不要)
+		/// @param omitDefaultValues 既定値と等しい設定値・プロパティを省略するかどうか
 		/// @return JSON
 		[[nodiscard]]
-		JSON toJSON(detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No) const;
+		JSON toJSON(detail::WithInstanceIdYN withInstanceId = detail::WithInstanceIdYN::No, OmitDefaultValuesYN omitDefaultValues = OmitDefaultValuesYN::No) const;
 
 		/// @brief ノード配下にパラメータ参照のあるパラメータ名を列挙
 		/// @param pParamRefs 挿入先のハッシュセットのポインタ
@@ -353,7 +510,9 @@ namespace noco
 		template <typename Predicate>
 		void removeComponentsIf(Predicate predicate)
 		{
+			materializeIfDeferred();
 			m_components.remove_if(std::move(predicate));
+			++m_componentsVersion;
 		}
 
 		/// @brief 指定した型のコンポーネントをすべて削除
@@ -742,6 +901,12 @@ namespace noco
 		[[nodiscard]]
 		const Array<std::shared_ptr<ComponentBase>>& components() const;
 
+		/// @brief コンポーネント構成のバージョンを取得
+		/// @return コンポーネントの追加・削除・並べ替えの度に増加する値
+		/// @note コンポーネントの検索結果をキャッシュする際のキーとして使用する
+		[[nodiscard]]
+		uint64 componentsVersion() const;
+
 		/// @brief インタラクション可能かどうかを取得
 		/// @return インタラクション可能な場合はtrue、そうでなければfalseを返す
 		[[nodiscard]]
@@ -1170,9 +1335,28 @@ namespace noco
 
 		/// @brief ノードを複製する
 		/// @return 複製されたノード
+		/// @note シリアライズ対象の内容(子ノード・シリアライズ可能なコンポーネントを含む)をJSONを経由せずに直接コピーする。インスタンスIDは新たに割り当てられる
 		[[nodiscard]]
 		std::shared_ptr<Node> clone() const;
 
+		/// @brief ノードを複製する
+		/// @param factory コンポーネントを生成するためのファクトリ
+		/// @return 複製されたノード
+		/// @note シリアライズ対象の内容(子ノード・シリアライズ可能なコンポーネントを含む)をJSONを経由せずに直接コピーする。インスタンスIDは新たに割り当てられる
+		[[nodiscard]]
+		std::shared_ptr<Node> clone(const ComponentFactory& factory) const;
+
+		/// @brief 中身(コンポーネント・子ノード)の生成が遅延されているかどうかを取得
+		/// @return 遅延されている場合はtrue
+		/// @note SetDeferredNodeLoadingEnabledで遅延を有効にして読み込んだ、一度もアクティブになっていないノードが対象
+		[[nodiscard]]
+		bool hasDeferredContent() const;
+
+		/// @brief 生成が遅延されている中身(コンポーネント・子ノード)を生成する
+		/// @param recursive 子孫ノードも対象とするかどうか
+		/// @note 必要になった時点で自動的に生成されるため通常は呼び出す必要はない。表示前に生成コストを払っておきたい場合に使用する
+		void materializeDeferredContent(RecursiveYN recursive = RecursiveYN::Yes);
+
 		/// @brief updateKeyInput関数を毎フレーム実行するコンポーネントを追加
 		/// @param keyInputUpdater updateKeyInput関数の関数オブジェクト
 		/// @return ノード自身(メソッドチェーンのため)
@@ -1301,6 +1485,7 @@ namespace noco
 		[[nodiscard]]
 		const Array<std::shared_ptr<Node>>& children() const override
 		{
+			materializeIfDeferred();
 			return m_children;
 		}
 
@@ -1309,6 +1494,7 @@ namespace noco
 		[[nodiscard]]
 		size_t childCount() const override
 		{
+			materializeIfDeferred();
 			return m_children.size();
 		}
 
@@ -1440,7 +1626,9 @@ namespace noco
 	std::shared_ptr<TComponent> Node::addComponent(const std::shared_ptr<TComponent>& component)
 		requires std::derived_from<TComponent, ComponentBase>
 	{
+		materializeIfDeferred();
 		m_components.push_back(component);
+		++m_componentsVersion;
 		
 		if (m_activeInHierarchy)
 		{
@@ -1454,11 +1642,13 @@ namespace noco
 	std::shared_ptr<TComponent> Node::addComponentAtIndex(const std::shared_ptr<TComponent>& component, size_t index)
 		requires std::derived_from<TComponent, ComponentBase>
 	{
+		materializeIfDeferred();
 		if (index > m_components.size())
 		{
 			index = m_components.size();
 		}
 		m_components.insert(m_components.begin() + index, component);
+		++m_componentsVersion;
 		
 		if (m_activeInHierarchy)
 		{
@@ -1507,6 +1697,7 @@ namespace noco
 		}
 
 		// 子ノードを再帰的に検索
+		materializeIfDeferred();
 		for (const auto& child : m_children)
 		{
 			child->findAll(predicate, pResults, AppendYN::Yes);
@@ -1517,6 +1708,12 @@ namespace noco
 	[[nodiscard]]
 	std::shared_ptr<TComponent> Node::getComponent(RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const
 	{
+		// 遅延されている中身に該当する型のコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainComponent<TComponent>(recursive, includeSubCanvas))
+		{
+			return nullptr;
+		}
+		materializeIfDeferred();
 		for (const auto& component : m_components)
 		{
 			if (auto concreteComponent = std::dynamic_pointer_cast<TComponent>(component))
@@ -1574,7 +1771,14 @@ namespace noco
 			pResults->clear();
 		}
 
+		// 遅延されている中身に該当する型のコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainComponent<TComponent>(recursive, includeSubCanvas))
+		{
+			return;
+		}
+
 		// 自身のコンポーネントから該当する型のものを収集
+		materializeIfDeferred();
 		for (const auto& component : m_components)
 		{
 			if (auto concreteComponent = std::dynamic_pointer_cast<TComponent>(component))
@@ -1629,7 +1833,14 @@ namespace noco
 			pResults->clear();
 		}
 
+		// 遅延されている中身に該当する型のコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainComponent<TComponent>(recursive, includeSubCanvas))
+		{
+			return;
+		}
+
 		// 自身のコンポーネントから条件を満たすものを収集
+		materializeIfDeferred();
 		for (const auto& component : m_components)
 		{
 			if (auto concreteComponent = std::dynamic_pointer_cast<TComponent>(component))
@@ -1718,6 +1929,13 @@ namespace noco
 	template <typename TComponent>
 	void Node::removeComponents(RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas)
 	{
+		// 遅延されている中身に該当する型のコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainComponent<TComponent>(recursive, includeSubCanvas))
+		{
+			return;
+		}
+		materializeIfDeferred();
+
 		// SubCanvasの子を先に処理（m_componentsから削除する前に行う必要がある）
 		if (recursive == RecursiveYN::Yes && includeSubCanvas)
 		{
@@ -1743,6 +1961,7 @@ namespace noco
 			}
 			return false;
 		});
+		++m_componentsVersion;
 
 		// 再帰的に処理する場合は子ノードも処理
 		if (recursive == RecursiveYN::Yes)
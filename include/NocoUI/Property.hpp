@@ -6,6 +6,7 @@
 #include "Smoothing.hpp"
 #include "LRTB.hpp"
 #include "Param.hpp"
+#include "detail/BinaryCanvasIO.hpp"
 
 namespace noco
 {
@@ -29,6 +30,61 @@ namespace noco
 		virtual void update(InteractionState interactionState, const Array<String>& activeStyleStates, double deltaTime, const HashTable<String, ParamValue>& params, SkipSmoothingYN skipSmoothing) = 0;
 		virtual void appendJSON(JSON& json) const = 0;
 		virtual void readFromJSON(const JSON& json) = 0;
+		/// @brief シリアライズ対象の内容(プロパティ値・パラメータ参照)を同じ名前・型のプロパティからコピー
+		/// @note 既定の実装はJSONを経由する。組み込みのプロパティ型はJSONを経由せず直接コピーする
+		virtual void copySerializedFrom(const IProperty& other)
+		{
+			JSON json;
+			other.appendJSON(json);
+			readFromJSON(json);
+		}
+		/// @brief シリアライズ対象の内容(プロパティ値・パラメータ参照)が同じ名前・型のプロパティと等しいかどうかを取得
+		/// @note 既定の実装はJSONを経由して比較する。組み込みのプロパティ型はJSONを経由せず直接比較する
+		[[nodiscard]]
+		virtual bool hasSameSerializedContent(const IProperty& other) const
+		{
+			JSON json;
+			appendJSON(json);
+			JSON otherJSON;
+			other.appendJSON(otherJSON);
+			return json == otherJSON;
+		}
+		/// @brief 既定の状態のプロパティと内容が異なる場合のみJSONに書き込む
+		/// @param json 書き込み先のJSON
+		/// @param defaultProperty 既定の状態の同じ名前・型のプロパティ
+		/// @note パラメータ参照を持つ場合は、読み込み時に値のキーが存在しないとパラメータ参照も読まれないため常に書き込む
+		void appendJSONIfNotDefault(JSON& json, const IProperty& defaultProperty) const
+		{
+			if (hasParamRef() || !hasSameSerializedContent(defaultProperty))
+			{
+				appendJSON(json);
+			}
+		}
+		/// @brief バイナリ形式(.nocob)での値の種類
+		/// @note writeBinary・readBinaryをオーバーライドする場合は合わせてオーバーライドする
+		[[nodiscard]]
+		virtual detail::BinaryValueKind binaryValueKind() const
+		{
+			return detail::BinaryValueKind::JSON;
+		}
+		/// @brief シリアライズ対象の内容(プロパティ値・パラメータ参照)をバイナリ形式(.nocob)で書き込む
+		/// @note 既定の実装はappendJSONの内容を汎用の値の木として書き込む。組み込みのプロパティ型はJSONを経由せず値を直接書き込む
+		virtual void writeBinary(detail::BinaryCanvasWriter& writer) const
+		{
+			JSON json;
+			appendJSON(json);
+			writer.writeJSON(json);
+		}
+		/// @brief writeBinaryで書き込んだ内容を読み込む
+		virtual void readBinary(detail::BinaryCanvasReader& reader)
+		{
+			JSON json;
+			reader.readJSON(json);
+			if (!reader.failed())
+			{
+				readFromJSON(json);
+			}
+		}
 		virtual String propertyValueStringOfDefault() const = 0;
 		virtual Optional<String> propertyValueStringOf(InteractionState interactionState, const Array<String>& activeStyleStates) const = 0;
 		virtual String propertyValueStringOfFallback(InteractionState interactionState, const Array<String>& activeStyleStates) const = 0;
@@ -61,8 +117,38 @@ namespace noco
 		virtual Optional<String> previewParamRefAppliedString(const ParamValue& paramValue, ParamRefMode mode) const = 0;
 		virtual void clearParamRefIfInvalid(const HashTable<String, ParamValue>& validParams, HashSet<String>& clearedParams) = 0;
 		virtual void clearCurrentFrameOverride() = 0;
+		/// @brief 現在の値の変化検出用の値を取得(描画内容の変化検出用)
+		/// @note 値が変化すると必ず変化する。値が同じでも変化する場合がある
+		virtual uint64 currentValueVersion() const
+		{
+			return 0;
+		}
 	};
 
+	namespace detail
+	{
+		template <class T>
+		[[nodiscard]]
+		uint64 HashPropertyValue(const T& value)
+		{
+			if constexpr (std::same_as<T, String>)
+			{
+				return value.hash();
+			}
+			else
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+				return Hash::FNV1a(&value, sizeof(T));
+			}
+		}
+
+		[[nodiscard]]
+		inline uint64 HashCombine(uint64 seed, uint64 value)
+		{
+			return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+		}
+	}
+
 	template <typename T>
 	constexpr PropertyEditType PropertyEditTypeOf()
 	{
@@ -169,6 +255,22 @@ namespace noco
 		/*NonSerialized*/ Optional<T> m_paramRefOverride; // パラメータ参照による上書き
 		/*NonSerialized*/ Optional<T> m_currentFrameOverride;
 		/*NonSerialized*/ int32 m_currentFrameOverrideFrameCount = 0;
+		/*NonSerialized*/ mutable uint64 m_contentVersion = 0;
+		/*NonSerialized*/ mutable const T* m_contentVersionSource = nullptr;
+
+		void bumpContentVersion()
+		{
+			++m_contentVersion;
+		}
+
+		void setParamRefOverride(Optional<T>&& paramRefOverride)
+		{
+			if (m_paramRefOverride != paramRefOverride)
+			{
+				m_paramRefOverride = std::move(paramRefOverride);
+				bumpContentVersion();
+			}
+		}
 
 	public:
 		Property(const char32_t* name, const PropertyValue<T>& propertyValue)
@@ -211,6 +313,7 @@ namespace noco
 		void setPropertyValue(const PropertyValue<T>& propertyValue)
 		{
 			m_propertyValue = propertyValue;
+			bumpContentVersion();
 		}
 
 		[[nodiscard]]
@@ -310,13 +413,42 @@ namespace noco
 		
 		void setCurrentFrameOverride(const T& value)
 		{
-			m_currentFrameOverride = value;
+			if (!m_currentFrameOverride.has_value() || *m_currentFrameOverride != value)
+			{
+				m_currentFrameOverride = value;
+				bumpContentVersion();
+			}
 			m_currentFrameOverrideFrameCount = Scene::FrameCount();
 		}
 		
 		void clearCurrentFrameOverride() override
 		{
-			m_currentFrameOverride.reset();
+			if (m_currentFrameOverride.has_value())
+			{
+				m_currentFrameOverride.reset();
+				bumpContentVersion();
+			}
+		}
+
+		/// @brief 現在の値の内容バージョンを取得
+		/// @return 値が変化するたびに増加する値
+		/// @note 値の参照元(スタイルステート・パラメータ参照・現在フレームの上書き)が切り替わった場合も増加するため、キャッシュの更新判定に値の比較の代わりに使用できる
+		[[nodiscard]]
+		uint64 contentVersion() const
+		{
+			const T* source = &value();
+			if (source != m_contentVersionSource)
+			{
+				m_contentVersionSource = source;
+				++m_contentVersion;
+			}
+			return m_contentVersion;
+		}
+
+		[[nodiscard]]
+		uint64 currentValueVersion() const override
+		{
+			return contentVersion();
 		}
 		
 		[[nodiscard]]
@@ -340,24 +472,24 @@ namespace noco
 						const T& base = m_propertyValue.value(interactionState, activeStyleStates);
 						if (auto resolved = ApplyParamRefMode<T>(base, it->second, m_paramRefMode))
 						{
-							m_paramRefOverride = std::move(*resolved);
+							setParamRefOverride(std::move(resolved));
 						}
 						else
 						{
 							// パラメータの型が合わない場合はクリア
-							m_paramRefOverride.reset();
+							setParamRefOverride(none);
 						}
 					}
 					else
 					{
 						// パラメータが見つからない場合はクリア
-						m_paramRefOverride.reset();
+						setParamRefOverride(none);
 					}
 				}
 				else
 				{
 					// パラメータ参照がない場合はクリア
-					m_paramRefOverride.reset();
+					setParamRefOverride(none);
 				}
 			}
 		}
@@ -382,6 +514,7 @@ namespace noco
 				return;
 			}
 			m_propertyValue = PropertyValue<T>::FromJSON(json[m_name]);
+			bumpContentVersion();
 
 			const String paramRefKey = String(m_name) + U"_paramRef";
 			if (json.contains(paramRefKey))
@@ -402,6 +535,70 @@ namespace noco
 			}
 		}
 
+		void copySerializedFrom(const IProperty& other) override
+		{
+			const auto* otherProperty = dynamic_cast<const Property*>(&other);
+			if (otherProperty == nullptr)
+			{
+				IProperty::copySerializedFrom(other);
+				return;
+			}
+			m_propertyValue = otherProperty->m_propertyValue;
+			bumpContentVersion();
+			m_paramRef = otherProperty->m_paramRef;
+			m_paramRefMode = otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		bool hasSameSerializedContent(const IProperty& other) const override
+		{
+			const auto* otherProperty = dynamic_cast<const Property*>(&other);
+			if (otherProperty == nullptr)
+			{
+				return IProperty::hasSameSerializedContent(other);
+			}
+			return m_propertyValue == otherProperty->m_propertyValue
+				&& m_paramRef == otherProperty->m_paramRef
+				&& m_paramRefMode == otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		detail::BinaryValueKind binaryValueKind() const override
+		{
+			return detail::BinaryValueKindOf<T>();
+		}
+
+		void writeBinary(detail::BinaryCanvasWriter& writer) const override
+		{
+			if constexpr (detail::BinaryValueType<T>)
+			{
+				writer.writePropertyValue(m_propertyValue);
+				writer.writeParamRef(m_paramRef, m_paramRefMode);
+			}
+			else
+			{
+				IProperty::writeBinary(writer);
+			}
+		}
+
+		void readBinary(detail::BinaryCanvasReader& reader) override
+		{
+			if constexpr (detail::BinaryValueType<T>)
+			{
+				reader.readPropertyValue(m_propertyValue);
+				bumpContentVersion();
+				reader.readParamRef(m_paramRef, m_paramRefMode);
+				if (m_paramRefMode != ParamRefMode::Normal)
+				{
+					m_paramRefMode = ValidateParamRefModeFromJSON(m_paramRefMode, AvailableParamRefModesFor<T>(), name());
+				}
+			}
+			else
+			{
+				IProperty::readBinary(reader);
+			}
+		}
+
 		[[nodiscard]]
 		String propertyValueStringOfDefault() const override
 		{
@@ -422,17 +619,20 @@ namespace noco
 
 		bool trySetPropertyValueString(StringView value) override
 		{
+			bumpContentVersion();
 			return m_propertyValue.trySetValueString(value);
 		}
 
 		bool trySetPropertyValueStringOf(StringView value, InteractionState interactionState, StringView styleState = U"") override
 		{
+			bumpContentVersion();
 			return m_propertyValue.trySetValueStringOf(value, interactionState, styleState);
 		}
 
 		void unsetPropertyValueOf(InteractionState interactionState, StringView styleState = U"") override
 		{
 			m_propertyValue.unsetValueOf(interactionState, styleState);
+			bumpContentVersion();
 		}
 
 		[[nodiscard]]
@@ -663,7 +863,8 @@ namespace noco
 			}
 			else
 			{
-				m_smoothing.update(m_propertyValue.value(interactionState, activeStyleStates), m_propertyValue.smoothTime(), deltaTime);
+				// パラメータ参照がある場合はスムージング後の値を直後に使用するため、一括評価せず即座に評価する
+				m_smoothing.update(m_propertyValue.value(interactionState, activeStyleStates), m_propertyValue.smoothTime(), deltaTime, m_paramRef.isEmpty() ? detail::s_activeSmoothingBatch : nullptr);
 			}
 
 			// パラメータ参照適用
@@ -718,6 +919,13 @@ namespace noco
 		{
 			m_currentFrameOverride.reset();
 		}
+
+		[[nodiscard]]
+		uint64 currentValueVersion() const override
+		{
+			// 補間中は毎フレーム値が変化するため、内容バージョンではなく値のハッシュを使用
+			return detail::HashPropertyValue(value());
+		}
 		
 		[[nodiscard]]
 		bool hasCurrentFrameOverride() const
@@ -766,6 +974,70 @@ namespace noco
 			}
 		}
 
+		void copySerializedFrom(const IProperty& other) override
+		{
+			const auto* otherProperty = dynamic_cast<const SmoothProperty*>(&other);
+			if (otherProperty == nullptr)
+			{
+				IProperty::copySerializedFrom(other);
+				return;
+			}
+			m_propertyValue = otherProperty->m_propertyValue;
+			m_smoothing = Smoothing<T>{ m_propertyValue.value(InteractionState::Default, Array<String>{}) };
+			m_paramRef = otherProperty->m_paramRef;
+			m_paramRefMode = otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		bool hasSameSerializedContent(const IProperty& other) const override
+		{
+			const auto* otherProperty = dynamic_cast<const SmoothProperty*>(&other);
+			if (otherProperty == nullptr)
+			{
+				return IProperty::hasSameSerializedContent(other);
+			}
+			return m_propertyValue == otherProperty->m_propertyValue
+				&& m_paramRef == otherProperty->m_paramRef
+				&& m_paramRefMode == otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		detail::BinaryValueKind binaryValueKind() const override
+		{
+			return detail::BinaryValueKindOf<T>();
+		}
+
+		void writeBinary(detail::BinaryCanvasWriter& writer) const override
+		{
+			if constexpr (detail::BinaryValueType<T>)
+			{
+				writer.writePropertyValue(m_propertyValue);
+				writer.writeParamRef(m_paramRef, m_paramRefMode);
+			}
+			else
+			{
+				IProperty::writeBinary(writer);
+			}
+		}
+
+		void readBinary(detail::BinaryCanvasReader& reader) override
+		{
+			if constexpr (detail::BinaryValueType<T>)
+			{
+				reader.readPropertyValue(m_propertyValue);
+				m_smoothing = Smoothing<T>{ m_propertyValue.value(InteractionState::Default, Array<String>{}) };
+				reader.readParamRef(m_paramRef, m_paramRefMode);
+				if (m_paramRefMode != ParamRefMode::Normal)
+				{
+					m_paramRefMode = ValidateParamRefModeFromJSON(m_paramRefMode, AvailableParamRefModesFor<T>(), name());
+				}
+			}
+			else
+			{
+				IProperty::readBinary(reader);
+			}
+		}
+
 		[[nodiscard]]
 		String propertyValueStringOfDefault() const override
 		{
@@ -880,6 +1152,22 @@ namespace noco
 		/*NonSerialized*/ Optional<T> m_paramRefOverride; // パラメータ参照による上書き
 		/*NonSerialized*/ Optional<T> m_currentFrameOverride;
 		/*NonSerialized*/ int32 m_currentFrameOverrideFrameCount = 0;
+		/*NonSerialized*/ mutable uint64 m_contentVersion = 0;
+		/*NonSerialized*/ mutable const T* m_contentVersionSource = nullptr;
+
+		void bumpContentVersion()
+		{
+			++m_contentVersion;
+		}
+
+		void setParamRefOverride(Optional<T>&& paramRefOverride)
+		{
+			if (m_paramRefOverride != paramRefOverride)
+			{
+				m_paramRefOverride = std::move(paramRefOverride);
+				bumpContentVersion();
+			}
+		}
 
 	public:
 		template <class U>
@@ -905,11 +1193,13 @@ namespace noco
 		void setValue(const U& value) requires std::convertible_to<U, T>
 		{
 			m_value = value;
+			bumpContentVersion();
 		}
 
 		void setValue(StringView value) requires std::same_as<T, String>
 		{
 			m_value = String{ value };
+			bumpContentVersion();
 		}
 
 		[[nodiscard]]
@@ -1014,13 +1304,42 @@ namespace noco
 
 		void setCurrentFrameOverride(const T& value)
 		{
-			m_currentFrameOverride = value;
+			if (!m_currentFrameOverride.has_value() || *m_currentFrameOverride != value)
+			{
+				m_currentFrameOverride = value;
+				bumpContentVersion();
+			}
 			m_currentFrameOverrideFrameCount = Scene::FrameCount();
 		}
 		
 		void clearCurrentFrameOverride() override
 		{
-			m_currentFrameOverride.reset();
+			if (m_currentFrameOverride.has_value())
+			{
+				m_currentFrameOverride.reset();
+				bumpContentVersion();
+			}
+		}
+
+		/// @brief 現在の値の内容バージョンを取得
+		/// @return 値が変化するたびに増加する値
+		/// @note 値の参照元(スタイルステート・パラメータ参照・現在フレームの上書き)が切り替わった場合も増加するため、キャッシュの更新判定に値の比較の代わりに使用できる
+		[[nodiscard]]
+		uint64 contentVersion() const
+		{
+			const T* source = &value();
+			if (source != m_contentVersionSource)
+			{
+				m_contentVersionSource = source;
+				++m_contentVersion;
+			}
+			return m_contentVersion;
+		}
+
+		[[nodiscard]]
+		uint64 currentValueVersion() const override
+		{
+			return contentVersion();
 		}
 		
 		[[nodiscard]]
@@ -1043,24 +1362,24 @@ namespace noco
 					{
 						if (auto resolved = ApplyParamRefMode<T>(m_value, it->second, m_paramRefMode))
 						{
-							m_paramRefOverride = std::move(*resolved);
+							setParamRefOverride(std::move(resolved));
 						}
 						else
 						{
 							// パラメータの型が合わない場合はクリア
-							m_paramRefOverride.reset();
+							setParamRefOverride(none);
 						}
 					}
 					else
 					{
 						// パラメータが見つからない場合はクリア
-						m_paramRefOverride.reset();
+						setParamRefOverride(none);
 					}
 				}
 				else
 				{
 					// パラメータ参照がない場合はクリア
-					m_paramRefOverride.reset();
+					setParamRefOverride(none);
 				}
 			}
 		}
@@ -1102,6 +1421,7 @@ namespace noco
 
 			// Propertyが後からPropertyNonInteractiveに変更される場合を考慮して、PropertyValue<T>::FromJSONを使う
 			m_value = PropertyValue<T>::FromJSON(json[m_name]).defaultValue();
+			bumpContentVersion();
 
 			const String paramRefKey = String(m_name) + U"_paramRef";
 			if (json.contains(paramRefKey))
@@ -1122,6 +1442,73 @@ namespace noco
 			}
 		}
 
+		void copySerializedFrom(const IProperty& other) override
+		{
+			const auto* otherProperty = dynamic_cast<const PropertyNonInteractive*>(&other);
+			if (otherProperty == nullptr)
+			{
+				IProperty::copySerializedFrom(other);
+				return;
+			}
+			m_value = otherProperty->m_value;
+			bumpContentVersion();
+			m_paramRef = otherProperty->m_paramRef;
+			m_paramRefMode = otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		bool hasSameSerializedContent(const IProperty& other) const override
+		{
+			const auto* otherProperty = dynamic_cast<const PropertyNonInteractive*>(&other);
+			if (otherProperty == nullptr)
+			{
+				return IProperty::hasSameSerializedContent(other);
+			}
+			return m_value == otherProperty->m_value
+				&& m_paramRef == otherProperty->m_paramRef
+				&& m_paramRefMode == otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		detail::BinaryValueKind binaryValueKind() const override
+		{
+			return detail::BinaryValueKindOf<T>();
+		}
+
+		void writeBinary(detail::BinaryCanvasWriter& writer) const override
+		{
+			if constexpr (detail::BinaryValueType<T>)
+			{
+				// Propertyが後からPropertyNonInteractiveに変更される場合を考慮して、PropertyValueとして書き込む
+				writer.writePropertyValue(PropertyValue<T>{ m_value });
+				writer.writeParamRef(m_paramRef, m_paramRefMode);
+			}
+			else
+			{
+				IProperty::writeBinary(writer);
+			}
+		}
+
+		void readBinary(detail::BinaryCanvasReader& reader) override
+		{
+			if constexpr (detail::BinaryValueType<T>)
+			{
+				PropertyValue<T> propertyValue{ T{} };
+				reader.readPropertyValue(propertyValue);
+				m_value = propertyValue.defaultValue();
+				bumpContentVersion();
+				reader.readParamRef(m_paramRef, m_paramRefMode);
+				if (m_paramRefMode != ParamRefMode::Normal)
+				{
+					m_paramRefMode = ValidateParamRefModeFromJSON(m_paramRefMode, AvailableParamRefModesFor<T>(), name());
+				}
+			}
+			else
+			{
+				IProperty::readBinary(reader);
+			}
+		}
+
 		[[nodiscard]]
 		String propertyValueStringOfDefault() const override
 		{
@@ -1159,6 +1546,7 @@ namespace noco
 			if (const auto valueOpt = StringToValueOpt<T>(value))
 			{
 				m_value = *valueOpt;
+				bumpContentVersion();
 				return true;
 			}
 			else
@@ -1394,7 +1782,8 @@ namespace noco
 			}
 			else
 			{
-				m_smoothing.update(targetColorF, m_propertyValue.smoothTime(), deltaTime);
+				// パラメータ参照がある場合はスムージング後の値を直後に使用するため、一括評価せず即座に評価する
+				m_smoothing.update(targetColorF, m_propertyValue.smoothTime(), deltaTime, m_paramRef.isEmpty() ? detail::s_activeSmoothingBatch : nullptr);
 			}
 
 			// パラメータ参照適用
@@ -1452,6 +1841,13 @@ namespace noco
 			m_currentFrameOverride = none;
 		}
 
+		[[nodiscard]]
+		uint64 currentValueVersion() const override
+		{
+			// 補間中は毎フレーム値が変化するため、内容バージョンではなく値のハッシュを使用
+			return detail::HashPropertyValue(value());
+		}
+
 		void appendJSON(JSON& json) const override
 		{
 			json[m_name] = m_propertyValue.toJSON();
@@ -1493,6 +1889,56 @@ namespace noco
 			}
 		}
 
+		void copySerializedFrom(const IProperty& other) override
+		{
+			const auto* otherProperty = dynamic_cast<const SmoothProperty*>(&other);
+			if (otherProperty == nullptr)
+			{
+				IProperty::copySerializedFrom(other);
+				return;
+			}
+			m_propertyValue = otherProperty->m_propertyValue;
+			m_smoothing = Smoothing<ColorF>{ ColorF{ m_propertyValue.value(InteractionState::Default, Array<String>{}) } };
+			m_paramRef = otherProperty->m_paramRef;
+			m_paramRefMode = otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		bool hasSameSerializedContent(const IProperty& other) const override
+		{
+			const auto* otherProperty = dynamic_cast<const SmoothProperty*>(&other);
+			if (otherProperty == nullptr)
+			{
+				return IProperty::hasSameSerializedContent(other);
+			}
+			return m_propertyValue == otherProperty->m_propertyValue
+				&& m_paramRef == otherProperty->m_paramRef
+				&& m_paramRefMode == otherProperty->m_paramRefMode;
+		}
+
+		[[nodiscard]]
+		detail::BinaryValueKind binaryValueKind() const override
+		{
+			return detail::BinaryValueKind::Color;
+		}
+
+		void writeBinary(detail::BinaryCanvasWriter& writer) const override
+		{
+			writer.writePropertyValue(m_propertyValue);
+			writer.writeParamRef(m_paramRef, m_paramRefMode);
+		}
+
+		void readBinary(detail::BinaryCanvasReader& reader) override
+		{
+			reader.readPropertyValue(m_propertyValue);
+			m_smoothing = Smoothing<ColorF>{ ColorF{ m_propertyValue.value(InteractionState::Default, Array<String>{}) } };
+			reader.readParamRef(m_paramRef, m_paramRefMode);
+			if (m_paramRefMode != ParamRefMode::Normal)
+			{
+				m_paramRefMode = ValidateParamRefModeFromJSON(m_paramRefMode, AvailableParamRefModesFor<Color>(), name());
+			}
+		}
+
 		String propertyValueStringOfDefault() const override
 		{
 			return m_propertyValue.getValueStringOfDefault();
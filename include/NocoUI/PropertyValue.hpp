@@ -19,6 +19,11 @@ struct std::hash<std::pair<s3d::String, noco::InteractionState>>
 
 namespace noco
 {
+	namespace detail
+	{
+		class BinaryCanvasReader;
+	}
+
 	template <class T>
 	struct PropertyStyleStateValue
 	{
@@ -37,6 +42,9 @@ namespace noco
 		PropertyStyleStateValue& operator=(const PropertyStyleStateValue&) = default;
 		PropertyStyleStateValue(PropertyStyleStateValue&&) noexcept = default;
 		PropertyStyleStateValue& operator=(PropertyStyleStateValue&&) noexcept = default;
+
+		[[nodiscard]]
+		bool operator==(const PropertyStyleStateValue& other) const = default;
 	};
 
 	template <class T>
@@ -75,6 +83,8 @@ namespace noco
 
 		std::unique_ptr<HashTable<String, PropertyStyleStateValue<T>>> m_styleStateValues;
 
+		friend class detail::BinaryCanvasReader;
+
 	public:
 
 		/*implicit*/ PropertyValue(const T& defaultVal)
@@ -169,6 +179,38 @@ namespace noco
 			return m_styleStateValues;
 		}
 
+		/// @brief デフォルト値・InteractionState毎の値・styleState毎の値をすべて列挙する
+		/// @param fun 各値を受け取る関数
+		template <class Fun>
+		void forEachValue(Fun&& fun) const
+		{
+			fun(m_defaultValue);
+			if (m_interactionValues)
+			{
+				for (const auto& value : { &m_interactionValues->hoveredValue, &m_interactionValues->pressedValue, &m_interactionValues->disabledValue })
+				{
+					if (*value)
+					{
+						fun(**value);
+					}
+				}
+			}
+			if (m_styleStateValues)
+			{
+				for (const auto& [styleState, styleStateValue] : *m_styleStateValues)
+				{
+					fun(styleStateValue.defaultValue);
+					for (const auto& value : { &styleStateValue.hoveredValue, &styleStateValue.pressedValue, &styleStateValue.disabledValue })
+					{
+						if (*value)
+						{
+							fun(**value);
+						}
+					}
+				}
+			}
+		}
+
 		[[nodiscard]]
 		const T& value(InteractionState interactionState, const Array<String>& activeStyleStates) const
 		{
@@ -252,6 +294,41 @@ namespace noco
 			return m_defaultValue;
 		}
 
+		/// @brief シリアライズされる内容(各値・スムージング時間)が等しいかどうかを取得
+		/// @note InteractionState毎の値・styleState毎の値は、保持していない場合と空の場合を区別しない
+		[[nodiscard]]
+		bool operator==(const PropertyValue& other) const
+		{
+			if (m_defaultValue != other.m_defaultValue
+				|| m_smoothTime != other.m_smoothTime
+				|| hoveredValue() != other.hoveredValue()
+				|| pressedValue() != other.pressedValue()
+				|| disabledValue() != other.disabledValue())
+			{
+				return false;
+			}
+
+			const size_t styleStateCount = m_styleStateValues ? m_styleStateValues->size() : 0;
+			const size_t otherStyleStateCount = other.m_styleStateValues ? other.m_styleStateValues->size() : 0;
+			if (styleStateCount != otherStyleStateCount)
+			{
+				return false;
+			}
+			if (styleStateCount == 0)
+			{
+				return true;
+			}
+			for (const auto& [styleState, styleStateValue] : *m_styleStateValues)
+			{
+				const auto it = other.m_styleStateValues->find(styleState);
+				if (it == other.m_styleStateValues->end() || !(it->second == styleStateValue))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
 		[[nodiscard]]
 		bool hasHovered() const noexcept
 		{
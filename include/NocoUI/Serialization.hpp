@@ -221,4 +221,43 @@ namespace noco
 			static_assert([] { return false; }(), "Unsupported type for FromArrayJSON");
 		}
 	}
+
+	namespace detail
+	{
+		/// @brief 既定の状態でシリアライズした内容と等しい値をJSONオブジェクトから取り除く
+		/// @param json 対象のJSONオブジェクト
+		/// @param defaultJSON 既定の状態でシリアライズしたJSONオブジェクト
+		/// @param keepKeys 値に関わらず残すキー
+		/// @note パラメータ参照を持つプロパティは、読み込み時に値のキーが存在しないとパラメータ参照も読まれないため残す
+		inline void EraseDefaultValuesFromJSON(JSON& json, const JSON& defaultJSON, std::initializer_list<StringView> keepKeys = {})
+		{
+			if (!json.isObject() || !defaultJSON.isObject())
+			{
+				return;
+			}
+
+			Array<String> keysToErase;
+			for (const auto& member : json)
+			{
+				const String& key = member.key;
+				if (std::find(keepKeys.begin(), keepKeys.end(), StringView{ key }) != keepKeys.end())
+				{
+					continue;
+				}
+				if (json.contains(key + U"_paramRef"))
+				{
+					continue;
+				}
+				if (defaultJSON.contains(key) && member.value == defaultJSON[key])
+				{
+					keysToErase.push_back(key);
+				}
+			}
+
+			for (const auto& key : keysToErase)
+			{
+				json.erase(key);
+			}
+		}
+	}
 }
@@ -15,6 +15,119 @@ namespace noco
 		{ T::SmoothDamp(t, t, t, 0.0) } -> std::convertible_to<T>;
 	};
 
+	namespace detail
+	{
+		/// @brief SmoothingBatchで一括評価する際の値の要素数(一括評価に対応しない型は0)
+		template <class T>
+		inline constexpr size_t SmoothingLaneCount = 0;
+
+		template <>
+		inline constexpr size_t SmoothingLaneCount<double> = 1;
+
+		template <>
+		inline constexpr size_t SmoothingLaneCount<Vec2> = 2;
+
+		template <>
+		inline constexpr size_t SmoothingLaneCount<ColorF> = 4;
+
+		/// @brief 値の要素の先頭アドレスを返す
+		template <class T>
+		[[nodiscard]]
+		double* SmoothingLanes(T& value) requires (SmoothingLaneCount<T> > 0)
+		{
+			static_assert(sizeof(T) == sizeof(double) * SmoothingLaneCount<T>);
+			if constexpr (std::same_as<T, double>)
+			{
+				return &value;
+			}
+			else if constexpr (std::same_as<T, Vec2>)
+			{
+				return &value.x;
+			}
+			else
+			{
+				return &value.r;
+			}
+		}
+
+		/// @brief 目標値との差と速度がこの値以下になったら目標値に到達したとみなす
+		inline constexpr double SmoothingSettleThreshold = 1e-4;
+
+		/// @brief 複数のSmoothingのSmoothDampを一括で評価するためのバッファ
+		/// @note 値・目標値・速度を要素数毎の連続した配列(SoA)に格納し、flush時にまとめて計算して書き戻す
+		class SmoothingBatch
+		{
+		private:
+			struct Lanes
+			{
+				Array<double> current; // 登録数×要素数
+				Array<double> target;
+				Array<double> velocity;
+				Array<double> omega; // 要素毎に展開した係数
+				Array<double> exp;
+				Array<double> deltaTime;
+				Array<double> result;
+				Array<double> resultVelocity;
+				Array<double*> currentOut; // 登録毎の書き戻し先
+				Array<double*> velocityOut;
+
+				void clear();
+			};
+
+			// 要素数1(スカラー)・2(Vec2)・4(ColorF)毎のバッファ
+			std::array<Lanes, 3> m_lanes;
+
+			template <size_t LaneCount>
+			void flushLanes(Lanes& lanes);
+
+		public:
+			/// @brief SmoothDampの評価を登録する
+			/// @param laneCount 値の要素数(1, 2, 4のいずれか)
+			/// @param current 現在値の書き戻し先
+			/// @param velocity 速度の書き戻し先
+			/// @param target 目標値
+			/// @param smoothTime 目標値に到達するまでのおおよその時間(秒)
+			/// @param deltaTime 経過時間(秒)
+			void add(size_t laneCount, double* current, double* velocity, const double* target, double smoothTime, double deltaTime);
+
+			/// @brief 登録済みのSmoothDampをまとめて評価し、結果を書き戻す
+			void flush();
+
+			/// @brief 登録済みで未評価の数を返す
+			[[nodiscard]]
+			size_t size() const;
+		};
+
+		/// @brief Smoothingが一括評価に使用するバッファ(nullptrの場合は即座に評価)
+		inline SmoothingBatch* s_activeSmoothingBatch = nullptr;
+
+		/// @brief スコープ内でSmoothingの評価をバッファへ登録し、スコープの終わりでまとめて評価する
+		class SmoothingBatchScope
+		{
+		private:
+			SmoothingBatch& m_batch;
+			SmoothingBatch* m_prevBatch;
+
+		public:
+			explicit SmoothingBatchScope(SmoothingBatch& batch)
+				: m_batch{ batch }
+				, m_prevBatch{ s_activeSmoothingBatch }
+			{
+				s_activeSmoothingBatch = &m_batch;
+			}
+
+			~SmoothingBatchScope()
+			{
+				m_batch.flush();
+				s_activeSmoothingBatch = m_prevBatch;
+			}
+
+			SmoothingBatchScope(const SmoothingBatchScope&) = delete;
+
+			SmoothingBatchScope& operator=(const SmoothingBatchScope&) = delete;
+		};
+	}
+
 	template <class T>
 	class Smoothing
 	{
@@ -24,6 +137,24 @@ namespace noco
 		/*NonSerialized*/ T m_currentValue;
 		/*NonSerialized*/ T m_velocity;
 
+		/// @brief 目標値との差と速度が十分小さい場合に目標値で確定させる
+		void settleIfClose(const T& targetValue) requires (detail::SmoothingLaneCount<T> > 0)
+		{
+			T target = targetValue;
+			const double* current = detail::SmoothingLanes(m_currentValue);
+			const double* velocity = detail::SmoothingLanes(m_velocity);
+			const double* targetLanes = detail::SmoothingLanes(target);
+			for (size_t i = 0; i < detail::SmoothingLaneCount<T>; ++i)
+			{
+				if (Abs(current[i] - targetLanes[i]) > detail::SmoothingSettleThreshold || Abs(velocity[i]) > detail::SmoothingSettleThreshold)
+				{
+					return;
+				}
+			}
+			m_currentValue = targetValue;
+			m_velocity = T{};
+		}
+
 	public:
 		explicit Smoothing(const T& initialValue, const T& initialVelocity = T{})
 			: m_currentValue{ initialValue }
@@ -31,13 +162,35 @@ namespace noco
 		{
 		}
 
-		void update(const T& targetValue, double smoothTime, double deltaTime)
+		/// @brief 現在値を目標値に近づける
+		/// @param targetValue 目標値
+		/// @param smoothTime 目標値に到達するまでのおおよその時間(秒)
+		/// @param deltaTime 経過時間(秒)
+		/// @param batch 一括評価に使用するバッファ(nullptrの場合は即座に評価。指定した場合、現在値はバッファのflush時に更新される)
+		void update(const T& targetValue, double smoothTime, double deltaTime, detail::SmoothingBatch* batch = nullptr)
 		{
 			if (smoothTime <= 0.0)
 			{
 				m_currentValue = targetValue;
 				return;
 			}
+
+			// 目標値に到達して静止している場合は計算不要
+			if (m_currentValue == targetValue && m_velocity == T{})
+			{
+				return;
+			}
+
+			if constexpr (detail::SmoothingLaneCount<T> > 0)
+			{
+				if (batch && deltaTime > 0.0)
+				{
+					T target = targetValue;
+					batch->add(detail::SmoothingLaneCount<T>, detail::SmoothingLanes(m_currentValue), detail::SmoothingLanes(m_velocity), detail::SmoothingLanes(target), smoothTime, deltaTime);
+					return;
+				}
+			}
+
 			if constexpr (HasSmoothDamp<T>)
 			{
 				m_currentValue = Math::SmoothDamp(m_currentValue, targetValue, m_velocity, smoothTime, unspecified, deltaTime);
@@ -46,6 +199,11 @@ namespace noco
 			{
 				m_currentValue = T::SmoothDamp(m_currentValue, targetValue, m_velocity, smoothTime, unspecified, deltaTime);
 			}
+
+			if constexpr (detail::SmoothingLaneCount<T> > 0)
+			{
+				settleIfClose(targetValue);
+			}
 		}
 
 		[[nodiscard]]
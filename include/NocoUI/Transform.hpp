@@ -76,11 +76,24 @@ namespace noco
 
 		void update(InteractionState interactionState, const Array<String>& activeStyleStates, double deltaTime, const HashTable<String, ParamValue>& params, SkipSmoothingYN skipSmoothing);
 
+		/// @param omitDefaultValues Yesの場合、既定の状態と等しいプロパティを書き込まない
 		[[nodiscard]]
-		JSON toJSON() const;
+		JSON toJSON(OmitDefaultValuesYN omitDefaultValues = OmitDefaultValuesYN::No) const;
 
 		void readFromJSON(const JSON& json);
 
+		/// @brief シリアライズ対象の内容(プロパティ値・パラメータ参照)を他のTransformからコピー
+		/// @param other コピー元
+		void copySerializedFrom(const Transform& other);
+
+		/// @brief シリアライズ対象の内容をバイナリ形式(.nocob)で書き込む
+		/// @param writer 書き込み先
+		void writeBinary(detail::BinaryCanvasWriter& writer) const;
+
+		/// @brief writeBinaryで書き込んだ内容を読み込む
+		/// @param reader 読み込み元
+		void readBinary(detail::BinaryCanvasReader& reader);
+
 		[[nodiscard]]
 		size_t countParamRefs(StringView paramName) const;
 
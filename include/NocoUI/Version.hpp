@@ -5,8 +5,12 @@ namespace noco
 {
 	constexpr StringView NocoUIVersion = U"0.4.3";
 
-	constexpr int32 CurrentSerializedVersion = 10;
+	constexpr int32 CurrentSerializedVersion = 11;
 
 	/// @brief Number型を廃止してInt/Double型を導入したserializedVersion
 	constexpr int32 SerializedVersion_IntDoubleParamType = 8;
+
+	/// @brief 既定値と等しいプロパティ・ノードの設定値の省略(OmitDefaultValuesYN::Yes)を導入したserializedVersion
+	/// @note これ以降のファイルでは値が存在しない場合に既定値を使用するため、既定値を変更する場合はserializedVersionを上げて互換性対応が必要
+	constexpr int32 SerializedVersion_OmitDefaultValues = 11;
 }
@@ -29,6 +29,8 @@ namespace noco
 	using SkipSmoothingYN = YesNo<struct SkipSmoothingYN_tag>;
 	using OnlyScrollableYN = YesNo<struct OnlyScrollableYN_tag>;
 	using IncludeSubCanvasYN = YesNo<struct IncludeSubCanvasYN_tag>;
+	using OmitDefaultValuesYN = YesNo<struct OmitDefaultValuesYN_tag>;
+	using AllowPlaceholderYN = YesNo<struct AllowPlaceholderYN_tag>;
 
 	namespace detail
 	{
@@ -0,0 +1,42 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+
+namespace noco::detail
+{
+	/// @brief 大きい順に並んだ候補のうち、収まる最初の候補の番号を返す
+	/// @param candidateCount 候補の数
+	/// @param fnFits 候補の番号を受け取り、収まるかどうかを返す関数
+	/// @return 収まる最初の候補の番号(収まる候補がない場合は最後の候補の番号)
+	/// @note 収まるかどうかはサイズに対して単調なため、二分探索でも大きい候補から順に試す場合と同じ結果になる
+	template <typename FitsFunc>
+	[[nodiscard]]
+	size_t FindFirstFittingCandidate(size_t candidateCount, FitsFunc&& fnFits)
+	{
+		if (candidateCount == 0)
+		{
+			return 0;
+		}
+
+		if (fnFits(0))
+		{
+			return 0;
+		}
+
+		// 最後の候補は収まらない場合も採用する
+		size_t low = 1;
+		size_t high = candidateCount - 1;
+		while (low < high)
+		{
+			const size_t mid = low + (high - low) / 2;
+			if (fnFits(mid))
+			{
+				high = mid;
+			}
+			else
+			{
+				low = mid + 1;
+			}
+		}
+		return low;
+	}
+}
@@ -0,0 +1,977 @@
+﻿#pragma once
+#include <Siv3D.hpp>
+#include <span>
+#include "../Serialization.hpp"
+#include "../LRTB.hpp"
+#include "../Param.hpp"
+#include "../PropertyValue.hpp"
+
+namespace noco::detail
+{
+	/// @brief バイナリ形式(.nocob)でのプロパティ値の種類
+	/// @note コンポーネントの型定義に記録し、読み込み時に型が変わったプロパティを読み飛ばすために使用する
+	enum class BinaryValueKind : uint8
+	{
+		JSON, // 組み込みで対応していない型(appendJSONの内容を汎用の値の木として書き込む)
+		Bool,
+		Int,
+		Double,
+		String,
+		Vec2,
+		Color,
+		LRTB,
+		Enum,
+	};
+
+	/// @brief バイナリ形式(.nocob)で値を直接読み書きできる型
+	template <class T>
+	concept BinaryValueType = std::is_arithmetic_v<T>
+		|| std::is_enum_v<T>
+		|| std::same_as<T, String>
+		|| std::same_as<T, Vec2>
+		|| std::same_as<T, Color>
+		|| std::same_as<T, LRTB>;
+
+	template <class T>
+	[[nodiscard]]
+	constexpr BinaryValueKind BinaryValueKindOf()
+	{
+		if constexpr (std::same_as<T, bool>)
+		{
+			return BinaryValueKind::Bool;
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			return BinaryValueKind::Enum;
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			return BinaryValueKind::Int;
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			return BinaryValueKind::Double;
+		}
+		else if constexpr (std::same_as<T, String>)
+		{
+			return BinaryValueKind::String;
+		}
+		else if constexpr (std::same_as<T, Vec2>)
+		{
+			return BinaryValueKind::Vec2;
+		}
+		else if constexpr (std::same_as<T, Color>)
+		{
+			return BinaryValueKind::Color;
+		}
+		else if constexpr (std::same_as<T, LRTB>)
+		{
+			return BinaryValueKind::LRTB;
+		}
+		else
+		{
+			return BinaryValueKind::JSON;
+		}
+	}
+
+	/// @brief PropertyValueの先頭に書き込む、省略可能な値の有無を表すフラグ
+	namespace BinaryPropertyValueFlags
+	{
+		constexpr uint8 HoveredValue = 1 << 0;
+		constexpr uint8 PressedValue = 1 << 1;
+		constexpr uint8 DisabledValue = 1 << 2;
+		constexpr uint8 SmoothTime = 1 << 3;
+		constexpr uint8 StyleStateValues = 1 << 4;
+	}
+
+	/// @brief 書き込み時のプロパティIDに対応する、読み込み先のコンポーネントのプロパティ
+	/// @note 型定義の読み込み後、コンポーネントの型毎に1回だけ解決する
+	struct BinaryPropertyBinding
+	{
+		/// @brief 読み込み先のプロパティのインデックス(ComponentBase::propertiesの添字)。プロパティが存在しないか値の種類が異なる場合はnone
+		Optional<size_t> propertyIndex;
+
+		/// @brief 書き込み時の値の種類(読み飛ばす場合に使用)
+		BinaryValueKind kind = BinaryValueKind::JSON;
+
+		/// @brief 列挙型の序数の変換表。書き込み時と列挙子が一致する場合はnone
+		Optional<Array<Optional<size_t>>> enumOrdinalMap;
+	};
+
+	/// @brief バイナリ形式(.nocob)の本体の書き込み
+	/// @note 文字列は文字列テーブルに登録し、本体にはインデックスのみを書き込む
+	class BinaryCanvasWriter
+	{
+	private:
+		Array<Byte> m_bytes;
+		Array<String> m_strings;
+		HashTable<String, uint32> m_stringIndices;
+
+		enum class JSONTag : uint8
+		{
+			Null = 0,
+			False,
+			True,
+			Integer,
+			Double,
+			String,
+			Array,
+			Object,
+		};
+
+		friend class BinaryCanvasReader;
+
+		[[nodiscard]]
+		uint32 stringIndex(const String& value)
+		{
+			auto [it, inserted] = m_stringIndices.try_emplace(value, static_cast<uint32>(m_strings.size()));
+			if (inserted)
+			{
+				m_strings.push_back(value);
+			}
+			return it->second;
+		}
+
+	public:
+		void writeByte(uint8 value)
+		{
+			m_bytes.push_back(static_cast<Byte>(value));
+		}
+
+		void writeVarUint(uint64 value)
+		{
+			while (value >= 0x80)
+			{
+				m_bytes.push_back(static_cast<Byte>((value & 0x7F) | 0x80));
+				value >>= 7;
+			}
+			m_bytes.push_back(static_cast<Byte>(value));
+		}
+
+		/// @brief 符号付き整数をzigzag符号化した可変長整数として書き込む
+		void writeVarInt(int64 value)
+		{
+			writeVarUint((static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63));
+		}
+
+		void writeDouble(double value)
+		{
+			const auto* bytes = reinterpret_cast<const Byte*>(&value);
+			m_bytes.insert(m_bytes.end(), bytes, bytes + sizeof(double));
+		}
+
+		/// @brief 文字列を文字列テーブルのインデックスとして書き込む
+		void writeString(const String& value)
+		{
+			writeVarUint(stringIndex(value));
+		}
+
+		/// @brief 値を型に応じた形式で書き込む
+		/// @note 列挙型は列挙子の序数で書き込む。列挙子として定義されていない値は読み込み時に既定値となる序数で書き込む
+		template <BinaryValueType T>
+		void writeValue(const T& value)
+		{
+			if constexpr (std::same_as<T, bool>)
+			{
+				writeByte(value ? 1 : 0);
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				writeVarUint(magic_enum::enum_index(value).value_or(magic_enum::enum_count<T>()));
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				writeVarInt(static_cast<int64>(value));
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				writeDouble(static_cast<double>(value));
+			}
+			else if constexpr (std::same_as<T, String>)
+			{
+				writeString(value);
+			}
+			else if constexpr (std::same_as<T, Vec2>)
+			{
+				writeDouble(value.x);
+				writeDouble(value.y);
+			}
+			else if constexpr (std::same_as<T, Color>)
+			{
+				writeByte(value.r);
+				writeByte(value.g);
+				writeByte(value.b);
+				writeByte(value.a);
+			}
+			else if constexpr (std::same_as<T, LRTB>)
+			{
+				writeDouble(value.left);
+				writeDouble(value.right);
+				writeDouble(value.top);
+				writeDouble(value.bottom);
+			}
+		}
+
+		template <BinaryValueType T>
+		void writeOptionalValue(const Optional<T>& value)
+		{
+			if (value)
+			{
+				writeValue(*value);
+			}
+		}
+
+		template <class T>
+		[[nodiscard]]
+		static uint8 OptionalValueFlags(const Optional<T>& hoveredValue, const Optional<T>& pressedValue, const Optional<T>& disabledValue)
+		{
+			return static_cast<uint8>((hoveredValue ? BinaryPropertyValueFlags::HoveredValue : 0)
+				| (pressedValue ? BinaryPropertyValueFlags::PressedValue : 0)
+				| (disabledValue ? BinaryPropertyValueFlags::DisabledValue : 0));
+		}
+
+		/// @brief PropertyValueを書き込む
+		/// @note 先頭のフラグで省略可能な値(InteractionState毎の値・スムージング時間・styleState毎の値)の有無を表し、存在するものだけを書き込む
+		template <BinaryValueType T>
+		void writePropertyValue(const PropertyValue<T>& propertyValue)
+		{
+			const auto& styleStateValues = propertyValue.styleStateValues();
+			const bool hasStyleStateValues = styleStateValues && !styleStateValues->empty();
+
+			uint8 flags = OptionalValueFlags(propertyValue.hoveredValue(), propertyValue.pressedValue(), propertyValue.disabledValue());
+			if (propertyValue.smoothTime() != 0.0)
+			{
+				flags |= BinaryPropertyValueFlags::SmoothTime;
+			}
+			if (hasStyleStateValues)
+			{
+				flags |= BinaryPropertyValueFlags::StyleStateValues;
+			}
+			writeByte(flags);
+
+			writeValue(propertyValue.defaultValue());
+			writeOptionalValue(propertyValue.hoveredValue());
+			writeOptionalValue(propertyValue.pressedValue());
+			writeOptionalValue(propertyValue.disabledValue());
+			if (flags & BinaryPropertyValueFlags::SmoothTime)
+			{
+				writeDouble(propertyValue.smoothTime());
+			}
+
+			if (hasStyleStateValues)
+			{
+				writeVarUint(styleStateValues->size());
+				for (const auto& [styleState, styleStateValue] : *styleStateValues)
+				{
+					writeString(styleState);
+
+					writeByte(OptionalValueFlags(styleStateValue.hoveredValue, styleStateValue.pressedValue, styleStateValue.disabledValue));
+
+					writeValue(styleStateValue.defaultValue);
+					writeOptionalValue(styleStateValue.hoveredValue);
+					writeOptionalValue(styleStateValue.pressedValue);
+					writeOptionalValue(styleStateValue.disabledValue);
+				}
+			}
+		}
+
+		/// @brief パラメータ参照を書き込む
+		/// @note 参照なしは0、参照ありは文字列テーブルのインデックス+1の後に参照モードの序数を書き込む
+		void writeParamRef(const String& paramRef, ParamRefMode paramRefMode)
+		{
+			if (paramRef.isEmpty())
+			{
+				writeVarUint(0);
+				return;
+			}
+			writeVarUint(static_cast<uint64>(stringIndex(paramRef)) + 1);
+			writeValue(paramRefMode);
+		}
+
+		/// @brief JSONを汎用の値の木(型タグ + 値)として書き込む
+		/// @note 組み込みで対応していない型のプロパティや、ファクトリに登録されていないコンポーネントに使用する
+		void writeJSON(const JSON& json)
+		{
+			if (json.isObject())
+			{
+				writeByte(static_cast<uint8>(JSONTag::Object));
+				writeVarUint(json.size());
+				for (const auto& member : json)
+				{
+					writeString(member.key);
+					writeJSON(member.value);
+				}
+			}
+			else if (json.isArray())
+			{
+				writeByte(static_cast<uint8>(JSONTag::Array));
+				writeVarUint(json.size());
+				for (const auto& element : json.arrayView())
+				{
+					writeJSON(element);
+				}
+			}
+			else if (json.isString())
+			{
+				writeByte(static_cast<uint8>(JSONTag::String));
+				writeString(json.getString());
+			}
+			else if (json.isBool())
+			{
+				writeByte(static_cast<uint8>(json.get<bool>() ? JSONTag::True : JSONTag::False));
+			}
+			else if (json.isInteger())
+			{
+				writeByte(static_cast<uint8>(JSONTag::Integer));
+				writeVarInt(json.get<int64>());
+			}
+			else if (json.isNumber())
+			{
+				writeByte(static_cast<uint8>(JSONTag::Double));
+				writeDouble(json.get<double>());
+			}
+			else
+			{
+				writeByte(static_cast<uint8>(JSONTag::Null));
+			}
+		}
+
+		[[nodiscard]]
+		size_t size() const
+		{
+			return m_bytes.size();
+		}
+
+		/// @brief 指定位置以降に書き込んだ内容を取得
+		[[nodiscard]]
+		std::span<const Byte> bytesFrom(size_t offset) const
+		{
+			return std::span<const Byte>{ m_bytes }.subspan(offset);
+		}
+
+		/// @brief 指定位置以降に書き込んだ内容を破棄
+		void truncate(size_t size)
+		{
+			m_bytes.resize(size);
+		}
+
+		/// @brief 別の書き込み先の内容を末尾に追加
+		/// @note 文字列テーブルを共有している(同じ書き込み先から書き出した)内容のみ追加できる
+		void append(std::span<const Byte> bytes)
+		{
+			m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
+		}
+
+		[[nodiscard]]
+		const Array<Byte>& bytes() const
+		{
+			return m_bytes;
+		}
+
+		[[nodiscard]]
+		const Array<String>& strings() const
+		{
+			return m_strings;
+		}
+	};
+
+	/// @brief バイナリ形式(.nocob)の本体の読み込み
+	/// @note 範囲外の読み込みなど不正なデータを検出した場合は失敗状態となり、以降の読み込みは既定値を返す。呼び出し側はレコードの区切りでfailedを確認する
+	class BinaryCanvasReader
+	{
+	private:
+		using JSONTag = BinaryCanvasWriter::JSONTag;
+
+		// 不正なデータによるスタックオーバーフローを防ぐための入れ子の深さの上限
+		static constexpr size_t MaxJSONDepth = 256;
+
+		std::span<const Byte> m_data;
+		size_t m_position = 0;
+		Array<String> m_strings;
+		const Array<Optional<size_t>>* m_enumOrdinalMap = nullptr;
+		bool m_failed = false;
+
+		static inline const String EmptyString{};
+
+		template <class T>
+		[[nodiscard]]
+		T readEnum(const Array<Optional<size_t>>* enumOrdinalMap)
+		{
+			constexpr size_t EnumCount = magic_enum::enum_count<T>();
+			size_t ordinal = static_cast<size_t>(readVarUint());
+			if (enumOrdinalMap)
+			{
+				ordinal = (ordinal < enumOrdinalMap->size()) ? (*enumOrdinalMap)[ordinal].value_or(EnumCount) : EnumCount;
+			}
+			// JSONで不明な列挙値を読み込んだ場合と同様に、範囲外の序数は既定値として扱う
+			return (ordinal < EnumCount) ? magic_enum::enum_value<T>(ordinal) : T{};
+		}
+
+		[[nodiscard]]
+		bool hasRemaining(size_t size) const
+		{
+			return !m_failed && m_data.size() - m_position >= size;
+		}
+
+		void readJSONImpl(JSON& json, size_t depth)
+		{
+			if (depth > MaxJSONDepth)
+			{
+				fail();
+				return;
+			}
+
+			switch (static_cast<JSONTag>(readByte()))
+			{
+			case JSONTag::Null:
+				json = JSON{ nullptr };
+				return;
+
+			case JSONTag::False:
+				json = false;
+				return;
+
+			case JSONTag::True:
+				json = true;
+				return;
+
+			case JSONTag::Integer:
+				json = readVarInt();
+				return;
+
+			case JSONTag::Double:
+				json = readDouble();
+				return;
+
+			case JSONTag::String:
+				json = readString();
+				return;
+
+			case JSONTag::Array:
+			{
+				const size_t count = readCount();
+				json = Array<JSON>{};
+				for (size_t i = 0; i < count && !m_failed; ++i)
+				{
+					JSON element;
+					readJSONImpl(element, depth + 1);
+					json.push_back(element);
+				}
+				return;
+			}
+
+			case JSONTag::Object:
+			{
+				const size_t count = readCount();
+				json = JSON{};
+				for (size_t i = 0; i < count && !m_failed; ++i)
+				{
+					const String& key = readString();
+					JSON value;
+					readJSONImpl(value, depth + 1);
+					json[key] = std::move(value);
+				}
+				return;
+			}
+
+			default:
+				fail();
+				return;
+			}
+		}
+
+	public:
+		explicit BinaryCanvasReader(std::span<const Byte> data)
+			: m_data{ data }
+		{
+		}
+
+		[[nodiscard]]
+		bool failed() const
+		{
+			return m_failed;
+		}
+
+		void fail()
+		{
+			m_failed = true;
+		}
+
+		[[nodiscard]]
+		bool isAtEnd() const
+		{
+			return !m_failed && m_position == m_data.size();
+		}
+
+		[[nodiscard]]
+		size_t position() const
+		{
+			return m_position;
+		}
+
+		/// @brief 指定バイト数の内容を読み込み、その範囲を返す
+		[[nodiscard]]
+		std::span<const Byte> readBytes(size_t size)
+		{
+			if (!hasRemaining(size))
+			{
+				fail();
+				return {};
+			}
+			const auto bytes = m_data.subspan(m_position, size);
+			m_position += size;
+			return bytes;
+		}
+
+		[[nodiscard]]
+		uint8 readByte()
+		{
+			if (!hasRemaining(1))
+			{
+				fail();
+				return 0;
+			}
+			return static_cast<uint8>(m_data[m_position++]);
+		}
+
+		[[nodiscard]]
+		uint64 readVarUint()
+		{
+			uint64 value = 0;
+			for (uint32 shift = 0; shift < 64; shift += 7)
+			{
+				const uint8 byte = readByte();
+				value |= static_cast<uint64>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return value;
+				}
+			}
+			fail();
+			return 0;
+		}
+
+		[[nodiscard]]
+		int64 readVarInt()
+		{
+			const uint64 value = readVarUint();
+			return static_cast<int64>(value >> 1) ^ -static_cast<int64>(value & 1);
+		}
+
+		[[nodiscard]]
+		double readDouble()
+		{
+			if (!hasRemaining(sizeof(double)))
+			{
+				fail();
+				return 0.0;
+			}
+			double value = 0.0;
+			std::memcpy(&value, m_data.data() + m_position, sizeof(double));
+			m_position += sizeof(double);
+			return value;
+		}
+
+		/// @brief 要素数を読み込む
+		/// @note 要素は最低1バイトを占めるため、残りのバイト数を超える要素数は不正として扱う
+		[[nodiscard]]
+		size_t readCount()
+		{
+			const uint64 count = readVarUint();
+			if (m_failed || count > m_data.size() - m_position)
+			{
+				fail();
+				return 0;
+			}
+			return static_cast<size_t>(count);
+		}
+
+		/// @brief 文字列テーブルを読み込む
+		void readStringTable()
+		{
+			const size_t count = readCount();
+			m_strings.clear();
+			m_strings.reserve(count);
+			for (size_t i = 0; i < count && !m_failed; ++i)
+			{
+				const auto bytes = readBytes(readCount());
+				m_strings.push_back(Unicode::FromUTF8(std::string_view{ reinterpret_cast<const char*>(bytes.data()), bytes.size() }));
+			}
+		}
+
+		/// @brief 文字列テーブルのインデックスを読み込み、対応する文字列を返す
+		[[nodiscard]]
+		const String& readString()
+		{
+			const uint64 index = readVarUint();
+			if (m_failed || index >= m_strings.size())
+			{
+				fail();
+				return EmptyString;
+			}
+			return m_strings[static_cast<size_t>(index)];
+		}
+
+		/// @brief 列挙型の値を読み込む際の、書き込み時の序数から現在の序数への変換表を設定
+		/// @param enumOrdinalMap 変換表。nullptrの場合は変換しない
+		/// @note 書き込み後に列挙子が追加・並べ替えられたコンポーネントのプロパティを正しく読み込むために使用する
+		void setEnumOrdinalMap(const Array<Optional<size_t>>* enumOrdinalMap)
+		{
+			m_enumOrdinalMap = enumOrdinalMap;
+		}
+
+		template <BinaryValueType T>
+		void readValue(T& value)
+		{
+			if constexpr (std::same_as<T, bool>)
+			{
+				value = readByte() != 0;
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				value = readEnum<T>(m_enumOrdinalMap);
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				value = static_cast<T>(readVarInt());
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				value = static_cast<T>(readDouble());
+			}
+			else if constexpr (std::same_as<T, String>)
+			{
+				value = readString();
+			}
+			else if constexpr (std::same_as<T, Vec2>)
+			{
+				value.x = readDouble();
+				value.y = readDouble();
+			}
+			else if constexpr (std::same_as<T, Color>)
+			{
+				value.r = readByte();
+				value.g = readByte();
+				value.b = readByte();
+				value.a = readByte();
+			}
+			else if constexpr (std::same_as<T, LRTB>)
+			{
+				value.left = readDouble();
+				value.right = readDouble();
+				value.top = readDouble();
+				value.bottom = readDouble();
+			}
+		}
+
+		template <BinaryValueType T>
+		[[nodiscard]]
+		Optional<T> readOptionalValue(bool exists)
+		{
+			if (!exists)
+			{
+				return none;
+			}
+			T value{};
+			readValue(value);
+			return value;
+		}
+
+		/// @brief BinaryCanvasWriter::writePropertyValueで書き込んだPropertyValueを読み込む
+		template <BinaryValueType T>
+		void readPropertyValue(PropertyValue<T>& propertyValue)
+		{
+			const uint8 flags = readByte();
+
+			T defaultValue{};
+			readValue(defaultValue);
+			const Optional<T> hoveredValue = readOptionalValue<T>(flags & BinaryPropertyValueFlags::HoveredValue);
+			const Optional<T> pressedValue = readOptionalValue<T>(flags & BinaryPropertyValueFlags::PressedValue);
+			const Optional<T> disabledValue = readOptionalValue<T>(flags & BinaryPropertyValueFlags::DisabledValue);
+			const double smoothTime = (flags & BinaryPropertyValueFlags::SmoothTime) ? readDouble() : 0.0;
+			propertyValue = PropertyValue<T>{ defaultValue, hoveredValue, pressedValue, disabledValue, smoothTime };
+
+			if (flags & BinaryPropertyValueFlags::StyleStateValues)
+			{
+				const size_t count = readCount();
+				propertyValue.m_styleStateValues = std::make_unique<HashTable<String, PropertyStyleStateValue<T>>>();
+				propertyValue.m_styleStateValues->reserve(count);
+				for (size_t i = 0; i < count && !m_failed; ++i)
+				{
+					const String& styleState = readString();
+					const uint8 styleStateFlags = readByte();
+
+					PropertyStyleStateValue<T> styleStateValue;
+					readValue(styleStateValue.defaultValue);
+					styleStateValue.hoveredValue = readOptionalValue<T>(styleStateFlags & BinaryPropertyValueFlags::HoveredValue);
+					styleStateValue.pressedValue = readOptionalValue<T>(styleStateFlags & BinaryPropertyValueFlags::PressedValue);
+					styleStateValue.disabledValue = readOptionalValue<T>(styleStateFlags & BinaryPropertyValueFlags::DisabledValue);
+					propertyValue.m_styleStateValues->insert_or_assign(styleState, std::move(styleStateValue));
+				}
+			}
+		}
+
+		/// @brief BinaryCanvasWriter::writeParamRefで書き込んだパラメータ参照を読み込む
+		void readParamRef(String& paramRef, ParamRefMode& paramRefMode)
+		{
+			const uint64 indexPlusOne = readVarUint();
+			if (indexPlusOne == 0)
+			{
+				paramRef.clear();
+				paramRefMode = ParamRefMode::Normal;
+				return;
+			}
+			if (m_failed || indexPlusOne > m_strings.size())
+			{
+				fail();
+				return;
+			}
+			paramRef = m_strings[static_cast<size_t>(indexPlusOne - 1)];
+			// 変換表はプロパティ値の列挙型用のため、参照モードには適用しない
+			paramRefMode = readEnum<ParamRefMode>(nullptr);
+		}
+
+		/// @brief BinaryCanvasWriter::writeJSONで書き込んだ汎用の値の木を読み込む
+		void readJSON(JSON& json)
+		{
+			readJSONImpl(json, 0);
+		}
+
+		/// @brief 指定した種類の値を読み込み、JSONでの表現(IProperty::appendJSONで書き込む値と同じ形式)に変換する
+		/// @param kind 値の種類
+		/// @param enumCandidates 列挙型の場合の、書き込み時の列挙子名
+		/// @note 列挙値は列挙子名に変換する。列挙子として定義されていない序数は空文字列(読み込み時に既定値となる)とする
+		[[nodiscard]]
+		JSON readValueJSON(BinaryValueKind kind, const Array<String>& enumCandidates)
+		{
+			switch (kind)
+			{
+			case BinaryValueKind::Bool:
+				return readByte() != 0;
+
+			case BinaryValueKind::Int:
+				return readVarInt();
+
+			case BinaryValueKind::Double:
+				return readDouble();
+
+			case BinaryValueKind::String:
+				return readString();
+
+			case BinaryValueKind::Vec2:
+			{
+				Vec2 value{};
+				readValue(value);
+				return ToArrayJSON(value);
+			}
+
+			case BinaryValueKind::Color:
+			{
+				Color value{};
+				readValue(value);
+				return ToArrayJSON(value);
+			}
+
+			case BinaryValueKind::LRTB:
+			{
+				LRTB value{};
+				readValue(value);
+				return value.toJSON();
+			}
+
+			case BinaryValueKind::Enum:
+			{
+				const uint64 ordinal = readVarUint();
+				return (ordinal < enumCandidates.size()) ? enumCandidates[static_cast<size_t>(ordinal)] : String{};
+			}
+
+			default:
+			{
+				JSON json;
+				readJSON(json);
+				return json;
+			}
+			}
+		}
+
+		/// @brief IProperty::writeBinaryで書き込んだプロパティの内容を読み込み、IProperty::appendJSONと同じ形式でJSONに追加する
+		/// @param json 追加先のJSON
+		/// @param name プロパティ名
+		/// @param kind 書き込み時の値の種類
+		/// @param enumCandidates 列挙型の場合の、書き込み時の列挙子名
+		/// @note プロパティを持つオブジェクトを生成せずに、型定義のみからJSONを復元するために使用する
+		void readPropertyJSON(JSON& json, const String& name, BinaryValueKind kind, const Array<String>& enumCandidates = {})
+		{
+			if (kind == BinaryValueKind::JSON)
+			{
+				JSON propertyJSON;
+				readJSON(propertyJSON);
+				if (!propertyJSON.isObject())
+				{
+					return;
+				}
+				for (const auto& member : propertyJSON)
+				{
+					json[member.key] = member.value;
+				}
+				return;
+			}
+
+			// PropertyValue::toJSONと同様に、省略可能な値がなければ値を直接、あればオブジェクトとして書き込む
+			const auto readInteractionValues = [this, kind, &enumCandidates](JSON& valueJSON, uint8 flags)
+				{
+					valueJSON[U"default"] = readValueJSON(kind, enumCandidates);
+					if (flags & BinaryPropertyValueFlags::HoveredValue)
+					{
+						valueJSON[U"hovered"] = readValueJSON(kind, enumCandidates);
+					}
+					if (flags & BinaryPropertyValueFlags::PressedValue)
+					{
+						valueJSON[U"pressed"] = readValueJSON(kind, enumCandidates);
+					}
+					if (flags & BinaryPropertyValueFlags::DisabledValue)
+					{
+						valueJSON[U"disabled"] = readValueJSON(kind, enumCandidates);
+					}
+				};
+
+			const uint8 flags = readByte();
+			if (flags == 0)
+			{
+				json[name] = readValueJSON(kind, enumCandidates);
+			}
+			else
+			{
+				JSON valueJSON;
+				readInteractionValues(valueJSON, flags);
+				if (flags & BinaryPropertyValueFlags::SmoothTime)
+				{
+					valueJSON[U"smoothTime"] = readDouble();
+				}
+				if (flags & BinaryPropertyValueFlags::StyleStateValues)
+				{
+					JSON styleStatesJSON;
+					const size_t count = readCount();
+					for (size_t i = 0; i < count && !m_failed; ++i)
+					{
+						const String& styleState = readString();
+						const uint8 styleStateFlags = readByte();
+						if (styleStateFlags == 0)
+						{
+							styleStatesJSON[styleState] = readValueJSON(kind, enumCandidates);
+						}
+						else
+						{
+							JSON styleStateJSON;
+							readInteractionValues(styleStateJSON, styleStateFlags);
+							styleStatesJSON[styleState] = styleStateJSON;
+						}
+					}
+					valueJSON[U"styleStates"] = styleStatesJSON;
+				}
+				json[name] = valueJSON;
+			}
+
+			String paramRef;
+			ParamRefMode paramRefMode = ParamRefMode::Normal;
+			readParamRef(paramRef, paramRefMode);
+			if (!paramRef.isEmpty())
+			{
+				json[name + U"_paramRef"] = paramRef;
+				if (paramRefMode != ParamRefMode::Normal)
+				{
+					json[name + U"_paramRefMode"] = EnumToString(paramRefMode);
+				}
+			}
+		}
+
+		/// @brief 指定した種類の値を読み飛ばす
+		void skipValue(BinaryValueKind kind)
+		{
+			switch (kind)
+			{
+			case BinaryValueKind::Bool:
+				(void)readByte();
+				return;
+
+			case BinaryValueKind::Int:
+			case BinaryValueKind::String:
+			case BinaryValueKind::Enum:
+				(void)readVarUint();
+				return;
+
+			case BinaryValueKind::Double:
+				(void)readBytes(sizeof(double));
+				return;
+
+			case BinaryValueKind::Vec2:
+				(void)readBytes(sizeof(double) * 2);
+				return;
+
+			case BinaryValueKind::Color:
+				(void)readBytes(4);
+				return;
+
+			case BinaryValueKind::LRTB:
+				(void)readBytes(sizeof(double) * 4);
+				return;
+
+			case BinaryValueKind::JSON:
+			{
+				JSON json;
+				readJSON(json);
+				return;
+			}
+
+			default:
+				fail();
+				return;
+			}
+		}
+
+		/// @brief IProperty::writeBinaryで書き込んだプロパティの内容を読み飛ばす
+		/// @note 書き込み後にプロパティの型が変わった場合や、プロパティが削除された場合に使用する
+		void skipProperty(BinaryValueKind kind)
+		{
+			if (kind == BinaryValueKind::JSON)
+			{
+				skipValue(kind);
+				return;
+			}
+
+			const auto skipOptionalValues = [this, kind](uint8 flags)
+				{
+					for (const uint8 flag : { BinaryPropertyValueFlags::HoveredValue, BinaryPropertyValueFlags::PressedValue, BinaryPropertyValueFlags::DisabledValue })
+					{
+						if (flags & flag)
+						{
+							skipValue(kind);
+						}
+					}
+				};
+
+			const uint8 flags = readByte();
+			skipValue(kind);
+			skipOptionalValues(flags);
+			if (flags & BinaryPropertyValueFlags::SmoothTime)
+			{
+				(void)readDouble();
+			}
+			if (flags & BinaryPropertyValueFlags::StyleStateValues)
+			{
+				const size_t count = readCount();
+				for (size_t i = 0; i < count && !m_failed; ++i)
+				{
+					(void)readString();
+					const uint8 styleStateFlags = readByte();
+					skipValue(kind);
+					skipOptionalValues(styleStateFlags);
+				}
+			}
+
+			String paramRef;
+			ParamRefMode paramRefMode = ParamRefMode::Normal;
+			readParamRef(paramRef, paramRefMode);
+		}
+	};
+}
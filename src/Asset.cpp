@@ -1,6 +1,15 @@
 ﻿#include "NocoUI/Asset.hpp"
+#include "NocoUI/AssetArchive.hpp"
+#include "NocoUI/BinaryCanvas.hpp"
+#include "NocoUI/CanvasPrototype.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace noco
 {
@@ -17,6 +26,447 @@ namespace noco
 			return BaseDirectoryPath();
 		}
 
+		uint64& AssetGeneration()
+		{
+			static uint64 generation = 0;
+			return generation;
+		}
+
+		/// @brief 非同期読み込み用のワーカースレッドプール
+		/// @note スレッドは最初のタスク追加時に生成する
+		class AssetLoadWorkerPool
+		{
+		private:
+			std::mutex m_mutex;
+			std::condition_variable m_taskCondition;
+			std::condition_variable m_idleCondition;
+			std::deque<std::function<void()>> m_tasks;
+			Array<std::thread> m_threads;
+			size_t m_workerCount;
+			size_t m_runningTaskCount = 0;
+			bool m_stopping = false;
+
+		public:
+			AssetLoadWorkerPool()
+				: m_workerCount{ Clamp<size_t>(std::thread::hardware_concurrency(), 2, 5) - 1 }
+			{
+			}
+
+			~AssetLoadWorkerPool()
+			{
+				// 終了時は未着手のタスクを破棄する
+				{
+					std::lock_guard lock{ m_mutex };
+					m_tasks.clear();
+				}
+				stop();
+			}
+
+			AssetLoadWorkerPool(const AssetLoadWorkerPool&) = delete;
+			AssetLoadWorkerPool& operator=(const AssetLoadWorkerPool&) = delete;
+
+			void enqueue(std::function<void()> task)
+			{
+				{
+					std::lock_guard lock{ m_mutex };
+					if (m_threads.empty())
+					{
+						for (size_t i = 0; i < m_workerCount; ++i)
+						{
+							m_threads.emplace_back([this] { workerLoop(); });
+						}
+					}
+					m_tasks.push_back(std::move(task));
+				}
+				m_taskCondition.notify_one();
+			}
+
+			void waitIdle()
+			{
+				std::unique_lock lock{ m_mutex };
+				m_idleCondition.wait(lock, [this] { return m_tasks.empty() && m_runningTaskCount == 0; });
+			}
+
+			void setWorkerCount(size_t workerCount)
+			{
+				stop();
+				m_workerCount = Max<size_t>(workerCount, 1);
+			}
+
+			size_t workerCount() const
+			{
+				return m_workerCount;
+			}
+
+		private:
+			void workerLoop()
+			{
+				while (true)
+				{
+					std::function<void()> task;
+					{
+						std::unique_lock lock{ m_mutex };
+						m_taskCondition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+						if (m_tasks.empty())
+						{
+							return;
+						}
+						task = std::move(m_tasks.front());
+						m_tasks.pop_front();
+						++m_runningTaskCount;
+					}
+
+					task();
+
+					{
+						std::lock_guard lock{ m_mutex };
+						--m_runningTaskCount;
+					}
+					m_idleCondition.notify_all();
+				}
+			}
+
+			/// @brief 積まれているタスクをすべて処理してからスレッドを終了する
+			void stop()
+			{
+				{
+					std::lock_guard lock{ m_mutex };
+					m_stopping = true;
+				}
+				m_taskCondition.notify_all();
+				for (auto& thread : m_threads)
+				{
+					thread.join();
+				}
+				m_threads.clear();
+				m_stopping = false;
+			}
+		};
+
+		AssetLoadWorkerPool& WorkerPool()
+		{
+			static AssetLoadWorkerPool pool;
+			return pool;
+		}
+
+		AssetArchive& MountedArchive()
+		{
+			static AssetArchive archive;
+			return archive;
+		}
+
+		/// @brief アセットの読み込み元
+		struct AssetSource
+		{
+			FilePath fullPath;
+
+			// マウント中のアーカイブに含まれる場合はその内容(メモリマップされた領域をコピーせず参照する)
+			std::span<const Byte> archiveData;
+			bool fromArchive = false;
+		};
+
+		/// @brief アセットの読み込み元を検索する
+		/// @return マウント中のアーカイブに含まれる場合はその内容、含まれずファイルが存在する場合はそのフルパス、どちらでもない場合はnone
+		/// @note アーカイブに含まれる場合はファイルシステムへの問い合わせを行わない
+		Optional<AssetSource> FindAssetSource(FilePathView filePath)
+		{
+			if (const auto archiveData = MountedArchive().find(filePath))
+			{
+				return AssetSource{ .fullPath = FilePath{}, .archiveData = *archiveData, .fromArchive = true };
+			}
+
+			FilePath fullPath = Asset::GetFullPath(filePath);
+			if (!FileSystem::IsFile(fullPath))
+			{
+				return none;
+			}
+			return AssetSource{ .fullPath = std::move(fullPath), .archiveData = {}, .fromArchive = false };
+		}
+
+		MemoryViewReader ArchiveReader(const AssetSource& source)
+		{
+			return MemoryViewReader{ source.archiveData.data(), source.archiveData.size() };
+		}
+
+		Image DecodeImage(const AssetSource& source)
+		{
+			return source.fromArchive ? Image{ ArchiveReader(source) } : Image{ source.fullPath };
+		}
+
+		Wave DecodeWave(const AssetSource& source)
+		{
+			return source.fromArchive ? Wave{ ArchiveReader(source) } : Wave{ source.fullPath };
+		}
+
+		/// @brief パース済みのJSONと読み込み元のバイト数
+		/// @note バイト数はメモリ使用量の推定値として使用する(JSONを再シリアライズして求めるのを避けるため)
+		struct ParsedJSON
+		{
+			JSON json;
+			size_t sourceByteSize = 0;
+		};
+
+		ParsedJSON ParseJSON(const AssetSource& source)
+		{
+			// SubCanvasの参照先などはバイナリ形式(.nocob)の場合もあるため、形式を自動判別する
+			if (source.fromArchive)
+			{
+				return ParsedJSON{ .json = BinaryCanvas::LoadJSON(source.archiveData), .sourceByteSize = source.archiveData.size() };
+			}
+			return ParsedJSON{ .json = BinaryCanvas::LoadJSON(source.fullPath), .sourceByteSize = static_cast<size_t>(FileSystem::FileSize(source.fullPath)) };
+		}
+
+		Texture LoadTexture(const Optional<AssetSource>& source)
+		{
+			if (!source)
+			{
+				return Texture{};
+			}
+			return source->fromArchive ? Texture{ ArchiveReader(*source) } : Texture{ source->fullPath };
+		}
+
+		Audio LoadAudio(const Optional<AssetSource>& source)
+		{
+			if (!source)
+			{
+				return Audio{};
+			}
+			return source->fromArchive ? Audio{ DecodeWave(*source) } : Audio{ source->fullPath };
+		}
+
+		/// @brief ワーカースレッドで読み込み中のアセット
+		/// @note decodedはcompletedがtrueになるまでワーカースレッドのみが書き込む
+		template <class Decoded>
+		struct PendingLoad
+		{
+			FilePath filePath;
+			AssetSource source;
+			Decoded decoded{};
+			std::atomic<bool> completed = false;
+		};
+
+		/// @brief 読み込み中のアセットを依頼順に保持するリスト
+		/// @note メインスレッドからのみ操作する
+		template <class Decoded>
+		class PendingLoadList
+		{
+		private:
+			HashTable<FilePath, std::shared_ptr<PendingLoad<Decoded>>> m_table;
+			Array<std::shared_ptr<PendingLoad<Decoded>>> m_order;
+
+		public:
+			bool contains(FilePathView filePath) const
+			{
+				return m_table.contains(filePath);
+			}
+
+			size_t size() const
+			{
+				return m_table.size();
+			}
+
+			/// @brief ワーカースレッドへ読み込みを依頼する
+			/// @param decode 読み込み元を受け取りDecodedを返す関数(ワーカースレッドで実行される)
+			void request(FilePathView filePath, AssetSource&& source, Decoded (*decode)(const AssetSource&))
+			{
+				auto load = std::make_shared<PendingLoad<Decoded>>();
+				load->filePath = filePath;
+				load->source = std::move(source);
+				m_table.emplace(filePath, load);
+				m_order.push_back(load);
+
+				// キャンセルされた場合もワーカースレッド側で解放されるよう、shared_ptrを値で保持する
+				WorkerPool().enqueue([load, decode]
+					{
+						load->decoded = decode(load->source);
+						load->completed.store(true, std::memory_order_release);
+					});
+			}
+
+			bool cancel(FilePathView filePath)
+			{
+				const auto it = m_table.find(filePath);
+				if (it == m_table.end())
+				{
+					return false;
+				}
+				m_order.remove(it->second);
+				m_table.erase(it);
+				return true;
+			}
+
+			void clear()
+			{
+				m_table.clear();
+				m_order.clear();
+			}
+
+			/// @brief 読み込みが完了したものを依頼順に登録する
+			/// @param registerAsset ファイルパスとデコード結果を受け取り登録する関数
+			/// @param canContinue 次の1件を処理してよいかを返す関数
+			/// @param processedCount 登録した件数の加算先
+			template <class RegisterFun, class CanContinueFun>
+			void processCompleted(RegisterFun&& registerAsset, CanContinueFun&& canContinue, size_t& processedCount)
+			{
+				for (auto it = m_order.begin(); it != m_order.end();)
+				{
+					if (!(*it)->completed.load(std::memory_order_acquire))
+					{
+						++it;
+						continue;
+					}
+					if (!canContinue())
+					{
+						break;
+					}
+					const std::shared_ptr<PendingLoad<Decoded>> load = *it;
+					it = m_order.erase(it);
+					m_table.erase(load->filePath);
+					registerAsset(load->filePath, std::move(load->decoded));
+					++processedCount;
+				}
+			}
+		};
+
+		struct AsyncLoadState
+		{
+			bool enabled = false;
+			Duration uploadTimeBudgetPerFrame{ 0.004 };
+			Texture placeholderTexture;
+			int32 lastProcessedFrameCount = -1;
+			PendingLoadList<Image> textures;
+			PendingLoadList<Wave> audios;
+			PendingLoadList<ParsedJSON> jsons;
+		};
+
+		AsyncLoadState& AsyncState()
+		{
+			static AsyncLoadState state;
+			return state;
+		}
+
+		struct MemoryBudgets
+		{
+			Optional<size_t> texture;
+			Optional<size_t> audio;
+			Optional<size_t> json;
+		};
+
+		MemoryBudgets& Budgets()
+		{
+			static MemoryBudgets budgets;
+			return budgets;
+		}
+
+		/// @brief ワンショット再生の終了まで保持しているオーディオ
+		struct RetainedOneShotAudio
+		{
+			std::shared_ptr<const Audio> audio;
+			uint64 endTimeMillisec = 0;
+		};
+
+		Array<RetainedOneShotAudio>& RetainedOneShotAudios()
+		{
+			static Array<RetainedOneShotAudio> audios;
+			return audios;
+		}
+
+		void ReleaseFinishedOneShotAudios()
+		{
+			const uint64 currentTimeMillisec = Time::GetMillisec();
+			RetainedOneShotAudios().remove_if([currentTimeMillisec](const RetainedOneShotAudio& retained) { return retained.endTimeMillisec <= currentTimeMillisec; });
+		}
+
+		struct CanvasPrototypeCacheEntry
+		{
+			// 元となったJSON。再読み込み・アンロード・退避された場合は失効するため、プロトタイプを作り直す判定に使う
+			std::weak_ptr<const JSON> sourceJSON;
+			std::shared_ptr<const CanvasPrototype> prototype;
+		};
+
+		HashTable<FilePath, CanvasPrototypeCacheEntry>& CanvasPrototypeCache()
+		{
+			static HashTable<FilePath, CanvasPrototypeCacheEntry> cache;
+			return cache;
+		}
+
+		void EraseExpiredCanvasPrototypes()
+		{
+			auto& cache = CanvasPrototypeCache();
+			for (auto it = cache.begin(); it != cache.end();)
+			{
+				if (it->second.sourceJSON.expired())
+				{
+					it = cache.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		template <class T>
+		void EvictToBudget(detail::AssetTable<T>& table, const Optional<size_t>& budgetBytes)
+		{
+			if (budgetBytes)
+			{
+				table.evictToBudget(*budgetBytes);
+			}
+		}
+
+		/// @brief 未依頼であれば非同期読み込みを依頼する
+		/// @return 読み込み中の場合はtrue、ファイルが存在しない場合はfalse
+		template <class Decoded>
+		bool RequestAsyncLoad(PendingLoadList<Decoded>& list, FilePathView filePath, Decoded (*decode)(const AssetSource&))
+		{
+			if (list.contains(filePath))
+			{
+				return true;
+			}
+			auto source = FindAssetSource(filePath);
+			if (!source)
+			{
+				return false;
+			}
+			list.request(filePath, std::move(*source), decode);
+			return true;
+		}
+
+		/// @brief 読み込みが完了したアセットを登録する
+		/// @param budget 時間の上限。noneの場合は上限なし
+		void ProcessCompletedLoads(const Optional<Duration>& budget)
+		{
+			auto& state = AsyncState();
+			const Stopwatch stopwatch{ StartImmediately::Yes };
+			size_t processedCount = 0;
+			// 進行を保証するため、最低1件は時間の上限に関わらず処理する
+			const auto canContinue = [&]
+			{
+				return !budget || processedCount == 0 || stopwatch.elapsed() < *budget;
+			};
+
+			// JSONは登録のみで軽量なため先に処理する
+			state.jsons.processCompleted(
+				[](const FilePath& filePath, ParsedJSON&& parsed) { detail::JSONAssetTable().registerAsset(filePath, std::move(parsed.json), parsed.sourceByteSize); },
+				[] { return true; },
+				processedCount);
+			state.textures.processCompleted(
+				[](const FilePath& filePath, Image&& image) { detail::TextureAssetTable().registerAsset(filePath, Texture{ image }); },
+				canContinue,
+				processedCount);
+			state.audios.processCompleted(
+				[](const FilePath& filePath, Wave&& wave) { detail::AudioAssetTable().registerAsset(filePath, Audio{ wave }); },
+				canContinue,
+				processedCount);
+
+			if (processedCount > 0)
+			{
+				// 代替テクスチャを保持している解決済みテクスチャのキャッシュを無効にする
+				detail::IncrementAssetGeneration();
+			}
+		}
+
 		/// @brief パスが絶対パスかどうかを判定
 		/// @param path 判定するパス
 		/// @return 絶対パスの場合true
@@ -49,6 +499,203 @@ namespace noco
 		}
 	}
 
+	size_t detail::EstimateAssetByteSize(const Texture& texture)
+	{
+		if (texture.isEmpty())
+		{
+			return 0;
+		}
+		const size_t baseByteSize = static_cast<size_t>(texture.width()) * texture.height() * texture.getFormat().pixelSize();
+		// ミップマップ全段の合計は元画像の約1/3となる
+		return texture.hasMipMap() ? baseByteSize * 4 / 3 : baseByteSize;
+	}
+
+	size_t detail::EstimateAssetByteSize(const Audio& audio)
+	{
+		if (audio.isEmpty())
+		{
+			return 0;
+		}
+		return audio.samples() * sizeof(WaveSample);
+	}
+
+	void detail::IncrementAssetGeneration()
+	{
+		++AssetGeneration();
+	}
+
+	uint64 Asset::Generation()
+	{
+		return AssetGeneration();
+	}
+
+	void Asset::InvalidateResolvedTextures()
+	{
+		detail::IncrementAssetGeneration();
+	}
+
+	void Asset::SetAsyncLoadingEnabled(bool enabled)
+	{
+		AsyncState().enabled = enabled;
+	}
+
+	bool Asset::IsAsyncLoadingEnabled()
+	{
+		return AsyncState().enabled;
+	}
+
+	void Asset::SetAsyncWorkerCount(size_t workerCount)
+	{
+		WorkerPool().setWorkerCount(workerCount);
+	}
+
+	size_t Asset::AsyncWorkerCount()
+	{
+		return WorkerPool().workerCount();
+	}
+
+	void Asset::SetUploadTimeBudgetPerFrame(const Duration& budget)
+	{
+		AsyncState().uploadTimeBudgetPerFrame = budget;
+	}
+
+	Duration Asset::UploadTimeBudgetPerFrame()
+	{
+		return AsyncState().uploadTimeBudgetPerFrame;
+	}
+
+	void Asset::SetPlaceholderTexture(const Texture& texture)
+	{
+		AsyncState().placeholderTexture = texture;
+		detail::IncrementAssetGeneration();
+	}
+
+	const Texture& Asset::PlaceholderTexture()
+	{
+		return AsyncState().placeholderTexture;
+	}
+
+	bool Asset::IsLoading(FilePathView filePath)
+	{
+		const auto& state = AsyncState();
+		return state.textures.contains(filePath)
+			|| state.audios.contains(filePath)
+			|| state.jsons.contains(filePath);
+	}
+
+	size_t Asset::PendingCount()
+	{
+		const auto& state = AsyncState();
+		return state.textures.size() + state.audios.size() + state.jsons.size();
+	}
+
+	void Asset::ProcessPendingLoads()
+	{
+		auto& state = AsyncState();
+		const int32 frameCount = Scene::FrameCount();
+		if (state.lastProcessedFrameCount == frameCount)
+		{
+			return;
+		}
+		state.lastProcessedFrameCount = frameCount;
+
+		if (PendingCount() > 0)
+		{
+			ProcessCompletedLoads(state.uploadTimeBudgetPerFrame);
+		}
+
+		// 前フレームまでに参照が外れたアセットを上限に応じて退避する
+		EnforceMemoryBudgets();
+	}
+
+	void Asset::SetTextureMemoryBudget(const Optional<size_t>& budgetBytes)
+	{
+		Budgets().texture = budgetBytes;
+		EvictToBudget(detail::TextureAssetTable(), budgetBytes);
+	}
+
+	const Optional<size_t>& Asset::TextureMemoryBudget()
+	{
+		return Budgets().texture;
+	}
+
+	void Asset::SetAudioMemoryBudget(const Optional<size_t>& budgetBytes)
+	{
+		Budgets().audio = budgetBytes;
+		ReleaseFinishedOneShotAudios();
+		EvictToBudget(detail::AudioAssetTable(), budgetBytes);
+	}
+
+	const Optional<size_t>& Asset::AudioMemoryBudget()
+	{
+		return Budgets().audio;
+	}
+
+	void Asset::SetJSONMemoryBudget(const Optional<size_t>& budgetBytes)
+	{
+		Budgets().json = budgetBytes;
+		EvictToBudget(detail::JSONAssetTable(), budgetBytes);
+	}
+
+	const Optional<size_t>& Asset::JSONMemoryBudget()
+	{
+		return Budgets().json;
+	}
+
+	void Asset::EnforceMemoryBudgets()
+	{
+		const auto& budgets = Budgets();
+		EvictToBudget(detail::TextureAssetTable(), budgets.texture);
+		ReleaseFinishedOneShotAudios();
+		EvictToBudget(detail::AudioAssetTable(), budgets.audio);
+		EvictToBudget(detail::JSONAssetTable(), budgets.json);
+		EraseExpiredCanvasPrototypes();
+	}
+
+	AssetMemoryUsage Asset::MemoryUsage()
+	{
+		const auto& textureTable = detail::TextureAssetTable();
+		const auto& audioTable = detail::AudioAssetTable();
+		const auto& jsonTable = detail::JSONAssetTable();
+		return AssetMemoryUsage{
+			.textureBytes = textureTable.totalByteSize(),
+			.audioBytes = audioTable.totalByteSize(),
+			.jsonBytes = jsonTable.totalByteSize(),
+			.textureCount = textureTable.size(),
+			.audioCount = audioTable.size(),
+			.jsonCount = jsonTable.size(),
+		};
+	}
+
+	void Asset::Preload(const AssetDependencies& dependencies)
+	{
+		auto& state = AsyncState();
+		for (const FilePath& filePath : dependencies.textureFilePaths())
+		{
+			if (!detail::TextureAssetTable().isRegistered(filePath))
+			{
+				RequestAsyncLoad(state.textures, filePath, DecodeImage);
+			}
+		}
+		for (const FilePath& filePath : dependencies.audioFilePaths())
+		{
+			if (!detail::AudioAssetTable().isRegistered(filePath))
+			{
+				RequestAsyncLoad(state.audios, filePath, DecodeWave);
+			}
+		}
+	}
+
+	void Asset::WaitForPendingLoads()
+	{
+		if (PendingCount() == 0)
+		{
+			return;
+		}
+		WorkerPool().waitIdle();
+		ProcessCompletedLoads(none);
+	}
+
 	const FilePath& Asset::GetBaseDirectoryPath()
 	{
 		return BaseDirectoryPathConst();
@@ -60,6 +707,7 @@ namespace noco
 		UnloadAllAudios();
 		UnloadAllJSONs();
 		BaseDirectoryPath() = baseDirectoryPath;
+		detail::IncrementAssetGeneration();
 	}
 
 	FilePath Asset::GetFullPath(FilePathView filePath)
@@ -69,7 +717,55 @@ namespace noco
 			: FileSystem::PathAppend(BaseDirectoryPathConst(), filePath);
 	}
 
-	const Texture& Asset::GetOrLoadTexture(FilePathView filePath)
+	bool Asset::MountArchive(FilePathView archivePath)
+	{
+		UnmountArchive();
+		if (!MountedArchive().open(archivePath))
+		{
+			return false;
+		}
+		// マウント前にファイルから読み込んだアセットがアーカイブの内容より優先されないよう破棄する
+		UnloadAllTextures();
+		UnloadAllAudios();
+		UnloadAllJSONs();
+		return true;
+	}
+
+	void Asset::UnmountArchive()
+	{
+		auto& archive = MountedArchive();
+		if (!archive.isOpen())
+		{
+			return;
+		}
+		// ワーカースレッドがメモリマップされた領域を参照している可能性があるため、完了を待ってから閉じる
+		UnloadAllTextures();
+		UnloadAllAudios();
+		UnloadAllJSONs();
+		WorkerPool().waitIdle();
+		archive.close();
+	}
+
+	bool Asset::IsArchiveMounted()
+	{
+		return MountedArchive().isOpen();
+	}
+
+	bool Asset::Exists(FilePathView filePath)
+	{
+		if (filePath.isEmpty())
+		{
+			return false;
+		}
+		return IsInArchive(filePath) || FileSystem::IsFile(GetFullPath(filePath));
+	}
+
+	bool Asset::IsInArchive(FilePathView filePath)
+	{
+		return MountedArchive().contains(filePath);
+	}
+
+	const Texture& Asset::GetOrLoadTexture(FilePathView filePath, AllowPlaceholderYN allowPlaceholder)
 	{
 		static const Texture EmptyTexture{};
 
@@ -81,25 +777,45 @@ namespace noco
 		auto& table = detail::TextureAssetTable();
 		if (!table.isRegistered(filePath))
 		{
-			const FilePath fullPath = GetFullPath(filePath);
-			if (!FileSystem::IsFile(fullPath))
+			// Preloadで依頼済みのものは非同期読み込みが無効でも完了を待つ
+			if (auto& state = AsyncState(); state.enabled || state.textures.contains(filePath))
+			{
+				// ファイル読み込みとデコードのみワーカースレッドで行い、テクスチャの生成はProcessPendingLoadsで行う
+				const bool loading = RequestAsyncLoad(state.textures, filePath, DecodeImage);
+				return (loading && allowPlaceholder) ? state.placeholderTexture : EmptyTexture;
+			}
+
+			const auto source = FindAssetSource(filePath);
+			if (!source)
 			{
 				return EmptyTexture;
 			}
-			table.registerAsset(filePath, Texture{ fullPath });
+			table.registerAsset(filePath, LoadTexture(source));
 		}
 
 		return table.get(filePath);
 	}
 
+	std::shared_ptr<const Texture> Asset::AcquireTexture(FilePathView filePath, AllowPlaceholderYN allowPlaceholder)
+	{
+		const Texture& texture = GetOrLoadTexture(filePath, allowPlaceholder);
+		if (const auto& table = detail::TextureAssetTable(); table.isRegistered(filePath))
+		{
+			return table.getShared(filePath);
+		}
+		// 非同期読み込み中の代替テクスチャはアセットテーブルの管理外のため複製して返す
+		return texture.isEmpty() ? nullptr : std::make_shared<const Texture>(texture);
+	}
+
 	const Texture& Asset::ReloadTexture(FilePathView filePath)
 	{
+		AsyncState().textures.cancel(filePath);
 		auto& table = detail::TextureAssetTable();
 		if (table.isRegistered(filePath))
 		{
 			table.unregister(filePath);
-			const FilePath fullPath = GetFullPath(filePath);
-			table.registerAsset(filePath, Texture{ fullPath });
+			detail::IncrementAssetGeneration();
+			table.registerAsset(filePath, LoadTexture(FindAssetSource(filePath)));
 			return table.get(filePath);
 		}
 		return Asset::GetOrLoadTexture(filePath);
@@ -107,18 +823,22 @@ namespace noco
 
 	bool Asset::UnloadTexture(FilePathView filePath)
 	{
+		const bool cancelled = AsyncState().textures.cancel(filePath);
 		auto& table = detail::TextureAssetTable();
 		if (table.isRegistered(filePath))
 		{
 			table.unregister(filePath);
+			detail::IncrementAssetGeneration();
 			return true;
 		}
-		return false;
+		return cancelled;
 	}
 
 	void Asset::UnloadAllTextures()
 	{
+		AsyncState().textures.clear();
 		detail::TextureAssetTable().clear();
+		detail::IncrementAssetGeneration();
 	}
 
 	const Audio& Asset::GetOrLoadAudio(FilePathView filePath)
@@ -133,24 +853,53 @@ namespace noco
 		auto& table = detail::AudioAssetTable();
 		if (!table.isRegistered(filePath))
 		{
-			const FilePath fullPath = GetFullPath(filePath);
-			if (!FileSystem::IsFile(fullPath))
+			if (auto& state = AsyncState(); state.enabled || state.audios.contains(filePath))
+			{
+				// ファイル読み込みとデコードのみワーカースレッドで行い、オーディオの生成はProcessPendingLoadsで行う
+				RequestAsyncLoad(state.audios, filePath, DecodeWave);
+				return EmptyAudio;
+			}
+
+			const auto source = FindAssetSource(filePath);
+			if (!source)
 			{
 				return EmptyAudio;
 			}
-			table.registerAsset(filePath, Audio{ fullPath });
+			table.registerAsset(filePath, LoadAudio(source));
 		}
 		return table.get(filePath);
 	}
 
+	std::shared_ptr<const Audio> Asset::AcquireAudio(FilePathView filePath)
+	{
+		const Audio& audio = GetOrLoadAudio(filePath);
+		if (const auto& table = detail::AudioAssetTable(); table.isRegistered(filePath))
+		{
+			return table.getShared(filePath);
+		}
+		return audio.isEmpty() ? nullptr : std::make_shared<const Audio>(audio);
+	}
+
+	void Asset::RetainAudioUntilOneShotEnds(const std::shared_ptr<const Audio>& audio)
+	{
+		if (!audio || audio->isEmpty())
+		{
+			return;
+		}
+		ReleaseFinishedOneShotAudios();
+		const uint64 lengthMillisec = static_cast<uint64>(std::ceil(audio->lengthSec() * 1000.0));
+		RetainedOneShotAudios().push_back(RetainedOneShotAudio{ .audio = audio, .endTimeMillisec = Time::GetMillisec() + lengthMillisec });
+	}
+
 	const Audio& Asset::ReloadAudio(FilePathView filePath)
 	{
+		AsyncState().audios.cancel(filePath);
 		auto& table = detail::AudioAssetTable();
 		if (table.isRegistered(filePath))
 		{
 			table.unregister(filePath);
-			const FilePath fullPath = GetFullPath(filePath);
-			table.registerAsset(filePath, Audio{ fullPath });
+			detail::IncrementAssetGeneration();
+			table.registerAsset(filePath, LoadAudio(FindAssetSource(filePath)));
 			return table.get(filePath);
 		}
 		return Asset::GetOrLoadAudio(filePath);
@@ -158,18 +907,22 @@ namespace noco
 
 	bool Asset::UnloadAudio(FilePathView filePath)
 	{
+		const bool cancelled = AsyncState().audios.cancel(filePath);
 		auto& table = detail::AudioAssetTable();
 		if (table.isRegistered(filePath))
 		{
 			table.unregister(filePath);
+			detail::IncrementAssetGeneration();
 			return true;
 		}
-		return false;
+		return cancelled;
 	}
 
 	void Asset::UnloadAllAudios()
 	{
+		AsyncState().audios.clear();
 		detail::AudioAssetTable().clear();
+		detail::IncrementAssetGeneration();
 	}
 
 	const JSON& Asset::GetOrLoadJSON(FilePathView filePath)
@@ -184,17 +937,42 @@ namespace noco
 		auto& table = detail::JSONAssetTable();
 		if (!table.isRegistered(filePath))
 		{
-			const FilePath fullPath = GetFullPath(filePath);
-			if (!FileSystem::IsFile(fullPath))
+			if (auto& state = AsyncState(); state.enabled)
 			{
+				// パースまでワーカースレッドで行う。パースに失敗した場合も再読み込みを繰り返さないよう無効なJSONのまま登録される
+				RequestAsyncLoad(state.jsons, filePath, ParseJSON);
 				return EmptyJSON;
 			}
-			const JSON json = JSON::Load(fullPath);
-			if (!json)
+		}
+
+		return detail::GetOrLoadJSONImmediately(filePath);
+	}
+
+	const JSON& detail::GetOrLoadJSONImmediately(FilePathView filePath)
+	{
+		static const JSON EmptyJSON{};
+
+		if (filePath.isEmpty())
+		{
+			return EmptyJSON;
+		}
+
+		auto& table = JSONAssetTable();
+		if (!table.isRegistered(filePath))
+		{
+			AsyncState().jsons.cancel(filePath);
+
+			const auto source = FindAssetSource(filePath);
+			if (!source)
+			{
+				return EmptyJSON;
+			}
+			ParsedJSON parsed = ParseJSON(*source);
+			if (!parsed.json)
 			{
 				return EmptyJSON;
 			}
-			table.registerAsset(filePath, json);
+			table.registerAsset(filePath, std::move(parsed.json), parsed.sourceByteSize);
 		}
 
 		return table.get(filePath);
@@ -202,13 +980,15 @@ namespace noco
 
 	const JSON& Asset::ReloadJSON(FilePathView filePath)
 	{
+		AsyncState().jsons.cancel(filePath);
 		auto& table = detail::JSONAssetTable();
 		if (table.isRegistered(filePath))
 		{
 			table.unregister(filePath);
-			const FilePath fullPath = GetFullPath(filePath);
-			const JSON json = JSON::Load(fullPath);
-			table.registerAsset(filePath, json);
+			detail::IncrementAssetGeneration();
+			const auto source = FindAssetSource(filePath);
+			ParsedJSON parsed = source ? ParseJSON(*source) : ParsedJSON{ .json = JSON::Invalid() };
+			table.registerAsset(filePath, std::move(parsed.json), parsed.sourceByteSize);
 			return table.get(filePath);
 		}
 		return Asset::GetOrLoadJSON(filePath);
@@ -216,17 +996,51 @@ namespace noco
 
 	bool Asset::UnloadJSON(FilePathView filePath)
 	{
+		const bool cancelled = AsyncState().jsons.cancel(filePath);
 		auto& table = detail::JSONAssetTable();
 		if (table.isRegistered(filePath))
 		{
 			table.unregister(filePath);
+			CanvasPrototypeCache().erase(FilePath{ filePath });
+			detail::IncrementAssetGeneration();
 			return true;
 		}
-		return false;
+		return cancelled;
 	}
 
 	void Asset::UnloadAllJSONs()
 	{
+		AsyncState().jsons.clear();
 		detail::JSONAssetTable().clear();
+		CanvasPrototypeCache().clear();
+		detail::IncrementAssetGeneration();
+	}
+
+	std::shared_ptr<const CanvasPrototype> Asset::GetOrLoadCanvasPrototype(FilePathView filePath)
+	{
+		const JSON& json = Asset::GetOrLoadJSON(filePath);
+		if (!json)
+		{
+			return nullptr;
+		}
+
+		// 非同期読み込み中は未登録のまま空のJSONが返される
+		auto& table = detail::JSONAssetTable();
+		if (!table.isRegistered(filePath))
+		{
+			return nullptr;
+		}
+		const std::shared_ptr<const JSON> sourceJSON = table.getShared(filePath);
+
+		auto& cache = CanvasPrototypeCache();
+		if (auto it = cache.find(filePath); it != cache.end() && it->second.sourceJSON.lock() == sourceJSON)
+		{
+			return it->second.prototype;
+		}
+
+		// Canvasとして不正な場合もnullptrをキャッシュし、同じJSONに対して構築を繰り返さない
+		std::shared_ptr<const CanvasPrototype> prototype = CanvasPrototype::CreateFromJSON(*sourceJSON);
+		cache.insert_or_assign(FilePath{ filePath }, CanvasPrototypeCacheEntry{ .sourceJSON = sourceJSON, .prototype = prototype });
+		return prototype;
 	}
 }
@@ -0,0 +1,198 @@
+﻿#include "NocoUI/AssetArchive.hpp"
+
+namespace noco
+{
+	namespace
+	{
+		constexpr std::array<char, 8> Magic{ 'N', 'O', 'C', 'O', 'P', 'A', 'C', 'K' };
+
+		// マジック + フォーマットバージョン + エントリ数
+		constexpr size_t HeaderSize = Magic.size() + sizeof(uint32) + sizeof(uint32);
+
+		// データ位置 + サイズ + パスのバイト数
+		constexpr size_t IndexEntryFixedSize = sizeof(uint64) + sizeof(uint64) + sizeof(uint32);
+
+		template <class T>
+		[[nodiscard]]
+		bool ReadValue(const Byte* data, size_t dataSize, size_t& position, T& value)
+		{
+			if (dataSize - position < sizeof(T))
+			{
+				return false;
+			}
+			std::memcpy(&value, data + position, sizeof(T));
+			position += sizeof(T);
+			return true;
+		}
+	}
+
+	AssetArchive::~AssetArchive()
+	{
+		close();
+	}
+
+	bool AssetArchive::open(FilePathView archivePath)
+	{
+		close();
+
+		if (!m_file.open(archivePath))
+		{
+			return false;
+		}
+
+		const auto mapped = m_file.map();
+		if (mapped.data == nullptr || mapped.size < HeaderSize || std::memcmp(mapped.data, Magic.data(), Magic.size()) != 0)
+		{
+			Logger << U"[NocoUI error] AssetArchive::open: Invalid archive file: {}"_fmt(archivePath);
+			m_file.close();
+			return false;
+		}
+
+		size_t position = Magic.size();
+		uint32 formatVersion = 0;
+		uint32 entryCount = 0;
+		(void)ReadValue(mapped.data, mapped.size, position, formatVersion);
+		(void)ReadValue(mapped.data, mapped.size, position, entryCount);
+		if (formatVersion != FormatVersion)
+		{
+			Logger << U"[NocoUI error] AssetArchive::open: Unsupported format version {} (expected {}): {}"_fmt(formatVersion, FormatVersion, archivePath);
+			m_file.close();
+			return false;
+		}
+
+		m_entries.reserve(entryCount);
+		for (uint32 i = 0; i < entryCount; ++i)
+		{
+			uint64 offset = 0;
+			uint64 size = 0;
+			uint32 pathByteLength = 0;
+			if (!ReadValue(mapped.data, mapped.size, position, offset)
+				|| !ReadValue(mapped.data, mapped.size, position, size)
+				|| !ReadValue(mapped.data, mapped.size, position, pathByteLength)
+				|| mapped.size - position < pathByteLength
+				|| offset > mapped.size
+				|| size > mapped.size - offset)
+			{
+				Logger << U"[NocoUI error] AssetArchive::open: Corrupted archive index: {}"_fmt(archivePath);
+				m_entries.clear();
+				m_file.close();
+				return false;
+			}
+
+			const std::string_view pathUTF8{ reinterpret_cast<const char*>(mapped.data + position), pathByteLength };
+			position += pathByteLength;
+			m_entries.emplace(Unicode::FromUTF8(pathUTF8), Entry{ .offset = static_cast<size_t>(offset), .size = static_cast<size_t>(size) });
+		}
+
+		m_data = mapped.data;
+		m_dataSize = mapped.size;
+		return true;
+	}
+
+	void AssetArchive::close()
+	{
+		if (m_data)
+		{
+			m_file.unmap();
+		}
+		m_file.close();
+		m_data = nullptr;
+		m_dataSize = 0;
+		m_entries.clear();
+	}
+
+	bool AssetArchive::contains(StringView path) const
+	{
+		return m_entries.contains(NormalizePath(path));
+	}
+
+	Optional<std::span<const Byte>> AssetArchive::find(StringView path) const
+	{
+		if (!m_data)
+		{
+			return none;
+		}
+
+		const auto it = m_entries.find(NormalizePath(path));
+		if (it == m_entries.end())
+		{
+			return none;
+		}
+		return std::span<const Byte>{ m_data + it->second.offset, it->second.size };
+	}
+
+	String AssetArchive::NormalizePath(StringView path)
+	{
+		String normalized = String{ path }.replaced(U'\\', U'/');
+		while (normalized.starts_with(U"./"))
+		{
+			normalized.erase(0, 2);
+		}
+		return normalized;
+	}
+
+	bool AssetArchive::Build(FilePathView sourceDirectoryPath, FilePathView archivePath)
+	{
+		if (!FileSystem::IsDirectory(sourceDirectoryPath))
+		{
+			Logger << U"[NocoUI error] AssetArchive::Build: Source directory not found: {}"_fmt(sourceDirectoryPath);
+			return false;
+		}
+
+		const FilePath archiveFullPath = FileSystem::FullPath(archivePath);
+		Array<std::pair<String, FilePath>> files;
+		for (const FilePath& path : FileSystem::DirectoryContents(sourceDirectoryPath, Recursive::Yes))
+		{
+			if (!FileSystem::IsFile(path) || FileSystem::FullPath(path) == archiveFullPath)
+			{
+				continue;
+			}
+			files.emplace_back(NormalizePath(FileSystem::RelativePath(path, sourceDirectoryPath)), path);
+		}
+		// 出力内容を環境に依らず一定にするためパス順に並べる
+		files.sort_by([](const auto& a, const auto& b) { return a.first < b.first; });
+
+		Array<std::string> pathsUTF8 = files.map([](const auto& file) { return file.first.toUTF8(); });
+		size_t dataOffset = HeaderSize;
+		for (const std::string& pathUTF8 : pathsUTF8)
+		{
+			dataOffset += IndexEntryFixedSize + pathUTF8.size();
+		}
+
+		const Array<size_t> fileSizes = files.map([](const auto& file) { return static_cast<size_t>(FileSystem::FileSize(file.second)); });
+
+		BinaryWriter writer{ archivePath };
+		if (!writer)
+		{
+			Logger << U"[NocoUI error] AssetArchive::Build: Failed to open output file: {}"_fmt(archivePath);
+			return false;
+		}
+
+		writer.write(Magic.data(), Magic.size());
+		writer.write(FormatVersion);
+		writer.write(static_cast<uint32>(files.size()));
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			writer.write(static_cast<uint64>(dataOffset));
+			writer.write(static_cast<uint64>(fileSizes[i]));
+			writer.write(static_cast<uint32>(pathsUTF8[i].size()));
+			writer.write(pathsUTF8[i].data(), pathsUTF8[i].size());
+			dataOffset += fileSizes[i];
+		}
+
+		// 巨大なディレクトリでもメモリを圧迫しないよう1ファイルずつ読み込んで書き込む
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			const Blob blob{ files[i].second };
+			if (blob.size() != fileSizes[i])
+			{
+				Logger << U"[NocoUI error] AssetArchive::Build: Failed to read file: {}"_fmt(files[i].second);
+				writer.close();
+				FileSystem::Remove(archivePath);
+				return false;
+			}
+			writer.write(blob.data(), blob.size());
+		}
+		return true;
+	}
+}
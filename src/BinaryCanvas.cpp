@@ -0,0 +1,1100 @@
+﻿#include "NocoUI/BinaryCanvas.hpp"
+#include "NocoUI/Canvas.hpp"
+#include "NocoUI/ComponentFactory.hpp"
+#include "NocoUI/ParamUtils.hpp"
+#include "NocoUI/Version.hpp"
+#include "NocoUI/detail/BinaryCanvasIO.hpp"
+
+namespace noco
+{
+	namespace
+	{
+		constexpr std::array<char, 8> Magic{ 'N', 'O', 'C', 'O', 'B', 'I', 'N', '\0' };
+
+		// 不正なデータによるスタックオーバーフローを防ぐためのノードの入れ子の深さの上限
+		constexpr size_t MaxNodeDepth = 256;
+
+		// 以下の種類の値・ParamValueの型の並び順はファイルに書き込まれるため、変更する場合はFormatVersionを上げる
+
+		enum class RegionType : uint8
+		{
+			InlineRegion = 0,
+			AnchorRegion,
+		};
+
+		enum class LayoutType : uint8
+		{
+			FlowLayout = 0,
+			HorizontalLayout,
+			VerticalLayout,
+		};
+
+		/// @brief ノードの真偽値の設定をまとめたフラグ
+		namespace NodeFlags
+		{
+			constexpr uint64 IsHitTarget = 1 << 0;
+			constexpr uint64 InheritChildrenHover = 1 << 1;
+			constexpr uint64 InheritChildrenPress = 1 << 2;
+			constexpr uint64 HorizontalScrollable = 1 << 3;
+			constexpr uint64 VerticalScrollable = 1 << 4;
+			constexpr uint64 WheelScrollEnabled = 1 << 5;
+			constexpr uint64 DragScrollEnabled = 1 << 6;
+			constexpr uint64 RubberBandScrollEnabled = 1 << 7;
+			constexpr uint64 ClippingEnabled = 1 << 8;
+		}
+
+		/// @brief Regionの最小・最大サイズの有無を表すフラグ
+		namespace SizeConstraintFlags
+		{
+			constexpr uint8 MinWidth = 1 << 0;
+			constexpr uint8 MinHeight = 1 << 1;
+			constexpr uint8 MaxWidth = 1 << 2;
+			constexpr uint8 MaxHeight = 1 << 3;
+		}
+
+		template <class TRegion>
+		void WriteSizeConstraints(detail::BinaryCanvasWriter& writer, const TRegion& region)
+		{
+			writer.writeByte(static_cast<uint8>((region.minWidth ? SizeConstraintFlags::MinWidth : 0)
+				| (region.minHeight ? SizeConstraintFlags::MinHeight : 0)
+				| (region.maxWidth ? SizeConstraintFlags::MaxWidth : 0)
+				| (region.maxHeight ? SizeConstraintFlags::MaxHeight : 0)));
+			writer.writeOptionalValue(region.minWidth);
+			writer.writeOptionalValue(region.minHeight);
+			writer.writeOptionalValue(region.maxWidth);
+			writer.writeOptionalValue(region.maxHeight);
+		}
+
+		template <class TRegion>
+		void ReadSizeConstraints(detail::BinaryCanvasReader& reader, TRegion& region)
+		{
+			const uint8 flags = reader.readByte();
+			region.minWidth = reader.readOptionalValue<double>(flags & SizeConstraintFlags::MinWidth);
+			region.minHeight = reader.readOptionalValue<double>(flags & SizeConstraintFlags::MinHeight);
+			region.maxWidth = reader.readOptionalValue<double>(flags & SizeConstraintFlags::MaxWidth);
+			region.maxHeight = reader.readOptionalValue<double>(flags & SizeConstraintFlags::MaxHeight);
+		}
+
+		void WriteRegion(detail::BinaryCanvasWriter& writer, const RegionVariant& region)
+		{
+			if (const auto* inlineRegion = std::get_if<InlineRegion>(&region))
+			{
+				writer.writeByte(static_cast<uint8>(RegionType::InlineRegion));
+				writer.writeValue(inlineRegion->sizeRatio);
+				writer.writeValue(inlineRegion->sizeDelta);
+				writer.writeValue(inlineRegion->flexibleWeight);
+				writer.writeValue(inlineRegion->margin);
+				WriteSizeConstraints(writer, *inlineRegion);
+			}
+			else if (const auto* anchorRegion = std::get_if<AnchorRegion>(&region))
+			{
+				writer.writeByte(static_cast<uint8>(RegionType::AnchorRegion));
+				writer.writeValue(anchorRegion->anchorMin);
+				writer.writeValue(anchorRegion->anchorMax);
+				writer.writeValue(anchorRegion->posDelta);
+				writer.writeValue(anchorRegion->sizeDelta);
+				writer.writeValue(anchorRegion->sizeDeltaPivot);
+				WriteSizeConstraints(writer, *anchorRegion);
+			}
+		}
+
+		[[nodiscard]]
+		RegionVariant ReadRegion(detail::BinaryCanvasReader& reader)
+		{
+			switch (static_cast<RegionType>(reader.readByte()))
+			{
+			case RegionType::InlineRegion:
+			{
+				InlineRegion region;
+				reader.readValue(region.sizeRatio);
+				reader.readValue(region.sizeDelta);
+				reader.readValue(region.flexibleWeight);
+				reader.readValue(region.margin);
+				ReadSizeConstraints(reader, region);
+				return region;
+			}
+
+			case RegionType::AnchorRegion:
+			{
+				AnchorRegion region;
+				reader.readValue(region.anchorMin);
+				reader.readValue(region.anchorMax);
+				reader.readValue(region.posDelta);
+				reader.readValue(region.sizeDelta);
+				reader.readValue(region.sizeDeltaPivot);
+				ReadSizeConstraints(reader, region);
+				return region;
+			}
+
+			default:
+				reader.fail();
+				return InlineRegion{};
+			}
+		}
+
+		void WriteLayout(detail::BinaryCanvasWriter& writer, const LayoutVariant& layout)
+		{
+			std::visit([&writer](const auto& childrenLayout)
+				{
+					using LayoutT = std::decay_t<decltype(childrenLayout)>;
+					if constexpr (std::same_as<LayoutT, FlowLayout>)
+					{
+						writer.writeByte(static_cast<uint8>(LayoutType::FlowLayout));
+					}
+					else if constexpr (std::same_as<LayoutT, HorizontalLayout>)
+					{
+						writer.writeByte(static_cast<uint8>(LayoutType::HorizontalLayout));
+					}
+					else
+					{
+						writer.writeByte(static_cast<uint8>(LayoutType::VerticalLayout));
+					}
+					writer.writeValue(childrenLayout.padding);
+					writer.writeValue(childrenLayout.spacing);
+					writer.writeValue(childrenLayout.horizontalAlign);
+					writer.writeValue(childrenLayout.verticalAlign);
+				}, layout);
+		}
+
+		template <class TLayout>
+		[[nodiscard]]
+		TLayout ReadLayoutFields(detail::BinaryCanvasReader& reader)
+		{
+			TLayout layout;
+			reader.readValue(layout.padding);
+			reader.readValue(layout.spacing);
+			reader.readValue(layout.horizontalAlign);
+			reader.readValue(layout.verticalAlign);
+			return layout;
+		}
+
+		[[nodiscard]]
+		LayoutVariant ReadLayout(detail::BinaryCanvasReader& reader)
+		{
+			switch (static_cast<LayoutType>(reader.readByte()))
+			{
+			case LayoutType::FlowLayout:
+				return ReadLayoutFields<FlowLayout>(reader);
+
+			case LayoutType::HorizontalLayout:
+				return ReadLayoutFields<HorizontalLayout>(reader);
+
+			case LayoutType::VerticalLayout:
+				return ReadLayoutFields<VerticalLayout>(reader);
+
+			default:
+				reader.fail();
+				return FlowLayout{};
+			}
+		}
+
+		void WriteParamValue(detail::BinaryCanvasWriter& writer, const ParamValue& value)
+		{
+			writer.writeByte(static_cast<uint8>(value.index()));
+			std::visit([&writer](const auto& v)
+				{
+					writer.writeValue(v);
+				}, value);
+		}
+
+		template <size_t Index = 0>
+		[[nodiscard]]
+		Optional<ParamValue> ReadParamValue(detail::BinaryCanvasReader& reader, size_t typeIndex)
+		{
+			if constexpr (Index < std::variant_size_v<ParamValue>)
+			{
+				if (typeIndex == Index)
+				{
+					std::variant_alternative_t<Index, ParamValue> value{};
+					reader.readValue(value);
+					return ParamValue{ std::in_place_index<Index>, std::move(value) };
+				}
+				return ReadParamValue<Index + 1>(reader, typeIndex);
+			}
+			else
+			{
+				reader.fail();
+				return none;
+			}
+		}
+
+		class CanvasEncoder
+		{
+		private:
+			/// @brief 書き込むコンポーネントの型定義
+			struct ComponentSchema
+			{
+				String type;
+
+				/// @brief ファクトリで生成した直後のコンポーネント(プロパティIDはこのコンポーネントのプロパティの並び順)
+				std::shared_ptr<SerializableComponentBase> defaultComponent;
+
+				/// @brief プロパティID毎の、既定値を書き込んだ内容
+				Array<Array<Byte>> defaultPayloads;
+			};
+
+			const ComponentFactory& m_factory;
+			detail::BinaryCanvasWriter m_writer;
+			Array<ComponentSchema> m_schemas;
+			HashTable<String, Optional<size_t>> m_schemaIndices;
+
+			[[nodiscard]]
+			Optional<size_t> schemaIndexOf(const SerializableComponentBase& component)
+			{
+				const String type = component.type();
+				auto it = m_schemaIndices.find(type);
+				if (it == m_schemaIndices.end())
+				{
+					it = m_schemaIndices.emplace(type, addSchema(type)).first;
+				}
+
+				// 型定義と異なるプロパティ構成のコンポーネント(不明なコンポーネントのハンドラで生成されるもの等)は型定義を使用しない
+				if (!it->second || !detail::HasSamePropertyLayout(*m_schemas[*it->second].defaultComponent, component))
+				{
+					return none;
+				}
+				return it->second;
+			}
+
+			[[nodiscard]]
+			Optional<size_t> addSchema(const String& type)
+			{
+				auto defaultComponent = m_factory.createComponent(type);
+				if (!defaultComponent || defaultComponent->type() != type)
+				{
+					return none;
+				}
+
+				// 既定値の内容は書き込み先の末尾に一時的に書き込んで取得する(文字列のインデックスを共有するため)
+				Array<Array<Byte>> defaultPayloads;
+				for (const IProperty* property : defaultComponent->properties())
+				{
+					const size_t start = m_writer.size();
+					property->writeBinary(m_writer);
+					const auto payload = m_writer.bytesFrom(start);
+					defaultPayloads.emplace_back(payload.begin(), payload.end());
+					m_writer.truncate(start);
+				}
+
+				m_schemas.push_back(ComponentSchema{ .type = type, .defaultComponent = std::move(defaultComponent), .defaultPayloads = std::move(defaultPayloads) });
+				return m_schemas.size() - 1;
+			}
+
+			void writeComponent(const SerializableComponentBase& component)
+			{
+				const Optional<size_t> schemaIndex = schemaIndexOf(component);
+				if (!schemaIndex)
+				{
+					m_writer.writeVarUint(0);
+					m_writer.writeJSON(component.toJSON());
+					return;
+				}
+
+				m_writer.writeVarUint(*schemaIndex + 1);
+				const ComponentSchema& schema = m_schemas[*schemaIndex];
+				const auto& properties = component.properties();
+				for (size_t propertyId = 0; propertyId < properties.size(); ++propertyId)
+				{
+					const size_t recordStart = m_writer.size();
+					m_writer.writeVarUint(propertyId + 1);
+					const size_t payloadStart = m_writer.size();
+					properties[propertyId]->writeBinary(m_writer);
+					if (std::ranges::equal(m_writer.bytesFrom(payloadStart), schema.defaultPayloads[propertyId]))
+					{
+						// 既定値と等しいプロパティは書き込まない
+						m_writer.truncate(recordStart);
+					}
+				}
+				m_writer.writeVarUint(0);
+			}
+
+			void writeNode(const Node& node)
+			{
+				m_writer.writeString(node.name());
+				WriteRegion(m_writer, node.region());
+				node.transform().writeBinary(m_writer);
+				WriteLayout(m_writer, node.childrenLayout());
+
+				uint64 flags = 0;
+				flags |= node.isHitTarget() ? NodeFlags::IsHitTarget : 0;
+				flags |= node.inheritChildrenHover() ? NodeFlags::InheritChildrenHover : 0;
+				flags |= node.inheritChildrenPress() ? NodeFlags::InheritChildrenPress : 0;
+				flags |= node.horizontalScrollable() ? NodeFlags::HorizontalScrollable : 0;
+				flags |= node.verticalScrollable() ? NodeFlags::VerticalScrollable : 0;
+				flags |= node.wheelScrollEnabled() ? NodeFlags::WheelScrollEnabled : 0;
+				flags |= node.dragScrollEnabled() ? NodeFlags::DragScrollEnabled : 0;
+				flags |= node.rubberBandScrollEnabled() ? NodeFlags::RubberBandScrollEnabled : 0;
+				flags |= node.clippingEnabled() ? NodeFlags::ClippingEnabled : 0;
+				m_writer.writeVarUint(flags);
+
+				m_writer.writeValue(node.hitPadding());
+				m_writer.writeValue(node.decelerationRate());
+				m_writer.writeValue(node.scrollBarType());
+				node.activeSelfProperty().writeBinary(m_writer);
+				node.interactableProperty().writeBinary(m_writer);
+				node.styleStateProperty().writeBinary(m_writer);
+				node.zOrderInSiblingsProperty().writeBinary(m_writer);
+
+				Array<const SerializableComponentBase*> components;
+				for (const auto& component : node.components())
+				{
+					if (const auto* serializableComponent = dynamic_cast<const SerializableComponentBase*>(component.get()))
+					{
+						components.push_back(serializableComponent);
+					}
+				}
+				m_writer.writeVarUint(components.size());
+				for (const SerializableComponentBase* component : components)
+				{
+					writeComponent(*component);
+				}
+
+				m_writer.writeVarUint(node.children().size());
+				for (const auto& child : node.children())
+				{
+					writeNode(*child);
+				}
+			}
+
+			void writeSchemas()
+			{
+				m_writer.writeVarUint(m_schemas.size());
+				for (const ComponentSchema& schema : m_schemas)
+				{
+					m_writer.writeString(schema.type);
+					const auto& properties = schema.defaultComponent->properties();
+					m_writer.writeVarUint(properties.size());
+					for (const IProperty* property : properties)
+					{
+						m_writer.writeString(String{ property->name() });
+						const detail::BinaryValueKind kind = property->binaryValueKind();
+						m_writer.writeByte(static_cast<uint8>(kind));
+						if (kind == detail::BinaryValueKind::Enum)
+						{
+							const Array<String> candidates = property->enumCandidates();
+							m_writer.writeVarUint(candidates.size());
+							for (const String& candidate : candidates)
+							{
+								m_writer.writeString(candidate);
+							}
+						}
+					}
+				}
+			}
+
+		public:
+			explicit CanvasEncoder(const ComponentFactory& factory)
+				: m_factory{ factory }
+			{
+			}
+
+			[[nodiscard]]
+			Blob encode(const Canvas& canvas)
+			{
+				// Canvas::CreateFromJSONと同じ順序で書き込む
+				m_writer.writeString(String{ NocoUIVersion });
+				m_writer.writeVarInt(CurrentSerializedVersion);
+				m_writer.writeValue(Vec2{ canvas.referenceSize() });
+				WriteLayout(m_writer, canvas.childrenLayout());
+
+				m_writer.writeVarUint(canvas.children().size());
+				for (const auto& child : canvas.children())
+				{
+					writeNode(*child);
+				}
+
+				m_writer.writeVarUint(canvas.params().size());
+				for (const auto& [name, value] : canvas.params())
+				{
+					m_writer.writeString(name);
+					WriteParamValue(m_writer, value);
+				}
+				m_writer.writeValue(canvas.autoFitMode());
+				m_writer.writeString(canvas.defaultFontAssetName());
+
+				// 型定義は本体の書き込み中に確定するため、本体の後に書き込んでからファイル上では本体の前に配置する
+				const size_t bodySize = m_writer.size();
+				writeSchemas();
+
+				Array<Byte> out;
+				const auto* magicBytes = reinterpret_cast<const Byte*>(Magic.data());
+				out.insert(out.end(), magicBytes, magicBytes + Magic.size());
+
+				const uint32 formatVersion = BinaryCanvas::FormatVersion;
+				const auto* versionBytes = reinterpret_cast<const Byte*>(&formatVersion);
+				out.insert(out.end(), versionBytes, versionBytes + sizeof(uint32));
+
+				detail::BinaryCanvasWriter stringTable;
+				stringTable.writeVarUint(m_writer.strings().size());
+				for (const String& str : m_writer.strings())
+				{
+					const std::string utf8 = Unicode::ToUTF8(str);
+					stringTable.writeVarUint(utf8.size());
+					stringTable.append(std::span<const Byte>{ reinterpret_cast<const Byte*>(utf8.data()), utf8.size() });
+				}
+				out.insert(out.end(), stringTable.bytes().begin(), stringTable.bytes().end());
+
+				const auto schemaBytes = m_writer.bytesFrom(bodySize);
+				out.insert(out.end(), schemaBytes.begin(), schemaBytes.end());
+				out.insert(out.end(), m_writer.bytes().begin(), m_writer.bytes().begin() + bodySize);
+				return Blob{ std::move(out) };
+			}
+		};
+
+		/// @brief バイナリ形式のデータの読み込みの共通部分(ヘッダ・コンポーネントの型定義・バージョン)
+		class BinaryCanvasDecoderBase
+		{
+		protected:
+			/// @brief 読み込んだコンポーネントの型定義
+			struct ComponentSchema
+			{
+				struct PropertySchema
+				{
+					String name;
+					detail::BinaryValueKind kind = detail::BinaryValueKind::JSON;
+					Array<String> enumCandidates;
+				};
+
+				String type;
+				Array<PropertySchema> properties;
+
+				/// @brief プロパティID毎の読み込み先(Canvasを生成する場合に、最初にこの型のコンポーネントを生成した時点で解決する)
+				Optional<Array<detail::BinaryPropertyBinding>> propertyBindings;
+			};
+
+			detail::BinaryCanvasReader m_reader;
+			Array<ComponentSchema> m_schemas;
+			StringView m_functionName;
+
+			BinaryCanvasDecoderBase(std::span<const Byte> data, StringView functionName)
+				: m_reader{ data }
+				, m_functionName{ functionName }
+			{
+			}
+
+			[[nodiscard]]
+			bool readHeader()
+			{
+				const auto header = m_reader.readBytes(Magic.size() + sizeof(uint32));
+				if (m_reader.failed() || !BinaryCanvas::IsBinary(header))
+				{
+					return false;
+				}
+
+				uint32 formatVersion = 0;
+				std::memcpy(&formatVersion, header.data() + Magic.size(), sizeof(uint32));
+				if (formatVersion != BinaryCanvas::FormatVersion)
+				{
+					Logger << U"[NocoUI error] {}: Unsupported format version {} (expected {}). Convert the .noco file again"_fmt(m_functionName, formatVersion, BinaryCanvas::FormatVersion);
+					return false;
+				}
+
+				m_reader.readStringTable();
+				return !m_reader.failed();
+			}
+
+			void readSchemas()
+			{
+				const size_t schemaCount = m_reader.readCount();
+				m_schemas.reserve(schemaCount);
+				for (size_t i = 0; i < schemaCount && !m_reader.failed(); ++i)
+				{
+					ComponentSchema& schema = m_schemas.emplace_back();
+					schema.type = m_reader.readString();
+
+					const size_t propertyCount = m_reader.readCount();
+					schema.properties.reserve(propertyCount);
+					for (size_t propertyId = 0; propertyId < propertyCount && !m_reader.failed(); ++propertyId)
+					{
+						auto& property = schema.properties.emplace_back();
+						property.name = m_reader.readString();
+
+						const uint8 kind = m_reader.readByte();
+						if (kind > static_cast<uint8>(detail::BinaryValueKind::Enum))
+						{
+							m_reader.fail();
+							return;
+						}
+						property.kind = static_cast<detail::BinaryValueKind>(kind);
+
+						if (property.kind == detail::BinaryValueKind::Enum)
+						{
+							const size_t candidateCount = m_reader.readCount();
+							property.enumCandidates.reserve(candidateCount);
+							for (size_t candidateIndex = 0; candidateIndex < candidateCount && !m_reader.failed(); ++candidateIndex)
+							{
+								property.enumCandidates.push_back(m_reader.readString());
+							}
+						}
+					}
+				}
+			}
+
+			/// @brief ヘッダ・型定義・本体の先頭のバージョンを読み込む
+			/// @return 書き込み時のNocoUIのバージョン。現在のバージョンで読み込めないデータの場合はnone
+			[[nodiscard]]
+			Optional<String> readPreamble()
+			{
+				if (!readHeader())
+				{
+					return none;
+				}
+				readSchemas();
+
+				const String version = m_reader.readString();
+				const int32 serializedVersion = static_cast<int32>(m_reader.readVarInt());
+				if (m_reader.failed())
+				{
+					return none;
+				}
+				if (serializedVersion != CurrentSerializedVersion)
+				{
+					// 既定値と等しいプロパティを省略しているため、既定値が異なる可能性のある他のバージョンのデータは読み込まない
+					Logger << U"[NocoUI error] {}: Data was converted with a different NocoUI version (version: {}, serializedVersion: {}). Current serializedVersion: {}. Convert the .noco file again"_fmt(
+						m_functionName, version, serializedVersion, CurrentSerializedVersion);
+					return none;
+				}
+				return version;
+			}
+		};
+
+		/// @brief バイナリ形式のデータからCanvasのJSONを復元する
+		/// @note ノード・コンポーネントを生成せず、型定義とプロパティIDの列からJSONを組み立てる。ファクトリやSubCanvasの参照先の読み込みを伴わないため、ワーカースレッドから呼び出せる
+		class BinaryCanvasJSONDecoder : private BinaryCanvasDecoderBase
+		{
+		private:
+			[[nodiscard]]
+			JSON readComponentJSON()
+			{
+				const uint64 schemaIndexPlusOne = m_reader.readVarUint();
+				if (schemaIndexPlusOne == 0)
+				{
+					// ファクトリに登録されていない型のコンポーネントはJSONとして書き込まれている
+					JSON json;
+					m_reader.readJSON(json);
+					return json;
+				}
+				if (schemaIndexPlusOne > m_schemas.size())
+				{
+					m_reader.fail();
+					return JSON{};
+				}
+
+				// 既定値と等しいプロパティは書き込まれていないため、JSONにも含めない(読み込み時に既定値となる)
+				const ComponentSchema& schema = m_schemas[static_cast<size_t>(schemaIndexPlusOne - 1)];
+				JSON json;
+				json[U"type"] = schema.type;
+				while (true)
+				{
+					const uint64 propertyIdPlusOne = m_reader.readVarUint();
+					if (propertyIdPlusOne == 0 || m_reader.failed())
+					{
+						break;
+					}
+					if (propertyIdPlusOne > schema.properties.size())
+					{
+						m_reader.fail();
+						break;
+					}
+					const auto& propertySchema = schema.properties[static_cast<size_t>(propertyIdPlusOne - 1)];
+					m_reader.readPropertyJSON(json, propertySchema.name, propertySchema.kind, propertySchema.enumCandidates);
+				}
+				return json;
+			}
+
+			[[nodiscard]]
+			JSON readNodeJSON(size_t depth)
+			{
+				if (depth > MaxNodeDepth)
+				{
+					m_reader.fail();
+					return JSON{};
+				}
+
+				// Node::toJSONと同じキーで書き込む
+				JSON json;
+				json[U"name"] = m_reader.readString();
+				json[U"region"] = std::visit([](const auto& region) { return region.toJSON(); }, ReadRegion(m_reader));
+				Transform transform;
+				transform.readBinary(m_reader);
+				json[U"transform"] = transform.toJSON();
+				json[U"childrenLayout"] = std::visit([](const auto& childrenLayout) { return childrenLayout.toJSON(); }, ReadLayout(m_reader));
+
+				const uint64 flags = m_reader.readVarUint();
+				json[U"isHitTarget"] = (flags & NodeFlags::IsHitTarget) != 0;
+				json[U"inheritChildrenHover"] = (flags & NodeFlags::InheritChildrenHover) != 0;
+				json[U"inheritChildrenPress"] = (flags & NodeFlags::InheritChildrenPress) != 0;
+				json[U"horizontalScrollable"] = (flags & NodeFlags::HorizontalScrollable) != 0;
+				json[U"verticalScrollable"] = (flags & NodeFlags::VerticalScrollable) != 0;
+				json[U"wheelScrollEnabled"] = (flags & NodeFlags::WheelScrollEnabled) != 0;
+				json[U"dragScrollEnabled"] = (flags & NodeFlags::DragScrollEnabled) != 0;
+				json[U"rubberBandScrollEnabled"] = (flags & NodeFlags::RubberBandScrollEnabled) != 0;
+				json[U"clippingEnabled"] = (flags & NodeFlags::ClippingEnabled) != 0;
+
+				LRTB hitPadding;
+				m_reader.readValue(hitPadding);
+				json[U"hitPadding"] = hitPadding.toJSON();
+				json[U"decelerationRate"] = m_reader.readDouble();
+				ScrollBarType scrollBarType{};
+				m_reader.readValue(scrollBarType);
+				json[U"scrollBarType"] = EnumToString(scrollBarType);
+
+				// Nodeのプロパティ(activeSelf・interactable・styleState・zOrderInSiblings)の型に対応する値の種類で読み込む
+				m_reader.readPropertyJSON(json, U"activeSelf", detail::BinaryValueKind::Bool);
+				m_reader.readPropertyJSON(json, U"interactable", detail::BinaryValueKind::Bool);
+				m_reader.readPropertyJSON(json, U"styleState", detail::BinaryValueKind::String);
+				m_reader.readPropertyJSON(json, U"zOrderInSiblings", detail::BinaryValueKind::Int);
+
+				Array<JSON> componentsJSON;
+				const size_t componentCount = m_reader.readCount();
+				for (size_t i = 0; i < componentCount && !m_reader.failed(); ++i)
+				{
+					componentsJSON.push_back(readComponentJSON());
+				}
+				json[U"components"] = componentsJSON;
+
+				Array<JSON> childrenJSON;
+				const size_t childCount = m_reader.readCount();
+				for (size_t i = 0; i < childCount && !m_reader.failed(); ++i)
+				{
+					childrenJSON.push_back(readNodeJSON(depth + 1));
+				}
+				json[U"children"] = childrenJSON;
+
+				return json;
+			}
+
+		public:
+			explicit BinaryCanvasJSONDecoder(std::span<const Byte> data)
+				: BinaryCanvasDecoderBase{ data, U"BinaryCanvas::Decode" }
+			{
+			}
+
+			[[nodiscard]]
+			JSON readCanvasJSON()
+			{
+				const Optional<String> version = readPreamble();
+				if (!version)
+				{
+					return JSON::Invalid();
+				}
+
+				// Canvas::toJSONと同じキーで書き込む
+				JSON json;
+				json[U"version"] = *version;
+				json[U"serializedVersion"] = CurrentSerializedVersion;
+
+				Vec2 referenceSize{};
+				m_reader.readValue(referenceSize);
+				json[U"referenceSize"] = ToArrayJSON(referenceSize);
+				json[U"childrenLayout"] = std::visit([](const auto& childrenLayout) { return childrenLayout.toJSON(); }, ReadLayout(m_reader));
+
+				Array<JSON> childrenJSON;
+				const size_t childCount = m_reader.readCount();
+				for (size_t i = 0; i < childCount && !m_reader.failed(); ++i)
+				{
+					childrenJSON.push_back(readNodeJSON(0));
+				}
+				json[U"children"] = childrenJSON;
+
+				JSON paramsJSON;
+				const size_t paramCount = m_reader.readCount();
+				for (size_t i = 0; i < paramCount && !m_reader.failed(); ++i)
+				{
+					const String& name = m_reader.readString();
+					const size_t typeIndex = m_reader.readByte();
+					const auto value = ReadParamValue(m_reader, typeIndex);
+					if (!value)
+					{
+						break;
+					}
+					if (!IsValidParameterName(name))
+					{
+						Logger << U"[NocoUI warning] Invalid parameter name '{}' found in binary canvas. Skipping."_fmt(name);
+						continue;
+					}
+					paramsJSON[name] = ParamValueToParamObjectJSON(*value);
+				}
+				if (paramCount > 0)
+				{
+					json[U"params"] = paramsJSON;
+				}
+
+				AutoFitMode autoFitMode{};
+				m_reader.readValue(autoFitMode);
+				if (autoFitMode != AutoFitMode::None)
+				{
+					json[U"autoFitMode"] = ValueToString(autoFitMode);
+				}
+				json[U"defaultFontAssetName"] = m_reader.readString();
+
+				if (!m_reader.isAtEnd())
+				{
+					return JSON::Invalid();
+				}
+				return json;
+			}
+		};
+	}
+
+	namespace detail
+	{
+		/// @brief バイナリ形式のデータからCanvasを直接生成する
+		/// @note CanvasのシリアライズされたメンバをCanvas::CreateFromJSONと同様に設定するため、Canvasのfriendとしている
+		class BinaryCanvasDecoder : private BinaryCanvasDecoderBase
+		{
+		private:
+			const ComponentFactory& m_factory;
+
+			/// @brief 型定義のプロパティをプロパティ名で現在のコンポーネントのプロパティと対応付ける
+			/// @note 値の種類が異なるプロパティは読み飛ばす。列挙子が異なる場合は列挙子名で序数を変換する
+			[[nodiscard]]
+			static Array<BinaryPropertyBinding> ResolvePropertyBindings(const ComponentSchema& schema, const SerializableComponentBase& component)
+			{
+				const auto& properties = component.properties();
+				Array<BinaryPropertyBinding> bindings;
+				bindings.reserve(schema.properties.size());
+				for (const auto& propertySchema : schema.properties)
+				{
+					BinaryPropertyBinding& binding = bindings.emplace_back();
+					binding.kind = propertySchema.kind;
+
+					const auto it = std::find_if(properties.begin(), properties.end(),
+						[&propertySchema](const IProperty* property) { return property->name() == propertySchema.name; });
+					if (it == properties.end() || (*it)->binaryValueKind() != propertySchema.kind)
+					{
+						continue;
+					}
+					binding.propertyIndex = static_cast<size_t>(it - properties.begin());
+
+					if (propertySchema.kind == BinaryValueKind::Enum)
+					{
+						const Array<String> candidates = (*it)->enumCandidates();
+						if (candidates != propertySchema.enumCandidates)
+						{
+							Array<Optional<size_t>> enumOrdinalMap;
+							enumOrdinalMap.reserve(propertySchema.enumCandidates.size());
+							for (const String& candidate : propertySchema.enumCandidates)
+							{
+								const auto candidateIt = std::find(candidates.begin(), candidates.end(), candidate);
+								enumOrdinalMap.push_back(candidateIt != candidates.end() ? Optional<size_t>{ static_cast<size_t>(candidateIt - candidates.begin()) } : none);
+							}
+							binding.enumOrdinalMap = std::move(enumOrdinalMap);
+						}
+					}
+				}
+				return bindings;
+			}
+
+			void skipComponentProperties(const ComponentSchema& schema)
+			{
+				while (true)
+				{
+					const uint64 propertyIdPlusOne = m_reader.readVarUint();
+					if (propertyIdPlusOne == 0 || m_reader.failed())
+					{
+						return;
+					}
+					if (propertyIdPlusOne > schema.properties.size())
+					{
+						m_reader.fail();
+						return;
+					}
+					m_reader.skipProperty(schema.properties[static_cast<size_t>(propertyIdPlusOne - 1)].kind);
+				}
+			}
+
+			void readComponent(Node& node)
+			{
+				const uint64 schemaIndexPlusOne = m_reader.readVarUint();
+				if (schemaIndexPlusOne == 0)
+				{
+					// ファクトリに登録されていない型のコンポーネントはJSONとして書き込まれている
+					JSON json;
+					m_reader.readJSON(json);
+					if (m_reader.failed())
+					{
+						return;
+					}
+					if (auto component = m_factory.createComponentFromJSON(json))
+					{
+						node.addComponent(component);
+					}
+					return;
+				}
+				if (schemaIndexPlusOne > m_schemas.size())
+				{
+					m_reader.fail();
+					return;
+				}
+
+				ComponentSchema& schema = m_schemas[static_cast<size_t>(schemaIndexPlusOne - 1)];
+				auto component = m_factory.createComponent(schema.type);
+				if (!component)
+				{
+					Logger << U"[NocoUI warning] Unknown component type: {}"_fmt(schema.type);
+					skipComponentProperties(schema);
+					return;
+				}
+				if (!schema.propertyBindings)
+				{
+					schema.propertyBindings = ResolvePropertyBindings(schema, *component);
+				}
+				component->readFromBinary(m_reader, *schema.propertyBindings);
+				if (!m_reader.failed())
+				{
+					node.addComponent(component);
+				}
+			}
+
+			[[nodiscard]]
+			std::shared_ptr<Node> readNode(size_t depth)
+			{
+				if (depth > MaxNodeDepth)
+				{
+					m_reader.fail();
+					return nullptr;
+				}
+
+				// Node::CreateFromJSONと同じ順序で設定する
+				const String& name = m_reader.readString();
+				auto node = Node::Create(name, ReadRegion(m_reader));
+				node->transform().readBinary(m_reader);
+				node->setChildrenLayout(ReadLayout(m_reader));
+
+				const uint64 flags = m_reader.readVarUint();
+				node->setIsHitTarget((flags & NodeFlags::IsHitTarget) != 0);
+				node->setInheritChildrenHover((flags & NodeFlags::InheritChildrenHover) != 0);
+				node->setInheritChildrenPress((flags & NodeFlags::InheritChildrenPress) != 0);
+				node->setHorizontalScrollable((flags & NodeFlags::HorizontalScrollable) != 0);
+				node->setVerticalScrollable((flags & NodeFlags::VerticalScrollable) != 0);
+				node->setWheelScrollEnabled((flags & NodeFlags::WheelScrollEnabled) != 0);
+				node->setDragScrollEnabled((flags & NodeFlags::DragScrollEnabled) != 0);
+				node->setRubberBandScrollEnabled((flags & NodeFlags::RubberBandScrollEnabled) != 0);
+				node->setClippingEnabled((flags & NodeFlags::ClippingEnabled) != 0);
+
+				LRTB hitPadding;
+				m_reader.readValue(hitPadding);
+				node->setHitPadding(hitPadding);
+				node->setDecelerationRate(m_reader.readDouble());
+				ScrollBarType scrollBarType{};
+				m_reader.readValue(scrollBarType);
+				node->setScrollBarType(scrollBarType);
+				node->activeSelfProperty().readBinary(m_reader);
+				node->interactableProperty().readBinary(m_reader);
+				node->styleStateProperty().readBinary(m_reader);
+				node->zOrderInSiblingsProperty().readBinary(m_reader);
+
+				const size_t componentCount = m_reader.readCount();
+				for (size_t i = 0; i < componentCount && !m_reader.failed(); ++i)
+				{
+					readComponent(*node);
+				}
+
+				const size_t childCount = m_reader.readCount();
+				for (size_t i = 0; i < childCount && !m_reader.failed(); ++i)
+				{
+					if (auto child = readNode(depth + 1))
+					{
+						node->addChild(child);
+					}
+				}
+
+				return m_reader.failed() ? nullptr : node;
+			}
+
+		public:
+			BinaryCanvasDecoder(std::span<const Byte> data, const ComponentFactory& factory)
+				: BinaryCanvasDecoderBase{ data, U"BinaryCanvas::Load" }
+				, m_factory{ factory }
+			{
+			}
+
+			[[nodiscard]]
+			std::shared_ptr<Canvas> readCanvas()
+			{
+				if (!readPreamble())
+				{
+					return nullptr;
+				}
+
+				std::shared_ptr<Canvas> canvas{ new Canvas{} };
+				canvas->m_serializedVersion = CurrentSerializedVersion;
+
+				Vec2 referenceSize{};
+				m_reader.readValue(referenceSize);
+				canvas->m_referenceSize = referenceSize;
+				canvas->m_size = referenceSize;  // 初期サイズとしても使用
+				canvas->m_childrenLayout = ReadLayout(m_reader);
+
+				const size_t childCount = m_reader.readCount();
+				for (size_t i = 0; i < childCount && !m_reader.failed(); ++i)
+				{
+					if (auto child = readNode(0))
+					{
+						canvas->addChild(child);
+					}
+				}
+
+				const size_t paramCount = m_reader.readCount();
+				for (size_t i = 0; i < paramCount && !m_reader.failed(); ++i)
+				{
+					const String& name = m_reader.readString();
+					const size_t typeIndex = m_reader.readByte();
+					auto value = ReadParamValue(m_reader, typeIndex);
+					if (!value)
+					{
+						break;
+					}
+					if (!IsValidParameterName(name))
+					{
+						Logger << U"[NocoUI warning] Invalid parameter name '{}' found in binary canvas. Skipping."_fmt(name);
+						continue;
+					}
+					canvas->m_params[name] = std::move(*value);
+				}
+
+				m_reader.readValue(canvas->m_autoFitMode);
+				canvas->m_defaultFontAssetName = m_reader.readString();
+
+				if (!m_reader.isAtEnd())
+				{
+					return nullptr;
+				}
+
+				canvas->markLayoutAsDirty();
+
+				return canvas;
+			}
+		};
+	}
+
+	bool BinaryCanvas::IsBinary(std::span<const Byte> data)
+	{
+		return data.size() >= Magic.size() && std::memcmp(data.data(), Magic.data(), Magic.size()) == 0;
+	}
+
+	bool BinaryCanvas::IsBinaryFile(FilePathView path)
+	{
+		BinaryReader reader{ path };
+		if (!reader)
+		{
+			return false;
+		}
+		std::array<Byte, Magic.size()> header{};
+		if (reader.read(header.data(), static_cast<int64>(header.size())) != static_cast<int64>(header.size()))
+		{
+			return false;
+		}
+		return IsBinary(header);
+	}
+
+	Blob BinaryCanvas::Encode(const Canvas& canvas)
+	{
+		return Encode(canvas, ComponentFactory::GetBuiltinFactory());
+	}
+
+	Blob BinaryCanvas::Encode(const Canvas& canvas, const ComponentFactory& factory)
+	{
+		CanvasEncoder encoder{ factory };
+		return encoder.encode(canvas);
+	}
+
+	Blob BinaryCanvas::Encode(const JSON& json)
+	{
+		return Encode(json, ComponentFactory::GetBuiltinFactory());
+	}
+
+	Blob BinaryCanvas::Encode(const JSON& json, const ComponentFactory& factory)
+	{
+		const auto canvas = Canvas::CreateFromJSON(json, factory);
+		if (!canvas)
+		{
+			return Blob{};
+		}
+		return Encode(*canvas, factory);
+	}
+
+	std::shared_ptr<Canvas> BinaryCanvas::Load(std::span<const Byte> data)
+	{
+		return Load(data, ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<Canvas> BinaryCanvas::Load(std::span<const Byte> data, const ComponentFactory& factory)
+	{
+		detail::BinaryCanvasDecoder decoder{ data, factory };
+		auto canvas = decoder.readCanvas();
+		if (!canvas)
+		{
+			Logger << U"[NocoUI error] BinaryCanvas::Load: Invalid binary canvas data";
+			return nullptr;
+		}
+		return canvas;
+	}
+
+	JSON BinaryCanvas::Decode(std::span<const Byte> data)
+	{
+		BinaryCanvasJSONDecoder decoder{ data };
+		const JSON json = decoder.readCanvasJSON();
+		if (!json)
+		{
+			Logger << U"[NocoUI error] BinaryCanvas::Decode: Invalid binary canvas data";
+		}
+		return json;
+	}
+
+	bool BinaryCanvas::Save(const JSON& json, FilePathView path)
+	{
+		if (!json)
+		{
+			return false;
+		}
+		const Blob blob = Encode(json);
+		if (blob.isEmpty())
+		{
+			return false;
+		}
+		return blob.save(path);
+	}
+
+	bool BinaryCanvas::ConvertFile(FilePathView sourcePath, FilePathView binaryPath)
+	{
+		const JSON json = JSON::Load(sourcePath);
+		if (!json)
+		{
+			Logger << U"[NocoUI error] BinaryCanvas::ConvertFile: Failed to load JSON: {}"_fmt(sourcePath);
+			return false;
+		}
+		if (!Save(json, binaryPath))
+		{
+			Logger << U"[NocoUI error] BinaryCanvas::ConvertFile: Failed to save: {}"_fmt(binaryPath);
+			return false;
+		}
+		return true;
+	}
+
+	JSON BinaryCanvas::LoadJSON(std::span<const Byte> data)
+	{
+		if (IsBinary(data))
+		{
+			return Decode(data);
+		}
+		return JSON::Load(MemoryViewReader{ data.data(), data.size() });
+	}
+
+	JSON BinaryCanvas::LoadJSON(FilePathView path, AllowExceptions allowExceptions)
+	{
+		if (!IsBinaryFile(path))
+		{
+			return JSON::Load(path, allowExceptions);
+		}
+
+		const Blob blob{ path };
+		JSON json = Decode(std::span<const Byte>{ blob.data(), blob.size() });
+		if (!json && allowExceptions)
+		{
+			throw Error{ U"BinaryCanvas::LoadJSON: Invalid binary canvas file: {}"_fmt(path) };
+		}
+		return json;
+	}
+}
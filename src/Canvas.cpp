@@ -1,11 +1,20 @@
 ﻿#include "NocoUI/Canvas.hpp"
+#include "NocoUI/Asset.hpp"
+#include "NocoUI/BinaryCanvas.hpp"
 #include "NocoUI/Init.hpp"
 #include "NocoUI/ComponentFactory.hpp"
 #include "NocoUI/ParamUtils.hpp"
 #include "NocoUI/Serialization.hpp"
 #include "NocoUI/Version.hpp"
 #include "NocoUI/Component/IFontCachedComponent.hpp"
+#include "NocoUI/Component/IAssetDependentComponent.hpp"
 #include "NocoUI/Component/SubCanvas.hpp"
+#include "NocoUI/Component/Sprite.hpp"
+#include "NocoUI/Component/TextureFontLabel.hpp"
+#include "NocoUI/Component/UISound.hpp"
+#include "NocoUI/Component/Tween.hpp"
+#include "NocoUI/Component/KeyframeAnimation.hpp"
+#include "NocoUI/detail/ScopedScissorRect.hpp"
 
 namespace noco
 {
@@ -25,7 +34,149 @@ namespace noco
 					return a->zOrderInSiblings() < b->zOrderInSiblings();
 				});
 		}
+
+		[[nodiscard]]
+		bool IsAxisAlignedQuad(const Quad& quad, const RectF& boundingRect)
+		{
+			// 回転や傾きがある場合は外接矩形より面積が小さくなる
+			constexpr double Epsilon = 1e-3;
+			return Math::Abs(boundingRect.area() - quad.area()) <= Epsilon * Max(1.0, boundingRect.area());
+		}
+
+		[[nodiscard]]
+		RectF IntersectRect(const RectF& a, const RectF& b)
+		{
+			const double left = Max(a.x, b.x);
+			const double top = Max(a.y, b.y);
+			const double right = Min(a.x + a.w, b.x + b.w);
+			const double bottom = Min(a.y + a.h, b.y + b.h);
+			return RectF{ left, top, Max(right - left, 0.0), Max(bottom - top, 0.0) };
+		}
+
+		// 事前ラスタライズを時間予算内で区切るための1チャンクあたりの文字数
+		constexpr size_t PrewarmGlyphsChunkSize = 16;
+
+		[[nodiscard]]
+		RectF UnionRect(const RectF& a, const RectF& b)
+		{
+			const double left = Min(a.x, b.x);
+			const double top = Min(a.y, b.y);
+			const double right = Max(a.x + a.w, b.x + b.w);
+			const double bottom = Max(a.y + a.h, b.y + b.h);
+			return RectF{ left, top, right - left, bottom - top };
+		}
+
+		using CollectAssetDependenciesFromJSONFunc = void (*)(const JSON&, const HashTable<String, ParamValue>&, AssetDependencies&);
+
+		/// @brief コンポーネントの種類名から、JSONからアセットファイルのパスを収集する関数を取得
+		/// @return アセットファイルを使用しない種類の場合はnullptr
+		[[nodiscard]]
+		CollectAssetDependenciesFromJSONFunc GetCollectAssetDependenciesFromJSONFunc(StringView type)
+		{
+			if (type == U"Sprite")
+			{
+				return &Sprite::CollectAssetDependenciesFromJSON;
+			}
+			if (type == U"TextureFontLabel")
+			{
+				return &TextureFontLabel::CollectAssetDependenciesFromJSON;
+			}
+			if (type == U"UISound")
+			{
+				return &UISound::CollectAssetDependenciesFromJSON;
+			}
+			if (type == U"SubCanvas")
+			{
+				return &SubCanvas::CollectAssetDependenciesFromJSON;
+			}
+			return nullptr;
+		}
+
+		/// @brief ノードのJSON(components・children)から、ノードを生成せずにアセットファイルのパスを収集する
+		void CollectAssetDependenciesFromNodeJSON(const JSON& nodeJSON, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies)
+		{
+			if (nodeJSON.contains(U"components") && nodeJSON[U"components"].isArray())
+			{
+				for (const auto& componentJSON : nodeJSON[U"components"].arrayView())
+				{
+					if (!componentJSON.contains(U"type"))
+					{
+						continue;
+					}
+					if (const auto fnCollect = GetCollectAssetDependenciesFromJSONFunc(componentJSON[U"type"].getOr<String>(U"")))
+					{
+						fnCollect(componentJSON, params, dependencies);
+					}
+				}
+			}
+			if (nodeJSON.contains(U"children") && nodeJSON[U"children"].isArray())
+			{
+				for (const auto& childJSON : nodeJSON[U"children"].arrayView())
+				{
+					CollectAssetDependenciesFromNodeJSON(childJSON, params, dependencies);
+				}
+			}
+		}
+
+		void CollectAssetDependenciesFromCanvasJSON(const JSON& canvasJSON, AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, int32 nestLevel);
+
+		/// @brief 収集済みのCanvasファイルのうち未走査のものを読み込み、ノードを生成せずに辿る
+		/// @param firstCanvasFilePathIndex 対象とするCanvasファイルのパスの開始位置
+		void CollectAssetDependenciesFromCanvasFiles(AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, size_t firstCanvasFilePathIndex, int32 nestLevel)
+		{
+			const size_t lastCanvasFilePathIndex = dependencies.canvasFilePaths().size();
+			for (size_t i = firstCanvasFilePathIndex; i < lastCanvasFilePathIndex; ++i)
+			{
+				// 再帰呼び出しで配列が再確保されるためコピーする
+				const FilePath canvasFilePath = dependencies.canvasFilePaths()[i];
+				if (visitedCanvasFilePaths.contains(canvasFilePath))
+				{
+					continue;
+				}
+				if (nestLevel >= SubCanvas::MaxNestLevel)
+				{
+					Logger << U"[NocoUI warning] Asset dependency collection skipped due to exceeding maximum nest level ({}): {}"_fmt(SubCanvas::MaxNestLevel, canvasFilePath);
+					continue;
+				}
+				visitedCanvasFilePaths.insert(canvasFilePath);
+
+				const JSON& json = detail::GetOrLoadJSONImmediately(canvasFilePath);
+				if (!json)
+				{
+					continue;
+				}
+				CollectAssetDependenciesFromCanvasJSON(json, dependencies, visitedCanvasFilePaths, nestLevel + 1);
+			}
+		}
+
+		/// @brief CanvasのJSONから、ノードを生成せずにアセットファイルのパスを収集する
+		void CollectAssetDependenciesFromCanvasJSON(const JSON& canvasJSON, AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, int32 nestLevel)
+		{
+			HashTable<String, ParamValue> params;
+			if (canvasJSON.contains(U"params") && canvasJSON[U"params"].isObject())
+			{
+				const int32 serializedVersion = canvasJSON.contains(U"serializedVersion") ? canvasJSON[U"serializedVersion"].getOr<int32>(CurrentSerializedVersion) : CurrentSerializedVersion;
+				for (const auto& member : canvasJSON[U"params"])
+				{
+					if (auto value = ParamValueFromParamObjectJSON(member.value, serializedVersion))
+					{
+						params.emplace(member.key, std::move(*value));
+					}
+				}
+			}
+
+			const size_t firstCanvasFilePathIndex = dependencies.canvasFilePaths().size();
+			if (canvasJSON.contains(U"children") && canvasJSON[U"children"].isArray())
+			{
+				for (const auto& childJSON : canvasJSON[U"children"].arrayView())
+				{
+					CollectAssetDependenciesFromNodeJSON(childJSON, params, dependencies);
+				}
+			}
+			CollectAssetDependenciesFromCanvasFiles(dependencies, visitedCanvasFilePaths, firstCanvasFilePathIndex, nestLevel);
+		}
 	}
+
 	void Canvas::EventRegistry::addEvent(const Event& event)
 	{
 		m_events.push_back(event);
@@ -432,7 +583,7 @@ namespace noco
 		return nullptr;
 	}
 	
-	JSON Canvas::toJSON(detail::WithInstanceIdYN withInstanceId) const
+	JSON Canvas::toJSON(detail::WithInstanceIdYN withInstanceId, OmitDefaultValuesYN omitDefaultValues) const
 	{
 		JSON json = JSON
 		{
@@ -452,7 +603,7 @@ namespace noco
 		Array<JSON> childrenArray;
 		for (const auto& child : m_children)
 		{
-			childrenArray.push_back(child->toJSON(withInstanceId));
+			childrenArray.push_back(child->toJSON(withInstanceId, omitDefaultValues));
 		}
 		json[U"children"] = childrenArray;
 
@@ -482,6 +633,11 @@ namespace noco
 	}
 	
 	std::shared_ptr<Canvas> Canvas::CreateFromJSON(const JSON& json, const ComponentFactory& componentFactory, detail::WithInstanceIdYN withInstanceId)
+	{
+		return CreateFromJSONImpl(json, componentFactory, withInstanceId, nullptr);
+	}
+
+	std::shared_ptr<Canvas> Canvas::CreateFromJSONImpl(const JSON& json, const ComponentFactory& componentFactory, detail::WithInstanceIdYN withInstanceId, const std::shared_ptr<const JSON>& sharedJSON)
 	{
 		if (!json.contains(U"version"))
 		{
@@ -545,12 +701,15 @@ namespace noco
 			}
 		}
 		
+		size_t childIndex = 0;
 		for (const auto& childJson : json[U"children"].arrayView())
 		{
-			if (auto child = Node::CreateFromJSON(childJson, componentFactory, withInstanceId))
+			const Optional<detail::SharedJSONLocation> childLocation = sharedJSON ? Optional<detail::SharedJSONLocation>{ detail::SharedJSONLocation{ .source = sharedJSON, .childIndexPath = { childIndex } } } : none;
+			if (auto child = Node::CreateFromJSONImpl(childJson, componentFactory, withInstanceId, childLocation ? &*childLocation : nullptr))
 			{
 				canvas->addChild(child);
 			}
+			++childIndex;
 		}
 
 		if (json.contains(U"params"))
@@ -594,24 +753,58 @@ namespace noco
 
 	std::shared_ptr<Canvas> Canvas::LoadFromFile(FilePathView path, AllowExceptions allowExceptions)
 	{
-		const JSON json = JSON::Load(path, allowExceptions);
-		if (!json)
-		{
-			return nullptr;
-		}
-		return Canvas::CreateFromJSON(json);
+		return LoadFromFile(path, ComponentFactory::GetBuiltinFactory(), allowExceptions);
 	}
 
 	std::shared_ptr<Canvas> Canvas::LoadFromFile(FilePathView path, const ComponentFactory& componentFactory, AllowExceptions allowExceptions)
 	{
-		const JSON json = JSON::Load(path, allowExceptions);
-		if (!json)
+		if (BinaryCanvas::IsBinaryFile(path))
+		{
+			// バイナリ形式はJSONを経由せずに直接生成する
+			const Blob blob{ path };
+			auto canvas = BinaryCanvas::Load(std::span<const Byte>{ blob.data(), blob.size() }, componentFactory);
+			if (!canvas && allowExceptions)
+			{
+				throw Error{ U"Canvas::LoadFromFile: Invalid binary canvas file: {}"_fmt(path) };
+			}
+			return canvas;
+		}
+
+		// 生成を遅延するノードが読み込んだJSONを複製せずに参照できるよう、共有して保持する
+		const auto json = std::make_shared<const JSON>(JSON::Load(path, allowExceptions));
+		if (!*json)
 		{
 			return nullptr;
 		}
-		return Canvas::CreateFromJSON(json, componentFactory);
+		return CreateFromJSONImpl(*json, componentFactory, detail::WithInstanceIdYN::No, json);
 	}
 	
+	std::shared_ptr<Canvas> Canvas::clone() const
+	{
+		return clone(ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<Canvas> Canvas::clone(const ComponentFactory& componentFactory) const
+	{
+		std::shared_ptr<Canvas> canvas{ new Canvas{} };
+		canvas->m_serializedVersion = m_serializedVersion;
+		canvas->m_referenceSize = m_referenceSize;
+		canvas->m_size = m_referenceSize;  // CreateFromJSONと同様に初期サイズとしても使用
+		canvas->m_childrenLayout = m_childrenLayout;
+		canvas->m_params = m_params;
+		canvas->m_autoFitMode = m_autoFitMode;
+		canvas->m_defaultFontAssetName = m_defaultFontAssetName;
+
+		for (const auto& child : m_children)
+		{
+			canvas->addChild(child->clone(componentFactory));
+		}
+
+		canvas->markLayoutAsDirty();
+
+		return canvas;
+	}
+
 	bool Canvas::tryReadFromJSON(const JSON& json, detail::WithInstanceIdYN withInstanceId)
 	{
 		return tryReadFromJSON(json, ComponentFactory::GetBuiltinFactory(), withInstanceId);
@@ -769,6 +962,15 @@ namespace noco
 
 		m_eventRegistry.clear();
 
+		// 非同期読み込みが完了したアセットを登録(1フレームに1回のみ処理される)
+		noco::Asset::ProcessPendingLoads();
+
+		processPendingPrewarmGlyphs();
+
+		// アニメーション用時計を進める
+		m_animationDeltaTime = m_animationPaused ? 0.0 : Scene::DeltaTime() * m_animationTimeScale;
+		m_animationTime += m_animationDeltaTime;
+
 		noco::detail::ClearCanvasUpdateContextIfNeeded();
 
 		// 親の変換行列をレイアウト更新時用に保持
@@ -988,6 +1190,10 @@ namespace noco
 		{
 			child->update(scrollableHoveredNode, Scene::DeltaTime(), combinedTransformMat, combinedHitTestMat, m_params);
 		}
+
+		// update中に登録されたTweenをまとめて評価
+		evaluateScheduledTweens();
+
 		for (const auto& child : m_tempChildrenBuffer)
 		{
 			child->lateUpdate();
@@ -995,15 +1201,22 @@ namespace noco
 
 		// update内でstyleStateがsetCurrentFrameOverrideで上書きされた場合用にステート更新はlateUpdate後に改めて実行(deltaTime適用)
 		// updateNodeStatesは順不同かつユーザーコードを含まないためm_childrenに対して直接実行
-		for (const auto& child : m_children)
+		// 時間を進めるスムージングはバッファへ登録し、スコープの終わりでまとめて評価
 		{
-			// InteractionStateはライフサイクルの途中では変えないためNoを指定
-			child->updateNodeStates(detail::UpdateInteractionStateYN::No, hoveredNode, Scene::DeltaTime(), m_interactable, InteractionState::Default, InteractionState::Default, isScrolling, m_params, EmptyStringArray);
+			const detail::SmoothingBatchScope smoothingBatchScope{ m_smoothingBatch };
+			for (const auto& child : m_children)
+			{
+				// InteractionStateはライフサイクルの途中では変えないためNoを指定
+				child->updateNodeStates(detail::UpdateInteractionStateYN::No, hoveredNode, Scene::DeltaTime(), m_interactable, InteractionState::Default, InteractionState::Default, isScrolling, m_params, EmptyStringArray);
+			}
 		}
 
-		for (const auto& child : m_tempChildrenBuffer)
 		{
-			child->postLateUpdate(Scene::DeltaTime(), combinedTransformMat, combinedHitTestMat, m_params);
+			const detail::SmoothingBatchScope smoothingBatchScope{ m_smoothingBatch };
+			for (const auto& child : m_tempChildrenBuffer)
+			{
+				child->postLateUpdate(Scene::DeltaTime(), combinedTransformMat, combinedHitTestMat, m_params);
+			}
 		}
 
 		// 同一フレーム内でのレイアウト更新はまとめて1回遅延実行
@@ -1047,17 +1260,316 @@ namespace noco
 	
 	void Canvas::draw() const
 	{
+		m_drawStats = CanvasDrawStats{};
+		if (m_retainedRenderingEnabled)
+		{
+			drawRetained();
+		}
+		else
+		{
+			drawImmediate();
+		}
+	}
+
+	void Canvas::drawImmediate() const
+	{
+		if (m_occlusionCullingEnabled)
+		{
+			applyOcclusionCulling();
+		}
+
 		// drawはzOrder昇順で実行(奥から手前へ)
 		// ユーザーコード内でのaddChild等の呼び出しでイテレータ破壊が起きないよう、ここでは一時バッファの使用が必須
 		m_tempChildrenBuffer.clear();
-		m_tempChildrenBuffer.reserve(m_children.size());
-		m_tempChildrenBuffer.assign(m_children.begin(), m_children.end());
-		SortByZOrderInSiblings(m_tempChildrenBuffer);
+		for (const size_t childIndex : m_childrenDrawOrderCache.get(m_children))
+		{
+			m_tempChildrenBuffer.push_back(m_children[childIndex]);
+		}
 		for (const auto& child : m_tempChildrenBuffer)
 		{
 			child->draw();
 		}
 		m_tempChildrenBuffer.clear();
+
+		if (m_occlusionCullingEnabled)
+		{
+			clearOcclusionCulling();
+		}
+	}
+
+	void Canvas::drawRetained() const
+	{
+		++m_retainedDrawCount;
+
+		// 描画先のサイズや乗算カラーが変わった場合は全体を再描画
+		const Size targetSize = Graphics2D::GetRenderTargetSize();
+		const ColorF colorMul = ColorF{ Graphics2D::GetColorMul() };
+		bool fullRedraw = std::exchange(m_retainedFullRedrawRequested, false);
+		if (m_retainedRenderTextureSize != targetSize)
+		{
+			m_retainedRenderTexture = RenderTexture{ targetSize, ColorF{ 0.0, 0.0 } };
+			m_retainedRenderTextureSize = targetSize;
+			fullRedraw = true;
+		}
+		if (m_retainedColorMul != colorMul)
+		{
+			m_retainedColorMul = colorMul;
+			fullRedraw = true;
+		}
+
+		// 変化したノードの前回・今回の領域を収集(全体を再描画する場合も状態の記録のために実行する)
+		m_retainedDamagedRect.reset();
+		const Array<size_t>& drawOrder = m_childrenDrawOrderCache.get(m_children);
+		for (size_t i = 0; i < drawOrder.size(); ++i)
+		{
+			collectDamagedRectsRecursive(m_children[drawOrder[i]], i, colorMul, none);
+		}
+
+		// 今回見つからなかったノード(削除・非アクティブ化されたノード)の前回の領域
+		for (auto it = m_retainedNodeDrawStates.begin(); it != m_retainedNodeDrawStates.end();)
+		{
+			if (it->second.lastSeenDrawCount != m_retainedDrawCount)
+			{
+				addDamagedRect(it->second.boundingRect);
+				m_retainedNodeDrawStates.erase(it++);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		if (fullRedraw)
+		{
+			m_retainedDamagedRect = RectF{ SizeF{ targetSize } };
+		}
+
+		if (m_retainedDamagedRect)
+		{
+			// 変化した領域をすべて含む範囲を1回の描画で再描画する
+			const RectF& damagedRect = *m_retainedDamagedRect;
+			const int32 left = static_cast<int32>(Math::Floor(damagedRect.x));
+			const int32 top = static_cast<int32>(Math::Floor(damagedRect.y));
+			const int32 right = static_cast<int32>(Math::Ceil(damagedRect.x + damagedRect.w));
+			const int32 bottom = static_cast<int32>(Math::Ceil(damagedRect.y + damagedRect.h));
+			const Rect scissorRect = Rect{ left, top, right - left, bottom - top }.getOverlap(Rect{ targetSize });
+			if (!scissorRect.isEmpty())
+			{
+				const ScopedRenderTarget2D renderTarget{ m_retainedRenderTexture };
+
+				// 対象範囲を透明でクリアしてから描画
+				{
+					const ScopedRenderStates2D blendState{ BlendState::Opaque };
+					const ScopedColorMul2D clearColorMul{ ColorF{ 1.0 } };
+					scissorRect.draw(ColorF{ 0.0, 0.0 });
+				}
+
+				// 乗算カラーはレンダーテクスチャへの描画時に適用済みのため、合成時には適用しない
+				const detail::ScopedScissorRect scopedScissorRect{ scissorRect };
+				drawImmediate();
+				m_drawStats.retainedRedrawRect = scissorRect;
+			}
+		}
+
+		// レンダーテクスチャはアルファ乗算済みの状態になるため、乗算済みアルファとして合成
+		const ScopedRenderStates2D blendState{ BlendState::Premultiplied };
+		const ScopedColorMul2D colorMulForComposite{ ColorF{ 1.0 } };
+		m_retainedRenderTexture.draw();
+	}
+
+	void Canvas::collectDamagedRectsRecursive(const std::shared_ptr<Node>& nodePtr, size_t drawOrderIndex, const ColorF& parentColor, const Optional<RectF>& parentClipRect) const
+	{
+		const Node& node = *nodePtr;
+
+		// Node::drawで描画されないノードは対象外(前回描画されていた場合は状態が削除され、前回の領域が再描画される)
+		if (!node.m_activeSelf.value() || !node.m_activeInHierarchyForLifecycle)
+		{
+			return;
+		}
+		const ColorF color = parentColor * ColorF{ node.m_transform.color().value() };
+		if (color.a <= 0.0)
+		{
+			return;
+		}
+
+		// 描画内容に影響する値から変化検出用の値を算出
+		// コンポーネントのプロパティは値そのものではなく内容バージョンを使用するため、文字列等のハッシュを毎フレーム計算しない
+		uint64 drawVersion = detail::HashPropertyValue(node.m_transformedQuad);
+		drawVersion = detail::HashCombine(drawVersion, detail::HashPropertyValue(color));
+		drawVersion = detail::HashCombine(drawVersion, parentClipRect ? detail::HashPropertyValue(*parentClipRect) : 0);
+		// 兄弟間の描画順(zOrderInSiblingsと並び順の両方を反映した順番)が変わると重なり方が変わるため含める
+		drawVersion = detail::HashCombine(drawVersion, detail::HashPropertyValue(drawOrderIndex));
+		drawVersion = detail::HashCombine(drawVersion, detail::HashPropertyValue(node.m_scrollBarAlpha.currentValue()));
+		bool redrawEveryFrame = false;
+		for (const auto& component : node.m_components)
+		{
+			drawVersion = detail::HashCombine(drawVersion, component->propertyValuesVersion());
+			// アセットの登録・解放やロード完了はプロパティ値を変えずに描画内容を変えるため、コンポーネントが解決したアセットも含める
+			drawVersion = detail::HashCombine(drawVersion, component->resolvedAssetsHash(node));
+			redrawEveryFrame = redrawEveryFrame || component->requiresRedrawEveryFrame();
+		}
+
+		const RectF boundingRect = node.m_transformedQuad.boundingRect().stretched(m_retainedDamageMargin);
+		auto it = m_retainedNodeDrawStates.find(node.instanceId());
+		if (it == m_retainedNodeDrawStates.end())
+		{
+			// 新たに描画されるノード
+			addDamagedRect(boundingRect);
+			m_retainedNodeDrawStates.emplace(node.instanceId(), RetainedNodeDrawState{
+				.drawVersion = drawVersion,
+				.boundingRect = boundingRect,
+				.redrawEveryFrame = redrawEveryFrame,
+				.lastSeenDrawCount = m_retainedDrawCount,
+			});
+		}
+		else
+		{
+			RetainedNodeDrawState& state = it->second;
+
+			// 前回毎フレーム再描画が必要だった場合は、不要になった直後のフレームも再描画する(カーソル等を消すため)
+			if (state.drawVersion != drawVersion || redrawEveryFrame || state.redrawEveryFrame)
+			{
+				addDamagedRect(state.boundingRect);
+				addDamagedRect(boundingRect);
+			}
+			state.drawVersion = drawVersion;
+			state.boundingRect = boundingRect;
+			state.redrawEveryFrame = redrawEveryFrame;
+			state.lastSeenDrawCount = m_retainedDrawCount;
+		}
+
+		Optional<RectF> clipRect = parentClipRect;
+		if (node.m_clippingEnabled)
+		{
+			const RectF nodeClipRect = node.unrotatedTransformedRect();
+			clipRect = parentClipRect ? IntersectRect(nodeClipRect, *parentClipRect) : nodeClipRect;
+		}
+		const Array<size_t>& drawOrder = node.m_childrenDrawOrderCache.get(node.m_children);
+		for (size_t i = 0; i < drawOrder.size(); ++i)
+		{
+			collectDamagedRectsRecursive(node.m_children[drawOrder[i]], i, color, clipRect);
+		}
+	}
+
+	void Canvas::addDamagedRect(const RectF& rect) const
+	{
+		if (rect.w <= 0.0 || rect.h <= 0.0)
+		{
+			return;
+		}
+		m_retainedDamagedRect = m_retainedDamagedRect ? UnionRect(*m_retainedDamagedRect, rect) : rect;
+	}
+
+	std::shared_ptr<Canvas> Canvas::setRetainedRenderingEnabled(bool enabled)
+	{
+		m_retainedRenderingEnabled = enabled;
+		if (!enabled)
+		{
+			// 保持していた描画結果を解放
+			m_retainedRenderTexture = RenderTexture{};
+			m_retainedRenderTextureSize = Size::Zero();
+			m_retainedNodeDrawStates.clear();
+		}
+		m_retainedFullRedrawRequested = true;
+		return shared_from_this();
+	}
+
+	void Canvas::collectOcclusionCullingEntriesRecursive(const std::shared_ptr<Node>& nodePtr, double parentAlpha, const Optional<RectF>& parentClipRect) const
+	{
+		const Node& node = *nodePtr;
+
+		// Node::drawで描画されないノードは対象外
+		if (!node.m_activeSelf.value() || !node.m_activeInHierarchyForLifecycle)
+		{
+			return;
+		}
+		const double alpha = parentAlpha * ColorF{ node.m_transform.color().value() }.a;
+		if (alpha <= 0.0)
+		{
+			return;
+		}
+
+		const RectF boundingRect = node.m_transformedQuad.boundingRect();
+
+		// 半透明や回転がある場合は遮蔽物として扱わない(遮蔽範囲は領域外へのはみ出しを含まない領域のみとする)
+		Optional<RectF> occluderRect;
+		if (alpha >= 1.0 && IsAxisAlignedQuad(node.m_transformedQuad, boundingRect))
+		{
+			const bool hasOpaqueComponent = node.m_components.any([](const auto& component) { return component->isOpaqueFullRect(); });
+			if (hasOpaqueComponent)
+			{
+				// 親のクリッピング範囲外は描画されないため、クリッピング範囲内のみを遮蔽範囲とする
+				occluderRect = parentClipRect ? IntersectRect(boundingRect, *parentClipRect) : boundingRect;
+			}
+		}
+
+		m_tempOcclusionCullingEntries.push_back(OcclusionCullingEntry{
+			.node = nodePtr,
+			.drawnRect = node.drawnBoundingRect(),
+			.occluderRect = occluderRect,
+		});
+
+		if (node.m_children.empty())
+		{
+			return;
+		}
+
+		Optional<RectF> clipRect = parentClipRect;
+		if (node.m_clippingEnabled)
+		{
+			const RectF nodeClipRect = node.unrotatedTransformedRect();
+			clipRect = parentClipRect ? IntersectRect(nodeClipRect, *parentClipRect) : nodeClipRect;
+		}
+
+		// Node::drawと同じくzOrder昇順で収集
+		for (const size_t childIndex : node.m_childrenDrawOrderCache.get(node.m_children))
+		{
+			collectOcclusionCullingEntriesRecursive(node.m_children[childIndex], alpha, clipRect);
+		}
+	}
+
+	void Canvas::applyOcclusionCulling() const
+	{
+		m_tempOcclusionCullingEntries.clear();
+		m_tempOccluderRects.clear();
+
+		const double rootAlpha = ColorF{ Graphics2D::GetColorMul() }.a;
+		for (const size_t childIndex : m_childrenDrawOrderCache.get(m_children))
+		{
+			collectOcclusionCullingEntriesRecursive(m_children[childIndex], rootAlpha, none);
+		}
+
+		// 描画順の逆(手前から奥へ)に走査し、より手前の遮蔽物に完全に覆われているノードをカリング
+		size_t culledCount = 0;
+		for (auto it = m_tempOcclusionCullingEntries.rbegin(); it != m_tempOcclusionCullingEntries.rend(); ++it)
+		{
+			const Optional<RectF>& drawnRect = it->drawnRect;
+			const bool culled = drawnRect && m_tempOccluderRects.any([&](const RectF& occluderRect) { return occluderRect.contains(*drawnRect); });
+			it->node->m_occlusionCulled = culled;
+			if (culled)
+			{
+				++culledCount;
+			}
+
+			if (it->occluderRect)
+			{
+				m_tempOccluderRects.push_back(*it->occluderRect);
+			}
+		}
+		m_tempOccluderRects.clear();
+
+		m_drawStats.occlusionTestedNodeCount = m_tempOcclusionCullingEntries.size();
+		m_drawStats.occlusionCulledNodeCount = culledCount;
+	}
+
+	void Canvas::clearOcclusionCulling() const
+	{
+		// 別のCanvasへ移動された場合などに設定が残らないよう、描画後は必ず解除する
+		for (const auto& entry : m_tempOcclusionCullingEntries)
+		{
+			entry.node->m_occlusionCulled = false;
+		}
+		m_tempOcclusionCullingEntries.clear();
 	}
 	
 	void Canvas::removeChildrenAll()
@@ -1984,4 +2496,181 @@ namespace noco
 			}
 		}
 	}
+
+	void Canvas::scheduleTween(const std::shared_ptr<Tween>& tween, const std::shared_ptr<Node>& node)
+	{
+		m_scheduledTweens.emplace_back(tween, node);
+	}
+
+	void Canvas::scheduleTween(const std::shared_ptr<KeyframeAnimation>& keyframeAnimation, const std::shared_ptr<Node>& node)
+	{
+		m_scheduledTweens.emplace_back(keyframeAnimation, node);
+	}
+
+	void Canvas::evaluateScheduledTweens()
+	{
+		// 同一ノードに複数のTween・KeyframeAnimationがある場合に後のものが優先されるよう、登録順(コンポーネント順)に評価する
+		for (const auto& [scheduled, node] : m_scheduledTweens)
+		{
+			std::visit([&node](const auto& tween) { tween->evaluate(node); }, scheduled);
+		}
+		m_scheduledTweens.clear();
+	}
+
+	void Canvas::collectPrewarmGlyphs(detail::GlyphPrewarmList& list, IncludeSubCanvasYN includeSubCanvas) const
+	{
+		for (const auto& child : m_children)
+		{
+			for (const auto& component : child->getComponents<detail::IFontCachedComponent>(RecursiveYN::Yes))
+			{
+				component->collectPrewarmGlyphs(m_defaultFontAssetName, m_params, list);
+			}
+
+			if (includeSubCanvas)
+			{
+				// SubCanvas配下はそのCanvas自身のパラメータとデフォルトフォントで解決する必要があるため、Canvas単位で辿る
+				for (const auto& subCanvas : child->getComponents<SubCanvas>(RecursiveYN::Yes))
+				{
+					if (const auto canvas = subCanvas->canvas())
+					{
+						canvas->collectPrewarmGlyphs(list, IncludeSubCanvasYN::Yes);
+					}
+				}
+			}
+		}
+	}
+
+	void Canvas::collectAssetDependenciesRecursive(AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, int32 nestLevel) const
+	{
+		const size_t firstCanvasFilePathIndex = dependencies.canvasFilePaths().size();
+
+		for (const auto& child : m_children)
+		{
+			collectNodeAssetDependenciesRecursive(*child, dependencies, visitedCanvasFilePaths, nestLevel);
+		}
+
+		// 未読み込みのCanvasファイル(ステート毎の値など)は読み込んでJSONのまま辿る
+		CollectAssetDependenciesFromCanvasFiles(dependencies, visitedCanvasFilePaths, firstCanvasFilePathIndex, nestLevel);
+	}
+
+	void Canvas::collectNodeAssetDependenciesRecursive(const Node& node, AssetDependencies& dependencies, HashSet<FilePath>& visitedCanvasFilePaths, int32 nestLevel) const
+	{
+		// 生成が遅延されている中身は生成せずにJSONから収集する
+		if (node.m_deferredContent)
+		{
+			node.m_deferredContent->jsonLocation.visit([&](const JSON& json)
+				{
+					CollectAssetDependenciesFromNodeJSON(json, m_params, dependencies);
+				});
+			return;
+		}
+
+		for (const auto& component : node.m_components)
+		{
+			if (const auto assetDependentComponent = dynamic_cast<const detail::IAssetDependentComponent*>(component.get()))
+			{
+				assetDependentComponent->collectAssetDependencies(m_params, dependencies);
+			}
+
+			// 読み込み済みのSubCanvasはそのCanvasを辿る
+			if (const auto subCanvas = dynamic_cast<const SubCanvas*>(component.get()))
+			{
+				const auto canvas = subCanvas->canvas();
+				if (canvas && nestLevel < SubCanvas::MaxNestLevel && visitedCanvasFilePaths.insert(subCanvas->loadedPath()).second)
+				{
+					canvas->collectAssetDependenciesRecursive(dependencies, visitedCanvasFilePaths, nestLevel + 1);
+				}
+			}
+		}
+
+		for (const auto& child : node.m_children)
+		{
+			collectNodeAssetDependenciesRecursive(*child, dependencies, visitedCanvasFilePaths, nestLevel);
+		}
+	}
+
+	AssetDependencies Canvas::collectAssetDependencies() const
+	{
+		AssetDependencies dependencies;
+		HashSet<FilePath> visitedCanvasFilePaths;
+		collectAssetDependenciesRecursive(dependencies, visitedCanvasFilePaths, 0);
+		return dependencies;
+	}
+
+	AssetDependencies Canvas::CollectAssetDependenciesFromFile(FilePathView path)
+	{
+		// Canvasを生成せずにJSONのまま辿る
+		const JSON json = BinaryCanvas::LoadJSON(path);
+		if (!json)
+		{
+			return {};
+		}
+		AssetDependencies dependencies;
+		HashSet<FilePath> visitedCanvasFilePaths;
+		CollectAssetDependenciesFromCanvasJSON(json, dependencies, visitedCanvasFilePaths, 0);
+		return dependencies;
+	}
+
+	AssetDependencies Canvas::PreloadFromFile(FilePathView path)
+	{
+		AssetDependencies dependencies = CollectAssetDependenciesFromFile(path);
+		Asset::Preload(dependencies);
+		return dependencies;
+	}
+
+	void Canvas::prewarmGlyphs(IncludeSubCanvasYN includeSubCanvas, const Optional<Duration>& timeBudgetPerFrame)
+	{
+		detail::GlyphPrewarmList list;
+		collectPrewarmGlyphs(list, includeSubCanvas);
+
+		// 前回の未処理分は今回の収集結果で置き換える
+		m_pendingPrewarmGlyphs.clear();
+		m_pendingPrewarmGlyphsIndex = 0;
+		for (const auto& entry : list.entries())
+		{
+			Array<char32> codePoints(entry.codePoints.begin(), entry.codePoints.end());
+			codePoints.sort();
+			for (size_t i = 0; i < codePoints.size(); i += PrewarmGlyphsChunkSize)
+			{
+				const size_t count = Min(PrewarmGlyphsChunkSize, codePoints.size() - i);
+				m_pendingPrewarmGlyphs.emplace_back(entry.font, String(codePoints.data() + i, count));
+			}
+		}
+
+		if (timeBudgetPerFrame)
+		{
+			m_prewarmGlyphsTimeBudgetPerFrame = *timeBudgetPerFrame;
+			return;
+		}
+
+		for (const auto& [font, chars] : m_pendingPrewarmGlyphs)
+		{
+			font.preload(chars);
+		}
+		m_pendingPrewarmGlyphs.clear();
+	}
+
+	void Canvas::processPendingPrewarmGlyphs()
+	{
+		if (!isPrewarmingGlyphs())
+		{
+			return;
+		}
+
+		// 予算が極端に小さくても処理が進むよう、少なくとも1チャンクは処理する
+		const Stopwatch stopwatch{ StartImmediately::Yes };
+		do
+		{
+			const auto& [font, chars] = m_pendingPrewarmGlyphs[m_pendingPrewarmGlyphsIndex];
+			font.preload(chars);
+			++m_pendingPrewarmGlyphsIndex;
+		}
+		while (isPrewarmingGlyphs() && stopwatch.elapsed() < m_prewarmGlyphsTimeBudgetPerFrame);
+
+		if (!isPrewarmingGlyphs())
+		{
+			m_pendingPrewarmGlyphs.clear();
+			m_pendingPrewarmGlyphsIndex = 0;
+		}
+	}
 }
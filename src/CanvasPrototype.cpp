@@ -0,0 +1,101 @@
+﻿#include "NocoUI/CanvasPrototype.hpp"
+
+namespace noco
+{
+	NodePrototype::NodePrototype(const std::shared_ptr<Node>& node, const ComponentFactory& componentFactory)
+		: m_node{ node }
+		, m_componentFactory{ componentFactory }
+	{
+	}
+
+	std::shared_ptr<NodePrototype> NodePrototype::CreateFromJSON(const JSON& json)
+	{
+		return CreateFromJSON(json, ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<NodePrototype> NodePrototype::CreateFromJSON(const JSON& json, const ComponentFactory& factory)
+	{
+		auto node = Node::CreateFromJSON(json, factory);
+		if (!node)
+		{
+			return nullptr;
+		}
+		return std::shared_ptr<NodePrototype>{ new NodePrototype{ node, factory } };
+	}
+
+	std::shared_ptr<NodePrototype> NodePrototype::CreateFromNode(const Node& node)
+	{
+		return CreateFromNode(node, ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<NodePrototype> NodePrototype::CreateFromNode(const Node& node, const ComponentFactory& factory)
+	{
+		return std::shared_ptr<NodePrototype>{ new NodePrototype{ node.clone(factory), factory } };
+	}
+
+	std::shared_ptr<Node> NodePrototype::instantiate() const
+	{
+		return m_node->clone(m_componentFactory);
+	}
+
+	CanvasPrototype::CanvasPrototype(const std::shared_ptr<Canvas>& canvas, const ComponentFactory& componentFactory)
+		: m_canvas{ canvas }
+		, m_componentFactory{ componentFactory }
+	{
+	}
+
+	std::shared_ptr<CanvasPrototype> CanvasPrototype::CreateFromJSON(const JSON& json)
+	{
+		return CreateFromJSON(json, ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<CanvasPrototype> CanvasPrototype::CreateFromJSON(const JSON& json, const ComponentFactory& factory)
+	{
+		auto canvas = Canvas::CreateFromJSON(json, factory);
+		if (!canvas)
+		{
+			return nullptr;
+		}
+		return std::shared_ptr<CanvasPrototype>{ new CanvasPrototype{ canvas, factory } };
+	}
+
+	std::shared_ptr<CanvasPrototype> CanvasPrototype::LoadFromFile(FilePathView path)
+	{
+		return LoadFromFile(path, ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<CanvasPrototype> CanvasPrototype::LoadFromFile(FilePathView path, const ComponentFactory& factory)
+	{
+		auto canvas = Canvas::LoadFromFile(path, factory);
+		if (!canvas)
+		{
+			return nullptr;
+		}
+		return std::shared_ptr<CanvasPrototype>{ new CanvasPrototype{ canvas, factory } };
+	}
+
+	std::shared_ptr<CanvasPrototype> CanvasPrototype::CreateFromCanvas(const Canvas& canvas)
+	{
+		return CreateFromCanvas(canvas, ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<CanvasPrototype> CanvasPrototype::CreateFromCanvas(const Canvas& canvas, const ComponentFactory& factory)
+	{
+		return std::shared_ptr<CanvasPrototype>{ new CanvasPrototype{ canvas.clone(factory), factory } };
+	}
+
+	std::shared_ptr<Canvas> CanvasPrototype::instantiate() const
+	{
+		return m_canvas->clone(m_componentFactory);
+	}
+
+	const SizeF& CanvasPrototype::referenceSize() const
+	{
+		return m_canvas->referenceSize();
+	}
+
+	AutoFitMode CanvasPrototype::autoFitMode() const
+	{
+		return m_canvas->autoFitMode();
+	}
+}
@@ -1,8 +1,44 @@
 ﻿#include "NocoUI/Component/ComponentBase.hpp"
 #include "NocoUI/Node.hpp"
+#include "NocoUI/ComponentFactory.hpp"
+#include "NocoUI/Serialization.hpp"
 
 namespace noco
 {
+	namespace
+	{
+		/// @brief 組み込みのファクトリで生成した直後のコンポーネントと、それをシリアライズしたJSON
+		struct DefaultComponent
+		{
+			std::shared_ptr<const SerializableComponentBase> component;
+			JSON json;
+		};
+
+		/// @brief 組み込みのファクトリで生成した直後のコンポーネントを取得
+		/// @return 組み込みのファクトリに登録されていない型の場合はnullptr
+		[[nodiscard]]
+		std::shared_ptr<const DefaultComponent> GetDefaultComponent(const String& type)
+		{
+			static std::mutex mutex;
+			static HashTable<String, std::shared_ptr<const DefaultComponent>> cache;
+
+			std::lock_guard lock{ mutex };
+			if (const auto it = cache.find(type); it != cache.end())
+			{
+				return it->second;
+			}
+
+			std::shared_ptr<const DefaultComponent> defaultComponent;
+			if (auto component = ComponentFactory::GetBuiltinFactory().createComponent(type))
+			{
+				JSON json = component->toJSON();
+				defaultComponent = std::make_shared<const DefaultComponent>(DefaultComponent{ .component = std::move(component), .json = std::move(json) });
+			}
+			cache.emplace(type, defaultComponent);
+			return defaultComponent;
+		}
+	}
+
 	void ComponentBase::updateProperties(InteractionState interactionState, const Array<String>& activeStyleStates, double deltaTime, const HashTable<String, ParamValue>& params, SkipSmoothingYN skipSmoothing)
 	{
 		for (IProperty* property : m_properties)
@@ -10,4 +46,80 @@ namespace noco
 			property->update(interactionState, activeStyleStates, deltaTime, params, skipSmoothing);
 		}
 	}
+
+	JSON SerializableComponentBase::toJSON(detail::WithInstanceIdYN withInstanceId, OmitDefaultValuesYN omitDefaultValues) const
+	{
+		if (omitDefaultValues)
+		{
+			// 組み込みの型は、生成直後の値と等しいプロパティを書き込まない
+			const auto defaultComponent = GetDefaultComponent(type());
+			if (defaultComponent && typeid(*defaultComponent->component) == typeid(*this))
+			{
+				JSON json;
+				json[U"type"] = typeOverrideInternal();
+
+				const auto& defaultProperties = defaultComponent->component->properties();
+				const auto& componentProperties = properties();
+				for (size_t i = 0; i < componentProperties.size(); ++i)
+				{
+					componentProperties[i]->appendJSONIfNotDefault(json, *defaultProperties[i]);
+				}
+
+				if (withInstanceId)
+				{
+					json[U"_instanceId"] = instanceId();
+				}
+
+				return json;
+			}
+		}
+		return toJSONOverrideInternal(withInstanceId);
+	}
+
+	void detail::EraseDefaultComponentValuesFromJSON(JSON& componentJSON)
+	{
+		if (!componentJSON.contains(U"type"))
+		{
+			return;
+		}
+		if (const auto defaultComponent = GetDefaultComponent(componentJSON[U"type"].getOr<String>(U"")))
+		{
+			detail::EraseDefaultValuesFromJSON(componentJSON, defaultComponent->json, { U"type", U"_instanceId" });
+		}
+	}
+
+	bool detail::HasSamePropertyLayout(const ComponentBase& a, const ComponentBase& b)
+	{
+		const auto& aProperties = a.properties();
+		const auto& bProperties = b.properties();
+		return aProperties.size() == bProperties.size()
+			&& std::equal(aProperties.begin(), aProperties.end(), bProperties.begin(),
+				[](const IProperty* aProperty, const IProperty* bProperty) { return aProperty->name() == bProperty->name(); });
+	}
+
+	std::shared_ptr<SerializableComponentBase> SerializableComponentBase::cloneComponent(const ComponentFactory& factory) const
+	{
+		const String componentType = type();
+		if (auto component = factory.createComponent(componentType))
+		{
+			if (component->type() == componentType && detail::HasSamePropertyLayout(*this, *component))
+			{
+				const auto& srcProperties = properties();
+				const auto& dstProperties = component->properties();
+				for (size_t i = 0; i < srcProperties.size(); ++i)
+				{
+					dstProperties[i]->copySerializedFrom(*srcProperties[i]);
+				}
+				return component;
+			}
+		}
+
+		// ファクトリに登録されていない型(不明なコンポーネントのハンドラで生成されるもの等)やプロパティ構成が異なる場合はJSONを経由する
+		return std::dynamic_pointer_cast<SerializableComponentBase>(factory.createComponentFromJSON(toJSON()));
+	}
+
+	std::shared_ptr<SerializableComponentBase> SerializableComponentBase::cloneComponent() const
+	{
+		return cloneComponent(ComponentFactory::GetBuiltinFactory());
+	}
 }
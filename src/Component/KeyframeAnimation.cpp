@@ -0,0 +1,599 @@
+﻿#include "NocoUI/Component/KeyframeAnimation.hpp"
+#include "NocoUI/Node.hpp"
+#include "NocoUI/Canvas.hpp"
+#include "NocoUI/Serialization.hpp"
+
+namespace noco
+{
+	namespace
+	{
+		constexpr StringView PropertiesKey = U"properties";
+
+		[[nodiscard]]
+		double EvaluateKeyframeEasing(TweenEasing easing, double t)
+		{
+			if (easing == TweenEasing::Linear)
+			{
+				return t;
+			}
+			if (TweenEasingLookupTable::IsGlobalEnabled())
+			{
+				return TweenEasingLookupTable::Evaluate(easing, t);
+			}
+			return EvaluateTweenEasing(easing, t);
+		}
+
+		/// @brief 時刻を含む区間の番号を前回の区間から辿って求める
+		/// @note 時間は通常単調に進むため、前回の区間から前後に辿ることで償却O(1)で求まる
+		[[nodiscard]]
+		size_t FindSegment(const double* times, size_t count, size_t cursor, double time)
+		{
+			const size_t lastSegment = count - 2;
+			cursor = Min(cursor, lastSegment);
+
+			if (time < times[cursor])
+			{
+				// ループで先頭へ戻った場合は先頭の区間から
+				if (time < times[1])
+				{
+					return 0;
+				}
+				while (cursor > 0 && time < times[cursor])
+				{
+					--cursor;
+				}
+			}
+			else
+			{
+				while (cursor < lastSegment && times[cursor + 1] <= time)
+				{
+					++cursor;
+				}
+			}
+			return cursor;
+		}
+
+		template <class T>
+		bool TrySetCurrentFrameOverride(IProperty* property, const T& value)
+		{
+			if (auto* p = dynamic_cast<Property<T>*>(property))
+			{
+				p->setCurrentFrameOverride(value);
+				return true;
+			}
+			if (auto* p = dynamic_cast<SmoothProperty<T>*>(property))
+			{
+				p->setCurrentFrameOverride(value);
+				return true;
+			}
+			if (auto* p = dynamic_cast<PropertyNonInteractive<T>*>(property))
+			{
+				p->setCurrentFrameOverride(value);
+				return true;
+			}
+			return false;
+		}
+
+		[[nodiscard]]
+		Vec2 ToVec2(const double* values)
+		{
+			return Vec2{ values[0], values[1] };
+		}
+
+		[[nodiscard]]
+		Color ToColor(const double* values)
+		{
+			return Color{
+				static_cast<uint8>(Clamp(Math::Round(values[0]), 0.0, 255.0)),
+				static_cast<uint8>(Clamp(Math::Round(values[1]), 0.0, 255.0)),
+				static_cast<uint8>(Clamp(Math::Round(values[2]), 0.0, 255.0)),
+				static_cast<uint8>(Clamp(Math::Round(values[3]), 0.0, 255.0)),
+			};
+		}
+
+		/// @brief キーフレームの値のJSONを要素の配列として読み込む
+		/// @return 読み込めなかった場合は空の配列
+		[[nodiscard]]
+		Array<double> ReadKeyframeValue(const JSON& valueJSON)
+		{
+			if (valueJSON.isNumber())
+			{
+				return { valueJSON.get<double>() };
+			}
+			if (valueJSON.isArray())
+			{
+				Array<double> values;
+				values.reserve(valueJSON.size());
+				for (const auto& elementJSON : valueJSON.arrayView())
+				{
+					if (!elementJSON.isNumber())
+					{
+						return {};
+					}
+					values.push_back(elementJSON.get<double>());
+				}
+				return values;
+			}
+			return {};
+		}
+
+		template <class T>
+		[[nodiscard]]
+		JSON KeyframesToJSON(const Array<Keyframe<T>>& keyframes)
+		{
+			JSON json = JSON::Parse(U"[]");
+			for (const auto& keyframe : keyframes)
+			{
+				JSON keyframeJSON;
+				keyframeJSON[U"time"] = keyframe.time;
+				if constexpr (std::same_as<T, double>)
+				{
+					keyframeJSON[U"value"] = keyframe.value;
+				}
+				else
+				{
+					keyframeJSON[U"value"] = ToArrayJSON(keyframe.value);
+				}
+				keyframeJSON[U"easing"] = EnumToString(keyframe.easing);
+				json.push_back(keyframeJSON);
+			}
+			return json;
+		}
+	}
+
+	void KeyframeAnimation::refreshChannelsIfNeeded() const
+	{
+		const uint64 version = m_keyframesJSON.contentVersion();
+		if (m_parsedKeyframesVersion == version)
+		{
+			return;
+		}
+		m_parsedKeyframesVersion = version;
+
+		m_channels.clear();
+		m_keyframeTimes.clear();
+		m_keyframeEasings.clear();
+		m_keyframeValues.clear();
+		m_duration = 0.0;
+
+		JSON json;
+		try
+		{
+			json = JSON::Parse(m_keyframesJSON.value());
+		}
+		catch (...)
+		{
+			Logger << U"[NocoUI warning] KeyframeAnimation: Failed to parse keyframesJSON";
+			return;
+		}
+		if (!json.isObject())
+		{
+			return;
+		}
+
+		const auto addChannel = [&](ChannelTarget target, const String& propertyPath, const JSON& keyframesJSON, Optional<size_t> requiredDimension)
+		{
+			if (!keyframesJSON.isArray() || keyframesJSON.size() == 0)
+			{
+				return;
+			}
+
+			struct ParsedKeyframe
+			{
+				double time;
+				TweenEasing easing;
+				Array<double> value;
+			};
+			Array<ParsedKeyframe> keyframes;
+			keyframes.reserve(keyframesJSON.size());
+			Optional<size_t> dimension = requiredDimension;
+			for (const auto& keyframeJSON : keyframesJSON.arrayView())
+			{
+				if (!keyframeJSON.isObject() || !keyframeJSON.hasElement(U"value"))
+				{
+					continue;
+				}
+				Array<double> value = ReadKeyframeValue(keyframeJSON[U"value"]);
+				if (value.empty())
+				{
+					continue;
+				}
+				if (!dimension)
+				{
+					dimension = value.size();
+				}
+				if (value.size() != *dimension)
+				{
+					Logger << U"[NocoUI warning] KeyframeAnimation: Keyframe value has unexpected number of elements";
+					continue;
+				}
+				keyframes.push_back(ParsedKeyframe{
+					.time = Max(GetFromJSONOr(keyframeJSON, U"time", 0.0), 0.0),
+					.easing = GetFromJSONOr(keyframeJSON, U"easing", TweenEasing::Linear),
+					.value = std::move(value),
+				});
+			}
+			if (keyframes.empty())
+			{
+				return;
+			}
+
+			// キーフレームは時刻順に並べて格納(同時刻の場合は記述順)
+			std::stable_sort(keyframes.begin(), keyframes.end(), [](const ParsedKeyframe& a, const ParsedKeyframe& b) { return a.time < b.time; });
+
+			Channel channel{
+				.target = target,
+				.propertyPath = propertyPath,
+				.keyframeOffset = m_keyframeTimes.size(),
+				.keyframeCount = keyframes.size(),
+				.valueOffset = m_keyframeValues.size(),
+				.valueDimension = *dimension,
+			};
+			for (const auto& keyframe : keyframes)
+			{
+				m_keyframeTimes.push_back(keyframe.time);
+				m_keyframeEasings.push_back(keyframe.easing);
+				m_keyframeValues.append(keyframe.value);
+			}
+			m_duration = Max(m_duration, keyframes.back().time);
+			m_channels.push_back(std::move(channel));
+		};
+
+		if (json.hasElement(U"translate"))
+		{
+			addChannel(ChannelTarget::Translate, U"", json[U"translate"], 2);
+		}
+		if (json.hasElement(U"scale"))
+		{
+			addChannel(ChannelTarget::Scale, U"", json[U"scale"], 2);
+		}
+		if (json.hasElement(U"rotation"))
+		{
+			addChannel(ChannelTarget::Rotation, U"", json[U"rotation"], 1);
+		}
+		if (json.hasElement(U"color"))
+		{
+			addChannel(ChannelTarget::Color, U"", json[U"color"], 4);
+		}
+		if (json.hasElement(PropertiesKey) && json[PropertiesKey].isObject())
+		{
+			for (const auto& [propertyPath, keyframesJSON] : json[PropertiesKey])
+			{
+				addChannel(ChannelTarget::Property, propertyPath, keyframesJSON, none);
+			}
+		}
+	}
+
+	void KeyframeAnimation::setChannelJSON(StringView key, const JSON& keyframesJSON)
+	{
+		JSON json;
+		try
+		{
+			json = JSON::Parse(m_keyframesJSON.value());
+		}
+		catch (...)
+		{
+		}
+		if (!json.isObject())
+		{
+			json = JSON::Parse(U"{}");
+		}
+
+		json[key] = keyframesJSON;
+		m_keyframesJSON.setValue(json.formatMinimum());
+	}
+
+	void KeyframeAnimation::setPropertyChannelJSON(StringView propertyPath, const JSON& keyframesJSON)
+	{
+		JSON json;
+		try
+		{
+			json = JSON::Parse(m_keyframesJSON.value());
+		}
+		catch (...)
+		{
+		}
+		if (!json.isObject())
+		{
+			json = JSON::Parse(U"{}");
+		}
+
+		if (!json.hasElement(PropertiesKey) || !json[PropertiesKey].isObject())
+		{
+			json[PropertiesKey] = JSON::Parse(U"{}");
+		}
+		json[PropertiesKey][propertyPath] = keyframesJSON;
+		m_keyframesJSON.setValue(json.formatMinimum());
+	}
+
+	void KeyframeAnimation::restart()
+	{
+		m_startTime.reset();
+		m_elapsedTime = 0.0;
+		for (auto& channel : m_channels)
+		{
+			channel.cursor = 0;
+		}
+	}
+
+	double KeyframeAnimation::currentTime() const
+	{
+		const double time = m_manualMode.value() ? m_manualTime.value() : m_elapsedTime;
+		if (time <= 0.0 || m_duration <= 0.0)
+		{
+			return Max(time, 0.0);
+		}
+
+		switch (m_loopType.value())
+		{
+		case TweenLoopType::Loop:
+			return Math::Fmod(time, m_duration);
+		case TweenLoopType::PingPong:
+		{
+			// 偶数サイクルは順方向、奇数サイクルは逆方向
+			const int64 cycle = static_cast<int64>(time / m_duration);
+			const double timeInCycle = Math::Fmod(time, m_duration);
+			return (cycle % 2 == 1) ? (m_duration - timeInCycle) : timeInCycle;
+		}
+		default:
+			return Min(time, m_duration);
+		}
+	}
+
+	void KeyframeAnimation::evaluateChannel(Channel& channel, double time, double* out) const
+	{
+		const double* times = m_keyframeTimes.data() + channel.keyframeOffset;
+		const double* values = m_keyframeValues.data() + channel.valueOffset;
+		const size_t dimension = channel.valueDimension;
+		const size_t count = channel.keyframeCount;
+
+		if (count == 1 || time <= times[0])
+		{
+			std::copy_n(values, dimension, out);
+			return;
+		}
+		if (time >= times[count - 1])
+		{
+			std::copy_n(values + (count - 1) * dimension, dimension, out);
+			return;
+		}
+
+		const size_t segment = FindSegment(times, count, channel.cursor, time);
+		channel.cursor = segment;
+
+		const double startTime = times[segment];
+		const double endTime = times[segment + 1];
+		const double* startValue = values + segment * dimension;
+		const double* endValue = startValue + dimension;
+		if (endTime <= startTime)
+		{
+			std::copy_n(endValue, dimension, out);
+			return;
+		}
+
+		const double progress = EvaluateKeyframeEasing(m_keyframeEasings[channel.keyframeOffset + segment], (time - startTime) / (endTime - startTime));
+		for (size_t i = 0; i < dimension; ++i)
+		{
+			out[i] = startValue[i] + (endValue[i] - startValue[i]) * progress;
+		}
+	}
+
+	IProperty* KeyframeAnimation::resolveProperty(Channel& channel, const std::shared_ptr<Node>& node) const
+	{
+		// コンポーネント構成が前回の解決時から変わっていなければ、見つからなかった場合も含め結果を再利用する
+		const uint64 componentsVersion = node->componentsVersion();
+		if (channel.resolvedComponentsVersion == componentsVersion && (!channel.resolvedProperty || !channel.resolvedComponent.expired()))
+		{
+			return channel.resolvedProperty;
+		}
+		channel.resolvedProperty = nullptr;
+		channel.resolvedComponent.reset();
+		channel.resolvedComponentsVersion = componentsVersion;
+
+		const size_t dotPos = channel.propertyPath.indexOf(U'.');
+		if (dotPos == String::npos)
+		{
+			return nullptr;
+		}
+		const String componentType = channel.propertyPath.substr(0, dotPos);
+		const StringView propertyName = StringView{ channel.propertyPath }.substr(dotPos + 1);
+
+		for (const auto& component : node->components())
+		{
+			const auto serializableComponent = std::dynamic_pointer_cast<SerializableComponentBase>(component);
+			if (!serializableComponent || serializableComponent->type() != componentType)
+			{
+				continue;
+			}
+			if (IProperty* property = component->getPropertyByName(propertyName))
+			{
+				channel.resolvedComponent = component;
+				channel.resolvedProperty = property;
+				return property;
+			}
+		}
+		return nullptr;
+	}
+
+	void KeyframeAnimation::evaluate(const std::shared_ptr<Node>& node)
+	{
+		refreshChannelsIfNeeded();
+		if (m_channels.empty())
+		{
+			return;
+		}
+
+		const double time = currentTime();
+		auto& transform = node->transform();
+		std::array<double, 4> value;
+		for (auto& channel : m_channels)
+		{
+			if (channel.valueDimension > value.size())
+			{
+				continue;
+			}
+			evaluateChannel(channel, time, value.data());
+
+			switch (channel.target)
+			{
+			case ChannelTarget::Translate:
+				transform.translate().setCurrentFrameOverride(ToVec2(value.data()));
+				break;
+			case ChannelTarget::Scale:
+				transform.scale().setCurrentFrameOverride(ToVec2(value.data()));
+				break;
+			case ChannelTarget::Rotation:
+				transform.rotation().setCurrentFrameOverride(value[0]);
+				break;
+			case ChannelTarget::Color:
+				transform.color().setCurrentFrameOverride(ToColor(value.data()));
+				break;
+			case ChannelTarget::Property:
+				if (IProperty* property = resolveProperty(channel, node))
+				{
+					// 値の要素数と型が合わないプロパティは無視する
+					switch (channel.valueDimension)
+					{
+					case 1:
+						TrySetCurrentFrameOverride(property, value[0])
+							|| TrySetCurrentFrameOverride(property, static_cast<int32>(Math::Round(value[0])));
+						break;
+					case 2:
+						TrySetCurrentFrameOverride(property, ToVec2(value.data()));
+						break;
+					case 4:
+						TrySetCurrentFrameOverride(property, ToColor(value.data()));
+						break;
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	void KeyframeAnimation::onActivated(const std::shared_ptr<Node>&)
+	{
+		if (m_active.value() && m_restartOnActive.value())
+		{
+			restart();
+		}
+	}
+
+	void KeyframeAnimation::update(const std::shared_ptr<Node>& node)
+	{
+		const std::shared_ptr<Canvas> canvas = node->containedCanvas();
+
+		// Canvasに属していない場合はCanvasのアニメーション用時計の代わりにシーン時間を使用
+		const double clockTime = canvas ? canvas->animationTime() : Scene::Time();
+
+		const bool currentActive = m_active.value();
+
+		if (m_restartOnActive.value() && m_prevActive.has_value() && !m_prevActive.value() && currentActive)
+		{
+			// 最初から再生
+			restart();
+		}
+		m_prevActive = currentActive;
+
+		if (!m_startTime.has_value())
+		{
+			m_startTime = clockTime;
+		}
+		m_elapsedTime = clockTime - *m_startTime;
+
+		if (!currentActive)
+		{
+			return;
+		}
+
+		// 評価はCanvasがupdate後にTweenとまとめて登録順に行う
+		if (canvas)
+		{
+			canvas->scheduleTween(shared_from_this(), node);
+		}
+		else
+		{
+			evaluate(node);
+		}
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setActive(const PropertyValue<bool>& active)
+	{
+		const bool prevActive = m_active.value();
+
+		m_active.setPropertyValue(active);
+
+		if (m_restartOnActive.value() && !prevActive && m_active.value())
+		{
+			// restartOnActiveが有効の場合、非アクティブ→アクティブに変化した場合は最初からやり直す
+			restart();
+		}
+
+		return shared_from_this();
+	}
+
+	bool KeyframeAnimation::isPlaying() const
+	{
+		if (!m_active.value())
+		{
+			return false;
+		}
+
+		// ループが有効な場合は常にtrue
+		if (m_loopType.value() != TweenLoopType::None)
+		{
+			return true;
+		}
+
+		const double time = m_manualMode.value() ? m_manualTime.value() : m_elapsedTime;
+		return time < duration();
+	}
+
+	double KeyframeAnimation::duration() const
+	{
+		refreshChannelsIfNeeded();
+		return m_duration;
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setTranslateKeyframes(const Array<Keyframe<Vec2>>& keyframes)
+	{
+		setChannelJSON(U"translate", KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setScaleKeyframes(const Array<Keyframe<Vec2>>& keyframes)
+	{
+		setChannelJSON(U"scale", KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setRotationKeyframes(const Array<Keyframe<double>>& keyframes)
+	{
+		setChannelJSON(U"rotation", KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setColorKeyframes(const Array<Keyframe<Color>>& keyframes)
+	{
+		setChannelJSON(U"color", KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setPropertyKeyframes(StringView propertyPath, const Array<Keyframe<double>>& keyframes)
+	{
+		setPropertyChannelJSON(propertyPath, KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setPropertyKeyframes(StringView propertyPath, const Array<Keyframe<Vec2>>& keyframes)
+	{
+		setPropertyChannelJSON(propertyPath, KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+
+	std::shared_ptr<KeyframeAnimation> KeyframeAnimation::setPropertyKeyframes(StringView propertyPath, const Array<Keyframe<Color>>& keyframes)
+	{
+		setPropertyChannelJSON(propertyPath, KeyframesToJSON(keyframes));
+		return shared_from_this();
+	}
+}
@@ -1,54 +1,232 @@
 ﻿#include "NocoUI/Component/Label.hpp"
+#include <list>
 #include "NocoUI/Node.hpp"
 #include "NocoUI/Canvas.hpp"
 #include "NocoUI/DefaultFont.hpp"
+#include "NocoUI/detail/AutoShrinkSearch.hpp"
 
 namespace noco
 {
 	namespace
 	{
 		static const String EmptyString = U"";
-	}
 
-	bool Label::Cache::refreshIfDirty(const String& text, const Optional<Font>& fontOpt, const String& fontAssetName, const String& canvasDefaultFontAssetName, double fontSize, double minFontSize, const Vec2& spacing, HorizontalOverflow horizontalOverflow, VerticalOverflow verticalOverflow, const SizeF& rectSize, LabelSizingMode newSizingMode)
-	{
-		const bool hasCustomFont = fontOpt.has_value();
-		const Font newFont = [&]() -> Font {
-			if (hasCustomFont)
+		constexpr size_t DefaultLabelLayoutCacheCapacity = 1024;
+
+		constexpr double MinAutoShrinkPrecision = 0.01;
+
+		/// @brief レイアウト結果の共有に用いるキー
+		struct LabelLayoutKey
+		{
+			uint64 fontId = 0;
+			String text;
+			double fontSize = 0.0;
+			double minFontSize = 0.0;
+			double autoShrinkPrecision = 0.0;
+			Vec2 spacing = Vec2::Zero();
+			SizeF rectSize = SizeF::Zero();
+			HorizontalOverflow horizontalOverflow = HorizontalOverflow::Wrap;
+			VerticalOverflow verticalOverflow = VerticalOverflow::Clip;
+			LabelSizingMode sizingMode = LabelSizingMode::Fixed;
+
+			[[nodiscard]]
+			bool operator==(const LabelLayoutKey& other) const = default;
+		};
+
+		struct LabelLayoutKeyHash
+		{
+			[[nodiscard]]
+			size_t operator()(const LabelLayoutKey& key) const
 			{
-				return *fontOpt;
+				uint64 hash = key.fontId;
+				hash = detail::HashCombine(hash, key.text.hash());
+				hash = detail::HashCombine(hash, detail::HashPropertyValue(key.fontSize));
+				hash = detail::HashCombine(hash, detail::HashPropertyValue(key.minFontSize));
+				hash = detail::HashCombine(hash, detail::HashPropertyValue(key.autoShrinkPrecision));
+				hash = detail::HashCombine(hash, detail::HashPropertyValue(key.spacing));
+				hash = detail::HashCombine(hash, detail::HashPropertyValue(key.rectSize));
+				hash = detail::HashCombine(hash, static_cast<uint64>(key.horizontalOverflow));
+				hash = detail::HashCombine(hash, static_cast<uint64>(key.verticalOverflow));
+				hash = detail::HashCombine(hash, static_cast<uint64>(key.sizingMode));
+				return static_cast<size_t>(hash);
 			}
+		};
 
-			if (!fontAssetName.empty() && FontAsset::IsRegistered(fontAssetName))
+		/// @brief レイアウト結果に影響しない矩形サイズの成分を0に正規化する
+		/// @note 折り返し・クリップ・縮小に使われない軸のサイズが異なるだけのLabel同士でもレイアウトを共有できるようにするため
+		[[nodiscard]]
+		SizeF NormalizeLayoutRectSize(const SizeF& rectSize, HorizontalOverflow horizontalOverflow, VerticalOverflow verticalOverflow, LabelSizingMode sizingMode)
+		{
+			bool usesWidth = false;
+			bool usesHeight = false;
+			switch (sizingMode)
 			{
-				return FontAsset(fontAssetName);
+			case LabelSizingMode::Fixed:
+				usesWidth = horizontalOverflow == HorizontalOverflow::Wrap;
+				usesHeight = verticalOverflow == VerticalOverflow::Clip;
+				break;
+			case LabelSizingMode::AutoShrink:
+				usesWidth = true;
+				usesHeight = true;
+				break;
+			case LabelSizingMode::AutoShrinkWidth:
+				usesWidth = true;
+				usesHeight = verticalOverflow == VerticalOverflow::Clip;
+				break;
+			case LabelSizingMode::AutoShrinkWidthResizeHeight:
+				usesWidth = true;
+				break;
+			case LabelSizingMode::AutoResize:
+				break;
+			case LabelSizingMode::AutoResizeHeight:
+				usesWidth = horizontalOverflow == HorizontalOverflow::Wrap;
+				break;
 			}
+			return SizeF{ usesWidth ? rectSize.x : 0.0, usesHeight ? rectSize.y : 0.0 };
+		}
+
+		/// @brief Labelのレイアウト結果を保持するLRUキャッシュ
+		class LabelLayoutLRU
+		{
+		private:
+			struct Entry
+			{
+				LabelLayoutKey key;
+				std::shared_ptr<const detail::LabelLayout> layout;
+			};
 
-			if (!canvasDefaultFontAssetName.empty() && FontAsset::IsRegistered(canvasDefaultFontAssetName))
+			std::list<Entry> m_entries;
+			HashTable<LabelLayoutKey, std::list<Entry>::iterator, LabelLayoutKeyHash> m_index;
+			size_t m_capacity = DefaultLabelLayoutCacheCapacity;
+
+			void evictOverflow()
 			{
-				return FontAsset(canvasDefaultFontAssetName);
+				while (m_entries.size() > m_capacity)
+				{
+					m_index.erase(m_entries.back().key);
+					m_entries.pop_back();
+				}
 			}
 
-			if (auto globalFont = noco::detail::GetGlobalDefaultFont())
+		public:
+			[[nodiscard]]
+			std::shared_ptr<const detail::LabelLayout> find(const LabelLayoutKey& key)
 			{
-				return *globalFont;
+				const auto it = m_index.find(key);
+				if (it == m_index.end())
+				{
+					return nullptr;
+				}
+
+				// 最近参照したエントリを先頭に移動
+				m_entries.splice(m_entries.begin(), m_entries, it->second);
+				return it->second->layout;
 			}
 
-			return SimpleGUI::GetFont();
-		}();
+			void insert(const LabelLayoutKey& key, const std::shared_ptr<const detail::LabelLayout>& layout)
+			{
+				if (m_capacity == 0)
+				{
+					return;
+				}
+
+				if (const auto it = m_index.find(key); it != m_index.end())
+				{
+					it->second->layout = layout;
+					m_entries.splice(m_entries.begin(), m_entries, it->second);
+					return;
+				}
+
+				m_entries.push_front(Entry{ .key = key, .layout = layout });
+				m_index.emplace(key, m_entries.begin());
+				evictOverflow();
+			}
+
+			[[nodiscard]]
+			size_t capacity() const
+			{
+				return m_capacity;
+			}
+
+			void setCapacity(size_t capacity)
+			{
+				m_capacity = capacity;
+				evictOverflow();
+			}
+
+			[[nodiscard]]
+			size_t count() const
+			{
+				return m_entries.size();
+			}
+
+			void clear()
+			{
+				m_index.clear();
+				m_entries.clear();
+			}
+		};
+
+		[[nodiscard]]
+		LabelLayoutLRU& GetLabelLayoutLRU()
+		{
+			static LabelLayoutLRU instance;
+			return instance;
+		}
+	}
+
+	const std::shared_ptr<const detail::LabelLayout>& detail::LabelLayout::Empty()
+	{
+		static const std::shared_ptr<const LabelLayout> empty = std::make_shared<const LabelLayout>();
+		return empty;
+	}
+
+	namespace LabelLayoutCache
+	{
+		void SetCapacity(size_t capacity)
+		{
+			GetLabelLayoutLRU().setCapacity(capacity);
+		}
+
+		size_t Capacity()
+		{
+			return GetLabelLayoutLRU().capacity();
+		}
+
+		size_t Count()
+		{
+			return GetLabelLayoutLRU().count();
+		}
+
+		void Clear()
+		{
+			GetLabelLayoutLRU().clear();
+		}
+	}
+
+	bool Label::Cache::refreshIfDirty(const String& text, uint64 textVersion, const Optional<Font>& fontOpt, const String& fontAssetName, uint64 fontAssetNameVersion, const String& canvasDefaultFontAssetName, double fontSize, double minFontSize, double autoShrinkPrecision, const Vec2& spacing, HorizontalOverflow horizontalOverflow, VerticalOverflow verticalOverflow, const SizeF& rectSize, LabelSizingMode newSizingMode)
+	{
+		const bool hasCustomFont = fontOpt.has_value();
+		const Font newFont = hasCustomFont ? *fontOpt : noco::detail::ResolveFont(fontAssetName, canvasDefaultFontAssetName);
 
 		if (prevParams.has_value() &&
-			!prevParams->isDirty(text, fontAssetName, fontSize, minFontSize, horizontalOverflow, verticalOverflow, spacing, rectSize, hasCustomFont, newFont, newSizingMode))
+			!prevParams->isDirty(text, textVersion, fontAssetName, fontAssetNameVersion, fontSize, minFontSize, autoShrinkPrecision, horizontalOverflow, verticalOverflow, spacing, rectSize, hasCustomFont, newFont, newSizingMode))
 		{
+			// 内容が同じでバージョンのみ変化した場合に、次回以降の比較を省略できるよう更新しておく
+			prevParams->textVersion = textVersion;
+			prevParams->fontAssetNameVersion = fontAssetNameVersion;
 			return false;
 		}
 
 		prevParams = CacheParams
 		{
 			.text = text,
+			.textVersion = textVersion,
 			.fontAssetName = fontAssetName,
+			.fontAssetNameVersion = fontAssetNameVersion,
 			.fontSize = fontSize,
 			.minFontSize = minFontSize,
+			.autoShrinkPrecision = autoShrinkPrecision,
 			.horizontalOverflow = horizontalOverflow,
 			.verticalOverflow = verticalOverflow,
 			.spacing = spacing,
@@ -62,37 +240,70 @@ namespace noco
 		fontMethod = newFont.method();
 		assetFontSize = newFont.fontSize();
 
-		auto refreshCacheAndGetRegionSize = [&](double targetFontSize, HorizontalOverflow hov, VerticalOverflow vov) -> SizeF
+		// 同条件のレイアウト結果が既にあれば共有する
+		LabelLayoutLRU& layoutLRU = GetLabelLayoutLRU();
+		const LabelLayoutKey layoutKey
+		{
+			.fontId = static_cast<uint64>(newFont.id().value()),
+			.text = text,
+			.fontSize = fontSize,
+			.minFontSize = newSizingMode == LabelSizingMode::AutoShrink ? minFontSize : 0.0,
+			.autoShrinkPrecision = newSizingMode == LabelSizingMode::AutoShrink ? autoShrinkPrecision : 0.0,
+			.spacing = spacing,
+			.rectSize = NormalizeLayoutRectSize(rectSize, horizontalOverflow, verticalOverflow, newSizingMode),
+			.horizontalOverflow = horizontalOverflow,
+			.verticalOverflow = verticalOverflow,
+			.sizingMode = newSizingMode,
+		};
+		if (auto sharedLayout = layoutLRU.find(layoutKey))
+		{
+			layout = std::move(sharedLayout);
+			return true;
+		}
+
+		auto newLayout = std::make_shared<detail::LabelLayout>();
+		detail::LabelLayout& layoutData = *newLayout;
+
+		// グリフはフォントサイズに依存しないため、AutoShrinkで複数回レイアウトする場合も一度だけ取得する
+		// (各行はこの配列内のインデックス範囲として保持する)
+		layoutData.glyphs = currentFont.getGlyphs(text);
+		const Array<Glyph>& glyphs = layoutData.glyphs;
+
+		// measureOnlyがtrueの場合は行キャッシュを生成せずサイズのみを計算し、rectSizeを超えた時点で打ち切る
+		auto refreshCacheAndGetRegionSize = [&](double targetFontSize, HorizontalOverflow hov, VerticalOverflow vov, bool measureOnly = false) -> SizeF
 			{
 				if (assetFontSize == 0)
 				{
-					this->assetFontSizeScale = 1.0;
+					layoutData.assetFontSizeScale = 1.0;
 				}
 				else
 				{
-					this->assetFontSizeScale = targetFontSize / assetFontSize;
+					layoutData.assetFontSizeScale = targetFontSize / assetFontSize;
 				}
-				this->lineHeight = currentFont.height(targetFontSize);
+				layoutData.lineHeight = currentFont.height(targetFontSize);
 
-				lineCaches.clear();
+				layoutData.lineCaches.clear();
 
 				double maxWidth = 0.0;
 				Vec2 offset = Vec2::Zero();
-				Array<Glyph> lineGlyphs;
+				size_t lineBegin = 0;
+				size_t lineEnd = 0;
+				bool lineHasGlyphs = false;
+				bool exceeded = false;
 				double minTopT = 1.0;
 				double maxBottomT = 0.0;
 
 				const auto fnPushLine =
 					[&]() -> bool
 					{
-						const double currentLineBottom = offset.y + this->lineHeight;
+						const double currentLineBottom = offset.y + layoutData.lineHeight;
 
 						if (vov == VerticalOverflow::Clip && currentLineBottom > rectSize.y)
 						{
 							return false;
 						}
 
-						if (!lineGlyphs.empty())
+						if (lineHasGlyphs)
 						{
 							// AutoShrinkの場合はスケールを適用
 							// (AutoShrinkWidthの場合、通常スケールで計算したサイズとノード幅を元にスケールを決めるため、ここではスケールを適用しない)
@@ -107,27 +318,38 @@ namespace noco
 							maxBottomT = 1.0;
 						}
 
-						lineCaches.push_back({
-							.glyphs = lineGlyphs,
-							.width = offset.x,
-							.offsetY = offset.y,
-							.minTopT = minTopT,
-							.maxBottomT = maxBottomT,
-						});
-						lineGlyphs.clear();
+						if (!measureOnly)
+						{
+							layoutData.lineCaches.push_back({
+								.glyphBegin = lineHasGlyphs ? lineBegin : 0,
+								.glyphEnd = lineHasGlyphs ? lineEnd : 0,
+								.width = offset.x,
+								.offsetY = offset.y,
+								.minTopT = minTopT,
+								.maxBottomT = maxBottomT,
+							});
+						}
+						lineHasGlyphs = false;
 						maxWidth = Max(maxWidth, offset.x);
 						offset.x = 0;
 						minTopT = 1.0;
 						maxBottomT = 0.0;
 
 						offset.y = currentLineBottom + spacing.y;
+
+						if (measureOnly && (maxWidth > rectSize.x || currentLineBottom > rectSize.y))
+						{
+							// 収まらないことが確定したため以降の計算は不要
+							exceeded = true;
+							return false;
+						}
 						return true;
 					};
 
 				const double fontHeight = Max(currentFont.height(targetFontSize), 1.0);
-				const Array<Glyph> glyphs = currentFont.getGlyphs(text);
-				for (const auto& glyph : glyphs)
+				for (size_t glyphIndex = 0; glyphIndex < glyphs.size(); ++glyphIndex)
 				{
+					const Glyph& glyph = glyphs[glyphIndex];
 					if (glyph.codePoint == U'\n')
 					{
 						if (!fnPushLine())
@@ -141,7 +363,7 @@ namespace noco
 					// (AutoShrinkWidthの場合、通常スケールで計算したサイズとノード幅を元にスケールを決めるため、ここではスケールを適用しない)
 					const double spacingScale = newSizingMode == LabelSizingMode::AutoShrink ? targetFontSize / fontSize : 1.0;
 
-					const double xAdvance = glyph.xAdvance * this->assetFontSizeScale + spacing.x * spacingScale;
+					const double xAdvance = glyph.xAdvance * layoutData.assetFontSizeScale + spacing.x * spacingScale;
 					if (hov == HorizontalOverflow::Wrap && offset.x + xAdvance > rectSize.x)
 					{
 						if (!fnPushLine())
@@ -151,94 +373,107 @@ namespace noco
 					}
 
 					offset.x += xAdvance;
-					lineGlyphs.push_back(glyph);
+					if (!lineHasGlyphs)
+					{
+						lineBegin = glyphIndex;
+					}
+					lineEnd = glyphIndex + 1;
+					lineHasGlyphs = true;
 
-					const double glyphTop = glyph.getOffset(this->assetFontSizeScale).y;
+					const double glyphTop = glyph.getOffset(layoutData.assetFontSizeScale).y;
 					minTopT = Min(minTopT, glyphTop / fontHeight);
-					maxBottomT = Max(maxBottomT, (glyphTop + glyph.texture.size.y * this->assetFontSizeScale) / fontHeight);
+					maxBottomT = Max(maxBottomT, (glyphTop + glyph.texture.size.y * layoutData.assetFontSizeScale) / fontHeight);
 				}
 
-				fnPushLine();
+				if (!exceeded)
+				{
+					fnPushLine();
+				}
 
 				return { maxWidth, offset.y - spacing.y };
 			};
 
 		if (newSizingMode == LabelSizingMode::AutoShrink)
 		{
-			double currentFontSize = fontSize;
-			while (currentFontSize >= minFontSize)
-			{
-				// 現在のフォントサイズで収まるかチェック(Overflowで計算)
-				const SizeF requiredSize = refreshCacheAndGetRegionSize(currentFontSize, horizontalOverflow, VerticalOverflow::Overflow);
-				if (requiredSize.x <= rectSize.x && requiredSize.y <= rectSize.y)
+			// 指定フォントサイズからautoShrinkPrecision刻みで縮小した候補のうち、収まる最大のものを求める
+			// (最後の候補は最小フォントサイズで、収まらない場合もそれを採用する)
+			const double precision = Max(autoShrinkPrecision, MinAutoShrinkPrecision);
+			const auto fnCandidateFontSize = [&](size_t step)
 				{
-					break;
-				}
-
-				currentFontSize -= 1.0;
-				if (currentFontSize < minFontSize)
+					return Max(fontSize - step * precision, minFontSize);
+				};
+			const auto fnFits = [&](size_t step)
 				{
-					currentFontSize = minFontSize;
-					break;
-				}
+					// 現在のフォントサイズで収まるかチェック(Overflowで計算し、サイズが分かった時点で打ち切る)
+					const SizeF requiredSize = refreshCacheAndGetRegionSize(fnCandidateFontSize(step), horizontalOverflow, VerticalOverflow::Overflow, true);
+					return requiredSize.x <= rectSize.x && requiredSize.y <= rectSize.y;
+				};
+
+			double currentFontSize = fontSize;
+			if (fontSize > minFontSize)
+			{
+				const size_t lastStep = static_cast<size_t>(Math::Ceil((fontSize - minFontSize) / precision));
+				currentFontSize = fnCandidateFontSize(detail::FindFirstFittingCandidate(lastStep + 1, fnFits));
 			}
-			this->effectiveFontSize = currentFontSize;
-			this->effectiveAutoShrinkWidthScale = 1.0;
+			layoutData.effectiveFontSize = currentFontSize;
+			layoutData.effectiveAutoShrinkWidthScale = 1.0;
 
 			// 最終的なフォントサイズと、実際のVerticalOverflowでキャッシュを確定
-			this->regionSize = refreshCacheAndGetRegionSize(this->effectiveFontSize, horizontalOverflow, verticalOverflow);
+			layoutData.regionSize = refreshCacheAndGetRegionSize(layoutData.effectiveFontSize, horizontalOverflow, verticalOverflow);
 		}
 		else if (newSizingMode == LabelSizingMode::AutoShrinkWidth)
 		{
-			this->effectiveFontSize = fontSize;
+			layoutData.effectiveFontSize = fontSize;
 
 			// AutoShrinkWidthでは折り返さないため常にHorizontalOverflow::Overflowとする
-			this->regionSize = refreshCacheAndGetRegionSize(fontSize, HorizontalOverflow::Overflow, verticalOverflow);
-			if (this->regionSize.x > rectSize.x && this->regionSize.x > 0.0)
+			layoutData.regionSize = refreshCacheAndGetRegionSize(fontSize, HorizontalOverflow::Overflow, verticalOverflow);
+			if (layoutData.regionSize.x > rectSize.x && layoutData.regionSize.x > 0.0)
 			{
-				this->effectiveAutoShrinkWidthScale = rectSize.x / this->regionSize.x;
+				layoutData.effectiveAutoShrinkWidthScale = rectSize.x / layoutData.regionSize.x;
 			}
 			else
 			{
-				this->effectiveAutoShrinkWidthScale = 1.0;
+				layoutData.effectiveAutoShrinkWidthScale = 1.0;
 			}
 		}
 		else if (newSizingMode == LabelSizingMode::AutoShrinkWidthResizeHeight)
 		{
-			this->effectiveFontSize = fontSize;
+			layoutData.effectiveFontSize = fontSize;
 
 			// 折り返さないためHorizontalOverflow::Overflow、高さはリサイズするためVerticalOverflow::Overflow
-			this->regionSize = refreshCacheAndGetRegionSize(fontSize, HorizontalOverflow::Overflow, VerticalOverflow::Overflow);
-			if (this->regionSize.x > rectSize.x && this->regionSize.x > 0.0)
+			layoutData.regionSize = refreshCacheAndGetRegionSize(fontSize, HorizontalOverflow::Overflow, VerticalOverflow::Overflow);
+			if (layoutData.regionSize.x > rectSize.x && layoutData.regionSize.x > 0.0)
 			{
-				this->effectiveAutoShrinkWidthScale = rectSize.x / this->regionSize.x;
+				layoutData.effectiveAutoShrinkWidthScale = rectSize.x / layoutData.regionSize.x;
 			}
 			else
 			{
-				this->effectiveAutoShrinkWidthScale = 1.0;
+				layoutData.effectiveAutoShrinkWidthScale = 1.0;
 			}
 		}
 		else if (newSizingMode == LabelSizingMode::AutoResize)
 		{
 			// AutoResizeではノードサイズの誤差による折り返しやクリップが発生しないよう、両方Overflowとする
-			this->effectiveFontSize = fontSize;
-			this->effectiveAutoShrinkWidthScale = 1.0;
-			this->regionSize = refreshCacheAndGetRegionSize(fontSize, HorizontalOverflow::Overflow, VerticalOverflow::Overflow);
+			layoutData.effectiveFontSize = fontSize;
+			layoutData.effectiveAutoShrinkWidthScale = 1.0;
+			layoutData.regionSize = refreshCacheAndGetRegionSize(fontSize, HorizontalOverflow::Overflow, VerticalOverflow::Overflow);
 		}
 		else if (newSizingMode == LabelSizingMode::AutoResizeHeight)
 		{
 			// AutoResizeHeightでは幅は固定し、HorizontalOverflowの設定に従って折り返し、高さのみOverflowとする
-			this->effectiveFontSize = fontSize;
-			this->effectiveAutoShrinkWidthScale = 1.0;
-			this->regionSize = refreshCacheAndGetRegionSize(fontSize, horizontalOverflow, VerticalOverflow::Overflow);
+			layoutData.effectiveFontSize = fontSize;
+			layoutData.effectiveAutoShrinkWidthScale = 1.0;
+			layoutData.regionSize = refreshCacheAndGetRegionSize(fontSize, horizontalOverflow, VerticalOverflow::Overflow);
 		}
 		else // LabelSizingMode::Fixed
 		{
-			this->effectiveFontSize = fontSize;
-			this->effectiveAutoShrinkWidthScale = 1.0;
-			this->regionSize = refreshCacheAndGetRegionSize(fontSize, horizontalOverflow, verticalOverflow);
+			layoutData.effectiveFontSize = fontSize;
+			layoutData.effectiveAutoShrinkWidthScale = 1.0;
+			layoutData.regionSize = refreshCacheAndGetRegionSize(fontSize, horizontalOverflow, verticalOverflow);
 		}
 
+		layout = newLayout;
+		layoutLRU.insert(layoutKey, layout);
 		return true;
 	}
 
@@ -253,11 +488,14 @@ namespace noco
 
 		m_autoResizeCache.refreshIfDirty(
 			m_text.value(),
+			m_text.contentVersion(),
 			m_fontOpt,
 			m_fontAssetName.value(),
+			m_fontAssetName.contentVersion(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
 			m_minFontSize.value(),
+			m_autoShrinkPrecision.value(),
 			m_characterSpacing.value(),
 			HorizontalOverflow::Overflow, // rectSize指定なしでのサイズ計算は折り返さないようOverflowで固定
 			VerticalOverflow::Overflow, // rectSize指定なしでのサイズ計算はクリップされないようOverflowで固定
@@ -265,7 +503,7 @@ namespace noco
 			sizingMode);
 
 		// AutoResizeでは小数点以下を切り上げたサイズをノードサイズとして使用
-		const SizeF& regionSize = m_autoResizeCache.regionSize;
+		const SizeF& regionSize = m_autoResizeCache.layout->regionSize;
 		const SizeF ceiledRegionSize{ Math::Ceil(regionSize.x), Math::Ceil(regionSize.y) };
 
 		// AutoResizeでは余白を加えたサイズを使用
@@ -273,11 +511,64 @@ namespace noco
 		return ceiledRegionSize + Vec2{ padding.totalWidth(), padding.totalHeight() };
 	}
 
+	void Label::collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, detail::GlyphPrewarmList& list) const
+	{
+		if (m_fontOpt)
+		{
+			list.addProperty(*m_fontOpt, m_text, params);
+			return;
+		}
+
+		for (const Font& font : detail::GlyphPrewarmList::ResolveFonts(m_fontAssetName, canvasDefaultFontAssetName, params))
+		{
+			list.addProperty(font, m_text, params);
+		}
+	}
+
 	void Label::update(const std::shared_ptr<Node>& node)
 	{
 		refreshAutoResizeImmediately(node);
 	}
 
+	Optional<LRTB> Label::drawOverflow() const
+	{
+		// 領域外へのはみ出しを許可している場合は、テキストの内容により描画範囲が変わるため求めない
+		if (m_horizontalOverflow.value() == HorizontalOverflow::Overflow || m_verticalOverflow.value() == VerticalOverflow::Overflow)
+		{
+			return none;
+		}
+
+		// 影のずれはフォントの基準サイズに対する値のため、描画時の大きさを求めない
+		if (m_shadowColor.value().a > 0)
+		{
+			return none;
+		}
+
+		// 外側の輪郭線は文字の外側に最大でフォントサイズ×outlineFactorOuterまで広がる(自動縮小はフォントサイズを小さくするのみ)
+		const double outline = (m_outlineColor.value().a > 0) ? m_fontSize.value() * Max(m_outlineFactorOuter.value(), 0.0) : 0.0;
+
+		// 余白が負の場合は領域の外側に描画される
+		const LRTB& padding = m_padding.value();
+		return LRTB{
+			.left = Max(-padding.left, 0.0) + outline,
+			.right = Max(-padding.right, 0.0) + outline,
+			.top = Max(-padding.top, 0.0) + outline,
+			.bottom = Max(-padding.bottom, 0.0) + outline,
+		};
+	}
+
+	uint64 Label::resolvedAssetsHash(const Node& node) const
+	{
+		// フォントアセットの登録・解除やsetFontで使用するフォントが変わるため、フォントのIDを使用
+		if (m_fontOpt)
+		{
+			return static_cast<uint64>(m_fontOpt->id().value());
+		}
+		const auto canvas = node.containedCanvas();
+		const Font font = noco::detail::ResolveFont(m_fontAssetName.value(), canvas ? canvas->defaultFontAssetName() : EmptyString);
+		return static_cast<uint64>(font.id().value());
+	}
+
 	void Label::draw(const Node& node) const
 	{
 		const auto& text = m_text.value();
@@ -308,18 +599,23 @@ namespace noco
 
 		m_cache.refreshIfDirty(
 			text,
+			m_text.contentVersion(),
 			m_fontOpt,
 			m_fontAssetName.value(),
+			m_fontAssetName.contentVersion(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
 			m_minFontSize.value(),
+			m_autoShrinkPrecision.value(),
 			characterSpacing,
 			m_horizontalOverflow.value(),
 			m_verticalOverflow.value(),
 			rect.size,
 			m_sizingMode.value());
 
-		const double startY = [this, &rect]()
+		const detail::LabelLayout& layout = *m_cache.layout;
+
+		const double startY = [this, &rect, &layout]()
 			{
 				const VerticalAlign& verticalAlign = m_verticalAlign.value();
 				switch (verticalAlign)
@@ -327,9 +623,9 @@ namespace noco
 				case VerticalAlign::Top:
 					return rect.y;
 				case VerticalAlign::Middle:
-					return rect.y + (rect.h - m_cache.regionSize.y) / 2;
+					return rect.y + (rect.h - layout.regionSize.y) / 2;
 				case VerticalAlign::Bottom:
-					return rect.y + rect.h - m_cache.regionSize.y;
+					return rect.y + rect.h - layout.regionSize.y;
 				default:
 					throw Error{ U"Invalid VerticalAlign: {}"_fmt(static_cast<std::underlying_type_t<VerticalAlign>>(verticalAlign)) };
 				}
@@ -364,7 +660,7 @@ namespace noco
 		}
 
 		const double autoShrinkWidthScale = (m_sizingMode.value() == LabelSizingMode::AutoShrinkWidth || m_sizingMode.value() == LabelSizingMode::AutoShrinkWidthResizeHeight)
-			? m_cache.effectiveAutoShrinkWidthScale
+			? layout.effectiveAutoShrinkWidthScale
 			: 1.0;
 
 		{
@@ -382,7 +678,7 @@ namespace noco
 				}
 			}
 
-			const double horizontalGradationWidth = m_cache.regionSize.x <= 0.0 ? 1.0 : m_cache.regionSize.x;
+			const double horizontalGradationWidth = layout.regionSize.x <= 0.0 ? 1.0 : layout.regionSize.x;
 			const double gradientLeft = [&rect, horizontalAlign, horizontalGradationWidth]()
 				{
 					switch (horizontalAlign)
@@ -402,7 +698,7 @@ namespace noco
 			const ColorF& gradationColor1 = m_gradationColor1.value();
 			const ColorF& gradationColor2 = m_gradationColor2.value();
 
-			for (const auto& lineCache : m_cache.lineCaches)
+			for (const auto& lineCache : layout.lineCaches)
 			{
 				const double effectiveLineWidth = lineCache.width * autoShrinkWidthScale;
 
@@ -423,24 +719,25 @@ namespace noco
 
 				double x = 0;
 
-				for (const auto& glyph : lineCache.glyphs)
+				for (size_t glyphIndex = lineCache.glyphBegin; glyphIndex < lineCache.glyphEnd; ++glyphIndex)
 				{
+					const Glyph& glyph = layout.glyphs[glyphIndex];
 					if (glyph.codePoint == U'\n')
 					{
 						continue;
 					}
 
 					const Vec2 pos{ startX + x, startY + lineCache.offsetY };
-					const Vec2 drawPos = pos + glyph.getOffset(m_cache.assetFontSizeScale) * Vec2{ autoShrinkWidthScale, 1.0 };
-					const auto scaledTexture = glyph.texture.scaled(m_cache.assetFontSizeScale * autoShrinkWidthScale, m_cache.assetFontSizeScale);
+					const Vec2 drawPos = pos + glyph.getOffset(layout.assetFontSizeScale) * Vec2{ autoShrinkWidthScale, 1.0 };
+					const auto scaledTexture = glyph.texture.scaled(layout.assetFontSizeScale * autoShrinkWidthScale, layout.assetFontSizeScale);
 
 					switch (gradationType)
 					{
 					case LabelGradationType::TopBottom:
 					{
-						const double lineGradationHeight = Max(m_cache.lineHeight, 1e-6);
-						const double topT = Clamp(glyph.getOffset(m_cache.assetFontSizeScale).y / lineGradationHeight, 0.0, 1.0);
-						const double bottomT = Clamp((glyph.getOffset(m_cache.assetFontSizeScale).y + glyph.texture.size.y * m_cache.assetFontSizeScale) / lineGradationHeight, 0.0, 1.0);
+						const double lineGradationHeight = Max(layout.lineHeight, 1e-6);
+						const double topT = Clamp(glyph.getOffset(layout.assetFontSizeScale).y / lineGradationHeight, 0.0, 1.0);
+						const double bottomT = Clamp((glyph.getOffset(layout.assetFontSizeScale).y + glyph.texture.size.y * layout.assetFontSizeScale) / lineGradationHeight, 0.0, 1.0);
 						const double minMaxTAbsDiff = Max(lineCache.maxBottomT - lineCache.minTopT, 1e-6);
 						const double scaledTopT = (topT - lineCache.minTopT) / minMaxTAbsDiff;
 						const double scaledBottomT = (bottomT - lineCache.minTopT) / minMaxTAbsDiff;
@@ -453,7 +750,7 @@ namespace noco
 					case LabelGradationType::LeftRight:
 					{
 						const double glyphLeft = drawPos.x;
-						const double glyphWidth = static_cast<double>(glyph.texture.size.x) * m_cache.assetFontSizeScale * autoShrinkWidthScale;
+						const double glyphWidth = static_cast<double>(glyph.texture.size.x) * layout.assetFontSizeScale * autoShrinkWidthScale;
 						const double glyphRight = glyphLeft + glyphWidth;
 						const double leftT = Clamp((glyphLeft - gradientLeft) / horizontalGradationWidth, 0.0, 1.0);
 						const double rightT = Clamp((glyphRight - gradientLeft) / horizontalGradationWidth, 0.0, 1.0);
@@ -473,7 +770,7 @@ namespace noco
 					switch (m_sizingMode.value())
 					{
 					case LabelSizingMode::AutoShrink:
-						spacingScale = m_cache.effectiveFontSize / m_fontSize.value();
+						spacingScale = layout.effectiveFontSize / m_fontSize.value();
 						break;
 					case LabelSizingMode::AutoShrinkWidth:
 					case LabelSizingMode::AutoShrinkWidthResizeHeight:
@@ -486,14 +783,14 @@ namespace noco
 						spacingScale = 1.0;
 						break;
 					}
-					x += (glyph.xAdvance * m_cache.assetFontSizeScale * autoShrinkWidthScale + characterSpacing.x * spacingScale);
+					x += (glyph.xAdvance * layout.assetFontSizeScale * autoShrinkWidthScale + characterSpacing.x * spacingScale);
 				}
 			}
 		}
 
 		if (m_underlineStyle.value() == LabelUnderlineStyle::Solid)
 		{
-			for (const auto& lineCache : m_cache.lineCaches)
+			for (const auto& lineCache : layout.lineCaches)
 			{
 				const double effectiveLineWidth = lineCache.width * autoShrinkWidthScale;
 				const double startX = [&rect, effectiveLineWidth, horizontalAlign]()
@@ -512,7 +809,7 @@ namespace noco
 					}();
 
 				const double thickness = m_underlineThickness.value();
-				const double y = startY + (lineCache.offsetY + m_cache.lineHeight);
+				const double y = startY + (lineCache.offsetY + layout.lineHeight);
 				Line{ startX, y, startX + effectiveLineWidth, y }.draw(thickness, m_underlineColor.value());
 			}
 		}
@@ -529,36 +826,42 @@ namespace noco
 
 		m_cache.refreshIfDirty(
 			m_text.value(),
+			m_text.contentVersion(),
 			m_fontOpt,
 			m_fontAssetName.value(),
+			m_fontAssetName.contentVersion(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
 			m_minFontSize.value(),
+			m_autoShrinkPrecision.value(),
 			m_characterSpacing.value(),
 			HorizontalOverflow::Overflow, // rectSize指定なしでのサイズ計算は折り返さないようOverflowで固定
 			VerticalOverflow::Overflow, // rectSize指定なしでのサイズ計算はクリップされないようOverflowで固定
 			m_cache.prevParams.has_value() ? m_cache.prevParams->rectSize : Vec2::Zero(), // rectSizeは使われないので、キャッシュ再更新がなるべく走らないよう前回と同じ値を渡す
 			sizingMode);
 
-		return m_cache.regionSize;
+		return m_cache.layout->regionSize;
 	}
 
 	SizeF Label::getContentSize(const SizeF& rectSize, const String& canvasDefaultFontAssetName) const
 	{
 		m_cache.refreshIfDirty(
 			m_text.value(),
+			m_text.contentVersion(),
 			m_fontOpt,
 			m_fontAssetName.value(),
+			m_fontAssetName.contentVersion(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
 			m_minFontSize.value(),
+			m_autoShrinkPrecision.value(),
 			m_characterSpacing.value(),
 			m_horizontalOverflow.value(),
 			m_verticalOverflow.value(),
 			rectSize,
 			m_sizingMode.value());
 
-		return m_cache.regionSize;
+		return m_cache.layout->regionSize;
 	}
 
 	void Label::refreshAutoResizeImmediately(const std::shared_ptr<Node>& node)
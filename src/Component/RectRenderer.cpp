@@ -3,6 +3,49 @@
 
 namespace noco
 {
+	bool RectRenderer::isOpaqueFullRect() const
+	{
+		// 角丸の場合は四隅が透けるため対象外
+		if (m_cornerRadius.value() != 0.0 || m_blendMode.value() != BlendMode::Normal)
+		{
+			return false;
+		}
+
+		switch (m_fillGradationType.value())
+		{
+		case RectFillGradationType::TopBottom:
+		case RectFillGradationType::LeftRight:
+			return m_fillGradationColor1.value().a == 255 && m_fillGradationColor2.value().a == 255;
+		default:
+			return m_fillColor.value().a == 255;
+		}
+	}
+
+	Optional<LRTB> RectRenderer::drawOverflow() const
+	{
+		LRTB overflow = LRTB::Zero();
+
+		// 外側の輪郭線
+		if (m_outlineColor.value().a > 0)
+		{
+			const double outlineThicknessOuter = Max(m_outlineThicknessOuter.value(), 0.0);
+			overflow = LRTB::All(outlineThicknessOuter);
+		}
+
+		// 影は領域をspreadだけ広げてoffsetだけずらし、blurの幅でぼかして描画される
+		if (m_shadowColor.value().a > 0)
+		{
+			const Vec2& shadowOffset = m_shadowOffset.value();
+			const double shadowExtent = Max(m_shadowSpread.value(), 0.0) + Max(m_shadowBlur.value(), 0.0);
+			overflow.left = Max(overflow.left, shadowExtent - shadowOffset.x);
+			overflow.right = Max(overflow.right, shadowExtent + shadowOffset.x);
+			overflow.top = Max(overflow.top, shadowExtent - shadowOffset.y);
+			overflow.bottom = Max(overflow.bottom, shadowExtent + shadowOffset.y);
+		}
+
+		return overflow;
+	}
+
 	void RectRenderer::draw(const Node& node) const
 	{
 		const RectFillGradationType fillGradationType = m_fillGradationType.value();
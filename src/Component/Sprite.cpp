@@ -122,14 +122,14 @@ namespace noco
 
 	namespace
 	{
-		Texture GetTexture(const String& textureFilePath, const String& textureAssetName)
+		std::shared_ptr<const Texture> GetTexture(const String& textureFilePath, const String& textureAssetName, AllowPlaceholderYN allowPlaceholder)
 		{
 			if (detail::IsEditorMode())
 			{
 				// エディタモードではアセット名は無視してファイル名のみを使用
 				if (!textureFilePath.empty())
 				{
-					return noco::Asset::GetOrLoadTexture(textureFilePath);
+					return noco::Asset::AcquireTexture(textureFilePath, allowPlaceholder);
 				}
 			}
 			else
@@ -138,14 +138,14 @@ namespace noco
 				// 気付かないうちにファイルパスが使われるのを避けるため、TextureAssetに指定されたキーが存在しない時もファイルパスへのフォールバックはしない仕様とする
 				if (!textureAssetName.empty())
 				{
-					return TextureAsset(textureAssetName);
+					return std::make_shared<const Texture>(TextureAsset(textureAssetName));
 				}
 				if (!textureFilePath.empty())
 				{
-					return noco::Asset::GetOrLoadTexture(textureFilePath);
+					return noco::Asset::AcquireTexture(textureFilePath, allowPlaceholder);
 				}
 			}
-			return Texture{};
+			return nullptr;
 		}
 	}
 
@@ -346,22 +346,50 @@ namespace noco
 		}
 	}
 
-	void Sprite::draw(const Node& node) const
+	void Sprite::collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const
 	{
-		Texture texture;
-		
-		// m_textureOptが設定されている場合は優先的に使用
-		if (m_textureOpt)
+		// 通常モードではアセット名が指定されている場合はファイルパスが使われないため対象外とする
+		if (!detail::IsEditorMode() && !m_textureAssetName.value().empty())
 		{
-			texture = *m_textureOpt;
+			return;
 		}
-		else
+		detail::ForEachPossibleStringValue(m_textureFilePath, params, [&](const String& textureFilePath) { dependencies.addTextureFilePath(textureFilePath); });
+	}
+
+	void Sprite::CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies)
+	{
+		// 通常モードではアセット名が指定されている場合はファイルパスが使われないため対象外とする
+		if (!detail::IsEditorMode() && !detail::GetDefaultStringValueFromJSON(json, U"textureAssetName").empty())
 		{
-			const String& textureFilePath = m_textureFilePath.value();
-			const String& textureAssetName = m_textureAssetName.value();
-			texture = GetTexture(textureFilePath, textureAssetName);
+			return;
 		}
-		
+		detail::ForEachPossibleStringValueInJSON(json, U"textureFilePath", params, [&](const String& textureFilePath) { dependencies.addTextureFilePath(textureFilePath); });
+	}
+
+	const Texture& Sprite::resolveTexture() const
+	{
+		// m_textureOptが設定されている場合は優先的に使用
+		if (m_textureOpt)
+		{
+			return *m_textureOpt;
+		}
+
+		// テクスチャの一部の領域を切り出して描画する場合、非同期読み込み中の代替テクスチャでは正しく描画できないため使用しない
+		const AllowPlaceholderYN allowPlaceholder{ m_textureRegionMode.value() == TextureRegionMode::Full && !m_nineSliceEnabled.value() };
+
+		// 解決済みのテクスチャをキャッシュから取得(アセットテーブルの検索を毎フレーム行わないため)
+		return m_resolvedTextureCache.getOrResolve(
+			m_textureFilePath.contentVersion(),
+			m_textureAssetName.contentVersion(),
+			detail::IsEditorMode(),
+			allowPlaceholder,
+			Asset::Generation(),
+			[&] { return GetTexture(m_textureFilePath.value(), m_textureAssetName.value(), allowPlaceholder); });
+	}
+
+	void Sprite::draw(const Node& node) const
+	{
+		const Texture& texture = resolveTexture();
 		const RectF rect = node.regionRect();
 		const Color& color = m_color.value();
 		const Color& addColorValue = m_addColor.value();
@@ -628,6 +656,44 @@ namespace noco
 		}
 	}
 
+	bool Sprite::isOpaqueFullRect() const
+	{
+		// テクスチャが不透明と指定されていても、アスペクト比保持やブレンド・シェーダー適用時は領域全体を覆うとは限らない
+		if (!m_textureOpaque.value())
+		{
+			return false;
+		}
+		if (m_color.value().a != 255 || m_blendMode.value() != BlendMode::Normal || m_preserveAspect.value() || !m_pixelShaderAssetName.value().empty())
+		{
+			return false;
+		}
+		// テクスチャが空の場合(未指定・ファイルが存在しない・読み込み中等)は描画されないか空のテクスチャとして描画されるため対象外とする
+		// 読み込み中の代替テクスチャは不透明とは限らないため対象外とする
+		const Texture& texture = resolveTexture();
+		if (texture.isEmpty())
+		{
+			return false;
+		}
+		if (const Texture& placeholderTexture = Asset::PlaceholderTexture(); !placeholderTexture.isEmpty() && texture.id() == placeholderTexture.id())
+		{
+			return false;
+		}
+		return true;
+	}
+
+	bool Sprite::requiresRedrawEveryFrame() const
+	{
+		// アニメーションはプロパティ外の状態(経過時間)で描画内容が変化するため
+		return m_gridAnimationType.value() != SpriteGridAnimationType::None
+			|| m_offsetAnimationType.value() != SpriteOffsetAnimationType::None;
+	}
+
+	uint64 Sprite::resolvedAssetsHash(const Node&) const
+	{
+		// 非同期読み込みの完了やアセットの再読み込みで解決されるテクスチャが変わるため、テクスチャのIDを使用
+		return static_cast<uint64>(resolveTexture().id().value());
+	}
+
 	void Sprite::drawNineSliceFromRegion(const Texture& texture, const RectF& sourceRect, const RectF& rect, const Color& color) const
 	{
 		const LRTB& margin = m_nineSliceMargin.value();
@@ -2,6 +2,8 @@
 #include "NocoUI/Node.hpp"
 #include "NocoUI/Canvas.hpp"
 #include "NocoUI/Asset.hpp"
+#include "NocoUI/AssetArchive.hpp"
+#include "NocoUI/CanvasPrototype.hpp"
 
 namespace noco
 {
@@ -138,11 +140,9 @@ namespace noco
 			return;
 		}
 
-		// 絶対パス/相対パスをフルパスに変換
-		const FilePath fullPath = noco::Asset::GetFullPath(path);
-
-		// ファイルが存在しない場合はスキップ
-		if (!FileSystem::Exists(fullPath))
+		// ファイルが存在しない場合はスキップ(マウント中のアーカイブに含まれる場合はファイルシステムにアクセスしない)
+		const bool isInArchive = noco::Asset::IsInArchive(path);
+		if (!isInArchive && !FileSystem::Exists(noco::Asset::GetFullPath(path)))
 		{
 			m_canvas.reset();
 			m_loadedPath.clear();
@@ -152,14 +152,15 @@ namespace noco
 		}
 
 		// グローバルスタックを使用して循環参照とネストレベルを確認
-		const FilePath normalizedFullPath = FileSystem::FullPath(fullPath);
+		const FilePath normalizedFullPath = isInArchive
+			? U"archive:" + AssetArchive::NormalizePath(path)
+			: FileSystem::FullPath(noco::Asset::GetFullPath(path));
 
 		// 最大ネストレベルチェック
-		constexpr int32 kMaxNestLevel = 10;
 		const auto& loadingPaths = LoadingPaths();
-		if (loadingPaths.size() >= kMaxNestLevel)
+		if (loadingPaths.size() >= MaxNestLevel)
 		{
-			Logger << U"[NocoUI error] SubCanvas load aborted due to exceeding maximum nest level ({}): {}"_fmt(kMaxNestLevel, path);
+			Logger << U"[NocoUI error] SubCanvas load aborted due to exceeding maximum nest level ({}): {}"_fmt(MaxNestLevel, path);
 			m_canvas.reset();
 			m_loadedPath = path; // 再読み込みさせないため、既に読み込み済み扱いとする
 			m_loadedAssetBasePath = currentBasePath;
@@ -180,18 +181,18 @@ namespace noco
 
 		const LoadingPathGuard guard{ normalizedFullPath };
 
-		const JSON& json = noco::Asset::GetOrLoadJSON(path);
-		if (!json)
+		// 同じCanvasファイルを参照するSubCanvas間でプロトタイプを共有し、JSONを毎回辿らずに生成する
+		const auto prototype = noco::Asset::GetOrLoadCanvasPrototype(path);
+		if (!prototype && noco::Asset::IsLoading(path))
 		{
+			// 非同期読み込み中の場合は読み込み済み扱いにせず、次フレーム以降に再試行する
 			m_canvas.reset();
-			m_loadedPath = path;
-			m_loadedAssetBasePath = currentBasePath;
+			m_loadedPath.clear();
+			m_loadedAssetBasePath.clear();
 			m_loadedCanvasAutoFitMode = AutoFitMode::None;
 			return;
 		}
-
-		auto canvas = Canvas::CreateFromJSON(json);
-		if (!canvas)
+		if (!prototype)
 		{
 			m_canvas.reset();
 			m_loadedPath = path;
@@ -200,6 +201,7 @@ namespace noco
 			return;
 		}
 
+		auto canvas = prototype->instantiate();
 		m_canvas = canvas;
 		m_loadedPath = path;
 		m_loadedAssetBasePath = currentBasePath;
@@ -211,6 +213,16 @@ namespace noco
 		m_appliedSerializedParamBindingModesJSON.clear();
 	}
 
+	std::shared_ptr<SerializableComponentBase> SubCanvas::cloneComponent(const ComponentFactory& factory) const
+	{
+		auto component = SerializableComponentBase::cloneComponent(factory);
+		if (const auto subCanvas = std::dynamic_pointer_cast<SubCanvas>(component))
+		{
+			subCanvas->loadCanvasInternal();
+		}
+		return component;
+	}
+
 	void SubCanvas::update(const std::shared_ptr<Node>& node)
 	{
 		// パスが変更されていたら再読み込み
@@ -444,6 +456,16 @@ namespace noco
 		}
 	}
 
+	void SubCanvas::collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const
+	{
+		detail::ForEachPossibleStringValue(m_canvasPath, params, [&](const String& canvasPath) { dependencies.addCanvasFilePath(canvasPath); });
+	}
+
+	void SubCanvas::CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies)
+	{
+		detail::ForEachPossibleStringValueInJSON(json, U"canvasPath", params, [&](const String& canvasPath) { dependencies.addCanvasFilePath(canvasPath); });
+	}
+
 	void SubCanvas::draw(const Node&) const
 	{
 		if (m_canvas)
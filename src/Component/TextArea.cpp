@@ -10,96 +10,176 @@ namespace noco
 		static const String EmptyString = U"";
 	}
 
-	void TextArea::Cache::refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize)
+	void detail::TextAreaCache::refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize, uint64 textVersion)
 	{
-		if (prevParams.has_value() && !prevParams->isDirty(text, fontAssetName, fontSize, rectSize))
+		if (!prevParams.has_value() || prevParams->isLayoutDirty(fontAssetName, fontSize, rectSize))
 		{
+			// レイアウト条件が変化した場合は全体を作り直す
+			prevParams = TextAreaCacheParams
+			{
+				.text = String{ text },
+				.textVersion = textVersion,
+				.fontAssetName = String{ fontAssetName },
+				.fontSize = fontSize,
+				.rectSize = rectSize,
+			};
+
+			font = noco::detail::ResolveFont(fontAssetName, canvasDefaultFontAssetName);
+			fontMethod = font.method();
+			const int32 baseFontSize = font.fontSize();
+			scale = (baseFontSize == 0) ? 1.0 : (fontSize / baseFontSize);
+			lineHeight = font.height(fontSize);
+
+			paragraphs.clear();
+			replaceParagraphs(text, 0, 0, 0, text.size());
+			rebuildLines();
+			return;
+		}
+
+		if (textVersion != 0 && textVersion == prevParams->textVersion)
+		{
+			// 内容バージョンが一致する場合はテキストの比較を省略する
+			return;
+		}
+		prevParams->textVersion = textVersion;
+
+		const StringView prevText = prevParams->text;
+
+		// 前回のテキストとの共通の先頭・末尾を除いた範囲を変化した範囲とする
+		const size_t minLength = Min(prevText.size(), text.size());
+		size_t prefixLength = 0;
+		while (prefixLength < minLength && prevText[prefixLength] == text[prefixLength])
+		{
+			++prefixLength;
+		}
+		if (prefixLength == prevText.size() && prefixLength == text.size())
+		{
+			// テキストに変化なし
 			return;
 		}
-		prevParams = CacheParams
+		size_t suffixLength = 0;
+		while (suffixLength < minLength - prefixLength && prevText[prevText.size() - 1 - suffixLength] == text[text.size() - 1 - suffixLength])
+		{
+			++suffixLength;
+		}
+		const size_t prevChangedEnd = prevText.size() - suffixLength;
+
+		// 変化した範囲を含む段落のみ作り直す
+		// (変化範囲の外側は前回と同じテキストのため、段落の区切りも前回と一致する)
+		const size_t firstParagraph = findParagraphIndex(prefixLength);
+		const size_t lastParagraph = findParagraphIndex(prevChangedEnd);
+		const size_t replaceTextBegin = paragraphs[firstParagraph].textBeginIndex;
+		const size_t replaceTextEnd = paragraphs[lastParagraph].textEndIndex() + text.size() - prevText.size();
+		replaceParagraphs(text, firstParagraph, lastParagraph + 1, replaceTextBegin, replaceTextEnd);
+
+		prevParams->text = String{ text };
+		rebuildLines();
+	}
+
+	void detail::TextAreaCache::replaceParagraphs(StringView text, size_t firstParagraph, size_t lastParagraph, size_t textBegin, size_t textEnd)
+	{
+		const double wrapWidth = prevParams ? prevParams->rectSize.x : 0.0;
+
+		Array<TextAreaParagraphCache> newParagraphs;
+		size_t paragraphBegin = textBegin;
+		while (true)
 		{
-			.text = String{ text },
-			.fontAssetName = String{ fontAssetName },
-			.fontSize = fontSize,
-			.rectSize = rectSize,
-		};
-
-		const Font font = [&]() -> Font {
-			if (!fontAssetName.empty() && FontAsset::IsRegistered(fontAssetName))
+			size_t paragraphEnd = paragraphBegin;
+			while (paragraphEnd < textEnd && text[paragraphEnd] != U'\n')
 			{
-				return FontAsset(fontAssetName);
+				++paragraphEnd;
 			}
 
-			if (!canvasDefaultFontAssetName.empty() && FontAsset::IsRegistered(canvasDefaultFontAssetName))
+			TextAreaParagraphCache paragraph;
+			paragraph.textBeginIndex = paragraphBegin;
+			paragraph.textLength = paragraphEnd - paragraphBegin;
+			paragraph.glyphs = font.getGlyphs(text.substr(paragraphBegin, paragraph.textLength));
+
+			// 折り返し位置を計算
+			const size_t glyphCount = Min(paragraph.glyphs.size(), paragraph.textLength);
+			paragraph.advanceOffsets.resize(glyphCount + 1);
+			paragraph.advanceOffsets[0] = 0.0;
+			size_t lineBegin = 0;
+			double lineWidth = 0.0;
+			for (size_t i = 0; i < glyphCount; ++i)
 			{
-				return FontAsset(canvasDefaultFontAssetName);
+				const double glyphWidth = paragraph.glyphs[i].xAdvance * scale;
+				paragraph.advanceOffsets[i + 1] = paragraph.advanceOffsets[i] + glyphWidth;
+				if (lineWidth + glyphWidth > wrapWidth && i > lineBegin)
+				{
+					paragraph.wrappedLines.push_back({ lineBegin, i, lineWidth });
+					paragraph.maxWidth = Max(paragraph.maxWidth, lineWidth);
+					lineBegin = i;
+					lineWidth = 0.0;
+				}
+				lineWidth += glyphWidth;
 			}
+			paragraph.wrappedLines.push_back({ lineBegin, glyphCount, lineWidth });
+			paragraph.maxWidth = Max(paragraph.maxWidth, lineWidth);
 
-			if (auto globalFont = noco::detail::GetGlobalDefaultFont())
+			newParagraphs.push_back(std::move(paragraph));
+
+			if (paragraphEnd >= textEnd)
 			{
-				return *globalFont;
+				break;
 			}
+			paragraphBegin = paragraphEnd + 1;
+		}
+
+		paragraphs.erase(paragraphs.begin() + firstParagraph, paragraphs.begin() + lastParagraph);
+		paragraphs.insert(paragraphs.begin() + firstParagraph, std::make_move_iterator(newParagraphs.begin()), std::make_move_iterator(newParagraphs.end()));
+
+		// 後続の段落の開始位置をずらす
+		for (size_t i = firstParagraph + newParagraphs.size(); i < paragraphs.size(); ++i)
+		{
+			paragraphs[i].textBeginIndex = paragraphs[i - 1].textEndIndex() + 1;
+		}
+	}
 
-			return SimpleGUI::GetFont();
-		}();
-		fontMethod = font.method();
-		const Array<Glyph> allGlyphs = font.getGlyphs(text);
-		const int32 baseFontSize = font.fontSize();
-		scale = (baseFontSize == 0) ? 1.0 : (fontSize / baseFontSize);
-		lineHeight = font.height(fontSize);
+	void detail::TextAreaCache::rebuildLines()
+	{
 		lines.clear();
 
-		Array<Glyph> lineGlyphs;
-		size_t lineBeginIndex = 0;
-		size_t currentIndex = 0;
-		double lineWidth = 0.0;
-		double maxWidth = 0.0;
-		const auto fnPushLine = [&]()
+		// テキストが空の場合は行なしとする
+		if (paragraphs.size() == 1 && paragraphs.front().textLength == 0)
 		{
-			lines.push_back({
-				lineGlyphs,
-				lineBeginIndex,
-				currentIndex,
-				lineWidth
-			});
-			lineGlyphs.clear();
-			lineBeginIndex = currentIndex;
-			maxWidth = Max(maxWidth, lineWidth);
-			lineWidth = 0.0;
-		};
-
-		for (size_t i = 0; i < text.length(); ++i, ++currentIndex)
+			regionSize = SizeF::Zero();
+			return;
+		}
+
+		double maxWidth = 0.0;
+		for (size_t paragraphIndex = 0; paragraphIndex < paragraphs.size(); ++paragraphIndex)
 		{
-			if (text[i] == U'\n')
-			{
-				// 改行文字のglyphは描画しないので、lineGlyphsには追加しない
-				fnPushLine();
-				lineBeginIndex = currentIndex + 1;
-				continue;
-			}
-			// 改行文字以外の場合、対応するglyphを追加
-			if (i < allGlyphs.size())
+			const auto& paragraph = paragraphs[paragraphIndex];
+			for (const auto& wrappedLine : paragraph.wrappedLines)
 			{
-				const auto& glyph = allGlyphs[i];
-				const double glyphWidth = glyph.xAdvance * scale;
-				if (lineWidth + glyphWidth > rectSize.x && !lineGlyphs.empty())
-				{
-					fnPushLine();
-				}
-				lineGlyphs.push_back(glyph);
-				lineWidth += glyphWidth;
+				lines.push_back({
+					.paragraphIndex = paragraphIndex,
+					.glyphBegin = wrappedLine.glyphBegin,
+					.glyphEnd = wrappedLine.glyphEnd,
+					.textBeginIndex = paragraph.textBeginIndex + wrappedLine.glyphBegin,
+					.textEndIndex = (&wrappedLine == &paragraph.wrappedLines.back()) ? paragraph.textEndIndex() : paragraph.textBeginIndex + wrappedLine.glyphEnd,
+					.width = wrappedLine.width,
+				});
 			}
+			maxWidth = Max(maxWidth, paragraph.maxWidth);
 		}
-		// 最後の行を追加
-		// テキストが空でない場合、または改行で終わっている場合は必ず最後の行を追加
-		if (!text.empty())
+		regionSize = { maxWidth, lines.size() * lineHeight };
+	}
+
+	size_t detail::TextAreaCache::findParagraphIndex(size_t textIndex) const
+	{
+		// textBeginIndexがtextIndex以下である最後の段落を探す
+		const auto it = std::upper_bound(paragraphs.begin(), paragraphs.end(), textIndex,
+			[](size_t index, const TextAreaParagraphCache& paragraph) { return index < paragraph.textBeginIndex; });
+		if (it == paragraphs.begin())
 		{
-			fnPushLine();
+			return 0;
 		}
-		regionSize = { maxWidth, lines.size() * lineHeight };
+		return static_cast<size_t>(std::distance(paragraphs.begin(), it)) - 1;
 	}
 
-	Vec2 TextArea::Cache::getCursorPos(size_t line, size_t column, size_t scrollOffsetX, size_t scrollOffsetY) const
+	Vec2 detail::TextAreaCache::getCursorPos(size_t line, size_t column, size_t scrollOffsetX, size_t scrollOffsetY) const
 	{
 		if (lines.empty())
 		{
@@ -111,23 +191,18 @@ namespace noco
 		}
 		double y = (static_cast<double>(line) - static_cast<double>(scrollOffsetY)) * lineHeight;
 		const auto& lineCache = lines[line];
-		double x = 0.0;
-		// スクロールオフセットまでの文字幅を計算して減算
-		for (size_t i = 0; i < Min(scrollOffsetX, lineCache.glyphs.size()); ++i)
+		// スクロールオフセットまでの文字幅を減算し、カーソル位置までの文字幅を加算
+		const size_t startIndex = Min(scrollOffsetX, lineCache.glyphCount());
+		const size_t glyphCount = Min(column, lineCache.glyphCount());
+		double x = -advanceToColumn(lineCache, startIndex);
+		if (glyphCount > startIndex)
 		{
-			x -= lineCache.glyphs[i].xAdvance * scale;
-		}
-		// カーソル位置までの文字幅を加算
-		const size_t glyphCount = Min(column, lineCache.glyphs.size());
-		const size_t startIndex = Min(scrollOffsetX, lineCache.glyphs.size());
-		for (size_t i = startIndex; i < glyphCount; ++i)
-		{
-			x += lineCache.glyphs[i].xAdvance * scale;
+			x += advanceToColumn(lineCache, glyphCount) - advanceToColumn(lineCache, startIndex);
 		}
 		return { x, y };
 	}
 
-	std::pair<size_t, size_t> TextArea::Cache::getCursorIndex(const Vec2& pos, size_t scrollOffsetX, size_t scrollOffsetY) const
+	std::pair<size_t, size_t> detail::TextAreaCache::getCursorIndex(const Vec2& pos, size_t scrollOffsetX, size_t scrollOffsetY) const
 	{
 		if (lines.empty())
 		{
@@ -140,32 +215,33 @@ namespace noco
 			return { lines.size() - 1, 0 };
 		}
 		const auto& lineCache = lines[line];
-		if (lineCache.glyphs.empty())
+		if (lineCache.glyphCount() == 0)
 		{
 			return { line, 0 };
 		}
-		double x = 0.0;
-		// スクロールオフセットまでの文字幅を計算して減算
-		for (size_t i = 0; i < Min(scrollOffsetX, lineCache.glyphs.size()); ++i)
-		{
-			x -= lineCache.glyphs[i].xAdvance * scale;
-		}
-		// マウス位置に対応する文字インデックスを検索
-		for (size_t i = 0; i < lineCache.glyphs.size(); ++i)
+		// スクロールオフセットまでの文字幅を減算
+		const double scrollX = advanceToColumn(lineCache, Min(scrollOffsetX, lineCache.glyphCount()));
+
+		// マウス位置が文字の中心より左側になる最初の文字を二分探索で求める
+		size_t low = 0;
+		size_t high = lineCache.glyphCount();
+		while (low < high)
 		{
-			const double glyphWidth = lineCache.glyphs[i].xAdvance * scale;
-			const double nextX = x + glyphWidth;
-			const double halfX = (x + nextX) / 2;
+			const size_t mid = low + (high - low) / 2;
+			const double halfX = (advanceToColumn(lineCache, mid) + advanceToColumn(lineCache, mid + 1)) / 2 - scrollX;
 			if (pos.x < halfX)
 			{
-				return { line, i };
+				high = mid;
+			}
+			else
+			{
+				low = mid + 1;
 			}
-			x = nextX;
 		}
-		return { line, lineCache.glyphs.size() };
+		return { line, low };
 	}
 
-	size_t TextArea::Cache::getLineColumnToIndex(size_t line, size_t column) const
+	size_t detail::TextAreaCache::getLineColumnToIndex(size_t line, size_t column) const
 	{
 		if (lines.empty())
 		{
@@ -179,15 +255,14 @@ namespace noco
 		return lineCache.textBeginIndex + Min(column, lineCache.textEndIndex - lineCache.textBeginIndex);
 	}
 
-	std::pair<size_t, size_t> TextArea::Cache::getIndexToLineColumn(size_t index) const
+	std::pair<size_t, size_t> detail::TextAreaCache::getIndexToLineColumn(size_t index) const
 	{
-		for (size_t i = 0; i < lines.size(); ++i)
+		// 行はテキスト上の位置順に並んでいるため、indexを末尾に含む最初の行を二分探索で求める
+		const auto it = std::lower_bound(lines.begin(), lines.end(), index,
+			[](const TextAreaLineCache& lineCache, size_t value) { return lineCache.textEndIndex < value; });
+		if (it != lines.end() && index >= it->textBeginIndex)
 		{
-			const auto& lineCache = lines[i];
-			if (index >= lineCache.textBeginIndex && index <= lineCache.textEndIndex)
-			{
-				return { i, index - lineCache.textBeginIndex };
-			}
+			return { static_cast<size_t>(std::distance(lines.begin(), it)), index - it->textBeginIndex };
 		}
 		// 見つからない場合は最後の行の最後にカーソルを配置
 		if (!lines.empty())
@@ -198,6 +273,17 @@ namespace noco
 		return { 0, 0 };
 	}
 
+	std::pair<size_t, size_t> detail::TextAreaCache::getVisibleLineRange(size_t scrollOffsetY, double viewHeight) const
+	{
+		const size_t firstLine = Min(scrollOffsetY, lines.size());
+		if (lineHeight <= 0.0)
+		{
+			return { firstLine, lines.size() };
+		}
+		const size_t visibleLines = static_cast<size_t>(Max(0.0, viewHeight / lineHeight)) + 1;
+		return { firstLine, Min(firstLine + visibleLines, lines.size()) };
+	}
+
 	std::pair<size_t, size_t> TextArea::moveCursorToMousePos(const RectF& rect, const std::shared_ptr<Node>& node)
 	{
 		const String& canvasDefaultFontAssetName = [&node]() -> const String&
@@ -217,7 +303,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 		
 		// ヒットテスト用逆変換でマウス座標を変換
 		const Vec2 nodeSpaceMousePos = node ? node->inverseTransformHitTestPoint(Cursor::PosF()) : Cursor::PosF();
@@ -359,7 +446,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 
 		// 現状は水平スクロールは行わない
 		// (将来的に折返し無効オプションを追加した場合に必要になる)
@@ -479,7 +567,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 
 		if (m_isDragging)
 		{
@@ -855,7 +944,8 @@ namespace noco
 						m_fontAssetName.value(),
 						canvasDefaultFontAssetName,
 						m_fontSize.value(),
-						rect.size);
+						rect.size,
+						m_text.contentVersion());
 
 					// カーソルを次の行の先頭に移動
 					const auto [line, column] = m_cache.getIndexToLineColumn(beforeIndex + 1);
@@ -875,7 +965,8 @@ namespace noco
 						m_fontAssetName.value(),
 						canvasDefaultFontAssetName,
 						m_fontSize.value(),
-						rect.size);
+						rect.size,
+						m_text.contentVersion());
 
 					// Ctrl+Vで挿入された場合、カーソル位置を挿入したテキストの末尾に更新
 					if (shortcutInsertSize > 0)
@@ -919,7 +1010,8 @@ namespace noco
 						m_fontAssetName.value(),
 						canvasDefaultFontAssetName,
 						m_fontSize.value(),
-						rect.size);
+						rect.size,
+						m_text.contentVersion());
 
 					const auto [line, column] = m_cache.getIndexToLineColumn(cursorIndex + validInput.size());
 					m_cursorLine = m_selectionAnchorLine = line;
@@ -959,6 +1051,20 @@ namespace noco
 		}
 	}
 
+	void TextArea::collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, detail::GlyphPrewarmList& list) const
+	{
+		for (const Font& font : detail::GlyphPrewarmList::ResolveFonts(m_fontAssetName, canvasDefaultFontAssetName, params))
+		{
+			list.addProperty(font, m_text, params);
+		}
+
+		// プレースホルダーはdraw内と同じ方法でフォントを決定する
+		const Font placeholderFont = (!m_fontAssetName.value().empty() && FontAsset::IsRegistered(m_fontAssetName.value()))
+			? FontAsset(m_fontAssetName.value())
+			: SimpleGUI::GetFont();
+		list.addProperty(placeholderFont, m_placeholderText, params);
+	}
+
 	void TextArea::update(const std::shared_ptr<Node>& node)
 	{
 		// 編集状態に応じてstyleStateをオーバーライド
@@ -997,7 +1103,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 
 		{
 			detail::ScopedScissorRect scissorRect{ clipRect.asRect() };
@@ -1008,25 +1115,26 @@ namespace noco
 				const auto [selectionBegin, selectionEnd] = getSelectionRange();
 				const auto [beginLine, beginColumn] = m_cache.getIndexToLineColumn(selectionBegin);
 				const auto [endLine, endColumn] = m_cache.getIndexToLineColumn(selectionEnd);
-				for (size_t line = beginLine; line <= endLine; ++line)
+				// 表示領域内の行のみを対象にする
+				const auto [firstVisibleLine, lastVisibleLine] = m_cache.getVisibleLineRange(m_scrollOffsetY, rect.h);
+				const size_t visibleBeginLine = Max(beginLine, firstVisibleLine);
+				const size_t visibleEndLine = Min(endLine + 1, lastVisibleLine);
+				for (size_t line = visibleBeginLine; line < visibleEndLine; ++line)
 				{
-					if (line >= m_scrollOffsetY && line < m_scrollOffsetY + static_cast<size_t>(rect.h / m_cache.lineHeight + 1))
+					size_t startColumn = (line == beginLine) ? beginColumn : 0;
+					size_t endCol = (line == endLine) ? endColumn : getColumnCount(line);
+					const Vec2 startPos = rect.pos + m_cache.getCursorPos(line, startColumn, m_scrollOffsetX, m_scrollOffsetY);
+					const Vec2 endPos = rect.pos + m_cache.getCursorPos(line, endCol, m_scrollOffsetX, m_scrollOffsetY);
+					// 表示領域内でクリップ
+					const double selectionLeft = Max(startPos.x, rect.x);
+					const double selectionRight = Min(endPos.x, rect.br().x);
+					if (selectionLeft < selectionRight)
 					{
-						size_t startColumn = (line == beginLine) ? beginColumn : 0;
-						size_t endCol = (line == endLine) ? endColumn : getColumnCount(line);
-						const Vec2 startPos = rect.pos + m_cache.getCursorPos(line, startColumn, m_scrollOffsetX, m_scrollOffsetY);
-						const Vec2 endPos = rect.pos + m_cache.getCursorPos(line, endCol, m_scrollOffsetX, m_scrollOffsetY);
-						// 表示領域内でクリップ
-						const double selectionLeft = Max(startPos.x, rect.x);
-						const double selectionRight = Min(endPos.x, rect.br().x);
-						if (selectionLeft < selectionRight)
-						{
-							const RectF selectionRect{
-								Vec2{ selectionLeft, startPos.y },
-								Vec2{ selectionRight - selectionLeft, m_cache.lineHeight }
-							};
-							selectionRect.draw(m_selectionColor.value());
-						}
+						const RectF selectionRect{
+							Vec2{ selectionLeft, startPos.y },
+							Vec2{ selectionRight - selectionLeft, m_cache.lineHeight }
+						};
+						selectionRect.draw(m_selectionColor.value());
 					}
 				}
 			}
@@ -1034,24 +1142,17 @@ namespace noco
 			// 各文字を描画
 			{
 				const ScopedCustomShader2D shader{ Font::GetPixelShader(m_cache.fontMethod) };
-				for (size_t lineIndex = m_scrollOffsetY; lineIndex < m_cache.lines.size(); ++lineIndex)
+				const auto [firstVisibleLine, lastVisibleLine] = m_cache.getVisibleLineRange(m_scrollOffsetY, rect.h);
+				for (size_t lineIndex = firstVisibleLine; lineIndex < lastVisibleLine; ++lineIndex)
 				{
 					const auto& line = m_cache.lines[lineIndex];
 					const double y = rect.y + (lineIndex - m_scrollOffsetY) * m_cache.lineHeight;
-					if (y > rect.br().y)
-					{
-						break;
-					}
+					// スクロールオフセットより手前の文字は表示領域外のため、その位置から描画する
+					const size_t startIndex = Min(m_scrollOffsetX, line.glyphCount());
 					double x = rect.x;
-					// スクロールオフセットまでの文字幅を計算して減算
-					for (size_t i = 0; i < Min(m_scrollOffsetX, line.glyphs.size()); ++i)
-					{
-						x -= line.glyphs[i].xAdvance * m_cache.scale;
-					}
-					// 表示する文字を描画
-					for (size_t i = 0; i < line.glyphs.size(); ++i)
+					for (size_t i = startIndex; i < line.glyphCount(); ++i)
 					{
-						const auto& glyph = line.glyphs[i];
+						const auto& glyph = m_cache.glyphAt(line, i);
 						// 改行文字はスキップ
 						if (glyph.codePoint == U'\n')
 						{
@@ -1159,8 +1260,10 @@ namespace noco
 				Vec2 editingPos = editingOffset;
 				{
 					const ScopedCustomShader2D shader{ Font::GetPixelShader(m_editingCache.fontMethod) };
-					for (const auto& glyph : m_editingCache.lines[0].glyphs)
+					const auto& editingLine = m_editingCache.lines[0];
+					for (size_t i = 0; i < editingLine.glyphCount(); ++i)
 					{
+						const auto& glyph = m_editingCache.glyphAt(editingLine, i);
 						glyph.texture.scaled(m_editingCache.scale).draw(editingPos + glyph.getOffset(m_editingCache.scale));
 						editingPos.x += glyph.xAdvance * m_editingCache.scale;
 					}
@@ -10,38 +10,24 @@ namespace noco
 	{
 		static const String EmptyString = U"";
 	}
-	void TextBox::Cache::refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize)
+	void TextBox::Cache::refreshIfDirty(StringView text, StringView fontAssetName, StringView canvasDefaultFontAssetName, double fontSize, const SizeF& rectSize, uint64 textVersion)
 	{
-		if (prevParams.has_value() && !prevParams->isDirty(text, fontAssetName, fontSize, rectSize))
+		if (prevParams.has_value() && !prevParams->isDirty(text, textVersion, fontAssetName, fontSize, rectSize))
 		{
+			// 内容が同じでバージョンのみ変化した場合に、次回以降の比較を省略できるよう更新しておく
+			prevParams->textVersion = textVersion;
 			return;
 		}
 		prevParams = CacheParams
 		{
 			.text = String{ text },
+			.textVersion = textVersion,
 			.fontAssetName = String{ fontAssetName },
 			.fontSize = fontSize,
 			.rectSize = rectSize,
 		};
 
-		const Font font = [&]() -> Font {
-			if (!fontAssetName.empty() && FontAsset::IsRegistered(fontAssetName))
-			{
-				return FontAsset(fontAssetName);
-			}
-
-			if (!canvasDefaultFontAssetName.empty() && FontAsset::IsRegistered(canvasDefaultFontAssetName))
-			{
-				return FontAsset(canvasDefaultFontAssetName);
-			}
-
-			if (auto globalFont = noco::detail::GetGlobalDefaultFont())
-			{
-				return *globalFont;
-			}
-
-			return SimpleGUI::GetFont();
-		}();
+		const Font font = noco::detail::ResolveFont(fontAssetName, canvasDefaultFontAssetName);
 		fontMethod = font.method();
 		glyphs = font.getGlyphs(text);
 		const int32 baseFontSize = font.fontSize();
@@ -199,7 +185,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 
 		const Vec2 alignOffset = getAlignOffset(rect);
 		const double drawOffsetX = getDrawOffsetX();
@@ -429,7 +416,8 @@ namespace noco
 							m_fontAssetName.value(),
 							canvasDefaultFontAssetName,
 							m_fontSize.value(),
-							rect.size);
+							rect.size,
+							m_text.contentVersion());
 						const size_t rightMostCursorIndex = m_cache.getCursorIndex(getDrawOffsetX(), m_scrollOffset, rect.w);
 						if (m_cursorIndex < rightMostCursorIndex)
 						{
@@ -697,7 +685,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 
 		const double contentWidth = m_cache.regionSize.x;
 		const double availableWidth = rect.w;
@@ -783,6 +772,20 @@ namespace noco
 		}
 	}
 
+	void TextBox::collectPrewarmGlyphs(const String& canvasDefaultFontAssetName, const HashTable<String, ParamValue>& params, detail::GlyphPrewarmList& list) const
+	{
+		for (const Font& font : detail::GlyphPrewarmList::ResolveFonts(m_fontAssetName, canvasDefaultFontAssetName, params))
+		{
+			list.addProperty(font, m_text, params);
+		}
+
+		// プレースホルダーはdraw内と同じ方法でフォントを決定する
+		const Font placeholderFont = (!m_fontAssetName.value().empty() && FontAsset::IsRegistered(m_fontAssetName.value()))
+			? FontAsset(m_fontAssetName.value())
+			: SimpleGUI::GetFont();
+		list.addProperty(placeholderFont, m_placeholderText, params);
+	}
+
 	void TextBox::update(const std::shared_ptr<Node>& node)
 	{
 		// 編集状態に応じてstyleStateをオーバーライド
@@ -821,7 +824,8 @@ namespace noco
 			m_fontAssetName.value(),
 			canvasDefaultFontAssetName,
 			m_fontSize.value(),
-			rect.size);
+			rect.size,
+			m_text.contentVersion());
 
 		// Alignオフセットを計算
 		const Vec2 alignOffset = getAlignOffset(rect);
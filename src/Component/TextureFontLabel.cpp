@@ -2,6 +2,7 @@
 #include "NocoUI/Node.hpp"
 #include "NocoUI/Canvas.hpp"
 #include "NocoUI/Asset.hpp"
+#include "NocoUI/detail/AutoShrinkSearch.hpp"
 
 namespace noco
 {
@@ -9,27 +10,51 @@ namespace noco
 	{
 		constexpr double ShrinkScaleFactor = 0.95;
 
-		Texture GetTexture(const String& textureFilePath, const String& textureAssetName)
+		// Buffer2Dのインデックス型で参照できる頂点数の上限
+		constexpr size_t MaxBatchVertexCount = std::numeric_limits<Vertex2D::IndexType>::max() + size_t{ 1 };
+
+		void AddQuad(Buffer2D& buffer, const RectF& rect, const RectF& uv, const Float2& inverseTextureSize, const Float4& color)
+		{
+			const auto baseIndex = static_cast<Vertex2D::IndexType>(buffer.vertices.size());
+			const float left = static_cast<float>(rect.x);
+			const float top = static_cast<float>(rect.y);
+			const float right = static_cast<float>(rect.x + rect.w);
+			const float bottom = static_cast<float>(rect.y + rect.h);
+			const float uvLeft = static_cast<float>(uv.x) * inverseTextureSize.x;
+			const float uvTop = static_cast<float>(uv.y) * inverseTextureSize.y;
+			const float uvRight = static_cast<float>(uv.x + uv.w) * inverseTextureSize.x;
+			const float uvBottom = static_cast<float>(uv.y + uv.h) * inverseTextureSize.y;
+
+			buffer.vertices.push_back(Vertex2D{ .pos = Float2{ left, top }, .tex = Float2{ uvLeft, uvTop }, .color = color });
+			buffer.vertices.push_back(Vertex2D{ .pos = Float2{ right, top }, .tex = Float2{ uvRight, uvTop }, .color = color });
+			buffer.vertices.push_back(Vertex2D{ .pos = Float2{ left, bottom }, .tex = Float2{ uvLeft, uvBottom }, .color = color });
+			buffer.vertices.push_back(Vertex2D{ .pos = Float2{ right, bottom }, .tex = Float2{ uvRight, uvBottom }, .color = color });
+			buffer.indices.push_back(TriangleIndex{ baseIndex, static_cast<Vertex2D::IndexType>(baseIndex + 1), static_cast<Vertex2D::IndexType>(baseIndex + 2) });
+			buffer.indices.push_back(TriangleIndex{ static_cast<Vertex2D::IndexType>(baseIndex + 2), static_cast<Vertex2D::IndexType>(baseIndex + 1), static_cast<Vertex2D::IndexType>(baseIndex + 3) });
+		}
+
+		// 文字毎にテクスチャの一部の領域を切り出して描画するため、非同期読み込み中の代替テクスチャは使用しない
+		std::shared_ptr<const Texture> GetTexture(const String& textureFilePath, const String& textureAssetName)
 		{
 			if (detail::IsEditorMode())
 			{
 				if (!textureFilePath.empty())
 				{
-					return noco::Asset::GetOrLoadTexture(textureFilePath);
+					return noco::Asset::AcquireTexture(textureFilePath, AllowPlaceholderYN::No);
 				}
 			}
 			else
 			{
 				if (!textureAssetName.empty())
 				{
-					return TextureAsset(textureAssetName);
+					return std::make_shared<const Texture>(TextureAsset(textureAssetName));
 				}
 				if (!textureFilePath.empty())
 				{
-					return noco::Asset::GetOrLoadTexture(textureFilePath);
+					return noco::Asset::AcquireTexture(textureFilePath, AllowPlaceholderYN::No);
 				}
 			}
-			return Texture{};
+			return nullptr;
 		}
 	}
 
@@ -56,8 +81,16 @@ namespace noco
 			return false;
 		}
 
-		uvMap.clear();
-		metricsMap.clear();
+		entries.clear();
+		sparseEntryIndices.clear();
+
+		// 文字セット内の最大のコードポイントまでを直接参照テーブルの範囲とする(ASCIIは常に含める)
+		char32 maxCodePoint = 0x7F;
+		for (const char32 ch : characterSet)
+		{
+			maxCodePoint = Max(maxCodePoint, ch);
+		}
+		denseEntryIndices.assign(Min(static_cast<size_t>(maxCodePoint) + 1, DenseTableMaxSize), InvalidEntryIndex);
 
 		if (textureGridColumns <= 0 || textureGridRows <= 0)
 		{
@@ -128,7 +161,8 @@ namespace noco
 			const double gridY = static_cast<double>(normalizedIndex / textureGridColumns);
 
 			// このキャラクタのトリム量を決定(JSON指定があればそれを、なければ共通値を使用)
-			const LRTB trim = charTrimMap.contains(ch) ? charTrimMap[ch] : textureCellTrim;
+			const auto trimIt = charTrimMap.find(ch);
+			const LRTB trim = (trimIt != charTrimMap.end()) ? trimIt->second : textureCellTrim;
 
 			// UV座標とサイズを計算(トリムを考慮)
 			const RectF baseRect{
@@ -138,27 +172,23 @@ namespace noco
 				textureCellSize.y
 			};
 
-			if (textureCellTrimClip)
-			{
-				uvMap[ch] = RectF{
-					baseRect.x + trim.left,
-					baseRect.y + trim.top,
-					baseRect.w - trim.left - trim.right,
-					baseRect.h - trim.top - trim.bottom
-				};
-			}
-			else
-			{
-				uvMap[ch] = baseRect;
-			}
-
-			metricsMap[ch] = CharacterMetrics{
-				.trim = trim,
-				.effectiveSize = Vec2{
-					textureCellSize.x - trim.left - trim.right,
-					textureCellSize.y - trim.top - trim.bottom
+			setEntry(ch, CharacterEntry{
+				.uv = textureCellTrimClip
+					? RectF{
+						baseRect.x + trim.left,
+						baseRect.y + trim.top,
+						baseRect.w - trim.left - trim.right,
+						baseRect.h - trim.top - trim.bottom
+					}
+					: baseRect,
+				.metrics = CharacterMetrics{
+					.trim = trim,
+					.effectiveSize = Vec2{
+						textureCellSize.x - trim.left - trim.right,
+						textureCellSize.y - trim.top - trim.bottom
+					},
 				},
-			};
+			});
 
 			++normalizedIndex;
 		}
@@ -177,11 +207,44 @@ namespace noco
 		return true;
 	}
 
+	void TextureFontLabel::TextureFontCache::setEntry(char32 character, const CharacterEntry& entry)
+	{
+		int32& index = (character < denseEntryIndices.size())
+			? denseEntryIndices[character]
+			: sparseEntryIndices.try_emplace(character, InvalidEntryIndex).first->second;
+
+		// 文字セット内で同じ文字が重複する場合は後のものを優先
+		if (index == InvalidEntryIndex)
+		{
+			index = static_cast<int32>(entries.size());
+			entries.push_back(entry);
+		}
+		else
+		{
+			entries[index] = entry;
+		}
+	}
+
+	const TextureFontLabel::TextureFontCache::CharacterEntry* TextureFontLabel::TextureFontCache::find(char32 character) const
+	{
+		if (character < denseEntryIndices.size())
+		{
+			const int32 index = denseEntryIndices[character];
+			return (index == InvalidEntryIndex) ? nullptr : &entries[index];
+		}
+
+		if (auto it = sparseEntryIndices.find(character); it != sparseEntryIndices.end())
+		{
+			return &entries[it->second];
+		}
+		return nullptr;
+	}
+
 	Optional<RectF> TextureFontLabel::TextureFontCache::getUV(char32 character) const
 	{
-		if (auto it = uvMap.find(character); it != uvMap.end())
+		if (const CharacterEntry* entry = find(character))
 		{
-			return it->second;
+			return entry->uv;
 		}
 		return none;
 	}
@@ -263,13 +326,17 @@ namespace noco
 			.textureCellTrimClip = newTextureCellTrimClip,
 		};
 
-		auto refreshCacheAndGetRegionSize = [&](const Vec2& targetCharacterSize, const Vec2& targetCharacterSpacing, HorizontalOverflow hov, VerticalOverflow vov) -> SizeF
+		// measureOnlyがtrueの場合は行キャッシュを生成せずサイズのみを計算し、rectSizeを超えた時点で打ち切る
+		auto refreshCacheAndGetRegionSize = [&](const Vec2& targetCharacterSize, const Vec2& targetCharacterSpacing, HorizontalOverflow hov, VerticalOverflow vov, bool measureOnly = false) -> SizeF
 			{
 				lineCaches.clear();
+				characters.clear();
 
 				double maxWidth = 0.0;
 				Vec2 offset = Vec2::Zero();
-				Array<CharInfo> lineChars;
+				size_t lineCharacterBegin = 0;
+				bool lineHasChars = false;
+				bool exceeded = false;
 				const double lineHeight = targetCharacterSize.y;
 
 				const auto fnPushLine = [&]() -> bool
@@ -281,18 +348,29 @@ namespace noco
 							return false;
 						}
 
-						if (!lineChars.empty())
+						if (lineHasChars)
 						{
 							offset.x -= targetCharacterSpacing.x;
 						}
 
-						lineCaches.push_back({ lineChars, offset.x, offset.y });
-						lineChars.clear();
+						if (!measureOnly)
+						{
+							lineCaches.push_back({ lineCharacterBegin, characters.size(), offset.x, offset.y });
+						}
+						lineCharacterBegin = characters.size();
+						lineHasChars = false;
 						maxWidth = Max(maxWidth, offset.x);
 
 						offset.x = 0;
 						offset.y = currentLineBottom + targetCharacterSpacing.y;
 
+						if (measureOnly && (maxWidth > rectSize.x || currentLineBottom > rectSize.y))
+						{
+							// 収まらないことが確定したため以降の計算は不要
+							exceeded = true;
+							return false;
+						}
+
 						return true;
 					};
 
@@ -309,9 +387,10 @@ namespace noco
 
 					// 個別のトリミング指定があれば適用、なければ共通の幅を使用
 					double charWidth = targetCharacterSize.x + targetCharacterSpacing.x;
-					if (auto it = textureFontCache.metricsMap.find(ch); it != textureFontCache.metricsMap.end())
+					const TextureFontCache::CharacterEntry* entry = textureFontCache.find(ch);
+					if (entry)
 					{
-						const double widthRatio = it->second.effectiveSize.x / newTextureCellSize.x;
+						const double widthRatio = entry->metrics.effectiveSize.x / newTextureCellSize.x;
 						charWidth = targetCharacterSize.x * widthRatio + targetCharacterSpacing.x;
 					}
 
@@ -323,63 +402,82 @@ namespace noco
 						}
 					}
 
-					if (auto uvRect = textureFontCache.getUV(ch))
+					if (entry)
 					{
-						lineChars.push_back(
-							CharInfo
-							{
-								ch,
-								*uvRect,
-								Vec2{ offset.x, 0 },
-							});
+						if (!measureOnly)
+						{
+							characters.push_back(
+								CharInfo
+								{
+									ch,
+									entry->uv,
+									Vec2{ offset.x, 0 },
+								});
+						}
+						lineHasChars = true;
 					}
 					offset.x += charWidth;
 				}
-				fnPushLine();
+				if (!exceeded)
+				{
+					fnPushLine();
+				}
 				return { maxWidth, offset.y - targetCharacterSpacing.y };
 			};
 
 		if (newSizingMode == TextureFontLabelSizingMode::AutoShrink)
 		{
-			Vec2 currentCharacterSize = characterSize;
 			const double aspectRatio = characterSize.y > 0 ? characterSize.x / characterSize.y : 1.0;
 			const double minSize = 1.0;
 
-			while (currentCharacterSize.x >= minSize && currentCharacterSize.y >= minSize)
+			// ShrinkScaleFactorずつ縮小した文字サイズの候補を列挙する(最後の候補は最小サイズに丸めたもの)
+			Array<Vec2> candidates;
+			if (characterSize.x >= minSize && characterSize.y >= minSize)
 			{
-				const Vec2 currentCharacterSpacing
+				Vec2 candidate = characterSize;
+				while (true)
 				{
-					characterSize.x > 0.0 ? characterSpacing.x * currentCharacterSize.x / characterSize.x : characterSpacing.x,
-					characterSize.y > 0.0 ? characterSpacing.y * currentCharacterSize.y / characterSize.y : characterSpacing.y
-				};
-
-				const SizeF requiredSize = refreshCacheAndGetRegionSize(currentCharacterSize, currentCharacterSpacing, horizontalOverflow, VerticalOverflow::Overflow);
-
-				if (requiredSize.x <= rectSize.x && requiredSize.y <= rectSize.y)
-				{
-					break;
-				}
-
-				currentCharacterSize *= ShrinkScaleFactor;
-
-				if (currentCharacterSize.x < minSize || currentCharacterSize.y < minSize)
-				{
-					currentCharacterSize.x = Max(currentCharacterSize.x, minSize);
-					currentCharacterSize.y = Max(currentCharacterSize.y, minSize);
-					if (aspectRatio > 0)
+					candidates.push_back(candidate);
+					candidate *= ShrinkScaleFactor;
+					if (candidate.x < minSize || candidate.y < minSize)
 					{
-						if (currentCharacterSize.x / currentCharacterSize.y > aspectRatio)
-						{
-							currentCharacterSize.x = currentCharacterSize.y * aspectRatio;
-						}
-						else
+						candidate.x = Max(candidate.x, minSize);
+						candidate.y = Max(candidate.y, minSize);
+						if (aspectRatio > 0)
 						{
-							currentCharacterSize.y = currentCharacterSize.x / aspectRatio;
+							if (candidate.x / candidate.y > aspectRatio)
+							{
+								candidate.x = candidate.y * aspectRatio;
+							}
+							else
+							{
+								candidate.y = candidate.x / aspectRatio;
+							}
 						}
+						candidates.push_back(candidate);
+						break;
 					}
-					break;
 				}
 			}
+
+			const auto fnFits = [&](size_t candidateIndex)
+				{
+					const Vec2& targetCharacterSize = candidates[candidateIndex];
+					const Vec2 targetCharacterSpacing
+					{
+						characterSize.x > 0.0 ? characterSpacing.x * targetCharacterSize.x / characterSize.x : characterSpacing.x,
+						characterSize.y > 0.0 ? characterSpacing.y * targetCharacterSize.y / characterSize.y : characterSpacing.y
+					};
+					const SizeF requiredSize = refreshCacheAndGetRegionSize(targetCharacterSize, targetCharacterSpacing, horizontalOverflow, VerticalOverflow::Overflow, true);
+					return requiredSize.x <= rectSize.x && requiredSize.y <= rectSize.y;
+				};
+
+			// 収まる最大の候補を求める(最後の候補は収まらない場合も採用する)
+			Vec2 currentCharacterSize = characterSize;
+			if (!candidates.empty())
+			{
+				currentCharacterSize = candidates[detail::FindFirstFittingCandidate(candidates.size(), fnFits)];
+			}
 			this->effectiveCharacterSize = currentCharacterSize;
 			this->effectiveAutoShrinkWidthScale = 1.0;
 
@@ -534,6 +632,62 @@ namespace noco
 		return shared_from_this();
 	}
 
+	void TextureFontLabel::collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const
+	{
+		// 通常モードではアセット名が指定されている場合はファイルパスが使われないため対象外とする
+		if (!detail::IsEditorMode() && !m_textureAssetName.value().empty())
+		{
+			return;
+		}
+		detail::ForEachPossibleStringValue(m_textureFilePath, params, [&](const String& textureFilePath) { dependencies.addTextureFilePath(textureFilePath); });
+	}
+
+	void TextureFontLabel::CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies)
+	{
+		// 通常モードではアセット名が指定されている場合はファイルパスが使われないため対象外とする
+		if (!detail::IsEditorMode() && !detail::GetDefaultStringValueFromJSON(json, U"textureAssetName").empty())
+		{
+			return;
+		}
+		detail::ForEachPossibleStringValueInJSON(json, U"textureFilePath", params, [&](const String& textureFilePath) { dependencies.addTextureFilePath(textureFilePath); });
+	}
+
+	Optional<LRTB> TextureFontLabel::drawOverflow() const
+	{
+		// 領域外へのはみ出しを許可している場合は、テキストの内容により描画範囲が変わるため求めない
+		if (m_horizontalOverflow.value() == HorizontalOverflow::Overflow || m_verticalOverflow.value() == VerticalOverflow::Overflow)
+		{
+			return none;
+		}
+
+		// 余白が負の場合は領域の外側に描画される
+		const LRTB& padding = m_padding.value();
+		return LRTB{
+			.left = Max(-padding.left, 0.0),
+			.right = Max(-padding.right, 0.0),
+			.top = Max(-padding.top, 0.0),
+			.bottom = Max(-padding.bottom, 0.0),
+		};
+	}
+
+	const Texture& TextureFontLabel::resolveTexture() const
+	{
+		// 解決済みのテクスチャをキャッシュから取得(アセットテーブルの検索を毎フレーム行わないため)
+		return m_resolvedTextureCache.getOrResolve(
+			m_textureFilePath.contentVersion(),
+			m_textureAssetName.contentVersion(),
+			detail::IsEditorMode(),
+			AllowPlaceholderYN::No,
+			Asset::Generation(),
+			[&] { return GetTexture(m_textureFilePath.value(), m_textureAssetName.value()); });
+	}
+
+	uint64 TextureFontLabel::resolvedAssetsHash(const Node&) const
+	{
+		// 非同期読み込みの完了やアセットの再読み込みで解決されるテクスチャが変わるため、テクスチャのIDを使用
+		return static_cast<uint64>(resolveTexture().id().value());
+	}
+
 	void TextureFontLabel::draw(const Node& node) const
 	{
 		const String& text = m_text.value();
@@ -542,7 +696,7 @@ namespace noco
 			return;
 		}
 
-		const Texture texture = GetTexture(m_textureFilePath.value(), m_textureAssetName.value());
+		const Texture& texture = resolveTexture();
 		if (!texture)
 		{
 			return;
@@ -699,6 +853,13 @@ namespace noco
 
 		const bool preserveAspect = m_preserveAspect.value();
 		const bool trimClip = m_textureCellTrimClip.value();
+
+		// 文字毎にTextureRegion::drawを呼ぶ代わりに、全文字の矩形を1つの頂点バッファにまとめて描画する
+		const Float2 inverseTextureSize{ 1.0f / texture.width(), 1.0f / texture.height() };
+		const Float4 vertexColor = ColorF{ color }.toFloat4();
+		m_drawBuffer.vertices.clear();
+		m_drawBuffer.indices.clear();
+
 		for (const auto& line : m_cache.lineCaches)
 		{
 			const double effectiveLineWidth = line.width * autoShrinkWidthScale;
@@ -712,28 +873,29 @@ namespace noco
 				lineOffsetX = rect.w - effectiveLineWidth;
 			}
 
-			for (const auto& charInfo : line.characters)
+			for (size_t characterIndex = line.characterBegin; characterIndex < line.characterEnd; ++characterIndex)
 			{
+				const auto& charInfo = m_cache.characters[characterIndex];
 				const Vec2 drawPos = rect.pos + Vec2{ lineOffsetX + charInfo.position.x * autoShrinkWidthScale, contentOffsetY + line.offsetY };
 
 				// 個別のトリミング指定があれば適用、なければ通常のサイズを使用
 				Vec2 finalSize = characterSize;
 				Vec2 trimDrawOffset = Vec2::Zero();
-				if (auto it = m_textureFontCache.metricsMap.find(charInfo.character); it != m_textureFontCache.metricsMap.end())
+				if (const auto* entry = m_textureFontCache.find(charInfo.character))
 				{
 					const Vec2& cellSize = m_textureCellSize.value();
 					if (cellSize.x != 0.0 && cellSize.y != 0.0)
 					{
 						if (trimClip)
 						{
-							const Vec2& effectiveSize = it->second.effectiveSize;
+							const Vec2& effectiveSize = entry->metrics.effectiveSize;
 							finalSize.x = characterSize.x * effectiveSize.x / cellSize.x;
 							finalSize.y = characterSize.y * effectiveSize.y / cellSize.y;
 						}
 						else
 						{
 							// クリッピングなしの場合、セルサイズ全体で描画してトリミング量の分だけ位置をずらす
-							const LRTB& trim = it->second.trim;
+							const LRTB& trim = entry->metrics.trim;
 							trimDrawOffset.x = -trim.left * characterSize.x / cellSize.x;
 							trimDrawOffset.y = (trim.bottom - trim.top) * 0.5 * characterSize.y / cellSize.y;
 						}
@@ -772,9 +934,20 @@ namespace noco
 				finalSize.x *= autoShrinkWidthScale;
 				centerOffset.x *= autoShrinkWidthScale;
 
-				texture(charInfo.sourceRect).resized(finalSize).draw(drawPos + centerOffset, color);
+				if (m_drawBuffer.vertices.size() + 4 > MaxBatchVertexCount)
+				{
+					m_drawBuffer.draw(texture);
+					m_drawBuffer.vertices.clear();
+					m_drawBuffer.indices.clear();
+				}
+				AddQuad(m_drawBuffer, RectF{ drawPos + centerOffset, finalSize }, charInfo.sourceRect, inverseTextureSize, vertexColor);
 			}
 		}
+
+		if (!m_drawBuffer.vertices.empty())
+		{
+			m_drawBuffer.draw(texture);
+		}
 	}
 
 	void TextureFontLabel::update(const std::shared_ptr<Node>& node)
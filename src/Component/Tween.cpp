@@ -1,11 +1,12 @@
 ﻿#include "NocoUI/Component/Tween.hpp"
 #include "NocoUI/Node.hpp"
+#include "NocoUI/Canvas.hpp"
 
 namespace noco
 {
-	double Tween::applyEasing(double t) const
+	double EvaluateTweenEasing(TweenEasing easing, double t)
 	{
-		switch (m_easing.value())
+		switch (easing)
 		{
 		case TweenEasing::Linear:
 			return t;
@@ -70,11 +71,101 @@ namespace noco
 		case TweenEasing::EaseInOutBounce:
 			return EaseInOutBounce(t);
 		default:
-			Logger << U"[NocoUI warning] Unknown TweenEasing: {}"_fmt(static_cast<std::underlying_type_t<TweenEasing>>(m_easing.value()));
+			Logger << U"[NocoUI warning] Unknown TweenEasing: {}"_fmt(static_cast<std::underlying_type_t<TweenEasing>>(easing));
 			return t;
 		}
 	}
 
+	namespace
+	{
+		constexpr size_t TweenEasingCount = static_cast<size_t>(TweenEasing::EaseInOutBounce) + 1;
+
+		struct TweenEasingLookupTableState
+		{
+			bool globalEnabled = false;
+			size_t resolution = TweenEasingLookupTable::DefaultResolution;
+			std::array<Array<double>, TweenEasingCount> tables;
+		};
+
+		TweenEasingLookupTableState& GetTweenEasingLookupTableState()
+		{
+			static TweenEasingLookupTableState state;
+			return state;
+		}
+	}
+
+	namespace TweenEasingLookupTable
+	{
+		void SetGlobalEnabled(bool enabled)
+		{
+			GetTweenEasingLookupTableState().globalEnabled = enabled;
+		}
+
+		bool IsGlobalEnabled()
+		{
+			return GetTweenEasingLookupTableState().globalEnabled;
+		}
+
+		void SetResolution(size_t resolution)
+		{
+			auto& state = GetTweenEasingLookupTableState();
+			resolution = Max(resolution, size_t{ 1 });
+			if (state.resolution == resolution)
+			{
+				return;
+			}
+			state.resolution = resolution;
+			for (auto& table : state.tables)
+			{
+				table.clear();
+			}
+		}
+
+		size_t Resolution()
+		{
+			return GetTweenEasingLookupTableState().resolution;
+		}
+
+		double Evaluate(TweenEasing easing, double t)
+		{
+			const size_t easingIndex = static_cast<size_t>(easing);
+			if (easingIndex >= TweenEasingCount)
+			{
+				return EvaluateTweenEasing(easing, t);
+			}
+
+			auto& state = GetTweenEasingLookupTableState();
+			const size_t resolution = state.resolution;
+			auto& table = state.tables[easingIndex];
+			if (table.empty())
+			{
+				// 両端を含むresolution + 1個のサンプルを作成
+				table.resize(resolution + 1);
+				for (size_t i = 0; i <= resolution; ++i)
+				{
+					table[i] = EvaluateTweenEasing(easing, static_cast<double>(i) / resolution);
+				}
+			}
+
+			const double position = Math::Clamp(t, 0.0, 1.0) * resolution;
+			const size_t index = Min(static_cast<size_t>(position), resolution - 1);
+			const double fraction = position - static_cast<double>(index);
+			return table[index] + (table[index + 1] - table[index]) * fraction;
+		}
+	}
+
+	double Tween::applyEasing(double t) const
+	{
+		const bool useLookupTable = (m_easingEvaluation == TweenEasingEvaluation::Global)
+			? TweenEasingLookupTable::IsGlobalEnabled()
+			: (m_easingEvaluation == TweenEasingEvaluation::LookupTable);
+		if (useLookupTable)
+		{
+			return TweenEasingLookupTable::Evaluate(m_easing.value(), t);
+		}
+		return EvaluateTweenEasing(m_easing.value(), t);
+	}
+
 	void Tween::updateTranslate(const std::shared_ptr<Node>& node, double progress)
 	{
 		const Vec2& from = m_translateFrom.value();
@@ -119,35 +210,95 @@ namespace noco
 		transform.color().setCurrentFrameOverride(interpolated);
 	}
 
+	void Tween::applyEasedProgress(const std::shared_ptr<Node>& node, double easedProgress)
+	{
+		// 有効なプロパティに値を反映
+		if (m_translateEnabled.value())
+		{
+			updateTranslate(node, easedProgress);
+		}
+		if (m_scaleEnabled.value())
+		{
+			updateScale(node, easedProgress);
+		}
+		if (m_rotationEnabled.value())
+		{
+			updateRotation(node, easedProgress);
+		}
+		if (m_colorEnabled.value())
+		{
+			updateColor(node, easedProgress);
+		}
+	}
+
 	void Tween::onActivated(const std::shared_ptr<Node>&)
 	{
 		if (m_active.value() && m_restartOnActive.value())
 		{
-			m_stopwatch.restart();
+			restart();
 		}
 	}
 
 	void Tween::update(const std::shared_ptr<Node>& node)
 	{
+		const std::shared_ptr<Canvas> canvas = node->containedCanvas();
+
+		// Canvasに属していない場合はCanvasのアニメーション用時計の代わりにシーン時間を使用
+		const double clockTime = canvas ? canvas->animationTime() : Scene::Time();
+
 		const bool currentActive = m_active.value();
 
 		if (m_restartOnActive.value() && m_prevActive.has_value() && !m_prevActive.value() && currentActive)
 		{
 			// 最初から再生
-			m_stopwatch.restart();
+			restart();
 		}
 		m_prevActive = currentActive;
 
-		if (!m_stopwatch.isStarted())
+		if (!m_startTime.has_value())
 		{
-			m_stopwatch.start();
+			m_startTime = clockTime;
 		}
+		m_elapsedTime = clockTime - *m_startTime;
 
 		if (!currentActive)
 		{
 			return;
 		}
 
+		// 評価はCanvasがupdate後にまとめて行う
+		if (canvas)
+		{
+			canvas->scheduleTween(shared_from_this(), node);
+		}
+		else
+		{
+			evaluate(node);
+		}
+	}
+
+	void Tween::restart()
+	{
+		m_startTime.reset();
+		m_elapsedTime = 0.0;
+		m_retired = false;
+	}
+
+	void Tween::evaluate(const std::shared_ptr<Node>& node)
+	{
+		if (m_retired)
+		{
+			// 再生終了後にループ設定や時間が変更された場合は通常の評価に戻す
+			if (!m_manualMode.value() && m_loopType.value() == TweenLoopType::None && m_elapsedTime >= m_delay.value() + Max(m_duration.value(), 0.0))
+			{
+				// 再生終了済みのためループ・進捗の計算を省略して最終値のみ適用
+				// (currentFrameOverrideはフレーム毎に失効するため適用自体は毎フレーム必要)
+				applyEasedProgress(node, applyEasing(1.0));
+				return;
+			}
+			m_retired = false;
+		}
+
 		double time;
 		const double loopDuration = m_loopDuration.value();
 
@@ -157,7 +308,7 @@ namespace noco
 		}
 		else
 		{
-			time = m_stopwatch.sF();
+			time = m_elapsedTime;
 		}
 
 		// loopDurationが指定されている場合は適用
@@ -171,25 +322,8 @@ namespace noco
 		{
 			if (m_applyDuringDelay.value())
 			{
-				const double easedProgress = applyEasing(0.0);
-
 				// 有効なプロパティに0%の値を適用
-				if (m_translateEnabled.value())
-				{
-					updateTranslate(node, easedProgress);
-				}
-				if (m_scaleEnabled.value())
-				{
-					updateScale(node, easedProgress);
-				}
-				if (m_rotationEnabled.value())
-				{
-					updateRotation(node, easedProgress);
-				}
-				if (m_colorEnabled.value())
-				{
-					updateColor(node, easedProgress);
-				}
+				applyEasedProgress(node, applyEasing(0.0));
 			}
 			return;
 		}
@@ -197,36 +331,26 @@ namespace noco
 		// アニメーション時間を計算
 		const double animationTime = time - m_delay.value();
 		const double duration = m_duration.value();
+		const auto loopType = m_loopType.value();
+
+		// 手動モードでなくループもしない場合、再生が終了したら以降は最終値の適用のみ行う
+		if (!m_manualMode.value() && loopType == TweenLoopType::None && animationTime >= Max(duration, 0.0))
+		{
+			m_retired = true;
+			applyEasedProgress(node, applyEasing(1.0));
+			return;
+		}
 			
 		if (duration <= 0.0)
 		{
 			// durationが0以下の場合は即座に100%の値にする
-			const double easedProgress = applyEasing(1.0);
-
-			// 有効なプロパティに100%の値を適用
-			if (m_translateEnabled.value())
-			{
-				updateTranslate(node, easedProgress);
-			}
-			if (m_scaleEnabled.value())
-			{
-				updateScale(node, easedProgress);
-			}
-			if (m_rotationEnabled.value())
-			{
-				updateRotation(node, easedProgress);
-			}
-			if (m_colorEnabled.value())
-			{
-				updateColor(node, easedProgress);
-			}
+			applyEasedProgress(node, applyEasing(1.0));
 			return;
 		}
 		
 		double rawProgress = animationTime / duration;
 	
 		// ループ処理（loopDurationが設定されていない場合のみ）
-		const auto loopType = m_loopType.value();
 		if (loopDuration <= 0.0 && loopType != TweenLoopType::None && rawProgress >= 1.0)
 		{
 			if (loopType == TweenLoopType::Loop)
@@ -272,25 +396,7 @@ namespace noco
 
 		// イージング適用
 		const double clampedProgress = Math::Clamp(rawProgress, 0.0, 1.0);
-		const double easedProgress = applyEasing(clampedProgress);
-
-		// 有効なプロパティに値を反映
-		if (m_translateEnabled.value())
-		{
-			updateTranslate(node, easedProgress);
-		}
-		if (m_scaleEnabled.value())
-		{
-			updateScale(node, easedProgress);
-		}
-		if (m_rotationEnabled.value())
-		{
-			updateRotation(node, easedProgress);
-		}
-		if (m_colorEnabled.value())
-		{
-			updateColor(node, easedProgress);
-		}
+		applyEasedProgress(node, applyEasing(clampedProgress));
 	}
 
 	std::shared_ptr<Tween> Tween::setActive(const PropertyValue<bool>& active)
@@ -302,7 +408,7 @@ namespace noco
 		if (m_restartOnActive.value() && !prevActive && m_active.value())
 		{
 			// restartOnActiveが有効の場合、非アクティブ→アクティブに変化した場合は最初からやり直す
-			m_stopwatch.restart();
+			restart();
 		}
 
 		return shared_from_this();
@@ -324,7 +430,7 @@ namespace noco
 		}
 
 		// ループしない場合は、delay + duration以内かチェック
-		const double time = m_manualMode.value() ? m_manualTime.value() : m_stopwatch.sF();
+		const double time = m_manualMode.value() ? m_manualTime.value() : m_elapsedTime;
 		const double totalTime = m_delay.value() + m_duration.value();
 
 		return time < totalTime;
@@ -6,14 +6,14 @@ namespace noco
 {
 	namespace
 	{
-		Audio GetAudio(const String& audioFilePath, const String& audioAssetName)
+		std::shared_ptr<const Audio> GetAudio(const String& audioFilePath, const String& audioAssetName)
 		{
 			if (detail::IsEditorMode())
 			{
 				// エディタモードではアセット名は無視してファイル名のみを使用
 				if (!audioFilePath.empty())
 				{
-					return noco::Asset::GetOrLoadAudio(audioFilePath);
+					return noco::Asset::AcquireAudio(audioFilePath);
 				}
 			}
 			else
@@ -22,17 +22,37 @@ namespace noco
 				// 気付かないうちにファイルパスが使われるのを避けるため、AudioAssetに指定されたキーが存在しない時もファイルパスへのフォールバックはしない仕様とする
 				if (!audioAssetName.empty())
 				{
-					return AudioAsset(audioAssetName);
+					return std::make_shared<const Audio>(AudioAsset(audioAssetName));
 				}
 				if (!audioFilePath.empty())
 				{
-					return noco::Asset::GetOrLoadAudio(audioFilePath);
+					return noco::Asset::AcquireAudio(audioFilePath);
 				}
 			}
-			return Audio{};
+			return nullptr;
 		}
 	}
 
+	void UISound::collectAssetDependencies(const HashTable<String, ParamValue>& params, AssetDependencies& dependencies) const
+	{
+		// 通常モードではアセット名が指定されている場合はファイルパスが使われないため対象外とする
+		if (!detail::IsEditorMode() && !m_audioAssetName.value().empty())
+		{
+			return;
+		}
+		detail::ForEachPossibleStringValue(m_audioFilePath, params, [&](const String& audioFilePath) { dependencies.addAudioFilePath(audioFilePath); });
+	}
+
+	void UISound::CollectAssetDependenciesFromJSON(const JSON& json, const HashTable<String, ParamValue>& params, AssetDependencies& dependencies)
+	{
+		// 通常モードではアセット名が指定されている場合はファイルパスが使われないため対象外とする
+		if (!detail::IsEditorMode() && !detail::GetDefaultStringValueFromJSON(json, U"audioAssetName").empty())
+		{
+			return;
+		}
+		detail::ForEachPossibleStringValueInJSON(json, U"audioFilePath", params, [&](const String& audioFilePath) { dependencies.addAudioFilePath(audioFilePath); });
+	}
+
 	void UISound::update(const std::shared_ptr<Node>& node)
 	{
 		const auto triggerType = m_triggerType.value();
@@ -42,10 +62,12 @@ namespace noco
 		auto play = [&]() {
 			const String& audioFilePath = m_audioFilePath.value();
 			const String& audioAssetName = m_audioAssetName.value();
-			Audio audio = GetAudio(audioFilePath, audioAssetName);
-			if (audio)
+			const std::shared_ptr<const Audio> audio = GetAudio(audioFilePath, audioAssetName);
+			if (audio && *audio)
 			{
-				audio.playOneShot(m_volume.value());
+				audio->playOneShot(m_volume.value());
+				// 再生中にメモリ使用量の上限による退避で再生が途切れないよう、再生終了まで保持する
+				noco::Asset::RetainAudioUntilOneShotEnds(audio);
 			}
 		};
 
@@ -12,6 +12,127 @@
 
 namespace noco
 {
+	namespace
+	{
+		/// @brief 遅延生成用に保持するコンポーネントファクトリを取得
+		/// @note 組み込みのファクトリは静的な寿命を持つため所有せずに参照する
+		[[nodiscard]]
+		std::shared_ptr<const ComponentFactory> ShareComponentFactory(const ComponentFactory& factory)
+		{
+			if (&factory == &ComponentFactory::GetBuiltinFactory())
+			{
+				return std::shared_ptr<const ComponentFactory>{ std::shared_ptr<const ComponentFactory>{}, &factory };
+			}
+			return std::make_shared<const ComponentFactory>(factory);
+		}
+
+		/// @brief Node::Create直後のノードを取得
+		[[nodiscard]]
+		const Node& DefaultNode()
+		{
+			static const std::shared_ptr<const Node> defaultNode = Node::Create();
+			return *defaultNode;
+		}
+
+		/// @brief Node::Create直後のノードをシリアライズしたJSONを取得
+		[[nodiscard]]
+		const JSON& DefaultNodeJSON()
+		{
+			static const JSON defaultNodeJSON = DefaultNode().toJSON();
+			return defaultNodeJSON;
+		}
+
+		/// @brief ノードのJSONから既定値と等しい設定値を省略する(コンポーネント・子ノードは対象外)
+		void EraseDefaultNodeValuesFromJSON(JSON& nodeJSON)
+		{
+			// 読み込み時は存在しないキーに既定値を使用するため、既定値と等しい設定値は省略できる
+			detail::EraseDefaultValuesFromJSON(nodeJSON, DefaultNodeJSON(), { U"name", U"components", U"children", U"_instanceId" });
+			if (nodeJSON.contains(U"transform"))
+			{
+				JSON transformJSON = nodeJSON[U"transform"];
+				detail::EraseDefaultValuesFromJSON(transformJSON, DefaultNodeJSON()[U"transform"]);
+				if (transformJSON.size() == 0)
+				{
+					nodeJSON.erase(U"transform");
+				}
+				else
+				{
+					nodeJSON[U"transform"] = transformJSON;
+				}
+			}
+		}
+
+		/// @brief 生成が遅延されているノードの中身(components・children)から既定値と等しい設定値を再帰的に省略する
+		void EraseDefaultValuesFromDeferredJSON(JSON& contentJSON)
+		{
+			if (contentJSON.contains(U"components") && contentJSON[U"components"].isArray())
+			{
+				Array<JSON> componentsJSON;
+				for (const auto& componentJSON : contentJSON[U"components"].arrayView())
+				{
+					JSON omittedComponentJSON = componentJSON;
+					detail::EraseDefaultComponentValuesFromJSON(omittedComponentJSON);
+					componentsJSON.push_back(std::move(omittedComponentJSON));
+				}
+				contentJSON[U"components"] = componentsJSON;
+			}
+			if (contentJSON.contains(U"children") && contentJSON[U"children"].isArray())
+			{
+				Array<JSON> childrenJSON;
+				for (const auto& childJSON : contentJSON[U"children"].arrayView())
+				{
+					JSON omittedChildJSON = childJSON;
+					EraseDefaultNodeValuesFromJSON(omittedChildJSON);
+					EraseDefaultValuesFromDeferredJSON(omittedChildJSON);
+					childrenJSON.push_back(std::move(omittedChildJSON));
+				}
+				contentJSON[U"children"] = childrenJSON;
+			}
+		}
+
+		[[nodiscard]]
+		String GetComponentTypeFromJSON(const JSON& componentJSON)
+		{
+			return componentJSON.contains(U"type") ? componentJSON[U"type"].getOr<String>(U"") : String{};
+		}
+
+		/// @brief 生成が遅延されているノードの中身を生成せずに走査し、条件を満たし得るコンポーネント・子ノードが含まれるかどうかを取得
+		[[nodiscard]]
+		bool DeferredJSONMayContain(const JSON& contentJSON, const std::function<bool(const JSON&)>& componentPredicate, const std::function<bool(const JSON&)>& childPredicate, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas)
+		{
+			if (contentJSON.contains(U"components") && contentJSON[U"components"].isArray())
+			{
+				for (const auto& componentJSON : contentJSON[U"components"].arrayView())
+				{
+					// SubCanvasの中身は読み込むまで分からないため、含まれる場合は条件を満たし得るとみなす
+					if (includeSubCanvas && GetComponentTypeFromJSON(componentJSON) == U"SubCanvas")
+					{
+						return true;
+					}
+					if (componentPredicate && componentPredicate(componentJSON))
+					{
+						return true;
+					}
+				}
+			}
+			if (contentJSON.contains(U"children") && contentJSON[U"children"].isArray())
+			{
+				for (const auto& childJSON : contentJSON[U"children"].arrayView())
+				{
+					if (childPredicate && childPredicate(childJSON))
+					{
+						return true;
+					}
+					if (recursive && DeferredJSONMayContain(childJSON, componentPredicate, childPredicate, RecursiveYN::Yes, includeSubCanvas))
+					{
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+	}
+
 	InteractionState Node::updateForCurrentInteractionState(const std::shared_ptr<Node>& hoveredNode, InteractableYN parentInteractable, IsScrollingYN isAncestorScrolling, const HashTable<String, ParamValue>& params)
 	{
 		const InteractableYN interactable{ m_interactable.value() && parentInteractable };
@@ -102,20 +223,29 @@ namespace noco
 	{
 		const bool prevActiveInHierarchy = m_activeInHierarchy.getBool();
 		
+		ActiveYN activeInHierarchy = ActiveYN::No;
 		if (const auto parent = m_parent.lock())
 		{
-			m_activeInHierarchy = ActiveYN{ m_activeSelf.value() && parent->m_activeInHierarchy };
+			activeInHierarchy = ActiveYN{ m_activeSelf.value() && parent->m_activeInHierarchy };
 		}
 		else if (!m_canvas.expired())
 		{
 			// Canvas配下の直接の子の場合はactiveSelfに依存
-			m_activeInHierarchy = ActiveYN{ m_activeSelf.value() };
+			activeInHierarchy = ActiveYN{ m_activeSelf.value() };
 		}
 		else
 		{
 			// Canvas配下にない場合はactiveInHierarchyはfalse
-			m_activeInHierarchy = ActiveYN::No;
+			activeInHierarchy = ActiveYN::No;
+		}
+
+		// 遅延されている中身は初めてアクティブになる時に生成する
+		// (onActivatedの二重呼び出しを避けるため、activeInHierarchyを更新する前に生成する)
+		if (activeInHierarchy)
+		{
+			materializeIfDeferred();
 		}
+		m_activeInHierarchy = activeInHierarchy;
 		
 		// activeInHierarchyがfalseからtrueに変わった時にonActivatedを呼び出し
 		if (m_activeInHierarchy && !prevActiveInHierarchy)
@@ -307,6 +437,37 @@ namespace noco
 		}
 	}
 
+	const Array<size_t>& detail::ChildrenDrawOrderCache::get(const Array<std::shared_ptr<Node>>& children)
+	{
+		// 内容バージョンは値が変化する度に増加するのみのため、合計が変わらなければいずれのzOrderInSiblingsも変化していない
+		uint64 zOrderVersionSum = 0;
+		bool sameChildren = m_instanceIds.size() == children.size();
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			zOrderVersionSum += children[i]->zOrderInSiblingsProperty().contentVersion();
+			sameChildren = sameChildren && m_instanceIds[i] == children[i]->instanceId();
+		}
+		if (sameChildren && zOrderVersionSum == m_zOrderVersionSum)
+		{
+			return m_order;
+		}
+
+		m_instanceIds.resize(children.size());
+		m_order.resize(children.size());
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			m_instanceIds[i] = children[i]->instanceId();
+			m_order[i] = i;
+		}
+		std::stable_sort(m_order.begin(), m_order.end(),
+			[&children](size_t a, size_t b)
+			{
+				return children[a]->zOrderInSiblings() < children[b]->zOrderInSiblings();
+			});
+		m_zOrderVersionSum = zOrderVersionSum;
+		return m_order;
+	}
+
 	std::shared_ptr<Node> Node::Create(StringView name, const RegionVariant& region, IsHitTargetYN isHitTarget, InheritChildrenStateFlags inheritChildrenStateFlags)
 	{
 		return std::shared_ptr<Node>{ new Node{ s_nextInstanceId++, name, region, isHitTarget, inheritChildrenStateFlags } };
@@ -398,51 +559,152 @@ namespace noco
 		return std::holds_alternative<AnchorRegion>(m_region);
 	}
 
-	JSON Node::toJSON(detail::WithInstanceIdYN withInstanceId) const
+	JSON Node::toJSON(detail::WithInstanceIdYN withInstanceId, OmitDefaultValuesYN omitDefaultValues) const
 	{
+		// インスタンスIDは生成時に割り当てられるため、インスタンスID付きの場合は遅延されている中身を生成する
+		if (withInstanceId)
+		{
+			materializeIfDeferred();
+		}
+
 		Array<JSON> childrenJSON;
 		for (const auto& child : m_children)
 		{
-			childrenJSON.push_back(child->toJSON(withInstanceId));
+			childrenJSON.push_back(child->toJSON(withInstanceId, omitDefaultValues));
 		}
 
 		JSON result
 		{
 			{ U"name", m_name },
-			{ U"region", std::visit([](const auto& region) { return region.toJSON(); }, m_region) },
-			{ U"transform", m_transform.toJSON() },
-			{ U"childrenLayout", std::visit([](const auto& childrenLayout) { return childrenLayout.toJSON(); }, m_childrenLayout) },
 			{ U"components", Array<JSON>{} },
 			{ U"children", childrenJSON },
-			{ U"isHitTarget", m_isHitTarget.getBool() },
-			{ U"hitPadding", m_hitPadding.toJSON() },
-			{ U"inheritChildrenHover", inheritChildrenHover() },
-			{ U"inheritChildrenPress", inheritChildrenPress() },
-			{ U"horizontalScrollable", horizontalScrollable() },
-			{ U"verticalScrollable", verticalScrollable() },
-			{ U"wheelScrollEnabled", wheelScrollEnabled() },
-			{ U"dragScrollEnabled", dragScrollEnabled() },
-			{ U"decelerationRate", m_decelerationRate },
-			{ U"rubberBandScrollEnabled", m_rubberBandScrollEnabled.getBool() },
-			{ U"scrollBarType", EnumToString(m_scrollBarType) },
-			{ U"clippingEnabled", m_clippingEnabled.getBool() },
 		};
-		
-		m_activeSelf.appendJSON(result);
-		m_interactable.appendJSON(result);
-		m_styleState.appendJSON(result);
-		m_zOrderInSiblings.appendJSON(result);
+
+		if (omitDefaultValues)
+		{
+			// 読み込み時は存在しないキーに既定値を使用するため、既定値と等しい設定値は書き込まない
+			const Node& defaultNode = DefaultNode();
+			if (m_region != defaultNode.m_region)
+			{
+				result[U"region"] = std::visit([](const auto& region) { return region.toJSON(); }, m_region);
+			}
+			if (const JSON transformJSON = m_transform.toJSON(OmitDefaultValuesYN::Yes); transformJSON.size() > 0)
+			{
+				result[U"transform"] = transformJSON;
+			}
+			if (JSON childrenLayoutJSON = std::visit([](const auto& childrenLayout) { return childrenLayout.toJSON(); }, m_childrenLayout);
+				childrenLayoutJSON != DefaultNodeJSON()[U"childrenLayout"])
+			{
+				result[U"childrenLayout"] = std::move(childrenLayoutJSON);
+			}
+			if (m_isHitTarget.getBool() != defaultNode.m_isHitTarget.getBool())
+			{
+				result[U"isHitTarget"] = m_isHitTarget.getBool();
+			}
+			if (m_hitPadding != defaultNode.m_hitPadding)
+			{
+				result[U"hitPadding"] = m_hitPadding.toJSON();
+			}
+			if (inheritChildrenHover() != defaultNode.inheritChildrenHover())
+			{
+				result[U"inheritChildrenHover"] = inheritChildrenHover();
+			}
+			if (inheritChildrenPress() != defaultNode.inheritChildrenPress())
+			{
+				result[U"inheritChildrenPress"] = inheritChildrenPress();
+			}
+			if (horizontalScrollable() != defaultNode.horizontalScrollable())
+			{
+				result[U"horizontalScrollable"] = horizontalScrollable();
+			}
+			if (verticalScrollable() != defaultNode.verticalScrollable())
+			{
+				result[U"verticalScrollable"] = verticalScrollable();
+			}
+			if (wheelScrollEnabled() != defaultNode.wheelScrollEnabled())
+			{
+				result[U"wheelScrollEnabled"] = wheelScrollEnabled();
+			}
+			if (dragScrollEnabled() != defaultNode.dragScrollEnabled())
+			{
+				result[U"dragScrollEnabled"] = dragScrollEnabled();
+			}
+			if (m_decelerationRate != defaultNode.m_decelerationRate)
+			{
+				result[U"decelerationRate"] = m_decelerationRate;
+			}
+			if (m_rubberBandScrollEnabled.getBool() != defaultNode.m_rubberBandScrollEnabled.getBool())
+			{
+				result[U"rubberBandScrollEnabled"] = m_rubberBandScrollEnabled.getBool();
+			}
+			if (m_scrollBarType != defaultNode.m_scrollBarType)
+			{
+				result[U"scrollBarType"] = EnumToString(m_scrollBarType);
+			}
+			if (m_clippingEnabled.getBool() != defaultNode.m_clippingEnabled.getBool())
+			{
+				result[U"clippingEnabled"] = m_clippingEnabled.getBool();
+			}
+
+			m_activeSelf.appendJSONIfNotDefault(result, defaultNode.m_activeSelf);
+			m_interactable.appendJSONIfNotDefault(result, defaultNode.m_interactable);
+			m_styleState.appendJSONIfNotDefault(result, defaultNode.m_styleState);
+			m_zOrderInSiblings.appendJSONIfNotDefault(result, defaultNode.m_zOrderInSiblings);
+		}
+		else
+		{
+			result[U"region"] = std::visit([](const auto& region) { return region.toJSON(); }, m_region);
+			result[U"transform"] = m_transform.toJSON();
+			result[U"childrenLayout"] = std::visit([](const auto& childrenLayout) { return childrenLayout.toJSON(); }, m_childrenLayout);
+			result[U"isHitTarget"] = m_isHitTarget.getBool();
+			result[U"hitPadding"] = m_hitPadding.toJSON();
+			result[U"inheritChildrenHover"] = inheritChildrenHover();
+			result[U"inheritChildrenPress"] = inheritChildrenPress();
+			result[U"horizontalScrollable"] = horizontalScrollable();
+			result[U"verticalScrollable"] = verticalScrollable();
+			result[U"wheelScrollEnabled"] = wheelScrollEnabled();
+			result[U"dragScrollEnabled"] = dragScrollEnabled();
+			result[U"decelerationRate"] = m_decelerationRate;
+			result[U"rubberBandScrollEnabled"] = m_rubberBandScrollEnabled.getBool();
+			result[U"scrollBarType"] = EnumToString(m_scrollBarType);
+			result[U"clippingEnabled"] = m_clippingEnabled.getBool();
+
+			m_activeSelf.appendJSON(result);
+			m_interactable.appendJSON(result);
+			m_styleState.appendJSON(result);
+			m_zOrderInSiblings.appendJSON(result);
+		}
 
 		if (withInstanceId)
 		{
 			result[U"_instanceId"] = m_instanceId;
 		}
 
+		if (m_deferredContent)
+		{
+			// 生成が遅延されている場合は、保持している内容を出力する
+			m_deferredContent->jsonLocation.visit([&](const JSON& json)
+				{
+					JSON contentJSON
+					{
+						{ U"components", (json.contains(U"components") && json[U"components"].isArray()) ? json[U"components"] : JSON(Array<JSON>{}) },
+						{ U"children", (json.contains(U"children") && json[U"children"].isArray()) ? json[U"children"] : JSON(Array<JSON>{}) },
+					};
+					if (omitDefaultValues)
+					{
+						EraseDefaultValuesFromDeferredJSON(contentJSON);
+					}
+					result[U"components"] = contentJSON[U"components"];
+					result[U"children"] = contentJSON[U"children"];
+				});
+			return result;
+		}
+
 		for (const std::shared_ptr<ComponentBase>& component : m_components)
 		{
 			if (const auto serializableComponent = std::dynamic_pointer_cast<SerializableComponentBase>(component))
 			{
-				result[U"components"].push_back(serializableComponent->toJSON(withInstanceId));
+				result[U"components"].push_back(serializableComponent->toJSON(withInstanceId, omitDefaultValues));
 			}
 		}
 
@@ -451,6 +713,8 @@ namespace noco
 
 	void Node::populateParamRefs(HashSet<String>* pParamRefs) const
 	{
+		materializeIfDeferred();
+
 		if (!m_activeSelf.paramRef().isEmpty())
 		{
 			pParamRefs->insert(m_activeSelf.paramRef());
@@ -499,6 +763,11 @@ namespace noco
 	}
 	
 	std::shared_ptr<Node> Node::CreateFromJSON(const JSON& json, const ComponentFactory& componentFactory, detail::WithInstanceIdYN withInstanceId)
+	{
+		return CreateFromJSONImpl(json, componentFactory, withInstanceId, nullptr);
+	}
+
+	std::shared_ptr<Node> Node::CreateFromJSONImpl(const JSON& json, const ComponentFactory& componentFactory, detail::WithInstanceIdYN withInstanceId, const detail::SharedJSONLocation* location)
 	{
 		auto node = Node::Create();
 		if (json.contains(U"name"))
@@ -607,6 +876,23 @@ namespace noco
 			s_nextInstanceId = Max(s_nextInstanceId.load(), node->m_instanceId + 1);
 		}
 
+		// 遅延読み込みが有効な場合、非アクティブなノードの中身は生成せずに保持する
+		// (インスタンスIDは生成時に割り当てる必要があるため、インスタンスID付きの読み込みやエディタモードでは遅延しない)
+		if (IsDeferredNodeLoadingEnabled() && !withInstanceId && !detail::IsEditorMode() && !node->m_activeSelf.value())
+		{
+			const bool hasComponents = json.contains(U"components") && json[U"components"].isArray() && json[U"components"].size() > 0;
+			const bool hasChildren = json.contains(U"children") && json[U"children"].isArray() && json[U"children"].size() > 0;
+			if (hasComponents || hasChildren)
+			{
+				// 読み込み元のJSONを共有できない場合のみ、このノードのJSONを複製する(子孫の遅延ノードはこの複製を共有する)
+				node->m_deferredContent = std::make_unique<DeferredContent>(DeferredContent{
+					.jsonLocation = location ? *location : detail::SharedJSONLocation{ .source = std::make_shared<const JSON>(json) },
+					.componentFactory = ShareComponentFactory(componentFactory),
+				});
+				return node;
+			}
+		}
+
 		if (json.contains(U"components") && json[U"components"].isArray())
 		{
 			for (const auto& componentJSON : json[U"components"].arrayView())
@@ -617,10 +903,15 @@ namespace noco
 
 		if (json.contains(U"children") && json[U"children"].isArray())
 		{
+			// 子孫に遅延するノードがあり得る場合のみ、共有されたJSON内での位置を辿る
+			const bool tracksLocation = location && IsDeferredNodeLoadingEnabled() && !withInstanceId && !detail::IsEditorMode();
+			size_t childIndex = 0;
 			for (const auto& childJSON : json[U"children"].arrayView())
 			{
-				auto child = CreateFromJSON(childJSON, componentFactory, withInstanceId);
+				const Optional<detail::SharedJSONLocation> childLocation = tracksLocation ? Optional<detail::SharedJSONLocation>{ location->child(childIndex) } : none;
+				auto child = CreateFromJSONImpl(childJSON, componentFactory, withInstanceId, childLocation ? &*childLocation : nullptr);
 				node->addChild(child);
+				++childIndex;
 			}
 		}
 		return node;
@@ -856,10 +1147,13 @@ namespace noco
 			component->onDeactivated(shared_from_this());
 		}
 		m_components.remove(component);
+		++m_componentsVersion;
 	}
 
 	void Node::removeComponentsAll(RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas)
 	{
+		materializeIfDeferred();
+
 		// SubCanvasの子を先に処理（m_components.clear()の前に行う必要がある）
 		if (recursive == RecursiveYN::Yes && includeSubCanvas)
 		{
@@ -880,6 +1174,7 @@ namespace noco
 			}
 		}
 		m_components.clear();
+		++m_componentsVersion;
 
 		if (recursive == RecursiveYN::Yes)
 		{
@@ -904,6 +1199,7 @@ namespace noco
 			return false;
 		}
 		std::iter_swap(it, std::prev(it));
+		++m_componentsVersion;
 		return true;
 	}
 
@@ -921,11 +1217,14 @@ namespace noco
 			return false;
 		}
 		std::iter_swap(it, std::next(it));
+		++m_componentsVersion;
 		return true;
 	}
 
 	const std::shared_ptr<Node>& Node::addChild(std::shared_ptr<Node>&& child)
 	{
+		materializeIfDeferred();
+
 		if (!child->m_parent.expired() || child->isTopLevelNode())
 		{
 			throw Error{ U"addChild: Child node '{}' already has a parent node or parent canvas"_fmt(child->m_name) };
@@ -949,6 +1248,8 @@ namespace noco
 
 	const std::shared_ptr<Node>& Node::addChild(const std::shared_ptr<Node>& child)
 	{
+		materializeIfDeferred();
+
 		if (!child->m_parent.expired() || child->isTopLevelNode())
 		{
 			throw Error{ U"addChild: Child node '{}' already has a parent node or parent canvas"_fmt(child->m_name) };
@@ -972,6 +1273,8 @@ namespace noco
 
 	const std::shared_ptr<Node>& Node::emplaceChild(StringView name, const RegionVariant& region, IsHitTargetYN isHitTarget, InheritChildrenStateFlags inheritChildrenStateFlags)
 	{
+		materializeIfDeferred();
+
 		auto child = Node::Create(name, region, isHitTarget, inheritChildrenStateFlags);
 		child->setCanvasRecursive(m_canvas);
 		child->m_parent = shared_from_this();
@@ -1006,6 +1309,8 @@ namespace noco
 
 	const std::shared_ptr<Node>& Node::addChildFromJSON(const JSON& json)
 	{
+		materializeIfDeferred();
+
 		auto child = CreateFromJSON(json);
 		child->setCanvasRecursive(m_canvas);
 		child->m_parent = shared_from_this();
@@ -1018,6 +1323,8 @@ namespace noco
 	
 	const std::shared_ptr<Node>& Node::addChildFromJSON(const JSON& json, const ComponentFactory& factory)
 	{
+		materializeIfDeferred();
+
 		auto child = CreateFromJSON(json, factory);
 		child->setCanvasRecursive(m_canvas);
 		child->m_parent = shared_from_this();
@@ -1030,6 +1337,8 @@ namespace noco
 
 	const std::shared_ptr<Node>& Node::addChildAtIndexFromJSON(const JSON& json, size_t index)
 	{
+		materializeIfDeferred();
+
 		if (index > m_children.size())
 		{
 			index = m_children.size();
@@ -1047,6 +1356,8 @@ namespace noco
 	
 	const std::shared_ptr<Node>& Node::addChildAtIndexFromJSON(const JSON& json, size_t index, const ComponentFactory& factory)
 	{
+		materializeIfDeferred();
+
 		if (index > m_children.size())
 		{
 			index = m_children.size();
@@ -1064,6 +1375,8 @@ namespace noco
 
 	const std::shared_ptr<Node>& Node::addChildAtIndex(const std::shared_ptr<Node>& child, size_t index)
 	{
+		materializeIfDeferred();
+
 		if (!child->m_parent.expired() || child->isTopLevelNode())
 		{
 			throw Error{ U"addChildAtIndex: Child node '{}' already has a parent node or parent canvas"_fmt(child->m_name) };
@@ -1148,6 +1461,17 @@ namespace noco
 
 	std::shared_ptr<Node> Node::findByName(StringView name, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas)
 	{
+		// 遅延されている中身に該当する名前のノードが含まれない場合は生成しない
+		const auto childPredicate = [name](const JSON& childJSON)
+		{
+			return childJSON.contains(U"name") && childJSON[U"name"].getOr<String>(U"") == name;
+		};
+		if (!deferredContentMayContain(nullptr, childPredicate, recursive, includeSubCanvas))
+		{
+			return nullptr;
+		}
+		materializeIfDeferred();
+
 		for (const auto& child : m_children)
 		{
 			if (child->m_name == name)
@@ -1300,6 +1624,21 @@ namespace noco
 		return RectF{ contentRect.x - padding.left, contentRect.y - padding.top, contentRect.w + padding.left + padding.right, contentRect.h + padding.top + padding.bottom };
 	}
 
+	bool Node::isTransparentForHitTest() const
+	{
+		if (m_transform.color().value().a != 0)
+		{
+			return false;
+		}
+
+		// アルファが0の場合のみCanvasの設定を参照する
+		if (const auto canvas = m_canvas.lock())
+		{
+			return !canvas->m_transparentHitTestEnabled;
+		}
+		return false;
+	}
+
 	std::shared_ptr<Node> Node::hoveredNodeRecursive(OnlyScrollableYN onlyScrollable, detail::UsePrevZOrderInSiblingsYN usePrevZOrderInSiblings)
 	{
 		return hitTest(Cursor::PosF(), onlyScrollable, usePrevZOrderInSiblings);
@@ -1313,6 +1652,13 @@ namespace noco
 			return nullptr;
 		}
 
+		// 透明ノードのヒットテストが無効の場合、乗算カラーのアルファが0のノードは子孫を含めてスキップ
+		// (階層内の乗算カラーのアルファはいずれかが0であれば累積値も0になるため、各ノード自身の値のみ見ればよい)
+		if (isTransparentForHitTest())
+		{
+			return nullptr;
+		}
+
 		// 子のヒットテスト実行
 		// (クリッピング有効の場合は座標が自身の領域(※hitPaddingを含まない)内である場合のみ実行)
 		if (!m_clippingEnabled || m_hitQuad.contains(point))
@@ -1382,6 +1728,13 @@ namespace noco
 			return nullptr;
 		}
 
+		// 透明ノードのヒットテストが無効の場合、乗算カラーのアルファが0のノードは子孫を含めてスキップ
+		// (階層内の乗算カラーのアルファはいずれかが0であれば累積値も0になるため、各ノード自身の値のみ見ればよい)
+		if (isTransparentForHitTest())
+		{
+			return nullptr;
+		}
+
 		// 子のヒットテスト実行
 		// (クリッピング有効の場合は座標が自身の領域(※hitPaddingを含まない)内である場合のみ実行)
 		if (!m_clippingEnabled || m_hitQuad.contains(point))
@@ -2051,6 +2404,8 @@ namespace noco
 
 	void Node::replaceParamRefs(const String& oldName, const String& newName, RecursiveYN recursive)
 	{
+		materializeIfDeferred();
+
 		if (oldName.isEmpty())
 		{
 			Logger << U"[NocoUI warning] Node::replaceParamRefs called with empty oldName";
@@ -2122,23 +2477,30 @@ namespace noco
 			return;
 		}
 
-		// クリッピング有効の場合はクリッピング範囲を設定
-		Optional<detail::ScopedScissorRect> scissorRect;
-		if (m_clippingEnabled)
-		{
-			scissorRect.emplace(unrotatedTransformedRect().asRect());
-		}
-
 		// Transformの乗算カラーを適用
 		const ColorF transformColor = m_transform.color().value();
-		Optional<ScopedColorMul2D> colorMul;
 		const ColorF currentColor = ColorF{ Graphics2D::GetColorMul() };
 		const ColorF newColor = currentColor * transformColor;
+
+		// 累積の乗算カラーのアルファが0の場合は何も表示されないため、子孫を含めて描画をスキップ
+		if (newColor.a <= 0.0)
+		{
+			return;
+		}
+
+		Optional<ScopedColorMul2D> colorMul;
 		if (transformColor != ColorF{ 1.0 })
 		{
 			colorMul.emplace(newColor);
 		}
 
+		// クリッピング有効の場合はクリッピング範囲を設定
+		Optional<detail::ScopedScissorRect> scissorRect;
+		if (m_clippingEnabled)
+		{
+			scissorRect.emplace(unrotatedTransformedRect().asRect());
+		}
+
 		// draw関数はconstのため、addComponentやaddChild等によるイテレータ破壊は考慮不要とする
 		{
 			Optional<Transformer2D> transformer;
@@ -2147,9 +2509,13 @@ namespace noco
 				transformer.emplace(m_transformMatInHierarchy);
 			}
 
-			for (const auto& component : m_components)
+			// オクルージョンカリングで手前のノードに完全に隠れている場合は自身のコンポーネントの描画をスキップ
+			if (!m_occlusionCulled)
 			{
-				component->draw(*this);
+				for (const auto& component : m_components)
+				{
+					component->draw(*this);
+				}
 			}
 		}
 
@@ -2160,17 +2526,11 @@ namespace noco
 		// 子ノードのdraw実行
 		if (!m_children.empty())
 		{
-			m_tempChildrenBuffer.clear();
-			m_tempChildrenBuffer.reserve(m_children.size());
-			m_tempChildrenBuffer.assign(m_children.begin(), m_children.end());
-			SortByZOrderInSiblings(m_tempChildrenBuffer);
-
 			// drawはzOrder昇順で実行(奥から手前へ)
-			for (const auto& child : m_tempChildrenBuffer)
+			for (const size_t childIndex : m_childrenDrawOrderCache.get(m_children))
 			{
-				child->draw();
+				m_children[childIndex]->draw();
 			}
-			m_tempChildrenBuffer.clear();
 		}
 
 		// スクロールバー描画
@@ -2351,6 +2711,41 @@ namespace noco
 		return RectF{ Arg::center = center, width, height };
 	}
 
+	Optional<RectF> Node::drawnBoundingRect() const
+	{
+		LRTB overflow = LRTB::Zero();
+		for (const auto& component : m_components)
+		{
+			const Optional<LRTB> componentOverflow = component->drawOverflow();
+			if (!componentOverflow)
+			{
+				return none;
+			}
+			overflow.left = Max(overflow.left, componentOverflow->left);
+			overflow.right = Max(overflow.right, componentOverflow->right);
+			overflow.top = Max(overflow.top, componentOverflow->top);
+			overflow.bottom = Max(overflow.bottom, componentOverflow->bottom);
+		}
+
+		if (overflow == LRTB::Zero())
+		{
+			return m_transformedQuad.boundingRect();
+		}
+
+		// はみ出しを含む領域をノードと同じ変換行列で変換する
+		const RectF drawnRect{
+			m_regionRect.x - overflow.left,
+			m_regionRect.y - overflow.top,
+			m_regionRect.w + overflow.left + overflow.right,
+			m_regionRect.h + overflow.top + overflow.bottom };
+		const Quad drawnQuad{
+			m_transformMatInHierarchy.transformPoint(drawnRect.tl()),
+			m_transformMatInHierarchy.transformPoint(drawnRect.tr()),
+			m_transformMatInHierarchy.transformPoint(drawnRect.br()),
+			m_transformMatInHierarchy.transformPoint(drawnRect.bl()) };
+		return drawnQuad.boundingRect();
+	}
+
 	Mat3x2 Node::calculateHitTestMat(const Mat3x2& parentHitTestMat) const
 	{
 		if (m_transform.hitTestAffected().value())
@@ -2464,14 +2859,22 @@ namespace noco
 
 	bool Node::hasChildren() const
 	{
+		materializeIfDeferred();
 		return !m_children.isEmpty();
 	}
 
 	const Array<std::shared_ptr<ComponentBase>>& Node::components() const
 	{
+		materializeIfDeferred();
 		return m_components;
 	}
 
+	uint64 Node::componentsVersion() const
+	{
+		materializeIfDeferred();
+		return m_componentsVersion;
+	}
+
 	bool Node::interactable() const
 	{
 		return m_interactable.value();
@@ -3203,6 +3606,8 @@ namespace noco
 
 	void Node::removeChildrenAll()
 	{
+		materializeIfDeferred();
+
 		for (const auto& child : m_children)
 		{
 			child->setCanvasRecursive(std::weak_ptr<Canvas>{});
@@ -3261,11 +3666,168 @@ namespace noco
 
 	std::shared_ptr<Node> Node::clone() const
 	{
-		return CreateFromJSON(toJSON());
+		return clone(ComponentFactory::GetBuiltinFactory());
+	}
+
+	std::shared_ptr<Node> Node::clone(const ComponentFactory& componentFactory) const
+	{
+		auto node = Node::Create(m_name, m_region, m_isHitTarget, m_inheritChildrenStateFlags);
+		node->m_transform.copySerializedFrom(m_transform);
+		node->m_childrenLayout = m_childrenLayout;
+		node->m_hitPadding = m_hitPadding;
+		node->m_interactable.copySerializedFrom(m_interactable);
+		node->m_scrollableAxisFlags = m_scrollableAxisFlags;
+		node->m_scrollMethodFlags = m_scrollMethodFlags;
+		node->m_decelerationRate = m_decelerationRate;
+		node->m_rubberBandScrollEnabled = m_rubberBandScrollEnabled;
+		node->m_scrollBarType = m_scrollBarType;
+		node->m_clippingEnabled = m_clippingEnabled;
+		node->m_activeSelf.copySerializedFrom(m_activeSelf);
+		node->m_styleState.copySerializedFrom(m_styleState);
+		node->m_zOrderInSiblings.copySerializedFrom(m_zOrderInSiblings);
+
+		if (m_deferredContent)
+		{
+			// 生成が遅延されている中身は生成せずに複製元と共有する
+			node->m_deferredContent = std::make_unique<DeferredContent>(DeferredContent{
+				.jsonLocation = m_deferredContent->jsonLocation,
+				.componentFactory = (m_deferredContent->componentFactory.get() == &componentFactory) ? m_deferredContent->componentFactory : ShareComponentFactory(componentFactory),
+			});
+			return node;
+		}
+
+		for (const auto& component : m_components)
+		{
+			// シリアライズ対象外のコンポーネント(addUpdater等で追加した関数オブジェクト)は従来通り複製しない
+			if (const auto serializableComponent = std::dynamic_pointer_cast<SerializableComponentBase>(component))
+			{
+				if (auto clonedComponent = serializableComponent->cloneComponent(componentFactory))
+				{
+					node->addComponent(clonedComponent);
+				}
+			}
+		}
+
+		for (const auto& child : m_children)
+		{
+			node->addChild(child->clone(componentFactory));
+		}
+
+		return node;
+	}
+
+	bool Node::hasDeferredContent() const
+	{
+		return m_deferredContent != nullptr;
+	}
+
+	bool Node::deferredContentMayContain(const std::function<bool(const JSON&)>& componentPredicate, const std::function<bool(const JSON&)>& childPredicate, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const
+	{
+		if (!m_deferredContent)
+		{
+			return true;
+		}
+		bool mayContain = true;
+		m_deferredContent->jsonLocation.visit([&](const JSON& json)
+			{
+				mayContain = DeferredJSONMayContain(json, componentPredicate, childPredicate, recursive, includeSubCanvas);
+			});
+		return mayContain;
+	}
+
+	bool Node::deferredContentMayContainComponentOf(bool (*isInstanceOf)(const ComponentBase&), RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const
+	{
+		if (!m_deferredContent)
+		{
+			return true;
+		}
+
+		DeferredContent& deferredContent = *m_deferredContent;
+		const auto componentPredicate = [&](const JSON& componentJSON)
+		{
+			const String type = GetComponentTypeFromJSON(componentJSON);
+			auto it = deferredContent.componentTypeProbes.find(type);
+			if (it == deferredContent.componentTypeProbes.end())
+			{
+				it = deferredContent.componentTypeProbes.emplace(type, deferredContent.componentFactory->createComponent(type)).first;
+			}
+			// ファクトリで生成できない種類(未知のコンポーネント)は型を判定できないため、含まれ得るとみなす
+			return !it->second || isInstanceOf(*it->second);
+		};
+		bool mayContain = true;
+		deferredContent.jsonLocation.visit([&](const JSON& json)
+			{
+				mayContain = DeferredJSONMayContain(json, componentPredicate, nullptr, recursive, IncludeSubCanvasYN{ recursive && includeSubCanvas });
+			});
+		return mayContain;
+	}
+
+	bool Node::deferredContentMayContainTag(StringView tag, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas) const
+	{
+		const auto componentPredicate = [tag](const JSON& componentJSON)
+		{
+			// パラメータ参照を持つ場合は値が実行時に決まるため、一致し得るとみなす
+			if (componentJSON.contains(U"tag_paramRef") && !componentJSON[U"tag_paramRef"].getOr<String>(U"").isEmpty())
+			{
+				return true;
+			}
+			return componentJSON.contains(U"tag") && componentJSON[U"tag"].getOr<String>(U"") == tag;
+		};
+		return deferredContentMayContain(componentPredicate, nullptr, recursive, IncludeSubCanvasYN{ recursive && includeSubCanvas });
+	}
+
+	void Node::materializeDeferredContent(RecursiveYN recursive)
+	{
+		materializeIfDeferred();
+
+		if (recursive)
+		{
+			for (const auto& child : m_children)
+			{
+				child->materializeDeferredContent(RecursiveYN::Yes);
+			}
+		}
+	}
+
+	void Node::materializeDeferredContentImpl()
+	{
+		// 生成中に再度呼ばれた場合に二重に生成しないよう、先に取り出しておく
+		const std::unique_ptr<DeferredContent> deferredContent = std::move(m_deferredContent);
+		if (!deferredContent)
+		{
+			return;
+		}
+
+		const detail::SharedJSONLocation& location = deferredContent->jsonLocation;
+		const ComponentFactory& componentFactory = *deferredContent->componentFactory;
+		location.visit([&](const JSON& json)
+			{
+				if (json.contains(U"components") && json[U"components"].isArray())
+				{
+					for (const auto& componentJSON : json[U"components"].arrayView())
+					{
+						addComponentFromJSONImpl(componentJSON, componentFactory, detail::WithInstanceIdYN::No);
+					}
+				}
+
+				// 子孫の遅延ノードは同じJSONを共有する
+				if (json.contains(U"children") && json[U"children"].isArray())
+				{
+					size_t childIndex = 0;
+					for (const auto& childJSON : json[U"children"].arrayView())
+					{
+						const detail::SharedJSONLocation childLocation = location.child(childIndex);
+						addChild(CreateFromJSONImpl(childJSON, componentFactory, detail::WithInstanceIdYN::No, &childLocation));
+						++childIndex;
+					}
+				}
+			});
 	}
 
 	std::shared_ptr<Node> Node::childAt(size_t index) const
 	{
+		materializeIfDeferred();
+
 		if (index >= m_children.size())
 		{
 			return nullptr;
@@ -3397,6 +3959,13 @@ namespace noco
 
 	void Node::setTweenActiveAll(bool active, RecursiveYN recursive, IncludeSubCanvasYN includeSubCanvas)
 	{
+		// 遅延されている中身にTweenが含まれない場合は生成しない
+		if (!deferredContentMayContainComponent<Tween>(recursive, includeSubCanvas))
+		{
+			return;
+		}
+		materializeIfDeferred();
+
 		// 自身のTweenコンポーネントをすべて制御
 		for (const auto& component : m_components)
 		{
@@ -3435,6 +4004,13 @@ namespace noco
 			return;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return;
+		}
+		materializeIfDeferred();
+
 		// 自身のTweenコンポーネントをチェック
 		for (const auto& component : m_components)
 		{
@@ -3476,6 +4052,13 @@ namespace noco
 			return false;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return false;
+		}
+		materializeIfDeferred();
+
 		// 自身のTweenコンポーネントをチェック
 		for (const auto& component : m_components)
 		{
@@ -3531,6 +4114,13 @@ namespace noco
 			return none;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return none;
+		}
+		materializeIfDeferred();
+
 		// 自身のTextBox/TextAreaコンポーネントをチェック
 		for (const auto& component : m_components)
 		{
@@ -3587,6 +4177,13 @@ namespace noco
 			return;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return;
+		}
+		materializeIfDeferred();
+
 		// 自身のTextBox/TextAreaコンポーネントをチェック
 		for (const auto& component : m_components)
 		{
@@ -3641,6 +4238,13 @@ namespace noco
 			return none;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return none;
+		}
+		materializeIfDeferred();
+
 		// 自身のToggleコンポーネントをチェック
 		for (const auto& component : m_components)
 		{
@@ -3690,6 +4294,13 @@ namespace noco
 			return;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return;
+		}
+		materializeIfDeferred();
+
 		// 自身のToggleコンポーネントをチェック
 		for (auto& component : m_components)
 		{
@@ -3731,6 +4342,13 @@ namespace noco
 			return nullptr;
 		}
 
+		// 遅延されている中身に該当するタグを持つコンポーネントが含まれない場合は生成しない
+		if (!deferredContentMayContainTag(tag, recursive, includeSubCanvas))
+		{
+			return nullptr;
+		}
+		materializeIfDeferred();
+
 		// 自身のSubCanvasコンポーネントをチェック
 		for (const auto& component : m_components)
 		{
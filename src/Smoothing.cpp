@@ -0,0 +1,162 @@
+﻿#include "NocoUI/Smoothing.hpp"
+
+namespace noco::detail
+{
+	namespace
+	{
+		[[nodiscard]]
+		constexpr size_t LanesIndexOf(size_t laneCount)
+		{
+			switch (laneCount)
+			{
+			case 1:
+				return 0;
+			case 2:
+				return 1;
+			case 4:
+				return 2;
+			default:
+				return 3;
+			}
+		}
+	}
+
+	void SmoothingBatch::Lanes::clear()
+	{
+		current.clear();
+		target.clear();
+		velocity.clear();
+		omega.clear();
+		exp.clear();
+		deltaTime.clear();
+		currentOut.clear();
+		velocityOut.clear();
+	}
+
+	void SmoothingBatch::add(size_t laneCount, double* current, double* velocity, const double* target, double smoothTime, double deltaTime)
+	{
+		const size_t lanesIndex = LanesIndexOf(laneCount);
+		if (lanesIndex >= m_lanes.size())
+		{
+			return;
+		}
+
+		// Math::SmoothDampと同じ係数
+		smoothTime = Max(0.0001, smoothTime);
+		const double omega = 2.0 / smoothTime;
+		const double x = omega * deltaTime;
+		const double exp = 1.0 / (1.0 + x + 0.48 * x * x + 0.235 * x * x * x);
+
+		auto& lanes = m_lanes[lanesIndex];
+		for (size_t i = 0; i < laneCount; ++i)
+		{
+			lanes.current.push_back(current[i]);
+			lanes.target.push_back(target[i]);
+			lanes.velocity.push_back(velocity[i]);
+			lanes.omega.push_back(omega);
+			lanes.exp.push_back(exp);
+			lanes.deltaTime.push_back(deltaTime);
+		}
+		lanes.currentOut.push_back(current);
+		lanes.velocityOut.push_back(velocity);
+	}
+
+	template <size_t LaneCount>
+	void SmoothingBatch::flushLanes(Lanes& lanes)
+	{
+		const size_t count = lanes.currentOut.size();
+		if (count == 0)
+		{
+			return;
+		}
+
+		const size_t laneTotal = count * LaneCount;
+		lanes.result.resize(laneTotal);
+		lanes.resultVelocity.resize(laneTotal);
+
+		const double* current = lanes.current.data();
+		const double* target = lanes.target.data();
+		const double* velocity = lanes.velocity.data();
+		const double* omega = lanes.omega.data();
+		const double* exp = lanes.exp.data();
+		const double* deltaTime = lanes.deltaTime.data();
+		double* result = lanes.result.data();
+		double* resultVelocity = lanes.resultVelocity.data();
+
+		// 要素毎に独立した計算のため、分岐を含まないループでまとめて計算(コンパイラによるベクトル化の対象)
+		for (size_t i = 0; i < laneTotal; ++i)
+		{
+			const double change = current[i] - target[i];
+			const double temp = (velocity[i] + omega[i] * change) * deltaTime[i];
+			resultVelocity[i] = (velocity[i] - omega[i] * temp) * exp[i];
+			result[i] = target[i] + (change + temp) * exp[i];
+		}
+
+		for (size_t entry = 0; entry < count; ++entry)
+		{
+			const size_t base = entry * LaneCount;
+
+			// 目標値を通り過ぎた場合は目標値で止める(Math::SmoothDampと同じ判定)
+			bool overshoot;
+			if constexpr (LaneCount == 1)
+			{
+				overshoot = ((target[base] - current[base]) > 0.0) == (result[base] > target[base]);
+			}
+			else
+			{
+				double dot = 0.0;
+				for (size_t i = base; i < base + LaneCount; ++i)
+				{
+					dot += (target[i] - current[i]) * (result[i] - target[i]);
+				}
+				overshoot = dot > 0.0;
+			}
+
+			// 目標値との差と速度が十分小さい場合は目標値で確定させ、次フレーム以降は登録されないようにする
+			bool settled = true;
+			for (size_t i = base; i < base + LaneCount; ++i)
+			{
+				if (Abs(result[i] - target[i]) > SmoothingSettleThreshold || Abs(resultVelocity[i]) > SmoothingSettleThreshold)
+				{
+					settled = false;
+					break;
+				}
+			}
+
+			double* currentOut = lanes.currentOut[entry];
+			double* velocityOut = lanes.velocityOut[entry];
+			for (size_t i = 0; i < LaneCount; ++i)
+			{
+				if (overshoot || settled)
+				{
+					currentOut[i] = target[base + i];
+					velocityOut[i] = 0.0;
+				}
+				else
+				{
+					currentOut[i] = result[base + i];
+					velocityOut[i] = resultVelocity[base + i];
+				}
+			}
+		}
+
+		lanes.clear();
+	}
+
+	void SmoothingBatch::flush()
+	{
+		flushLanes<1>(m_lanes[0]);
+		flushLanes<2>(m_lanes[1]);
+		flushLanes<4>(m_lanes[2]);
+	}
+
+	size_t SmoothingBatch::size() const
+	{
+		size_t size = 0;
+		for (const auto& lanes : m_lanes)
+		{
+			size += lanes.currentOut.size();
+		}
+		return size;
+	}
+}
@@ -117,9 +117,20 @@ namespace noco
 		m_color.update(interactionState, activeStyleStates, deltaTime, params, skipSmoothing);
 	}
 
-	JSON Transform::toJSON() const
+	JSON Transform::toJSON(OmitDefaultValuesYN omitDefaultValues) const
 	{
 		JSON json;
+		if (omitDefaultValues)
+		{
+			static const Transform defaultTransform;
+			m_translate.appendJSONIfNotDefault(json, defaultTransform.m_translate);
+			m_scale.appendJSONIfNotDefault(json, defaultTransform.m_scale);
+			m_pivot.appendJSONIfNotDefault(json, defaultTransform.m_pivot);
+			m_rotation.appendJSONIfNotDefault(json, defaultTransform.m_rotation);
+			m_hitTestAffected.appendJSONIfNotDefault(json, defaultTransform.m_hitTestAffected);
+			m_color.appendJSONIfNotDefault(json, defaultTransform.m_color);
+			return json;
+		}
 		m_translate.appendJSON(json);
 		m_scale.appendJSON(json);
 		m_pivot.appendJSON(json);
@@ -139,6 +150,36 @@ namespace noco
 		m_color.readFromJSON(json);
 	}
 
+	void Transform::copySerializedFrom(const Transform& other)
+	{
+		m_translate.copySerializedFrom(other.m_translate);
+		m_scale.copySerializedFrom(other.m_scale);
+		m_pivot.copySerializedFrom(other.m_pivot);
+		m_rotation.copySerializedFrom(other.m_rotation);
+		m_hitTestAffected.copySerializedFrom(other.m_hitTestAffected);
+		m_color.copySerializedFrom(other.m_color);
+	}
+
+	void Transform::writeBinary(detail::BinaryCanvasWriter& writer) const
+	{
+		m_translate.writeBinary(writer);
+		m_scale.writeBinary(writer);
+		m_pivot.writeBinary(writer);
+		m_rotation.writeBinary(writer);
+		m_hitTestAffected.writeBinary(writer);
+		m_color.writeBinary(writer);
+	}
+
+	void Transform::readBinary(detail::BinaryCanvasReader& reader)
+	{
+		m_translate.readBinary(reader);
+		m_scale.readBinary(reader);
+		m_pivot.readBinary(reader);
+		m_rotation.readBinary(reader);
+		m_hitTestAffected.readBinary(reader);
+		m_color.readBinary(reader);
+	}
+
 	size_t Transform::countParamRefs(StringView paramName) const
 	{
 		if (paramName.isEmpty())
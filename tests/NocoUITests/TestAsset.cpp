@@ -0,0 +1,311 @@
+#include <catch2/catch.hpp>
+#include <Siv3D.hpp>
+#include <NocoUI.hpp>
+
+// ========================================
+// Assetのテスト
+// ========================================
+
+TEST_CASE("Asset generation", "[Asset]")
+{
+	SECTION("Unloading and base directory changes advance the generation")
+	{
+		const uint64 initial = noco::Asset::Generation();
+
+		noco::Asset::UnloadAllTextures();
+		const uint64 afterUnloadAll = noco::Asset::Generation();
+		CHECK(afterUnloadAll > initial);
+
+		// 読み込まれていないアセットのアンロードでは変化しない
+		CHECK(noco::Asset::UnloadTexture(U"not_loaded_texture.png") == false);
+		CHECK(noco::Asset::Generation() == afterUnloadAll);
+
+		const FilePath baseDirectoryPath = noco::Asset::GetBaseDirectoryPath();
+		noco::Asset::SetBaseDirectoryPath(baseDirectoryPath);
+		CHECK(noco::Asset::Generation() > afterUnloadAll);
+
+		const uint64 beforeInvalidate = noco::Asset::Generation();
+		noco::Asset::InvalidateResolvedTextures();
+		CHECK(noco::Asset::Generation() > beforeInvalidate);
+	}
+}
+
+TEST_CASE("ResolvedTextureCache", "[Asset]")
+{
+	noco::detail::ResolvedTextureCache cache;
+	int32 resolveCount = 0;
+	const auto resolve = [&]
+	{
+		++resolveCount;
+		return std::shared_ptr<const Texture>{};
+	};
+
+	SECTION("Empty textures are not cached")
+	{
+		CHECK(cache.getOrResolve(1, 1, false, noco::AllowPlaceholderYN::Yes, noco::Asset::Generation(), resolve).isEmpty());
+		CHECK(cache.getOrResolve(1, 1, false, noco::AllowPlaceholderYN::Yes, noco::Asset::Generation(), resolve).isEmpty());
+		CHECK(resolveCount == 2);
+	}
+}
+
+TEST_CASE("AssetTable memory accounting", "[Asset]")
+{
+	noco::detail::AssetTable<JSON> table;
+	const JSON json{ { U"key", U"value" } };
+	// JSONのメモリ使用量は登録時に読み込み元のバイト数として指定する
+	constexpr size_t byteSize = 100;
+
+	SECTION("Total byte size follows registration and removal")
+	{
+		table.registerAsset(U"a.json", JSON{ json }, byteSize);
+		table.registerAsset(U"b.json", JSON{ json }, byteSize);
+		CHECK(table.totalByteSize() == byteSize * 2);
+
+		// 登録済みのパスへの再登録は無視される
+		table.registerAsset(U"a.json", JSON{ json }, byteSize);
+		CHECK(table.totalByteSize() == byteSize * 2);
+
+		table.unregister(U"a.json");
+		CHECK(table.totalByteSize() == byteSize);
+
+		table.eraseIf([](const auto& pair) { return pair.first == U"b.json"; });
+		CHECK(table.totalByteSize() == 0);
+		CHECK(table.size() == 0);
+	}
+
+	SECTION("Assets used in the current frame are not evicted")
+	{
+		table.registerAsset(U"a.json", JSON{ json }, byteSize);
+		table.registerAsset(U"b.json", JSON{ json }, byteSize);
+		CHECK(table.evictToBudget(0) == 0);
+		CHECK(table.size() == 2);
+	}
+
+	SECTION("Empty assets are estimated as zero bytes")
+	{
+		CHECK(noco::detail::EstimateAssetByteSize(Texture{}) == 0);
+		CHECK(noco::detail::EstimateAssetByteSize(Audio{}) == 0);
+	}
+}
+
+TEST_CASE("Asset memory usage", "[Asset]")
+{
+	noco::Asset::UnloadAllTextures();
+	noco::Asset::UnloadAllAudios();
+	noco::Asset::UnloadAllJSONs();
+
+	const noco::AssetMemoryUsage usage = noco::Asset::MemoryUsage();
+	CHECK(usage.totalBytes() == 0);
+	CHECK(usage.textureCount == 0);
+	CHECK(noco::Asset::AcquireTexture(U"missing_texture.png") == nullptr);
+
+	noco::Asset::SetTextureMemoryBudget(1024);
+	CHECK(noco::Asset::TextureMemoryBudget() == 1024);
+	noco::Asset::SetTextureMemoryBudget(none);
+	CHECK(noco::Asset::TextureMemoryBudget() == none);
+}
+
+TEST_CASE("Asynchronous asset loading", "[Asset]")
+{
+	const FilePath directoryPath = FileSystem::PathAppend(FileSystem::TemporaryDirectoryPath(), U"NocoUITests_AsyncAsset");
+	const FilePath jsonPath = FileSystem::PathAppend(directoryPath, U"async.json");
+	FileSystem::CreateDirectories(directoryPath);
+	REQUIRE(JSON{ { U"value", 42 } }.save(jsonPath));
+
+	noco::Asset::UnloadAllJSONs();
+	noco::Asset::SetAsyncLoadingEnabled(true);
+
+	SECTION("Missing files are not queued")
+	{
+		CHECK(noco::Asset::GetOrLoadTexture(U"missing_async_texture.png").isEmpty());
+		CHECK(noco::Asset::IsLoading(U"missing_async_texture.png") == false);
+		CHECK(noco::Asset::PendingCount() == 0);
+	}
+
+	SECTION("JSON is registered after loading completes")
+	{
+		CHECK(!noco::Asset::GetOrLoadJSON(jsonPath));
+		CHECK(noco::Asset::IsLoading(jsonPath) == true);
+		CHECK(noco::Asset::PendingCount() == 1);
+
+		// 読み込み中に再度要求しても重複して依頼しない
+		CHECK(!noco::Asset::GetOrLoadJSON(jsonPath));
+		CHECK(noco::Asset::PendingCount() == 1);
+
+		const uint64 generation = noco::Asset::Generation();
+		noco::Asset::WaitForPendingLoads();
+		CHECK(noco::Asset::IsLoading(jsonPath) == false);
+		CHECK(noco::Asset::PendingCount() == 0);
+		CHECK(noco::Asset::Generation() > generation);
+		CHECK(noco::Asset::GetOrLoadJSON(jsonPath)[U"value"].get<int32>() == 42);
+
+		// メモリ使用量は読み込み元のファイルサイズとなる
+		CHECK(noco::Asset::MemoryUsage().jsonBytes == static_cast<size_t>(FileSystem::FileSize(jsonPath)));
+	}
+
+	SECTION("Unloading cancels pending loads")
+	{
+		CHECK(!noco::Asset::GetOrLoadJSON(jsonPath));
+		CHECK(noco::Asset::UnloadJSON(jsonPath) == true);
+		CHECK(noco::Asset::IsLoading(jsonPath) == false);
+
+		noco::Asset::WaitForPendingLoads();
+		CHECK(noco::Asset::PendingCount() == 0);
+
+		noco::Asset::SetAsyncLoadingEnabled(false);
+		CHECK(noco::Asset::GetOrLoadJSON(jsonPath)[U"value"].get<int32>() == 42);
+	}
+
+	noco::Asset::SetAsyncLoadingEnabled(false);
+	noco::Asset::UnloadAllJSONs();
+	FileSystem::Remove(directoryPath);
+}
+
+TEST_CASE("Canvas asset dependencies", "[Asset][Canvas]")
+{
+	const FilePath directoryPath = FileSystem::PathAppend(FileSystem::TemporaryDirectoryPath(), U"NocoUITests_AssetDependencies");
+	const FilePath childCanvasPath = FileSystem::PathAppend(directoryPath, U"child.noco");
+	const FilePath rootCanvasPath = FileSystem::PathAppend(directoryPath, U"root.noco");
+	FileSystem::CreateDirectories(directoryPath);
+	noco::Asset::UnloadAllJSONs();
+
+	// 子Canvasは自身を参照するSubCanvasを含む(循環参照)
+	{
+		auto childCanvas = noco::Canvas::Create();
+		auto node = noco::Node::Create();
+		node->emplaceComponent<noco::Sprite>(U"child.png");
+		node->emplaceComponent<noco::SubCanvas>(childCanvasPath);
+		childCanvas->addChild(node);
+		REQUIRE(childCanvas->toJSON().save(childCanvasPath));
+	}
+
+	{
+		auto rootCanvas = noco::Canvas::Create();
+		auto node = noco::Node::Create();
+		node->emplaceComponent<noco::Sprite>(noco::PropertyValue<String>{ U"normal.png" }.withHovered(U"hovered.png"));
+		node->emplaceComponent<noco::UISound>(U"click.wav");
+		node->emplaceComponent<noco::SubCanvas>(childCanvasPath);
+		rootCanvas->addChild(node);
+		REQUIRE(rootCanvas->toJSON().save(rootCanvasPath));
+	}
+
+	SECTION("Collects textures, audios and nested canvases once each")
+	{
+		const noco::AssetDependencies dependencies = noco::Canvas::CollectAssetDependenciesFromFile(rootCanvasPath);
+		CHECK(dependencies.textureFilePaths().sorted() == Array<FilePath>{ U"child.png", U"hovered.png", U"normal.png" });
+		CHECK(dependencies.audioFilePaths() == Array<FilePath>{ U"click.wav" });
+		CHECK(dependencies.canvasFilePaths() == Array<FilePath>{ childCanvasPath });
+	}
+
+	SECTION("Missing files produce empty dependencies")
+	{
+		CHECK(noco::Canvas::CollectAssetDependenciesFromFile(FileSystem::PathAppend(directoryPath, U"missing.noco")).empty());
+	}
+
+	SECTION("Deferred node content and parameter values are collected without materializing nodes")
+	{
+		noco::SetDeferredNodeLoadingEnabled(true);
+		struct RestoreDeferredNodeLoading
+		{
+			~RestoreDeferredNodeLoading()
+			{
+				noco::SetDeferredNodeLoadingEnabled(false);
+			}
+		} restore;
+
+		auto source = noco::Canvas::Create();
+		source->setParamValue(U"icon", String{ U"param.png" });
+		auto popup = noco::Node::Create(U"Popup");
+		popup->setActive(false);
+		auto iconNode = noco::Node::Create(U"Icon");
+		iconNode->emplaceComponent<noco::Sprite>(U"inactive.png")->getPropertyByName(U"textureFilePath")->setParamRef(U"icon");
+		popup->addChild(iconNode);
+		source->addChild(popup);
+
+		const FilePath deferredCanvasPath = FileSystem::PathAppend(directoryPath, U"deferred.noco");
+		REQUIRE(source->toJSON().save(deferredCanvasPath));
+
+		const Array<FilePath> expectedTextureFilePaths{ U"inactive.png", U"param.png" };
+		CHECK(noco::Canvas::CollectAssetDependenciesFromFile(deferredCanvasPath).textureFilePaths().sorted() == expectedTextureFilePaths);
+
+		auto canvas = noco::Canvas::LoadFromFile(deferredCanvasPath);
+		REQUIRE(canvas != nullptr);
+		REQUIRE(canvas->children()[0]->hasDeferredContent());
+		CHECK(canvas->collectAssetDependencies().textureFilePaths().sorted() == expectedTextureFilePaths);
+		CHECK(canvas->children()[0]->hasDeferredContent());
+	}
+
+	SECTION("Preloading skips missing asset files")
+	{
+		const noco::AssetDependencies dependencies = noco::Canvas::PreloadFromFile(rootCanvasPath);
+		CHECK(dependencies.size() == 5);
+		CHECK(noco::Asset::PendingCount() == 0);
+	}
+
+	noco::Asset::UnloadAllJSONs();
+	FileSystem::Remove(directoryPath);
+}
+
+TEST_CASE("AssetArchive", "[Asset][AssetArchive]")
+{
+	const FilePath directoryPath = FileSystem::PathAppend(FileSystem::TemporaryDirectoryPath(), U"NocoUITests_AssetArchive");
+	const FilePath sourceDirectoryPath = FileSystem::PathAppend(directoryPath, U"assets");
+	const FilePath archivePath = FileSystem::PathAppend(directoryPath, U"assets.nocopack");
+	FileSystem::CreateDirectories(FileSystem::PathAppend(sourceDirectoryPath, U"sub"));
+	REQUIRE(JSON{ { U"value", 1 } }.save(FileSystem::PathAppend(sourceDirectoryPath, U"a.json")));
+	REQUIRE(JSON{ { U"value", 2 } }.save(FileSystem::PathAppend(sourceDirectoryPath, U"sub/b.json")));
+	REQUIRE(noco::AssetArchive::Build(sourceDirectoryPath, archivePath));
+
+	SECTION("Path normalization")
+	{
+		CHECK(noco::AssetArchive::NormalizePath(U"./sub\\b.json") == U"sub/b.json");
+		CHECK(noco::AssetArchive::NormalizePath(U"a.json") == U"a.json");
+	}
+
+	SECTION("Entries are readable from the archive")
+	{
+		noco::AssetArchive archive;
+		REQUIRE(archive.open(archivePath));
+		CHECK(archive.size() == 2);
+		CHECK(archive.contains(U"a.json"));
+		CHECK(archive.contains(U"sub\\b.json"));
+		CHECK_FALSE(archive.contains(U"missing.json"));
+
+		const auto data = archive.find(U"sub/b.json");
+		REQUIRE(data.has_value());
+		const String text = Unicode::FromUTF8(std::string_view{ reinterpret_cast<const char*>(data->data()), data->size() });
+		CHECK(JSON::Parse(text)[U"value"].get<int32>() == 2);
+
+		archive.close();
+		CHECK_FALSE(archive.isOpen());
+		CHECK_FALSE(archive.find(U"a.json").has_value());
+	}
+
+	SECTION("Invalid archives are rejected")
+	{
+		noco::AssetArchive archive;
+		CHECK_FALSE(archive.open(FileSystem::PathAppend(sourceDirectoryPath, U"a.json")));
+		CHECK_FALSE(archive.open(FileSystem::PathAppend(directoryPath, U"missing.nocopack")));
+	}
+
+	SECTION("Mounted archive serves assets without the source files")
+	{
+		const FilePath baseDirectoryPath = noco::Asset::GetBaseDirectoryPath();
+		noco::Asset::SetBaseDirectoryPath(FileSystem::PathAppend(directoryPath, U"nonexistent"));
+		REQUIRE(noco::Asset::MountArchive(archivePath));
+		CHECK(noco::Asset::IsArchiveMounted());
+		CHECK(noco::Asset::Exists(U"sub/b.json"));
+		CHECK(noco::Asset::IsInArchive(U"a.json"));
+		CHECK_FALSE(noco::Asset::Exists(U"missing.json"));
+		CHECK(noco::Asset::GetOrLoadJSON(U"a.json")[U"value"].get<int32>() == 1);
+		CHECK(noco::Asset::GetOrLoadJSON(U"sub/b.json")[U"value"].get<int32>() == 2);
+
+		noco::Asset::UnmountArchive();
+		CHECK_FALSE(noco::Asset::IsArchiveMounted());
+		CHECK_FALSE(noco::Asset::Exists(U"a.json"));
+		CHECK(!noco::Asset::GetOrLoadJSON(U"a.json"));
+		noco::Asset::SetBaseDirectoryPath(baseDirectoryPath);
+	}
+
+	FileSystem::Remove(directoryPath);
+}
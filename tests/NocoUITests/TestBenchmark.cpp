@@ -0,0 +1,277 @@
+#include <catch2/catch.hpp>
+#include <Siv3D.hpp>
+#include <NocoUI.hpp>
+#include <NocoUI/detail/AutoShrinkSearch.hpp>
+
+// ========================================
+// ベンチマーク
+// ========================================
+// 通常のテスト実行では実行されないよう隠しタグを付けている
+// 実行する場合は NocoUITest "[benchmark]" のようにタグを指定する
+
+namespace
+{
+	// 二分探索に置き換える前の、大きい候補から順に試す方式(比較用)
+	template <typename FitsFunc>
+	[[nodiscard]]
+	size_t FindFirstFittingCandidateLinear(size_t candidateCount, FitsFunc&& fnFits)
+	{
+		if (candidateCount == 0)
+		{
+			return 0;
+		}
+		for (size_t i = 0; i + 1 < candidateCount; ++i)
+		{
+			if (fnFits(i))
+			{
+				return i;
+			}
+		}
+		return candidateCount - 1;
+	}
+}
+
+TEST_CASE("Label AutoShrink benchmark", "[.][benchmark][Label]")
+{
+	const String longText = U"The quick brown fox jumps over the lazy dog. "_s.repeat(200);
+	const SizeF rectSize{ 400, 300 };
+	constexpr double FontSize = 64.0;
+	constexpr double MinFontSize = 4.0;
+	constexpr double Precision = 0.5;
+
+	// レイアウト共有キャッシュが効くと計測にならないため無効化する
+	const size_t prevCapacity = noco::LabelLayoutCache::Capacity();
+	noco::LabelLayoutCache::SetCapacity(0);
+
+	// 候補のフォントサイズで全体をレイアウトして収まるかどうかを返す
+	const size_t candidateCount = static_cast<size_t>(Math::Ceil((FontSize - MinFontSize) / Precision)) + 1;
+	const auto fnFits = [&](size_t step)
+		{
+			auto label = std::make_shared<noco::Label>(longText);
+			label->setFontSize(Max(FontSize - step * Precision, MinFontSize));
+			const SizeF requiredSize = label->getContentSize(rectSize);
+			return requiredSize.x <= rectSize.x && requiredSize.y <= rectSize.y;
+		};
+
+	// 同じテキスト・矩形に対して、線形探索と二分探索で同じ候補が選ばれること
+	CHECK(noco::detail::FindFirstFittingCandidate(candidateCount, fnFits) == FindFirstFittingCandidateLinear(candidateCount, fnFits));
+
+	BENCHMARK("AutoShrink search (linear)")
+	{
+		return FindFirstFittingCandidateLinear(candidateCount, fnFits);
+	};
+
+	BENCHMARK("AutoShrink search (bisection)")
+	{
+		return noco::detail::FindFirstFittingCandidate(candidateCount, fnFits);
+	};
+
+	BENCHMARK("AutoShrink (Label)")
+	{
+		auto label = std::make_shared<noco::Label>(longText);
+		label->setFontSize(FontSize);
+		label->setMinFontSize(MinFontSize);
+		label->setAutoShrinkPrecision(Precision);
+		label->setSizingMode(noco::LabelSizingMode::AutoShrink);
+		return label->getContentSize(rectSize);
+	};
+
+	noco::LabelLayoutCache::SetCapacity(prevCapacity);
+}
+
+TEST_CASE("TextureFontLabel AutoShrink benchmark", "[.][benchmark][TextureFontLabel]")
+{
+	const String longText = U"The quick brown fox jumps over the lazy dog. "_s.repeat(200);
+	const SizeF rectSize{ 400, 300 };
+	constexpr double CharacterSize = 64.0;
+	constexpr double MinCharacterSize = 4.0;
+
+	const auto fnCreateLabel = [&](double characterSize)
+		{
+			auto label = std::make_shared<noco::TextureFontLabel>();
+			label->setText(longText);
+			label->setCharacterSet(U"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz .");
+			label->setCharacterSize(Vec2::All(characterSize));
+			return label;
+		};
+
+	// 候補の文字サイズで全体をレイアウトして収まるかどうかを返す
+	const size_t candidateCount = static_cast<size_t>(CharacterSize - MinCharacterSize) + 1;
+	const auto fnFits = [&](size_t step)
+		{
+			const SizeF requiredSize = fnCreateLabel(CharacterSize - static_cast<double>(step))->getContentSize(rectSize);
+			return requiredSize.x <= rectSize.x && requiredSize.y <= rectSize.y;
+		};
+
+	// 同じテキスト・矩形に対して、線形探索と二分探索で同じ候補が選ばれること
+	CHECK(noco::detail::FindFirstFittingCandidate(candidateCount, fnFits) == FindFirstFittingCandidateLinear(candidateCount, fnFits));
+
+	BENCHMARK("AutoShrink search (linear)")
+	{
+		return FindFirstFittingCandidateLinear(candidateCount, fnFits);
+	};
+
+	BENCHMARK("AutoShrink search (bisection)")
+	{
+		return noco::detail::FindFirstFittingCandidate(candidateCount, fnFits);
+	};
+
+	BENCHMARK("AutoShrink (TextureFontLabel)")
+	{
+		auto label = fnCreateLabel(CharacterSize);
+		label->setSizingMode(noco::TextureFontLabelSizingMode::AutoShrink);
+		return label->getContentSize(rectSize);
+	};
+}
+
+TEST_CASE("Tween easing lookup table benchmark", "[.][benchmark][Tween]")
+{
+	constexpr int32 SampleCount = 10000;
+	const Array<noco::TweenEasing> easings = {
+		noco::TweenEasing::EaseOutQuad,
+		noco::TweenEasing::EaseInOutElastic,
+		noco::TweenEasing::EaseOutBounce,
+	};
+
+	// 精度: 関数による評価とテーブルによる評価の最大誤差
+	for (const auto easing : easings)
+	{
+		double maxError = 0.0;
+		for (int32 i = 0; i <= SampleCount; ++i)
+		{
+			const double t = static_cast<double>(i) / SampleCount;
+			maxError = Max(maxError, Abs(noco::TweenEasingLookupTable::Evaluate(easing, t) - noco::EvaluateTweenEasing(easing, t)));
+		}
+		WARN("easing " << static_cast<int32>(easing) << " max error (resolution " << noco::TweenEasingLookupTable::Resolution() << "): " << maxError);
+	}
+
+	BENCHMARK("Exact")
+	{
+		double sum = 0.0;
+		for (const auto easing : easings)
+		{
+			for (int32 i = 0; i <= SampleCount; ++i)
+			{
+				sum += noco::EvaluateTweenEasing(easing, static_cast<double>(i) / SampleCount);
+			}
+		}
+		return sum;
+	};
+
+	BENCHMARK("LookupTable")
+	{
+		double sum = 0.0;
+		for (const auto easing : easings)
+		{
+			for (int32 i = 0; i <= SampleCount; ++i)
+			{
+				sum += noco::TweenEasingLookupTable::Evaluate(easing, static_cast<double>(i) / SampleCount);
+			}
+		}
+		return sum;
+	};
+}
+
+namespace
+{
+	// 読み込み・保存のベンチマークで共通のノード数
+	constexpr int32 BenchmarkItemCount = 500;
+
+	// RectRendererとLabelを持つ固定サイズのノードを追加する
+	void AddBenchmarkItems(noco::INodeContainer& parent, int32 count)
+	{
+		for (int32 i = 0; i < count; ++i)
+		{
+			auto node = noco::Node::Create(U"Item{}"_fmt(i));
+			node->setRegion(noco::InlineRegion{ .sizeDelta = Vec2{ 200, 40 } });
+			node->emplaceComponent<noco::RectRenderer>();
+			node->emplaceComponent<noco::Label>(U"Item {}"_fmt(i));
+			parent.addChild(node);
+		}
+	}
+}
+
+TEST_CASE("Binary canvas load benchmark", "[.][benchmark][BinaryCanvas]")
+{
+	auto canvas = noco::Canvas::Create();
+	AddBenchmarkItems(*canvas, BenchmarkItemCount);
+	const String text = canvas->toJSON().formatMinimum();
+	const Blob blob = noco::BinaryCanvas::Encode(*canvas);
+	WARN("JSON: " << Unicode::ToUTF8(text).size() << " bytes, Binary: " << blob.size() << " bytes");
+
+	BENCHMARK("JSON::Parse + Canvas::CreateFromJSON")
+	{
+		return noco::Canvas::CreateFromJSON(JSON::Parse(text));
+	};
+
+	BENCHMARK("BinaryCanvas::Load")
+	{
+		return noco::BinaryCanvas::Load(std::span<const Byte>{ blob.data(), blob.size() });
+	};
+}
+
+TEST_CASE("Deferred node loading benchmark", "[.][benchmark][Deferred]")
+{
+	// 非アクティブなタブを多数持つCanvas
+	auto canvas = noco::Canvas::Create();
+	for (int32 tabIndex = 0; tabIndex < 20; ++tabIndex)
+	{
+		auto tab = noco::Node::Create(U"Tab{}"_fmt(tabIndex));
+		tab->setActive(tabIndex == 0);
+		AddBenchmarkItems(*tab, 50);
+		canvas->addChild(tab);
+	}
+	const JSON json = canvas->toJSON();
+
+	// 計測が途中で失敗した場合も、他のテストに影響しないよう設定を元に戻す
+	struct RestoreDeferredNodeLoading
+	{
+		bool enabled = noco::IsDeferredNodeLoadingEnabled();
+
+		~RestoreDeferredNodeLoading()
+		{
+			noco::SetDeferredNodeLoadingEnabled(enabled);
+		}
+	} restore;
+
+	BENCHMARK("Immediate")
+	{
+		noco::SetDeferredNodeLoadingEnabled(false);
+		return noco::Canvas::CreateFromJSON(json);
+	};
+
+	BENCHMARK("Deferred")
+	{
+		noco::SetDeferredNodeLoadingEnabled(true);
+		return noco::Canvas::CreateFromJSON(json);
+	};
+}
+
+TEST_CASE("Default-omitting serialization benchmark", "[.][benchmark][Serialization]")
+{
+	auto canvas = noco::Canvas::Create();
+	AddBenchmarkItems(*canvas, BenchmarkItemCount);
+	const String fullText = canvas->toJSON().formatMinimum();
+	const String compactText = canvas->toJSON(noco::OmitDefaultValuesYN::Yes).formatMinimum();
+	WARN("Full: " << fullText.size() << " chars, Compact: " << compactText.size() << " chars");
+
+	BENCHMARK("Save (full)")
+	{
+		return canvas->toJSON().formatMinimum();
+	};
+
+	BENCHMARK("Save (compact)")
+	{
+		return canvas->toJSON(noco::OmitDefaultValuesYN::Yes).formatMinimum();
+	};
+
+	BENCHMARK("Load (full)")
+	{
+		return noco::Canvas::CreateFromJSON(JSON::Parse(fullText));
+	};
+
+	BENCHMARK("Load (compact)")
+	{
+		return noco::Canvas::CreateFromJSON(JSON::Parse(compactText));
+	};
+}
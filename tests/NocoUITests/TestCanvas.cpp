@@ -1339,3 +1339,510 @@ TEST_CASE("Canvas includeSubCanvas parameter", "[Canvas][SubCanvas]")
 		REQUIRE(canvas->containsChild(subCanvasGrandchild, noco::RecursiveYN::Yes, noco::IncludeSubCanvasYN::Yes) == true);
 	}
 }
+
+TEST_CASE("Canvas occlusion culling", "[Canvas][OcclusionCulling]")
+{
+	class DrawCountComponent : public noco::ComponentBase
+	{
+	private:
+		int32* m_pDrawCount;
+
+	public:
+		explicit DrawCountComponent(int32* pDrawCount)
+			: ComponentBase{ {} }
+			, m_pDrawCount{ pDrawCount }
+		{
+		}
+
+		void draw(const noco::Node&) const override
+		{
+			++(*m_pDrawCount);
+		}
+	};
+
+	const auto createFullRectNode = [](StringView name)
+		{
+			auto node = noco::Node::Create(name);
+			node->setRegion(noco::AnchorRegion{
+				.anchorMin = Vec2{ 0.0, 0.0 },
+				.anchorMax = Vec2{ 1.0, 1.0 },
+			});
+			return node;
+		};
+
+	SECTION("Nodes behind opaque node are culled")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		int32 backDrawCount = 0;
+		int32 frontDrawCount = 0;
+
+		auto back = createFullRectNode(U"Back");
+		back->emplaceComponent<DrawCountComponent>(&backDrawCount);
+		canvas->addChild(back);
+
+		auto front = createFullRectNode(U"Front");
+		front->emplaceComponent<noco::RectRenderer>(Palette::White);
+		front->emplaceComponent<DrawCountComponent>(&frontDrawCount);
+		canvas->addChild(front);
+
+		canvas->update();
+
+		// デフォルトでは無効
+		REQUIRE(canvas->occlusionCullingEnabled() == false);
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(frontDrawCount == 1);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 0);
+
+		canvas->setOcclusionCullingEnabled(true);
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(frontDrawCount == 2);
+		CHECK(canvas->drawStats().occlusionTestedNodeCount == 2);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 1);
+	}
+
+	SECTION("Translucent or rounded nodes do not occlude")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setOcclusionCullingEnabled(true);
+		int32 backDrawCount = 0;
+
+		auto back = createFullRectNode(U"Back");
+		back->emplaceComponent<DrawCountComponent>(&backDrawCount);
+		canvas->addChild(back);
+
+		auto front = createFullRectNode(U"Front");
+		const auto rectRenderer = front->emplaceComponent<noco::RectRenderer>(Color{ 255, 255, 255, 128 });
+		canvas->addChild(front);
+
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 0);
+
+		// 不透明でも角丸の場合は遮蔽しない
+		rectRenderer->setFillColor(Palette::White);
+		rectRenderer->setCornerRadius(8.0);
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 2);
+
+		// 角丸を解除すると遮蔽する
+		rectRenderer->setCornerRadius(0.0);
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 2);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 1);
+	}
+
+	SECTION("Partially covered nodes are not culled")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setOcclusionCullingEnabled(true);
+		int32 backDrawCount = 0;
+
+		auto back = createFullRectNode(U"Back");
+		back->emplaceComponent<DrawCountComponent>(&backDrawCount);
+		canvas->addChild(back);
+
+		auto front = noco::Node::Create(U"Front");
+		front->setRegion(noco::AnchorRegion{ .sizeDelta = Vec2{ 100, 100 } });
+		front->emplaceComponent<noco::RectRenderer>(Palette::White);
+		canvas->addChild(front);
+
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 0);
+	}
+
+	SECTION("Sprites without a resolved texture do not occlude")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setOcclusionCullingEnabled(true);
+		int32 backDrawCount = 0;
+
+		auto back = createFullRectNode(U"Back");
+		back->emplaceComponent<DrawCountComponent>(&backDrawCount);
+		canvas->addChild(back);
+
+		// テクスチャが不透明と指定されていても、ファイルが存在せずテクスチャが空の場合は遮蔽しない
+		auto front = createFullRectNode(U"Front");
+		const auto sprite = front->emplaceComponent<noco::Sprite>(U"missing_opaque_texture.png");
+		sprite->setTextureOpaque(true);
+		canvas->addChild(front);
+
+		canvas->update();
+		CHECK(sprite->isOpaqueFullRect() == false);
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 0);
+
+		sprite->setHideIfTextureEmpty(true);
+		canvas->update();
+		CHECK(sprite->isOpaqueFullRect() == false);
+		canvas->draw();
+		CHECK(backDrawCount == 2);
+	}
+
+	SECTION("Content drawn outside the node region prevents culling")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setOcclusionCullingEnabled(true);
+		int32 backDrawCount = 0;
+
+		auto back = noco::Node::Create(U"Back");
+		back->setRegion(noco::AnchorRegion{ .anchorMin = Vec2{ 0.5, 0.5 }, .anchorMax = Vec2{ 0.5, 0.5 }, .sizeDelta = Vec2{ 100, 100 } });
+		back->emplaceComponent<DrawCountComponent>(&backDrawCount);
+		const auto backRect = back->emplaceComponent<noco::RectRenderer>(Color{ 0, 0, 0, 0 });
+		canvas->addChild(back);
+
+		auto front = noco::Node::Create(U"Front");
+		front->setRegion(noco::AnchorRegion{ .anchorMin = Vec2{ 0.5, 0.5 }, .anchorMax = Vec2{ 0.5, 0.5 }, .sizeDelta = Vec2{ 120, 120 } });
+		front->emplaceComponent<noco::RectRenderer>(Palette::White);
+		canvas->addChild(front);
+
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 0);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 1);
+
+		// 影が手前のノードの外側まで広がる場合はカリングしない
+		backRect->setShadowColor(Palette::Black);
+		backRect->setShadowOffset(Vec2{ 20, 20 });
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 0);
+
+		// 影が手前のノードの内側に収まる場合はカリングする
+		backRect->setShadowOffset(Vec2{ 4, 4 });
+		backRect->setShadowBlur(0.0);
+		backRect->setShadowSpread(0.0);
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 1);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 1);
+
+		// 外側の輪郭線が手前のノードの外側まで広がる場合はカリングしない
+		backRect->setShadowColor(Color{ 0, 0, 0, 0 });
+		backRect->setOutlineColor(Palette::Black);
+		backRect->setOutlineThicknessOuter(20.0);
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 2);
+
+		// 領域外へのはみ出しを許可したLabelを持つノードはカリングしない
+		backRect->setOutlineThicknessOuter(0.0);
+		const auto label = back->emplaceComponent<noco::Label>(U"Text");
+		label->setHorizontalOverflow(noco::HorizontalOverflow::Wrap);
+		label->setVerticalOverflow(noco::VerticalOverflow::Clip);
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 2);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 1);
+
+		label->setVerticalOverflow(noco::VerticalOverflow::Overflow);
+		canvas->update();
+		canvas->draw();
+		CHECK(backDrawCount == 3);
+		CHECK(canvas->drawStats().occlusionCulledNodeCount == 0);
+	}
+
+	SECTION("Draw order follows zOrderInSiblings and sibling order changes")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setOcclusionCullingEnabled(true);
+		int32 firstDrawCount = 0;
+		int32 secondDrawCount = 0;
+
+		auto first = createFullRectNode(U"First");
+		first->emplaceComponent<noco::RectRenderer>(Palette::White);
+		first->emplaceComponent<DrawCountComponent>(&firstDrawCount);
+		canvas->addChild(first);
+
+		auto second = createFullRectNode(U"Second");
+		second->emplaceComponent<noco::RectRenderer>(Palette::White);
+		second->emplaceComponent<DrawCountComponent>(&secondDrawCount);
+		canvas->addChild(second);
+
+		// 後から描画されるSecondがFirstを隠す
+		canvas->update();
+		canvas->draw();
+		CHECK(firstDrawCount == 0);
+		CHECK(secondDrawCount == 1);
+
+		// zOrderInSiblingsの変更で描画順が入れ替わる
+		first->setZOrderInSiblings(1);
+		canvas->update();
+		canvas->draw();
+		CHECK(firstDrawCount == 1);
+		CHECK(secondDrawCount == 1);
+
+		// zOrderInSiblingsが同じ場合は兄弟の並び順で描画される
+		first->setZOrderInSiblings(0);
+		canvas->swapChildren(0, 1);
+		canvas->update();
+		canvas->draw();
+		CHECK(firstDrawCount == 2);
+		CHECK(secondDrawCount == 1);
+	}
+}
+
+TEST_CASE("Canvas retained rendering", "[Canvas][RetainedRendering]")
+{
+	const auto createNode = [](StringView name, const Vec2& pos)
+		{
+			auto node = noco::Node::Create(name);
+			node->setRegion(noco::AnchorRegion{
+				.anchorMin = noco::Anchor::TopLeft,
+				.anchorMax = noco::Anchor::TopLeft,
+				.posDelta = pos,
+				.sizeDelta = Vec2{ 100, 100 },
+				.sizeDeltaPivot = noco::Anchor::TopLeft,
+			});
+			return node;
+		};
+
+	SECTION("Redraw only when something changed")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setRetainedRenderingEnabled(true);
+
+		auto node = createNode(U"Node", Vec2{ 0, 0 });
+		const auto rectRenderer = node->emplaceComponent<noco::RectRenderer>(Palette::White);
+		canvas->addChild(node);
+
+		// 初回は全体を再描画
+		canvas->update();
+		canvas->draw();
+		CHECK(canvas->drawStats().retainedRedrawRect.has_value());
+
+		// 変化がなければ再描画しない
+		canvas->update();
+		canvas->draw();
+		CHECK_FALSE(canvas->drawStats().retainedRedrawRect.has_value());
+
+		// プロパティ値が変化した場合は再描画する
+		rectRenderer->setFillColor(Palette::Red);
+		canvas->update();
+		canvas->draw();
+		CHECK(canvas->drawStats().retainedRedrawRect.has_value());
+
+		canvas->update();
+		canvas->draw();
+		CHECK_FALSE(canvas->drawStats().retainedRedrawRect.has_value());
+
+		// ノードを非アクティブにした場合は前回の領域を再描画する
+		node->setActive(false);
+		canvas->update();
+		canvas->draw();
+		CHECK(canvas->drawStats().retainedRedrawRect.has_value());
+
+		// 全体の再描画を要求
+		canvas->requestFullRedraw();
+		canvas->draw();
+		CHECK(canvas->drawStats().retainedRedrawRect.has_value());
+	}
+
+	SECTION("Redraw only the region of the changed node")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setRetainedRenderingEnabled(true);
+		canvas->setRetainedDamageMargin(0.0);
+
+		auto left = createNode(U"Left", Vec2{ 0, 0 });
+		left->emplaceComponent<noco::RectRenderer>(Palette::White);
+		canvas->addChild(left);
+
+		auto right = createNode(U"Right", Vec2{ 300, 0 });
+		const auto rightRenderer = right->emplaceComponent<noco::RectRenderer>(Palette::White);
+		canvas->addChild(right);
+
+		canvas->update();
+		canvas->draw();
+		REQUIRE(canvas->drawStats().retainedRedrawRect.has_value());
+
+		rightRenderer->setFillColor(Palette::Red);
+		canvas->update();
+		canvas->draw();
+		REQUIRE(canvas->drawStats().retainedRedrawRect.has_value());
+		CHECK(*canvas->drawStats().retainedRedrawRect == Rect{ 300, 0, 100, 100 });
+
+		// 離れた2つのノードが変化した場合は、両方を含む範囲を1回で再描画する
+		left->setActive(false);
+		rightRenderer->setFillColor(Palette::Blue);
+		canvas->update();
+		canvas->draw();
+		REQUIRE(canvas->drawStats().retainedRedrawRect.has_value());
+		CHECK(*canvas->drawStats().retainedRedrawRect == Rect{ 0, 0, 400, 100 });
+	}
+
+	SECTION("Redraw when the sibling order changes")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		canvas->setRetainedRenderingEnabled(true);
+		canvas->setRetainedDamageMargin(0.0);
+
+		auto first = createNode(U"First", Vec2{ 0, 0 });
+		first->emplaceComponent<noco::RectRenderer>(Palette::Red);
+		canvas->addChild(first);
+
+		auto second = createNode(U"Second", Vec2{ 50, 0 });
+		second->emplaceComponent<noco::RectRenderer>(Palette::Blue);
+		canvas->addChild(second);
+
+		auto unrelated = createNode(U"Unrelated", Vec2{ 300, 0 });
+		unrelated->emplaceComponent<noco::RectRenderer>(Palette::White);
+		canvas->addChild(unrelated);
+
+		canvas->update();
+		canvas->draw();
+		canvas->update();
+		canvas->draw();
+		REQUIRE_FALSE(canvas->drawStats().retainedRedrawRect.has_value());
+
+		// 並び順の入れ替えで重なり方が変わるため、入れ替えたノードの領域を再描画する
+		canvas->swapChildren(0, 1);
+		canvas->update();
+		canvas->draw();
+		REQUIRE(canvas->drawStats().retainedRedrawRect.has_value());
+		CHECK(*canvas->drawStats().retainedRedrawRect == Rect{ 0, 0, 150, 100 });
+
+		canvas->update();
+		canvas->draw();
+		CHECK_FALSE(canvas->drawStats().retainedRedrawRect.has_value());
+
+		// zOrderInSiblingsの変更でも再描画する
+		second->setZOrderInSiblings(1);
+		canvas->update();
+		canvas->draw();
+		REQUIRE(canvas->drawStats().retainedRedrawRect.has_value());
+		CHECK(canvas->drawStats().retainedRedrawRect->contains(Rect{ 0, 0, 150, 100 }));
+	}
+}
+
+TEST_CASE("Canvas glyph prewarming", "[Canvas][Font]")
+{
+	SECTION("Prewarm immediately without time budget")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		auto node = noco::Node::Create(U"Node");
+		node->emplaceComponent<noco::Label>(U"日本語テキスト");
+		canvas->addChild(node);
+
+		canvas->prewarmGlyphs();
+		CHECK_FALSE(canvas->isPrewarmingGlyphs());
+	}
+
+	SECTION("Spread prewarming over frames with time budget")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		auto node = noco::Node::Create(U"Node");
+		node->emplaceComponent<noco::Label>(U"日本語テキスト");
+		canvas->addChild(node);
+
+		canvas->prewarmGlyphs(noco::IncludeSubCanvasYN::No, Duration{ 0.0 });
+		CHECK(canvas->isPrewarmingGlyphs());
+
+		// 予算が0でも1フレームに少なくとも1チャンクは処理される
+		for (int32 i = 0; i < 100 && canvas->isPrewarmingGlyphs(); ++i)
+		{
+			canvas->update();
+		}
+		CHECK_FALSE(canvas->isPrewarmingGlyphs());
+	}
+
+	SECTION("Nothing to prewarm")
+	{
+		auto canvas = noco::Canvas::Create(SizeF{ 800, 600 });
+		auto node = noco::Node::Create(U"Node");
+		node->emplaceComponent<noco::Label>(U"");
+		canvas->addChild(node);
+
+		canvas->prewarmGlyphs(noco::IncludeSubCanvasYN::Yes, Duration{ 0.0 });
+		CHECK_FALSE(canvas->isPrewarmingGlyphs());
+	}
+}
+
+TEST_CASE("Canvas prototypes", "[Canvas][Prototype]")
+{
+	auto sourceCanvas = noco::Canvas::Create(SizeF{ 320, 240 });
+	sourceCanvas->setParamValue(U"title", String{ U"Card" });
+	sourceCanvas->setAutoFitMode(noco::AutoFitMode::FitWidth);
+	auto card = noco::Node::Create(U"Card");
+	card->emplaceComponent<noco::Label>()->getPropertyByName(U"text")->setParamRef(U"title");
+	sourceCanvas->addChild(card);
+	const JSON json = sourceCanvas->toJSON();
+
+	SECTION("Instances are independent copies of the prototype")
+	{
+		const auto prototype = noco::CanvasPrototype::CreateFromJSON(json);
+		REQUIRE(prototype != nullptr);
+		CHECK(prototype->referenceSize() == SizeF{ 320, 240 });
+		CHECK(prototype->autoFitMode() == noco::AutoFitMode::FitWidth);
+
+		const auto canvas1 = prototype->instantiate();
+		const auto canvas2 = prototype->instantiate();
+		REQUIRE(canvas1 != nullptr);
+		REQUIRE(canvas2 != nullptr);
+		CHECK(canvas1 != canvas2);
+		CHECK(canvas1->toJSON() == json);
+		CHECK(canvas2->toJSON() == json);
+
+		canvas1->findByName(U"Card")->setActive(false);
+		CHECK(canvas2->findByName(U"Card")->activeSelf());
+		CHECK(prototype->instantiate()->findByName(U"Card")->activeSelf());
+	}
+
+	SECTION("Invalid JSON does not create a prototype")
+	{
+		CHECK(noco::CanvasPrototype::CreateFromJSON(JSON{ { U"children", Array<JSON>{} } }) == nullptr);
+	}
+
+	SECTION("NodePrototype")
+	{
+		const auto prototype = noco::NodePrototype::CreateFromNode(*card);
+		const auto node1 = prototype->instantiate();
+		const auto node2 = prototype->instantiate();
+		CHECK(node1 != node2);
+		CHECK(node1->toJSON() == card->toJSON());
+
+		// 作成後に元のノードを変更してもプロトタイプには影響しない
+		card->setName(U"Renamed");
+		CHECK(prototype->instantiate()->name() == U"Card");
+	}
+
+	SECTION("Asset caches prototypes by path")
+	{
+		const FilePath directoryPath = FileSystem::PathAppend(FileSystem::TemporaryDirectoryPath(), U"NocoUITests_CanvasPrototype");
+		const FilePath canvasPath = FileSystem::PathAppend(directoryPath, U"card.noco");
+		FileSystem::CreateDirectories(directoryPath);
+		REQUIRE(json.save(canvasPath));
+		noco::Asset::UnloadAllJSONs();
+
+		const auto prototype = noco::Asset::GetOrLoadCanvasPrototype(canvasPath);
+		REQUIRE(prototype != nullptr);
+		CHECK(noco::Asset::GetOrLoadCanvasPrototype(canvasPath) == prototype);
+		CHECK(noco::Asset::GetOrLoadCanvasPrototype(FileSystem::PathAppend(directoryPath, U"missing.noco")) == nullptr);
+
+		// SubCanvasはキャッシュされたプロトタイプから個別のCanvasを生成する
+		auto canvas = noco::Canvas::Create();
+		auto subCanvas1 = std::make_shared<noco::SubCanvas>(canvasPath);
+		auto subCanvas2 = std::make_shared<noco::SubCanvas>(canvasPath);
+		canvas->addChild(noco::Node::Create(U"A"))->addComponent(subCanvas1);
+		canvas->addChild(noco::Node::Create(U"B"))->addComponent(subCanvas2);
+		canvas->update();
+		REQUIRE(subCanvas1->canvas() != nullptr);
+		REQUIRE(subCanvas2->canvas() != nullptr);
+		CHECK(subCanvas1->canvas() != subCanvas2->canvas());
+
+		// JSONを再読み込みするとプロトタイプは作り直される
+		noco::Asset::ReloadJSON(canvasPath);
+		CHECK(noco::Asset::GetOrLoadCanvasPrototype(canvasPath) != prototype);
+
+		noco::Asset::UnloadAllJSONs();
+		FileSystem::Remove(directoryPath);
+	}
+}
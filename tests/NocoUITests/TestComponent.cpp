@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 #include <Siv3D.hpp>
 #include <NocoUI.hpp>
+#include <NocoUI/detail/AutoShrinkSearch.hpp>
 
 // ========================================
 // Componentのテスト
@@ -49,6 +50,105 @@ TEST_CASE("Label component", "[Component][Label]")
 		label->setText(U"Hello, World!");
 		REQUIRE(label->text().defaultValue() == U"Hello, World!");
 	}
+
+	SECTION("Layout cache sharing")
+	{
+		noco::LabelLayoutCache::Clear();
+
+		auto label1 = std::make_shared<noco::Label>(U"Shared text");
+		auto label2 = std::make_shared<noco::Label>(U"Shared text");
+		auto label3 = std::make_shared<noco::Label>(U"Other text");
+
+		const SizeF size1 = label1->getContentSize();
+		REQUIRE(noco::LabelLayoutCache::Count() == 1);
+
+		// 同じ条件のLabelはレイアウトを共有し、同じ結果になる
+		const SizeF size2 = label2->getContentSize();
+		REQUIRE(noco::LabelLayoutCache::Count() == 1);
+		REQUIRE(size1 == size2);
+
+		label3->getContentSize();
+		REQUIRE(noco::LabelLayoutCache::Count() == 2);
+
+		// 容量を超えた分は古いものから破棄される
+		const size_t prevCapacity = noco::LabelLayoutCache::Capacity();
+		noco::LabelLayoutCache::SetCapacity(1);
+		REQUIRE(noco::LabelLayoutCache::Count() == 1);
+
+		noco::LabelLayoutCache::SetCapacity(prevCapacity);
+		noco::LabelLayoutCache::Clear();
+	}
+
+	SECTION("Layout cache evicts the least recently used entry")
+	{
+		noco::LabelLayoutCache::Clear();
+		const size_t prevCapacity = noco::LabelLayoutCache::Capacity();
+		noco::LabelLayoutCache::SetCapacity(2);
+
+		// Labelは自身のレイアウトを保持するため、共有キャッシュを参照させるには毎回新しいLabelを使う
+		const auto layoutWithNewLabel = [](StringView text)
+			{
+				std::make_shared<noco::Label>(String{ text })->getContentSize();
+			};
+
+		layoutWithNewLabel(U"Oldest");
+		layoutWithNewLabel(U"Touched");
+		REQUIRE(noco::LabelLayoutCache::Count() == 2);
+
+		// "Touched"を参照してから追加するため、最も古い"Oldest"が破棄される
+		layoutWithNewLabel(U"Touched");
+		layoutWithNewLabel(U"Newest");
+		REQUIRE(noco::LabelLayoutCache::Count() == 2);
+
+		// 容量を広げて、ヒットした場合はエントリ数が増えず、ミスした場合は増えることを利用して確認する
+		noco::LabelLayoutCache::SetCapacity(3);
+		layoutWithNewLabel(U"Touched");
+		CHECK(noco::LabelLayoutCache::Count() == 2);
+		layoutWithNewLabel(U"Newest");
+		CHECK(noco::LabelLayoutCache::Count() == 2);
+		layoutWithNewLabel(U"Oldest");
+		CHECK(noco::LabelLayoutCache::Count() == 3);
+
+		noco::LabelLayoutCache::SetCapacity(prevCapacity);
+		noco::LabelLayoutCache::Clear();
+		REQUIRE(noco::LabelLayoutCache::Count() == 0);
+	}
+
+	SECTION("AutoShrink fits text into the rect")
+	{
+		const String text = U"The quick brown fox jumps over the lazy dog. "_s.repeat(8);
+		const SizeF rectSize{ 200, 120 };
+
+		auto label = std::make_shared<noco::Label>(text);
+		label->setFontSize(64.0);
+		label->setMinFontSize(4.0);
+		label->setSizingMode(noco::LabelSizingMode::AutoShrink);
+
+		const SizeF shrunkSize = label->getContentSize(rectSize);
+		REQUIRE(shrunkSize.x <= rectSize.x);
+		REQUIRE(shrunkSize.y <= rectSize.y);
+
+		// 刻み幅を小さくしても、より小さいフォントサイズが選ばれることはない
+		label->setAutoShrinkPrecision(0.25);
+		const SizeF preciseSize = label->getContentSize(rectSize);
+		REQUIRE(preciseSize.x <= rectSize.x);
+		REQUIRE(preciseSize.y <= rectSize.y);
+		REQUIRE(preciseSize.y >= shrunkSize.y);
+	}
+
+	SECTION("AutoShrink search finds the same candidate as a linear scan")
+	{
+		// 収まる境界がどこにあっても、大きい候補から順に試す場合と同じ番号を返す
+		constexpr size_t CandidateCount = 17;
+		for (size_t firstFitting = 0; firstFitting <= CandidateCount; ++firstFitting)
+		{
+			const auto fnFits = [&](size_t index)
+				{
+					return index >= firstFitting;
+				};
+			CHECK(noco::detail::FindFirstFittingCandidate(CandidateCount, fnFits) == Min(firstFitting, CandidateCount - 1));
+		}
+	}
 }
 
 // TextBoxコンポーネントのテスト
@@ -78,6 +178,279 @@ TEST_CASE("TextArea component", "[Component][TextArea]")
 	}
 }
 
+namespace
+{
+	// 折り返しが発生するよう、数文字で行が埋まる幅にする
+	constexpr double TextAreaTestFontSize = 16.0;
+	const SizeF TextAreaTestRectSize{ 60.0, 400.0 };
+
+	noco::detail::TextAreaCache CreateTextAreaCache(StringView text)
+	{
+		noco::detail::TextAreaCache cache;
+		cache.refreshIfDirty(text, U"", U"", TextAreaTestFontSize, TextAreaTestRectSize);
+		return cache;
+	}
+
+	// 段落・行の区切りと幅がすべて一致することを確認する
+	void CheckSameTextAreaLayout(const noco::detail::TextAreaCache& actual, const noco::detail::TextAreaCache& expected)
+	{
+		REQUIRE(actual.paragraphs.size() == expected.paragraphs.size());
+		for (size_t i = 0; i < expected.paragraphs.size(); ++i)
+		{
+			const auto& actualParagraph = actual.paragraphs[i];
+			const auto& expectedParagraph = expected.paragraphs[i];
+			CHECK(actualParagraph.textBeginIndex == expectedParagraph.textBeginIndex);
+			CHECK(actualParagraph.textLength == expectedParagraph.textLength);
+			CHECK(actualParagraph.glyphs.size() == expectedParagraph.glyphs.size());
+			CHECK(actualParagraph.advanceOffsets == expectedParagraph.advanceOffsets);
+			CHECK(actualParagraph.maxWidth == expectedParagraph.maxWidth);
+			REQUIRE(actualParagraph.wrappedLines.size() == expectedParagraph.wrappedLines.size());
+			for (size_t j = 0; j < expectedParagraph.wrappedLines.size(); ++j)
+			{
+				CHECK(actualParagraph.wrappedLines[j].glyphBegin == expectedParagraph.wrappedLines[j].glyphBegin);
+				CHECK(actualParagraph.wrappedLines[j].glyphEnd == expectedParagraph.wrappedLines[j].glyphEnd);
+				CHECK(actualParagraph.wrappedLines[j].width == expectedParagraph.wrappedLines[j].width);
+			}
+		}
+
+		REQUIRE(actual.lines.size() == expected.lines.size());
+		for (size_t i = 0; i < expected.lines.size(); ++i)
+		{
+			CHECK(actual.lines[i].paragraphIndex == expected.lines[i].paragraphIndex);
+			CHECK(actual.lines[i].glyphBegin == expected.lines[i].glyphBegin);
+			CHECK(actual.lines[i].glyphEnd == expected.lines[i].glyphEnd);
+			CHECK(actual.lines[i].textBeginIndex == expected.lines[i].textBeginIndex);
+			CHECK(actual.lines[i].textEndIndex == expected.lines[i].textEndIndex);
+			CHECK(actual.lines[i].width == expected.lines[i].width);
+		}
+		CHECK(actual.regionSize == expected.regionSize);
+	}
+}
+
+TEST_CASE("TextArea incremental re-wrap", "[Component][TextArea]")
+{
+	struct TestCase
+	{
+		String before;
+		String after;
+		String description;
+	};
+
+	const String base = U"The quick brown fox\njumps over\n\nthe lazy dog";
+
+	const Array<TestCase> testCases = {
+		// 挿入
+		{ base, U"The quick brown red fox\njumps over\n\nthe lazy dog", U"Insert inside a paragraph" },
+		{ base, U">> The quick brown fox\njumps over\n\nthe lazy dog", U"Insert at the start of the text" },
+		{ base, base + U" again", U"Insert at the end of the text" },
+		{ base, U"The quick brown fox\n!jumps over\n\nthe lazy dog", U"Insert at the start of a paragraph" },
+		{ base, U"The quick brown fox!\njumps over\n\nthe lazy dog", U"Insert at the end of a paragraph" },
+		{ base, U"X\njumps over\n\nthe lazy dog", U"Replace a whole paragraph" },
+		{ U"", U"abc\ndef", U"Insert into empty text" },
+
+		// 段落の分割
+		{ base, U"The quick\n brown fox\njumps over\n\nthe lazy dog", U"Split a paragraph in the middle" },
+		{ base, U"\nThe quick brown fox\njumps over\n\nthe lazy dog", U"Split at the start of the text" },
+		{ base, base + U"\n", U"Split at the end of the text" },
+		{ base, U"The quick brown fox\n\njumps over\n\nthe lazy dog", U"Split at the start of a paragraph" },
+		{ base, U"The quick brown fox\njumps over\n\n\nthe lazy dog", U"Split an empty paragraph" },
+		{ base, U"The quick brown fox\njumps\n\n over\n\nthe lazy dog", U"Insert several newlines at once" },
+
+		// 削除
+		{ base, U"The quick fox\njumps over\n\nthe lazy dog", U"Delete inside a paragraph" },
+		{ base, U"he quick brown fox\njumps over\n\nthe lazy dog", U"Delete at the start of the text" },
+		{ base, U"The quick brown fox\njumps over\n\nthe lazy do", U"Delete at the end of the text" },
+		{ base, U"", U"Delete everything" },
+
+		// 段落の結合
+		{ base, U"The quick brown foxjumps over\n\nthe lazy dog", U"Merge two paragraphs" },
+		{ base, U"The quick brown fox\njumps over\nthe lazy dog", U"Remove an empty paragraph" },
+		{ U"\n" + base, base, U"Remove a leading newline" },
+		{ base + U"\n", base, U"Remove a trailing newline" },
+		{ base, U"The quick brown fox\njumps overthe lazy dog", U"Merge across an empty paragraph" },
+		{ base, U"The lazy dog", U"Delete across several paragraphs" },
+	};
+
+	SECTION("Single edits match a full rebuild")
+	{
+		for (const auto& testCase : testCases)
+		{
+			INFO(testCase.description);
+
+			auto cache = CreateTextAreaCache(testCase.before);
+			cache.refreshIfDirty(testCase.after, U"", U"", TextAreaTestFontSize, TextAreaTestRectSize);
+
+			CheckSameTextAreaLayout(cache, CreateTextAreaCache(testCase.after));
+		}
+	}
+
+	SECTION("Consecutive edits match a full rebuild")
+	{
+		auto cache = CreateTextAreaCache(U"");
+		String text;
+		for (const char32 ch : base)
+		{
+			text.push_back(ch);
+			cache.refreshIfDirty(text, U"", U"", TextAreaTestFontSize, TextAreaTestRectSize);
+		}
+		CheckSameTextAreaLayout(cache, CreateTextAreaCache(text));
+
+		while (!text.isEmpty())
+		{
+			text.erase(text.begin() + text.size() / 2);
+			cache.refreshIfDirty(text, U"", U"", TextAreaTestFontSize, TextAreaTestRectSize);
+			CheckSameTextAreaLayout(cache, CreateTextAreaCache(text));
+		}
+	}
+
+	SECTION("Wrapping actually occurs in the test layout")
+	{
+		const auto cache = CreateTextAreaCache(base);
+		CHECK(cache.lines.size() > cache.paragraphs.size());
+	}
+}
+
+TEST_CASE("TextArea index and position mapping", "[Component][TextArea]")
+{
+	// 1段落目: 短い行、2段落目: 空行、3段落目: 折り返される行、4段落目: 最後の行
+	const String text = U"ab\n\nThe quick brown fox\nxyz";
+	const auto cache = CreateTextAreaCache(text);
+	const auto& lines = cache.lines;
+	REQUIRE(lines.size() > 4);
+	REQUIRE(cache.lineHeight > 0.0);
+
+	const size_t emptyLine = 1;
+	const size_t lastLine = lines.size() - 1;
+	REQUIRE(lines[emptyLine].glyphCount() == 0);
+
+	SECTION("Every index round-trips through line and column")
+	{
+		for (size_t index = 0; index <= text.size(); ++index)
+		{
+			INFO(index);
+			const auto [line, column] = cache.getIndexToLineColumn(index);
+			CHECK(cache.getLineColumnToIndex(line, column) == index);
+		}
+	}
+
+	SECTION("Line starts")
+	{
+		for (size_t line = 0; line < lines.size(); ++line)
+		{
+			INFO(line);
+			CHECK(cache.getLineColumnToIndex(line, 0) == lines[line].textBeginIndex);
+
+			// 段落先頭の行はその行の先頭に対応する(折り返し位置は前の行の末尾として扱う)
+			if (lines[line].glyphBegin == 0)
+			{
+				CHECK(cache.getIndexToLineColumn(lines[line].textBeginIndex) == std::pair<size_t, size_t>{ line, 0 });
+			}
+		}
+	}
+
+	SECTION("Line ends")
+	{
+		for (size_t line = 0; line < lines.size(); ++line)
+		{
+			INFO(line);
+			const size_t length = lines[line].textEndIndex - lines[line].textBeginIndex;
+			CHECK(cache.getIndexToLineColumn(lines[line].textEndIndex) == std::pair<size_t, size_t>{ line, length });
+
+			// 行の長さを超える列は行末に丸める
+			CHECK(cache.getLineColumnToIndex(line, length + 10) == lines[line].textEndIndex);
+		}
+	}
+
+	SECTION("Empty lines")
+	{
+		const size_t index = lines[emptyLine].textBeginIndex;
+		CHECK(index == 3);
+		CHECK(cache.getIndexToLineColumn(index) == std::pair<size_t, size_t>{ emptyLine, 0 });
+		CHECK(cache.getLineColumnToIndex(emptyLine, 5) == index);
+		CHECK(cache.getCursorPos(emptyLine, 5, 0, 0) == Vec2{ 0.0, emptyLine * cache.lineHeight });
+		CHECK(cache.getCursorIndex(Vec2{ 100.0, (emptyLine + 0.5) * cache.lineHeight }, 0, 0) == std::pair<size_t, size_t>{ emptyLine, 0 });
+	}
+
+	SECTION("Last line")
+	{
+		CHECK(cache.getIndexToLineColumn(text.size()) == std::pair<size_t, size_t>{ lastLine, 3 });
+		CHECK(cache.getIndexToLineColumn(text.size() + 10) == std::pair<size_t, size_t>{ lastLine, 3 });
+		CHECK(cache.getLineColumnToIndex(lastLine, 3) == text.size());
+		CHECK(cache.getLineColumnToIndex(lines.size() + 3, 0) == text.size());
+
+		// 最後の行より下の位置は最後の行に対応する
+		CHECK(cache.getCursorIndex(Vec2{ 0.0, (lines.size() + 5) * cache.lineHeight }, 0, 0).first == lastLine);
+	}
+
+	SECTION("Cursor positions round-trip through cursor indices")
+	{
+		for (size_t line = 0; line < lines.size(); ++line)
+		{
+			for (size_t column = 0; column <= lines[line].glyphCount(); ++column)
+			{
+				INFO("line " << line << ", column " << column);
+				const Vec2 pos = cache.getCursorPos(line, column, 0, 0);
+				CHECK(pos.y == Approx(line * cache.lineHeight));
+				CHECK(cache.getCursorIndex(pos + Vec2{ 0.0, cache.lineHeight / 2 }, 0, 0) == std::pair<size_t, size_t>{ line, column });
+			}
+		}
+	}
+
+	SECTION("Scroll offsets shift positions")
+	{
+		const size_t line = 2;
+		const Vec2 pos = cache.getCursorPos(line, 2, 1, 1);
+		CHECK(pos.y == Approx(cache.lineHeight));
+		CHECK(pos.x == Approx(cache.advanceToColumn(lines[line], 2) - cache.advanceToColumn(lines[line], 1)));
+		CHECK(cache.getCursorIndex(pos + Vec2{ 0.0, cache.lineHeight / 2 }, 1, 1) == std::pair<size_t, size_t>{ line, 2 });
+	}
+
+	SECTION("Visible line range is limited to the viewport")
+	{
+		const double lineHeight = cache.lineHeight;
+		CHECK(cache.getVisibleLineRange(0, lineHeight * 2.5) == std::pair<size_t, size_t>{ 0, 3 });
+
+		// 上端が表示領域の下端ちょうどにある行も含む
+		CHECK(cache.getVisibleLineRange(1, lineHeight * 2) == std::pair<size_t, size_t>{ 1, 4 });
+		CHECK(cache.getVisibleLineRange(2, 0.0) == std::pair<size_t, size_t>{ 2, 3 });
+
+		// 最後の行を超えないよう丸める
+		CHECK(cache.getVisibleLineRange(lastLine, lineHeight * 100) == std::pair<size_t, size_t>{ lastLine, lines.size() });
+		CHECK(cache.getVisibleLineRange(lines.size() + 5, lineHeight * 2) == std::pair<size_t, size_t>{ lines.size(), lines.size() });
+		CHECK(cache.getVisibleLineRange(0, lineHeight * 100) == std::pair<size_t, size_t>{ 0, lines.size() });
+	}
+}
+
+// TextureFontLabelコンポーネントのテスト
+TEST_CASE("TextureFontLabel component", "[Component][TextureFontLabel]")
+{
+	SECTION("Character lookup for ASCII and non-ASCII characters")
+	{
+		auto label = std::make_shared<noco::TextureFontLabel>();
+		label->setCharacterSet(U"0123456789あ");
+		label->setTextureGridColumns(1);
+		label->setTextureGridRows(11);
+		label->setTextureCellSize(Vec2{ 32, 32 });
+		label->setCharacterSize(Vec2{ 24, 24 });
+		label->setTextureCellTrimClip(true);
+
+		// 直接参照テーブルの範囲内("1")と範囲外("あ")の両方で個別のトリミングが反映される
+		label->setTextureCellTrimByCharacter({
+			{ U'1', noco::LRTB{ 4, 4, 0, 0 } },
+			{ U'あ', noco::LRTB{ 8, 8, 0, 0 } },
+		});
+
+		label->setText(U"1");
+		CHECK(label->getContentSize().x == Approx(18.0));
+
+		label->setText(U"あ");
+		CHECK(label->getContentSize().x == Approx(12.0));
+
+		label->setText(U"1あ2");
+		CHECK(label->getContentSize().x == Approx(18.0 + 12.0 + 24.0));
+	}
+}
+
 // onActivated/onDeactivatedの挙動テスト
 TEST_CASE("Component lifecycle callbacks", "[Component][Lifecycle]")
 {
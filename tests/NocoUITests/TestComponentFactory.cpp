@@ -166,3 +166,56 @@ TEST_CASE("ComponentFactory handler configuration", "[ComponentFactory]")
 		REQUIRE(component == nullptr);
 	}
 }
+
+TEST_CASE("Component cloning", "[ComponentFactory][Clone]")
+{
+	SECTION("Built-in components are copied property by property")
+	{
+		auto label = std::make_shared<noco::Label>(noco::PropertyValue<String>{ U"Default", U"Hovered", none, none }.withStyleState(U"selected", U"Selected"));
+		label->setFontSize(noco::PropertyValue<double>{ 20.0, 30.0, none, none, 0.2 });
+		label->getPropertyByName(U"color")->setParamRef(U"textColor");
+
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setKeyframesJSON(U"{\"rotation\": [{\"time\": 0.0, \"value\": 0.0}, {\"time\": 2.0, \"value\": 90.0}]}");
+
+		const Array<std::shared_ptr<noco::SerializableComponentBase>> components = {
+			label,
+			std::make_shared<noco::RectRenderer>(Palette::Red, Palette::Blue, 1.0, 2.0, 8.0),
+			std::make_shared<noco::Sprite>(U"image.png"),
+			animation,
+			std::make_shared<noco::SubCanvas>(U"missing.noco"),
+		};
+
+		for (const auto& component : components)
+		{
+			INFO("type: " << component->type());
+			const auto cloned = component->cloneComponent();
+			REQUIRE(cloned != nullptr);
+			CHECK(cloned != component);
+			CHECK(cloned->instanceId() != component->instanceId());
+			CHECK(cloned->toJSON() == component->toJSON());
+		}
+
+		const auto clonedAnimation = std::dynamic_pointer_cast<noco::KeyframeAnimation>(animation->cloneComponent());
+		REQUIRE(clonedAnimation != nullptr);
+		CHECK(clonedAnimation->duration() == Approx(2.0));
+	}
+
+	SECTION("Types missing from the factory fall back to JSON")
+	{
+		noco::ComponentFactory factory;
+		bool handlerCalled = false;
+		factory.setUnknownComponentHandler(
+			[&handlerCalled](const String& type, const JSON&, noco::detail::WithInstanceIdYN) -> std::shared_ptr<noco::ComponentBase>
+			{
+				handlerCalled = true;
+				return std::make_shared<noco::Label>(U"Placeholder: " + type);
+			});
+
+		const auto label = std::make_shared<noco::Label>(U"Original");
+		const auto cloned = std::dynamic_pointer_cast<noco::Label>(label->cloneComponent(factory));
+		REQUIRE(cloned != nullptr);
+		CHECK(handlerCalled);
+		CHECK(cloned->text().defaultValue() == U"Placeholder: Label");
+	}
+}
@@ -264,4 +264,35 @@ TEST_CASE("Hit Testing", "[Node][HitTest]")
 		auto hitNewlyVisible = parent->hitTest(Vec2{ 190, 190 });
 		REQUIRE(hitNewlyVisible == child);
 	}
+
+	SECTION("Hit test skips transparent nodes when disabled on canvas")
+	{
+		auto canvas = noco::Canvas::Create();
+		auto parent = noco::Node::Create(U"Parent");
+		parent->setRegion(noco::InlineRegion{ .sizeDelta = Vec2{ 200, 200 } });
+		canvas->addChild(parent);
+
+		auto child = noco::Node::Create(U"Child");
+		child->setRegion(noco::InlineRegion{ .sizeDelta = Vec2{ 100, 100 } });
+		parent->addChild(child);
+
+		// 親のアルファを0にする
+		parent->transform().setColor(Color{ 255, 255, 255, 0 });
+		canvas->update();
+
+		// デフォルトでは透明でもヒットする
+		REQUIRE(canvas->transparentHitTestEnabled());
+		REQUIRE(canvas->hitTest(Vec2{ 50, 50 }) == child);
+
+		// 無効にすると子孫を含めてヒットしない
+		canvas->setTransparentHitTestEnabled(false);
+		REQUIRE(canvas->hitTest(Vec2{ 50, 50 }) == nullptr);
+		REQUIRE(canvas->hitTest(Vec2{ 150, 150 }) == nullptr);
+
+		// アルファが0でなければヒットする
+		parent->transform().setColor(Color{ 255, 255, 255, 1 });
+		canvas->update();
+		REQUIRE(canvas->hitTest(Vec2{ 50, 50 }) == child);
+		REQUIRE(canvas->hitTest(Vec2{ 150, 150 }) == parent);
+	}
 }
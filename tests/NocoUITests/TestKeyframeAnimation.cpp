@@ -0,0 +1,294 @@
+#include <catch2/catch.hpp>
+#include <Siv3D.hpp>
+#include <NocoUI.hpp>
+
+// ========================================
+// KeyframeAnimationコンポーネントのテスト
+// ========================================
+
+TEST_CASE("KeyframeAnimation component", "[KeyframeAnimation]")
+{
+	auto canvas = noco::Canvas::Create();
+	auto node = noco::Node::Create();
+	canvas->addChild(node);
+
+	// フレーム時間に依存しないよう時計を止めてstepAnimationで進める
+	canvas->setAnimationPaused(true);
+
+	auto animation = std::make_shared<noco::KeyframeAnimation>();
+	animation->setTranslateKeyframes({
+		{ .time = 0.0, .value = Vec2{ 0.0, 0.0 } },
+		{ .time = 1.0, .value = Vec2{ 100.0, 0.0 } },
+		{ .time = 2.0, .value = Vec2{ 100.0, 50.0 } },
+		{ .time = 4.0, .value = Vec2{ 0.0, 50.0 } },
+	});
+	node->addComponent(animation);
+
+	SECTION("Duration is the time of the last keyframe")
+	{
+		CHECK(animation->duration() == Approx(4.0));
+	}
+
+	SECTION("Evaluates each segment in order")
+	{
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(0.0).margin(0.01));
+
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(50.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(0.0).margin(0.01));
+
+		canvas->stepAnimation(1.0);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(100.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(25.0).margin(0.01));
+
+		canvas->stepAnimation(1.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(50.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(50.0).margin(0.01));
+		CHECK(animation->isPlaying() == true);
+
+		// 最後のキーフレーム以降は最終値を維持する
+		canvas->stepAnimation(5.0);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(0.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(50.0).margin(0.01));
+		CHECK(animation->isPlaying() == false);
+	}
+
+	SECTION("Seeking backwards with manual mode")
+	{
+		animation->setManualMode(true);
+
+		const Array<std::pair<double, Vec2>> testCases = {
+			{ 3.0, Vec2{ 50.0, 50.0 } },
+			{ 0.5, Vec2{ 50.0, 0.0 } },
+			{ 1.5, Vec2{ 100.0, 25.0 } },
+			{ 1.0, Vec2{ 100.0, 0.0 } },
+			{ 4.0, Vec2{ 0.0, 50.0 } },
+			{ 0.0, Vec2{ 0.0, 0.0 } },
+		};
+		for (const auto& [time, expected] : testCases)
+		{
+			animation->setManualTime(time);
+			canvas->update();
+			INFO("manualTime: " << time);
+			CHECK(node->transform().translate().value().x == Approx(expected.x).margin(0.01));
+			CHECK(node->transform().translate().value().y == Approx(expected.y).margin(0.01));
+		}
+	}
+
+	SECTION("Loop wraps back to the first segment")
+	{
+		animation->setLoopType(noco::TweenLoopType::Loop);
+		canvas->update();
+
+		canvas->stepAnimation(3.0);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(50.0).margin(0.01));
+
+		canvas->stepAnimation(1.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(50.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(0.0).margin(0.01));
+		CHECK(animation->isPlaying() == true);
+	}
+
+	SECTION("PingPong plays backwards on odd cycles")
+	{
+		animation->setLoopType(noco::TweenLoopType::PingPong);
+		canvas->update();
+
+		canvas->stepAnimation(4.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(25.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(50.0).margin(0.01));
+
+		canvas->stepAnimation(3.0);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(50.0).margin(0.01));
+		CHECK(node->transform().translate().value().y == Approx(0.0).margin(0.01));
+	}
+}
+
+TEST_CASE("KeyframeAnimation channels", "[KeyframeAnimation]")
+{
+	auto canvas = noco::Canvas::Create();
+	auto node = noco::Node::Create();
+	canvas->addChild(node);
+	canvas->setAnimationPaused(true);
+
+	SECTION("Scale, rotation and color channels with easing")
+	{
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setScaleKeyframes({
+				{ .time = 0.0, .value = Vec2{ 1.0, 1.0 }, .easing = noco::TweenEasing::EaseInQuad },
+				{ .time = 1.0, .value = Vec2{ 2.0, 3.0 } },
+			})
+			->setRotationKeyframes({
+				{ .time = 0.0, .value = 0.0 },
+				{ .time = 1.0, .value = 90.0 },
+			})
+			->setColorKeyframes({
+				{ .time = 0.0, .value = Color{ 255, 255, 255, 255 } },
+				{ .time = 1.0, .value = Color{ 255, 0, 0, 0 } },
+			});
+		node->addComponent(animation);
+
+		canvas->update();
+		canvas->stepAnimation(0.5);
+		canvas->update();
+
+		// EaseInQuad(0.5) = 0.25
+		CHECK(node->transform().scale().value().x == Approx(1.25).margin(0.01));
+		CHECK(node->transform().scale().value().y == Approx(1.5).margin(0.01));
+		CHECK(node->transform().rotation().value() == Approx(45.0).margin(0.01));
+		CHECK(node->transform().color().value().r == 255);
+		CHECK(node->transform().color().value().g == 128);
+		CHECK(node->transform().color().value().a == 128);
+	}
+
+	SECTION("Numeric property of another component by name")
+	{
+		auto label = std::make_shared<noco::Label>();
+		label->setFontSize(10.0);
+		node->addComponent(label);
+
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setPropertyKeyframes(U"Label.fontSize", Array<noco::Keyframe<double>>{
+			{ .time = 0.0, .value = 10.0 },
+			{ .time = 2.0, .value = 30.0 },
+		});
+		node->addComponent(animation);
+
+		auto* fontSizeProperty = dynamic_cast<noco::SmoothProperty<double>*>(label->getPropertyByName(U"fontSize"));
+		REQUIRE(fontSizeProperty != nullptr);
+
+		canvas->update();
+		canvas->stepAnimation(1.0);
+		canvas->update();
+		CHECK(fontSizeProperty->value() == Approx(20.0).margin(0.01));
+
+		// 存在しないプロパティを指定しても他のチャンネルの評価は妨げない
+		animation->setPropertyKeyframes(U"Label.unknownProperty", Array<noco::Keyframe<double>>{
+			{ .time = 0.0, .value = 0.0 },
+		});
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(fontSizeProperty->value() == Approx(25.0).margin(0.01));
+	}
+
+	SECTION("Property channel resolves after the target component is added")
+	{
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setPropertyKeyframes(U"Label.fontSize", Array<noco::Keyframe<double>>{
+			{ .time = 0.0, .value = 10.0 },
+			{ .time = 2.0, .value = 30.0 },
+		});
+		node->addComponent(animation);
+
+		// 対象のコンポーネントが無い間は何もしない
+		canvas->update();
+		canvas->stepAnimation(1.0);
+		canvas->update();
+
+		// コンポーネント追加後は見つからなかった結果を使い回さずに解決し直す
+		auto label = std::make_shared<noco::Label>();
+		label->setFontSize(10.0);
+		node->addComponent(label);
+
+		auto* fontSizeProperty = dynamic_cast<noco::SmoothProperty<double>*>(label->getPropertyByName(U"fontSize"));
+		REQUIRE(fontSizeProperty != nullptr);
+
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(fontSizeProperty->value() == Approx(25.0).margin(0.01));
+
+		// 削除後に追加し直した別のコンポーネントにも追従する
+		node->removeComponent(label);
+		auto newLabel = std::make_shared<noco::Label>();
+		node->addComponent(newLabel);
+		auto* newFontSizeProperty = dynamic_cast<noco::SmoothProperty<double>*>(newLabel->getPropertyByName(U"fontSize"));
+		REQUIRE(newFontSizeProperty != nullptr);
+		canvas->update();
+		CHECK(newFontSizeProperty->value() == Approx(25.0).margin(0.01));
+	}
+
+	SECTION("Evaluated together with Tween in component order")
+	{
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setTranslateKeyframes({
+			{ .time = 0.0, .value = Vec2{ 10.0, 20.0 } },
+		});
+		node->addComponent(animation);
+
+		auto tween = std::make_shared<noco::Tween>();
+		tween->setManualMode(true)
+			->setActive(true)
+			->setTranslateEnabled(true)
+			->setTranslateFrom(Vec2{ 30.0, 40.0 })
+			->setTranslateTo(Vec2{ 30.0, 40.0 })
+			->setDuration(1.0);
+		node->addComponent(tween);
+
+		// 後に追加したTweenが優先される
+		canvas->update();
+		CHECK(node->transform().translate().value() == Vec2{ 30.0, 40.0 });
+
+		// 並べ替えるとKeyframeAnimationが優先される
+		node->moveComponentUp(tween);
+		canvas->update();
+		CHECK(node->transform().translate().value() == Vec2{ 10.0, 20.0 });
+	}
+
+	SECTION("Keyframes are sorted by time")
+	{
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setKeyframesJSON(U"{\"rotation\": [{\"time\": 1.0, \"value\": 10.0}, {\"time\": 0.0, \"value\": 0.0}]}");
+		node->addComponent(animation);
+
+		CHECK(animation->duration() == Approx(1.0));
+
+		canvas->update();
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(node->transform().rotation().value() == Approx(5.0).margin(0.01));
+	}
+
+	SECTION("Invalid JSON is ignored")
+	{
+		auto animation = std::make_shared<noco::KeyframeAnimation>();
+		animation->setKeyframesJSON(U"{invalid");
+		node->addComponent(animation);
+
+		CHECK(animation->duration() == 0.0);
+		canvas->update();
+		CHECK(node->transform().rotation().value() == Approx(0.0));
+	}
+}
+
+TEST_CASE("KeyframeAnimation serialization", "[KeyframeAnimation][Serialization]")
+{
+	auto animation = std::make_shared<noco::KeyframeAnimation>();
+	animation->setTranslateKeyframes({
+			{ .time = 0.0, .value = Vec2{ 0.0, 0.0 }, .easing = noco::TweenEasing::EaseOutCubic },
+			{ .time = 0.5, .value = Vec2{ 10.0, 20.0 } },
+		})
+		->setPropertyKeyframes(U"Label.fontSize", Array<noco::Keyframe<double>>{
+			{ .time = 0.0, .value = 12.0 },
+			{ .time = 1.5, .value = 24.0 },
+		})
+		->setLoopType(noco::TweenLoopType::PingPong);
+
+	const JSON json = animation->toJSON();
+	CHECK(json[U"type"].getString() == U"KeyframeAnimation");
+
+	const auto component = noco::ComponentFactory::GetBuiltinFactory().createComponentFromJSON(json);
+	const auto restored = std::dynamic_pointer_cast<noco::KeyframeAnimation>(component);
+	REQUIRE(restored != nullptr);
+	CHECK(restored->keyframesJSON() == animation->keyframesJSON());
+	CHECK(restored->loopType() == noco::TweenLoopType::PingPong);
+	CHECK(restored->duration() == Approx(1.5));
+}
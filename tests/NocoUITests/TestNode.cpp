@@ -996,3 +996,199 @@ TEST_CASE("Node includeSubCanvas parameter", "[Node][SubCanvas]")
 		REQUIRE(subCanvasGrandchild->getComponent<noco::Label>() == nullptr);
 	}
 }
+
+TEST_CASE("Node clone", "[Node][Clone]")
+{
+	auto node = noco::Node::Create(U"Root", noco::AnchorRegion{ .anchorMin = Anchor::TopLeft, .anchorMax = Anchor::BottomRight });
+	node->transform().setTranslate(noco::PropertyValue<Vec2>{ Vec2{ 10, 20 } }.withHovered(Vec2{ 15, 25 }));
+	node->transform().translate().setParamRef(U"offset");
+	node->setChildrenLayout(noco::VerticalLayout{ .spacing = 4.0 });
+	node->setHitPadding(noco::LRTB{ 1, 2, 3, 4 });
+	node->setScrollBarType(noco::ScrollBarType::Hidden);
+	node->setClippingEnabled(true);
+	node->setActiveSelfParamRef(U"visible");
+	node->setZOrderInSiblings(noco::PropertyValue<int32>{ 1 }.withStyleState(U"active", 5));
+	node->emplaceComponent<noco::Label>(U"Hello")->setFontSize(noco::PropertyValue<double>{ 20.0 }.withPressed(18.0));
+	node->addUpdater([](const std::shared_ptr<noco::Node>&) {});
+
+	auto child = noco::Node::Create(U"Child");
+	child->emplaceComponent<noco::RectRenderer>(Palette::Red);
+	child->addChild(noco::Node::Create(U"GrandChild"));
+	node->addChild(child);
+
+	const auto cloned = node->clone();
+	REQUIRE(cloned != nullptr);
+
+	SECTION("Serialized contents are identical")
+	{
+		CHECK(cloned->toJSON() == node->toJSON());
+		CHECK(cloned->instanceId() != node->instanceId());
+	}
+
+	SECTION("Clone is independent of the original")
+	{
+		REQUIRE(cloned->children().size() == 1);
+		CHECK(cloned->children()[0] != child);
+		CHECK(cloned->children()[0]->parentNode() == cloned);
+		CHECK(cloned->findByName(U"GrandChild") != nullptr);
+
+		const auto clonedLabel = cloned->getComponent<noco::Label>();
+		REQUIRE(clonedLabel != nullptr);
+		CHECK(clonedLabel != node->getComponent<noco::Label>());
+		clonedLabel->setText(U"Changed");
+		CHECK(node->getComponent<noco::Label>()->text().defaultValue() == U"Hello");
+	}
+
+	SECTION("Non-serializable components are not cloned")
+	{
+		CHECK(node->components().size() == 2);
+		CHECK(cloned->components().size() == 1);
+	}
+}
+
+TEST_CASE("Deferred loading of inactive nodes", "[Node][Deferred]")
+{
+	noco::SetDeferredNodeLoadingEnabled(true);
+	struct RestoreDeferredNodeLoading
+	{
+		~RestoreDeferredNodeLoading()
+		{
+			noco::SetDeferredNodeLoadingEnabled(false);
+		}
+	} restore;
+
+	auto source = noco::Canvas::Create();
+	auto popup = noco::Node::Create(U"Popup");
+	popup->setActive(false);
+	popup->emplaceComponent<noco::Label>(U"Popup title");
+	auto button = noco::Node::Create(U"Button");
+	button->emplaceComponent<noco::Toggle>()->setTag(U"popupToggle");
+	popup->addChild(button);
+	source->addChild(popup);
+	source->addChild(noco::Node::Create(U"Visible"));
+	const JSON json = source->toJSON();
+
+	SECTION("Inactive subtrees are materialized when they become active")
+	{
+		auto canvas = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas != nullptr);
+		const auto loadedPopup = canvas->children()[0];
+		CHECK(loadedPopup->name() == U"Popup");
+		CHECK(loadedPopup->hasDeferredContent());
+		CHECK_FALSE(canvas->children()[1]->hasDeferredContent());
+
+		// シリアライズでは生成せずに保持している内容を出力する
+		CHECK(canvas->toJSON() == json);
+		CHECK(loadedPopup->hasDeferredContent());
+
+		loadedPopup->setActive(true);
+		CHECK_FALSE(loadedPopup->hasDeferredContent());
+		CHECK(loadedPopup->getComponent<noco::Label>(noco::RecursiveYN::No) != nullptr);
+		REQUIRE(loadedPopup->childCount() == 1);
+		CHECK(loadedPopup->childAt(0)->name() == U"Button");
+		CHECK(loadedPopup->childAt(0)->activeInHierarchy());
+	}
+
+	SECTION("Lookups materialize on demand")
+	{
+		auto canvas = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas != nullptr);
+		CHECK(canvas->findByName(U"Button") != nullptr);
+		CHECK_FALSE(canvas->children()[0]->hasDeferredContent());
+		CHECK_FALSE(canvas->children()[0]->activeInHierarchy());
+
+		auto canvas2 = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas2 != nullptr);
+		CHECK(canvas2->getToggleValueByTagOpt(U"popupToggle").has_value());
+		CHECK_FALSE(canvas2->children()[0]->hasDeferredContent());
+	}
+
+	SECTION("Lookups without a match keep content deferred")
+	{
+		auto canvas = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas != nullptr);
+		const auto loadedPopup = canvas->children()[0];
+
+		// 保持している内容を走査し、一致するものが含まれない場合は生成しない
+		CHECK(canvas->findByName(U"Missing") == nullptr);
+		CHECK_FALSE(canvas->getToggleValueByTagOpt(U"otherToggle").has_value());
+		CHECK(loadedPopup->getComponent<noco::Sprite>(noco::RecursiveYN::Yes) == nullptr);
+		CHECK(loadedPopup->getComponents<noco::TextBox>(noco::RecursiveYN::Yes).empty());
+		loadedPopup->setTweenActiveByTag(U"", true);
+		loadedPopup->setTweenActiveAll(true);
+		CHECK(loadedPopup->hasDeferredContent());
+
+		CHECK(loadedPopup->getComponent<noco::Toggle>(noco::RecursiveYN::Yes) != nullptr);
+		CHECK_FALSE(loadedPopup->hasDeferredContent());
+	}
+
+	SECTION("Default-omitting serialization of deferred content")
+	{
+		auto canvas = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas != nullptr);
+		CHECK(canvas->toJSON(noco::OmitDefaultValuesYN::Yes) == source->toJSON(noco::OmitDefaultValuesYN::Yes));
+		CHECK(canvas->children()[0]->hasDeferredContent());
+	}
+
+	SECTION("Clones share deferred content")
+	{
+		auto canvas = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas != nullptr);
+		const auto cloned = canvas->children()[0]->clone();
+		CHECK(cloned->hasDeferredContent());
+
+		cloned->materializeDeferredContent();
+		CHECK_FALSE(cloned->hasDeferredContent());
+		CHECK(cloned->childCount() == 1);
+		CHECK(canvas->children()[0]->hasDeferredContent());
+	}
+
+	SECTION("Nested inactive nodes refer to the loaded JSON")
+	{
+		auto nestedSource = noco::Canvas::Create();
+		auto outer = noco::Node::Create(U"Outer");
+		outer->setActive(false);
+		auto inner = noco::Node::Create(U"Inner");
+		inner->setActive(false);
+		inner->emplaceComponent<noco::Label>(U"Inner label");
+		outer->addChild(noco::Node::Create(U"Sibling"));
+		outer->addChild(inner);
+		nestedSource->addChild(outer);
+		const JSON nestedJSON = nestedSource->toJSON();
+
+		const FilePath directoryPath = FileSystem::PathAppend(FileSystem::TemporaryDirectoryPath(), U"NocoUITests_DeferredNodeLoading");
+		const FilePath path = FileSystem::PathAppend(directoryPath, U"nested.noco");
+		FileSystem::CreateDirectories(directoryPath);
+		REQUIRE(nestedJSON.save(path));
+
+		// ファイルから読み込んだJSONは複製せずに共有し、子孫の遅延ノードはその中の位置を参照する
+		auto canvas = noco::Canvas::LoadFromFile(path);
+		REQUIRE(canvas != nullptr);
+		const auto loadedOuter = canvas->children()[0];
+		CHECK(loadedOuter->hasDeferredContent());
+		CHECK(canvas->toJSON() == nestedJSON);
+
+		loadedOuter->materializeDeferredContent();
+		REQUIRE(loadedOuter->childCount() == 2);
+		const auto loadedInner = loadedOuter->childAt(1);
+		CHECK(loadedInner->name() == U"Inner");
+		CHECK(loadedInner->hasDeferredContent());
+		CHECK(canvas->toJSON() == nestedJSON);
+
+		loadedInner->materializeDeferredContent();
+		const auto label = loadedInner->getComponent<noco::Label>(noco::RecursiveYN::No);
+		REQUIRE(label != nullptr);
+		CHECK(label->text().defaultValue() == U"Inner label");
+
+		FileSystem::Remove(directoryPath);
+	}
+
+	SECTION("Disabled by default")
+	{
+		noco::SetDeferredNodeLoadingEnabled(false);
+		auto canvas = noco::Canvas::CreateFromJSON(json);
+		REQUIRE(canvas != nullptr);
+		CHECK_FALSE(canvas->children()[0]->hasDeferredContent());
+		CHECK(canvas->children()[0]->childCount() == 1);
+	}
+}
@@ -157,6 +157,83 @@ TEST_CASE("SmoothProperty InteractionState transitions", "[Property]")
 	}
 }
 
+TEST_CASE("Smoothing batch evaluation", "[Property][Smoothing]")
+{
+	SECTION("Batched result matches immediate evaluation")
+	{
+		noco::Smoothing<Vec2> immediate{ Vec2{ 0.0, 0.0 } };
+		noco::Smoothing<Vec2> batched{ Vec2{ 0.0, 0.0 } };
+		noco::Smoothing<double> immediateScalar{ 10.0 };
+		noco::Smoothing<double> batchedScalar{ 10.0 };
+		noco::detail::SmoothingBatch batch;
+
+		for (int32 i = 0; i < 10; ++i)
+		{
+			immediate.update(Vec2{ 100.0, -50.0 }, 0.3, 0.016);
+			immediateScalar.update(-20.0, 0.2, 0.016);
+
+			batched.update(Vec2{ 100.0, -50.0 }, 0.3, 0.016, &batch);
+			batchedScalar.update(-20.0, 0.2, 0.016, &batch);
+			REQUIRE(batch.size() == 2);
+
+			// flushするまで値は変化しない
+			if (i == 0)
+			{
+				CHECK(batched.currentValue() == Vec2{ 0.0, 0.0 });
+			}
+			batch.flush();
+			REQUIRE(batch.size() == 0);
+
+			CHECK(batched.currentValue().x == Approx(immediate.currentValue().x));
+			CHECK(batched.currentValue().y == Approx(immediate.currentValue().y));
+			CHECK(batchedScalar.currentValue() == Approx(immediateScalar.currentValue()));
+		}
+	}
+
+	SECTION("Settled values are not registered")
+	{
+		noco::Smoothing<double> smoothing{ 0.0 };
+		noco::detail::SmoothingBatch batch;
+
+		smoothing.update(0.0, 0.3, 0.016, &batch);
+		CHECK(batch.size() == 0);
+
+		smoothing.update(1.0, 0.1, 0.016, &batch);
+		CHECK(batch.size() == 1);
+		batch.flush();
+
+		// 十分に時間が経過したら目標値で確定し、以降は登録されない
+		for (int32 i = 0; i < 200 && smoothing.currentValue() != 1.0; ++i)
+		{
+			smoothing.update(1.0, 0.1, 0.016, &batch);
+			batch.flush();
+		}
+		CHECK(smoothing.currentValue() == 1.0);
+
+		smoothing.update(1.0, 0.1, 0.016, &batch);
+		CHECK(batch.size() == 0);
+	}
+
+	SECTION("SmoothProperty uses active batch scope")
+	{
+		noco::SmoothProperty<Color> colorProperty{ U"color", Color{ 0, 0, 0, 255 } };
+		colorProperty.setPropertyValue(noco::PropertyValue<Color>{ Color{ 0, 0, 0, 255 } }.withHovered(Color{ 255, 255, 255, 255 }).withSmoothTime(0.2));
+
+		noco::detail::SmoothingBatch batch;
+		{
+			const noco::detail::SmoothingBatchScope scope{ batch };
+			colorProperty.update(noco::InteractionState::Hovered, {}, 0.05, {}, noco::SkipSmoothingYN::No);
+			CHECK(batch.size() == 1);
+			CHECK(colorProperty.value().r == 0);
+		}
+
+		// スコープの終わりで評価される
+		CHECK(batch.size() == 0);
+		CHECK(colorProperty.value().r > 0);
+		CHECK(colorProperty.value().r < 255);
+	}
+}
+
 TEST_CASE("Property currentFrameOverride", "[Property]")
 {
 	SECTION("Override temporarily changes value")
@@ -241,6 +318,61 @@ TEST_CASE("Property currentFrameOverride", "[Property]")
 	}
 }
 
+TEST_CASE("Property contentVersion", "[Property]")
+{
+	SECTION("Version changes only when the value changes")
+	{
+		noco::Property<String> property{ U"text", U"Hello" };
+
+		const uint64 version1 = property.contentVersion();
+		REQUIRE(property.contentVersion() == version1);
+
+		property.setPropertyValue(noco::PropertyValue<String>{ U"World"_s });
+		const uint64 version2 = property.contentVersion();
+		REQUIRE(version2 > version1);
+		REQUIRE(property.contentVersion() == version2);
+	}
+
+	SECTION("Version changes with parameter reference")
+	{
+		noco::Property<String> property{ U"text", U"Hello" };
+		property.setParamRef(U"message");
+		const uint64 version1 = property.contentVersion();
+
+		HashTable<String, noco::ParamValue> params;
+		params[U"message"] = noco::MakeParamValue(U"Param"_s);
+		property.update(noco::InteractionState::Default, {}, 0.016, params, noco::SkipSmoothingYN::No);
+		const uint64 version2 = property.contentVersion();
+		REQUIRE(version2 > version1);
+
+		// 同じパラメータ値で更新しても変化しない
+		property.update(noco::InteractionState::Default, {}, 0.016, params, noco::SkipSmoothingYN::No);
+		REQUIRE(property.contentVersion() == version2);
+
+		params[U"message"] = noco::MakeParamValue(U"Changed"_s);
+		property.update(noco::InteractionState::Default, {}, 0.016, params, noco::SkipSmoothingYN::No);
+		REQUIRE(property.contentVersion() > version2);
+	}
+
+	SECTION("Version changes with currentFrameOverride")
+	{
+		noco::PropertyNonInteractive<String> property{ U"text", U"Hello" };
+		const uint64 version1 = property.contentVersion();
+
+		property.setCurrentFrameOverride(U"Override");
+		const uint64 version2 = property.contentVersion();
+		REQUIRE(version2 > version1);
+
+		// 次のフレームでは上書きが解除されるため変化する
+		System::Update();
+		REQUIRE(property.contentVersion() > version2);
+
+		property.setValue(U"World");
+		REQUIRE(property.value() == U"World");
+		REQUIRE(property.contentVersion() > version2);
+	}
+}
+
 TEST_CASE("IsParamTypeCompatibleWith matrix", "[Property][Param]")
 {
 	using noco::IsParamTypeCompatibleWith;
@@ -257,3 +257,20 @@ TEST_CASE("PropertyValue FromJSON type checking", "[PropertyValue]")
 		REQUIRE(*prop.hoveredValue() == 50);  // 数値は正しく読み込まれる
 	}
 }
+
+TEST_CASE("PropertyValue forEachValue", "[PropertyValue]")
+{
+	const noco::PropertyValue<String> value = noco::PropertyValue<String>{ U"Default", U"Hovered", none, U"Disabled" }
+		.withStyleState(U"selected", U"Selected")
+		.withStyleStateInteraction(U"selected", noco::InteractionState::Pressed, U"SelectedPressed");
+
+	Array<String> values;
+	value.forEachValue([&](const String& v) { values.push_back(v); });
+
+	CHECK(values.size() == 5);
+	CHECK(values.contains(U"Default"));
+	CHECK(values.contains(U"Hovered"));
+	CHECK(values.contains(U"Disabled"));
+	CHECK(values.contains(U"Selected"));
+	CHECK(values.contains(U"SelectedPressed"));
+}
@@ -399,3 +399,355 @@ TEST_CASE("LRTB Serialization", "[LRTB][JSON][Serialization]")
 		REQUIRE(invalidMargin.margin == noco::LRTB::Zero());
 	}
 }
+
+TEST_CASE("Binary canvas format", "[Canvas][JSON][Serialization][BinaryCanvas]")
+{
+	auto canvas = noco::Canvas::Create();
+	canvas->setParamValue(U"title", String{ U"日本語のタイトル" });
+	canvas->setParamValue(U"count", 42);
+	for (int32 i = 0; i < 3; ++i)
+	{
+		auto node = noco::Node::Create(U"Item{}"_fmt(i));
+		node->transform().setTranslate(Vec2{ i * 10.5, -i });
+		node->setRegion(noco::InlineRegion{ .sizeDelta = Vec2{ 100, 20 } });
+		node->emplaceComponent<noco::Label>(U"Label{}"_fmt(i))->setHorizontalAlign(noco::HorizontalAlign::Right);
+		node->emplaceComponent<noco::RectRenderer>(Color{ 255, 128, 64 });
+		canvas->addChild(node);
+	}
+	const auto firstRect = canvas->children()[0]->getComponent<noco::RectRenderer>();
+	firstRect->setFillColor(noco::PropertyValue<Color>{ Palette::White }.withHovered(Palette::Red).withStyleState(U"selected", Palette::Blue));
+	canvas->children()[0]->getComponent<noco::Label>()->getPropertyByName(U"text")->setParamRef(U"title");
+	const JSON json = canvas->toJSON();
+
+	SECTION("Encode and decode round trip")
+	{
+		const Blob blob = noco::BinaryCanvas::Encode(*canvas);
+		const std::span<const Byte> data{ blob.data(), blob.size() };
+		CHECK(noco::BinaryCanvas::IsBinary(data));
+		CHECK(blob.size() < Unicode::ToUTF8(json.formatMinimum()).size());
+		CHECK(noco::BinaryCanvas::Encode(json) == blob);
+
+		// 既定値と等しいため書き込まれていないプロパティは、復元したJSONにも含まれない
+		const JSON decoded = noco::BinaryCanvas::Decode(data);
+		REQUIRE(decoded);
+		const JSON& decodedLabel = decoded[U"children"][0][U"components"][0];
+		CHECK(decodedLabel[U"type"].getString() == U"Label");
+		CHECK(decodedLabel[U"text_paramRef"].getString() == U"title");
+		CHECK_FALSE(decodedLabel.contains(U"fontSize"));
+
+		const auto decodedCanvas = noco::Canvas::CreateFromJSON(decoded);
+		REQUIRE(decodedCanvas != nullptr);
+		CHECK(decodedCanvas->toJSON() == json);
+	}
+
+	SECTION("Load builds nodes and components directly")
+	{
+		const Blob blob = noco::BinaryCanvas::Encode(*canvas);
+		const auto loaded = noco::BinaryCanvas::Load(std::span<const Byte>{ blob.data(), blob.size() });
+		REQUIRE(loaded != nullptr);
+		REQUIRE(loaded->children().size() == 3);
+		CHECK(loaded->paramValueAsOpt<String>(U"title").value_or(U"") == U"日本語のタイトル");
+		CHECK(loaded->paramValueAsOpt<int32>(U"count").value_or(0) == 42);
+
+		const auto& item2 = loaded->children()[2];
+		CHECK(item2->name() == U"Item2");
+		CHECK(item2->transform().translate().value() == Vec2{ 21.0, -2.0 });
+		CHECK(std::get<noco::InlineRegion>(item2->region()).sizeDelta == Vec2{ 100, 20 });
+
+		// 列挙値は列挙子の序数で、既定値以外のプロパティのみ書き込まれる
+		const auto label2 = item2->getComponent<noco::Label>();
+		REQUIRE(label2 != nullptr);
+		CHECK(label2->text().defaultValue() == U"Label2");
+		CHECK(label2->horizontalAlign().defaultValue() == noco::HorizontalAlign::Right);
+		CHECK(label2->verticalAlign().defaultValue() == noco::Label{}.verticalAlign().defaultValue());
+
+		// インタラクション状態・styleState毎の値とパラメータ参照
+		const auto rect0 = loaded->children()[0]->getComponent<noco::RectRenderer>();
+		REQUIRE(rect0 != nullptr);
+		CHECK(rect0->fillColor().defaultValue() == Color{ Palette::White });
+		CHECK(rect0->fillColor().hoveredValue() == Color{ Palette::Red });
+		REQUIRE(rect0->fillColor().styleStateValues() != nullptr);
+		CHECK(rect0->fillColor().styleStateValues()->at(U"selected").defaultValue == Color{ Palette::Blue });
+		CHECK(loaded->children()[0]->getComponent<noco::Label>()->getPropertyByName(U"text")->paramRef() == U"title");
+	}
+
+	SECTION("Properties equal to the default are not written")
+	{
+		auto defaultCanvas = noco::Canvas::Create();
+		auto modifiedCanvas = noco::Canvas::Create();
+		defaultCanvas->addChild(noco::Node::Create(U"Node"))->emplaceComponent<noco::Label>();
+		modifiedCanvas->addChild(noco::Node::Create(U"Node"))->emplaceComponent<noco::Label>()->setFontSize(50.0);
+		CHECK(noco::BinaryCanvas::Encode(*defaultCanvas).size() < noco::BinaryCanvas::Encode(*modifiedCanvas).size());
+	}
+
+	SECTION("Invalid data is rejected")
+	{
+		const Blob blob = noco::BinaryCanvas::Encode(json);
+		const std::span<const Byte> truncated{ blob.data(), blob.size() - 1 };
+		CHECK_FALSE(noco::BinaryCanvas::Decode(truncated));
+
+		const std::string text = "{}";
+		const std::span<const Byte> textData{ reinterpret_cast<const Byte*>(text.data()), text.size() };
+		CHECK_FALSE(noco::BinaryCanvas::IsBinary(textData));
+		CHECK_FALSE(noco::BinaryCanvas::Decode(textData));
+		CHECK(noco::BinaryCanvas::LoadJSON(textData).isObject());
+	}
+
+	SECTION("LoadFromFile detects the format")
+	{
+		const FilePath directoryPath = FileSystem::PathAppend(FileSystem::TemporaryDirectoryPath(), U"NocoUITests_BinaryCanvas");
+		const FilePath textPath = FileSystem::PathAppend(directoryPath, U"canvas.noco");
+		const FilePath binaryPath = FileSystem::PathAppend(directoryPath, U"canvas.nocob");
+		FileSystem::CreateDirectories(directoryPath);
+		REQUIRE(json.save(textPath));
+		REQUIRE(noco::BinaryCanvas::ConvertFile(textPath, binaryPath));
+		CHECK_FALSE(noco::BinaryCanvas::IsBinaryFile(textPath));
+		CHECK(noco::BinaryCanvas::IsBinaryFile(binaryPath));
+
+		const auto fromText = noco::Canvas::LoadFromFile(textPath);
+		const auto fromBinary = noco::Canvas::LoadFromFile(binaryPath);
+		REQUIRE(fromText != nullptr);
+		REQUIRE(fromBinary != nullptr);
+		CHECK(fromBinary->toJSON() == fromText->toJSON());
+		CHECK(fromBinary->children().size() == 3);
+
+		FileSystem::Remove(directoryPath);
+	}
+}
+
+namespace
+{
+	enum class CompatModeV1 : uint8
+	{
+		Alpha,
+		Beta,
+		Gamma,
+		Removed,
+	};
+
+	// 列挙子を並べ替え・追加・削除したもの
+	enum class CompatModeV2 : uint8
+	{
+		Gamma,
+		Delta,
+		Alpha,
+		Beta,
+	};
+
+	// 書き込み時のコンポーネントの定義
+	class CompatComponentV1 : public noco::SerializableComponentBase
+	{
+	private:
+		noco::Property<CompatModeV1> m_mode;
+		noco::Property<int32> m_count;
+		noco::Property<int32> m_removed;
+		noco::Property<String> m_label;
+
+	public:
+		CompatComponentV1()
+			: SerializableComponentBase{ U"CompatComponent", { &m_mode, &m_count, &m_removed, &m_label } }
+			, m_mode{ U"mode", CompatModeV1::Alpha }
+			, m_count{ U"count", 0 }
+			, m_removed{ U"removed", 0 }
+			, m_label{ U"label", U"" }
+		{
+		}
+
+		void set(CompatModeV1 mode, int32 count, int32 removed, const String& label)
+		{
+			m_mode.setPropertyValue(mode);
+			m_count.setPropertyValue(count);
+			m_removed.setPropertyValue(removed);
+			m_label.setPropertyValue(label);
+		}
+	};
+
+	// 読み込み時のコンポーネントの定義(プロパティの並べ替え・削除・追加と、countの型の変更)
+	class CompatComponentV2 : public noco::SerializableComponentBase
+	{
+	private:
+		noco::Property<String> m_label;
+		noco::Property<String> m_count;
+		noco::Property<CompatModeV2> m_mode;
+		noco::Property<bool> m_added;
+
+	public:
+		CompatComponentV2()
+			: SerializableComponentBase{ U"CompatComponent", { &m_label, &m_count, &m_mode, &m_added } }
+			, m_label{ U"label", U"" }
+			, m_count{ U"count", U"none" }
+			, m_mode{ U"mode", CompatModeV2::Delta }
+			, m_added{ U"added", true }
+		{
+		}
+
+		[[nodiscard]]
+		const String& label() const
+		{
+			return m_label.value();
+		}
+
+		[[nodiscard]]
+		const String& count() const
+		{
+			return m_count.value();
+		}
+
+		[[nodiscard]]
+		CompatModeV2 mode() const
+		{
+			return m_mode.value();
+		}
+
+		[[nodiscard]]
+		bool added() const
+		{
+			return m_added.value();
+		}
+	};
+}
+
+TEST_CASE("Binary canvas with custom components", "[Canvas][Serialization][BinaryCanvas]")
+{
+	noco::ComponentFactory writerFactory = noco::ComponentFactory::CreateWithBuiltinComponents();
+	writerFactory.registerComponentType<CompatComponentV1>(U"CompatComponent");
+
+	auto canvas = noco::Canvas::Create();
+	canvas->addChild(noco::Node::Create(U"Beta"))->emplaceComponent<CompatComponentV1>()->set(CompatModeV1::Beta, 7, 5, U"hello");
+	canvas->addChild(noco::Node::Create(U"Removed"))->emplaceComponent<CompatComponentV1>()->set(CompatModeV1::Removed, 0, 0, U"");
+	const Blob blob = noco::BinaryCanvas::Encode(*canvas, writerFactory);
+	const std::span<const Byte> data{ blob.data(), blob.size() };
+
+	SECTION("LoadJSON restores components missing from the builtin factory")
+	{
+		const JSON loadedJSON = noco::BinaryCanvas::LoadJSON(data);
+		REQUIRE(loadedJSON);
+		const JSON& componentJSON = loadedJSON[U"children"][0][U"components"][0];
+		CHECK(componentJSON[U"type"].getString() == U"CompatComponent");
+		CHECK(componentJSON[U"mode"].getString() == U"Beta");
+		CHECK(componentJSON[U"count"].get<int32>() == 7);
+		CHECK(componentJSON[U"label"].getString() == U"hello");
+		CHECK_FALSE(loadedJSON[U"children"][1][U"components"][0].contains(U"count"));
+
+		const auto restored = noco::Canvas::CreateFromJSON(loadedJSON, writerFactory);
+		REQUIRE(restored != nullptr);
+		CHECK(restored->toJSON() == canvas->toJSON());
+	}
+
+	SECTION("Load matches properties by name after the definition changed")
+	{
+		noco::ComponentFactory readerFactory = noco::ComponentFactory::CreateWithBuiltinComponents();
+		readerFactory.registerComponentType<CompatComponentV2>(U"CompatComponent");
+
+		const auto loaded = noco::BinaryCanvas::Load(data, readerFactory);
+		REQUIRE(loaded != nullptr);
+		REQUIRE(loaded->children().size() == 2);
+
+		// 並び順が変わったプロパティはプロパティ名で、並べ替えられた列挙子は列挙子名で対応付ける
+		const auto beta = loaded->children()[0]->getComponent<CompatComponentV2>();
+		REQUIRE(beta != nullptr);
+		CHECK(beta->label() == U"hello");
+		CHECK(beta->mode() == CompatModeV2::Beta);
+
+		// 値の種類が変わったプロパティ・削除されたプロパティは読み飛ばし、追加されたプロパティは既定値となる
+		CHECK(beta->count() == U"none");
+		CHECK(beta->added());
+
+		// 削除された列挙子は、JSONで不明な列挙値を読み込んだ場合と同様に列挙型の初期値となる
+		const auto removed = loaded->children()[1]->getComponent<CompatComponentV2>();
+		REQUIRE(removed != nullptr);
+		CHECK(removed->mode() == CompatModeV2{});
+	}
+}
+
+TEST_CASE("Default-omitting serialization", "[Canvas][Node][JSON][Serialization]")
+{
+	SECTION("Component properties equal to the default are omitted")
+	{
+		const auto defaultLabel = std::make_shared<noco::Label>();
+		const JSON defaultJSON = defaultLabel->toJSON(noco::detail::WithInstanceIdYN::No, noco::OmitDefaultValuesYN::Yes);
+		CHECK(defaultJSON[U"type"].getString() == U"Label");
+		CHECK(defaultJSON.size() == 1);
+
+		const auto label = std::make_shared<noco::Label>(U"Hello");
+		label->getPropertyByName(U"color")->setParamRef(U"textColor");
+		const JSON json = label->toJSON(noco::detail::WithInstanceIdYN::No, noco::OmitDefaultValuesYN::Yes);
+		CHECK(json.contains(U"text"));
+		CHECK_FALSE(json.contains(U"fontSize"));
+
+		// パラメータ参照を持つプロパティは値が既定値と等しくても残す
+		CHECK(json.contains(U"color"));
+		CHECK(json[U"color_paramRef"].getString() == U"textColor");
+
+		const auto restored = std::dynamic_pointer_cast<noco::Label>(noco::ComponentFactory::GetBuiltinFactory().createComponentFromJSON(json));
+		REQUIRE(restored != nullptr);
+		CHECK(restored->toJSON() == label->toJSON());
+	}
+
+	SECTION("Node fields equal to the default are omitted")
+	{
+		const auto node = noco::Node::Create(U"Node");
+		const JSON json = node->toJSON(noco::detail::WithInstanceIdYN::No, noco::OmitDefaultValuesYN::Yes);
+		CHECK(json[U"name"].getString() == U"Node");
+		CHECK(json.contains(U"components"));
+		CHECK(json.contains(U"children"));
+		CHECK_FALSE(json.contains(U"transform"));
+		CHECK_FALSE(json.contains(U"isHitTarget"));
+		CHECK_FALSE(json.contains(U"activeSelf"));
+
+		node->setActive(false);
+		node->transform().setScale(Vec2{ 2.0, 2.0 });
+		const JSON changedJSON = node->toJSON(noco::detail::WithInstanceIdYN::No, noco::OmitDefaultValuesYN::Yes);
+		CHECK(changedJSON.contains(U"activeSelf"));
+		CHECK(changedJSON[U"transform"].contains(U"scale"));
+		CHECK_FALSE(changedJSON[U"transform"].contains(U"translate"));
+	}
+
+	SECTION("Round trip through compact JSON")
+	{
+		noco::ComponentFactory factory = noco::ComponentFactory::CreateWithBuiltinComponents();
+		factory.registerComponentType<CompatComponentV1>(U"CompatComponent");
+
+		auto canvas = noco::Canvas::Create();
+		canvas->setParamValue(U"enabled", true);
+		canvas->setParamValue(U"size", 24.0);
+		const auto& node = canvas->addChild(noco::Node::Create(U"Node"));
+
+		// 値が既定値と等しいが、パラメータ参照を持つプロパティ
+		node->setInteractableParamRef(U"enabled");
+		const auto label = node->emplaceComponent<noco::Label>();
+		label->getPropertyByName(U"fontSize")->setParamRef(U"size");
+
+		// 既定値はそのままで、styleState毎の値のみを持つプロパティ
+		const auto rect = node->emplaceComponent<noco::RectRenderer>();
+		rect->setFillColor(noco::PropertyValue<Color>{ rect->fillColor().defaultValue() }.withStyleState(U"selected", Palette::Blue));
+
+		// 組み込みでない型のコンポーネント(既定値のまま)
+		node->emplaceComponent<CompatComponentV1>();
+
+		const JSON fullJSON = canvas->toJSON();
+		const JSON compactJSON = canvas->toJSON(noco::OmitDefaultValuesYN::Yes);
+		CHECK(compactJSON[U"serializedVersion"].get<int32>() >= noco::SerializedVersion_OmitDefaultValues);
+
+		const JSON& nodeJSON = compactJSON[U"children"][0];
+		CHECK(nodeJSON.contains(U"interactable"));
+		CHECK(nodeJSON[U"interactable_paramRef"].getString() == U"enabled");
+		CHECK_FALSE(nodeJSON.contains(U"activeSelf"));
+
+		const JSON& labelJSON = nodeJSON[U"components"][0];
+		CHECK(labelJSON.contains(U"fontSize"));
+		CHECK(labelJSON[U"fontSize_paramRef"].getString() == U"size");
+		CHECK_FALSE(labelJSON.contains(U"text"));
+
+		const JSON& rectJSON = nodeJSON[U"components"][1];
+		CHECK(rectJSON[U"fillColor"][U"styleStates"].contains(U"selected"));
+		CHECK_FALSE(rectJSON.contains(U"blendMode"));
+
+		// 組み込みのファクトリに登録されていない型は既定値が分からないため全て書き込む
+		CHECK(nodeJSON[U"components"][2] == CompatComponentV1{}.toJSON());
+
+		const auto restored = noco::Canvas::CreateFromJSON(compactJSON, factory);
+		REQUIRE(restored != nullptr);
+		CHECK(restored->toJSON() == fullJSON);
+	}
+}
@@ -868,4 +868,159 @@ TEST_CASE("Tween component", "[Tween]")
 		// canvas->update()を呼ばずにチェック
 		CHECK(canvas->isTweenPlayingByTag(U"test") == true);
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Tween with canvas animation clock", "[Tween][Canvas]")
+{
+	auto canvas = noco::Canvas::Create();
+	auto node = noco::Node::Create();
+	canvas->addChild(node);
+
+	// フレーム時間に依存しないよう時計を止めてstepAnimationで進める
+	canvas->setAnimationPaused(true);
+
+	auto tween = std::make_shared<noco::Tween>();
+	tween->setActive(true)
+		->setTranslateEnabled(true)
+		->setTranslateFrom(Vec2{ 0.0, 0.0 })
+		->setTranslateTo(Vec2{ 100.0, 0.0 })
+		->setDelay(0.0)
+		->setDuration(1.0)
+		->setEasing(noco::TweenEasing::Linear)
+		->setLoopType(noco::TweenLoopType::None);
+	node->addComponent(tween);
+
+	SECTION("Paused clock does not advance")
+	{
+		canvas->update();
+		CHECK(canvas->animationDeltaTime() == 0.0);
+		CHECK(node->transform().translate().value().x == Approx(0.0).margin(0.01));
+
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(0.0).margin(0.01));
+		CHECK(tween->isPlaying() == true);
+	}
+
+	SECTION("Step advances tweens deterministically")
+	{
+		canvas->update();
+
+		canvas->stepAnimation(0.25);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(25.0).margin(0.01));
+
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(75.0).margin(0.01));
+		CHECK(tween->isPlaying() == true);
+
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(100.0).margin(0.01));
+		CHECK(tween->isPlaying() == false);
+
+		// 再生終了後も最終値を維持する
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(100.0).margin(0.01));
+	}
+
+	SECTION("Restart after finishing")
+	{
+		canvas->update();
+		canvas->stepAnimation(2.0);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(100.0).margin(0.01));
+
+		tween->setActive(false);
+		canvas->update();
+		tween->setActive(true);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(0.0).margin(0.01));
+
+		canvas->stepAnimation(0.5);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(50.0).margin(0.01));
+	}
+
+	SECTION("Time scale")
+	{
+		canvas->setAnimationTimeScale(-1.0);
+		CHECK(canvas->animationTimeScale() == 0.0);
+
+		canvas->setAnimationTimeScale(0.0);
+		canvas->setAnimationPaused(false);
+		canvas->update();
+		CHECK(canvas->animationDeltaTime() == 0.0);
+	}
+}
+
+TEST_CASE("Tween easing lookup table", "[Tween]")
+{
+	SECTION("Lookup table approximates easing functions")
+	{
+		for (uint8 i = 0; i <= static_cast<uint8>(noco::TweenEasing::EaseInOutBounce); ++i)
+		{
+			const auto easing = static_cast<noco::TweenEasing>(i);
+			INFO("easing: " << static_cast<int32>(i));
+
+			// 両端は厳密に一致する
+			CHECK(noco::TweenEasingLookupTable::Evaluate(easing, 0.0) == Approx(noco::EvaluateTweenEasing(easing, 0.0)).margin(1e-9));
+			CHECK(noco::TweenEasingLookupTable::Evaluate(easing, 1.0) == Approx(noco::EvaluateTweenEasing(easing, 1.0)).margin(1e-9));
+
+			for (int32 step = 0; step <= 1000; ++step)
+			{
+				const double t = step / 1000.0;
+				CHECK(noco::TweenEasingLookupTable::Evaluate(easing, t) == Approx(noco::EvaluateTweenEasing(easing, t)).margin(0.005));
+			}
+		}
+	}
+
+	SECTION("Resolution")
+	{
+		const size_t prevResolution = noco::TweenEasingLookupTable::Resolution();
+
+		noco::TweenEasingLookupTable::SetResolution(0);
+		CHECK(noco::TweenEasingLookupTable::Resolution() == 1);
+
+		// 分割数1ではLinear以外も両端を結ぶ直線になる
+		CHECK(noco::TweenEasingLookupTable::Evaluate(noco::TweenEasing::EaseInQuad, 0.5) == Approx(0.5));
+
+		noco::TweenEasingLookupTable::SetResolution(prevResolution);
+		CHECK(noco::TweenEasingLookupTable::Evaluate(noco::TweenEasing::EaseInQuad, 0.5) == Approx(0.25).margin(0.001));
+	}
+
+	SECTION("Per-tween and global selection")
+	{
+		auto canvas = noco::Canvas::Create();
+		auto node = noco::Node::Create();
+		canvas->addChild(node);
+
+		auto tween = std::make_shared<noco::Tween>();
+		tween->setManualMode(true)
+			->setActive(true)
+			->setTranslateEnabled(true)
+			->setTranslateFrom(Vec2{ 0.0, 0.0 })
+			->setTranslateTo(Vec2{ 100.0, 0.0 })
+			->setDuration(1.0)
+			->setEasing(noco::TweenEasing::EaseOutBounce)
+			->setManualTime(0.37);
+		node->addComponent(tween);
+
+		CHECK(tween->easingEvaluation() == noco::TweenEasingEvaluation::Global);
+		CHECK(noco::TweenEasingLookupTable::IsGlobalEnabled() == false);
+
+		const double expected = 100.0 * noco::EvaluateTweenEasing(noco::TweenEasing::EaseOutBounce, 0.37);
+
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(expected));
+
+		tween->setEasingEvaluation(noco::TweenEasingEvaluation::LookupTable);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(expected).margin(0.5));
+
+		noco::TweenEasingLookupTable::SetGlobalEnabled(true);
+		tween->setEasingEvaluation(noco::TweenEasingEvaluation::Exact);
+		canvas->update();
+		CHECK(node->transform().translate().value().x == Approx(expected));
+		noco::TweenEasingLookupTable::SetGlobalEnabled(false);
+	}
+}
@@ -0,0 +1,50 @@
+﻿#include <Siv3D.hpp>
+#include <NocoUI.hpp>
+
+// UIアセットのディレクトリをアセットアーカイブ(.nocopack)にまとめるコマンドラインツール
+// 使い方: NocoPack <入力ディレクトリ> <出力ファイル>
+//         NocoPack --compile <入力.noco> <出力.nocob>  (Canvasをバイナリ形式に変換)
+
+// ウィンドウを使用しないためヘッドレスモードで起動
+SIV3D_SET(EngineOption::Renderer::Headless)
+
+void Main()
+{
+	const Array<String> args = System::GetCommandLineArgs();
+	if (args.size() == 4 && args[1] == U"--compile")
+	{
+		const FilePath& sourcePath = args[2];
+		const FilePath& binaryPath = args[3];
+		if (!noco::BinaryCanvas::ConvertFile(sourcePath, binaryPath))
+		{
+			Console << U"Failed to compile canvas: {}"_fmt(sourcePath);
+			return;
+		}
+		Console << U"Compiled {} into {} ({} bytes -> {} bytes)"_fmt(sourcePath, binaryPath, FileSystem::FileSize(sourcePath), FileSystem::FileSize(binaryPath));
+		return;
+	}
+
+	if (args.size() < 3)
+	{
+		Console << U"Usage: NocoPack <source directory> <output file (.{})>"_fmt(noco::AssetArchive::FileExtension);
+		Console << U"       NocoPack --compile <source canvas (.noco)> <output file (.{})>"_fmt(noco::BinaryCanvas::FileExtension);
+		return;
+	}
+
+	const FilePath& sourceDirectoryPath = args[1];
+	const FilePath& archivePath = args[2];
+	if (!noco::AssetArchive::Build(sourceDirectoryPath, archivePath))
+	{
+		Console << U"Failed to create archive: {}"_fmt(archivePath);
+		return;
+	}
+
+	// 作成したアーカイブが読み込めることを確認
+	noco::AssetArchive archive;
+	if (!archive.open(archivePath))
+	{
+		Console << U"Failed to open created archive: {}"_fmt(archivePath);
+		return;
+	}
+	Console << U"Packed {} files into {}"_fmt(archive.size(), archivePath);
+}